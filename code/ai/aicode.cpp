@@ -203,6 +203,9 @@ object *En_objp;
 #define	STEALTH_MAX_VIEW_DIST	400		// dist at which 1) stealth no longer visible 2) firing inaccuracy is greatest
 #define	STEALTH_VIEW_CONE_DOT	0.707		// (half angle of 45 degrees)
 
+// Weapons[] used to be this size, and the AI still fires less as the weapon count gets close to it
+#define	AI_WEAPON_SLOT_BUDGET	3000
+
 ai_class *Ai_classes = NULL;
 int	Ai_firing_enabled = 1;
 int	Num_ai_classes;
@@ -2045,7 +2048,7 @@ float get_wing_lowest_max_speed(object *objp)
 	ship_obj	*so;
 
 	Assert(objp->type == OBJ_SHIP);
-	Assert((objp->instance >= 0) && (objp->instance < MAX_OBJECTS));
+	Assert((objp->instance >= 0) && (objp->instance < MAX_SHIPS));
 	shipp = &Ships[objp->instance];
 	wingnum = shipp->wingnum;
 
@@ -2097,7 +2100,7 @@ float get_wing_lowest_av_ab_speed(object *objp)
 	ship_info *sip;
 
 	Assert(objp->type == OBJ_SHIP);
-	Assert((objp->instance >= 0) && (objp->instance < MAX_OBJECTS));
+	Assert((objp->instance >= 0) && (objp->instance < MAX_SHIPS));
 	shipp = &Ships[objp->instance];
 	Assert((shipp->ai_index >= 0) && (shipp->ai_index < MAX_AI_INFO));
 	aip = &Ai_info[shipp->ai_index];
@@ -3336,7 +3339,7 @@ void ai_stay_still(object *still_objp, vec3d *view_pos)
 	ai_info	*aip;
 
 	Assert(still_objp->type == OBJ_SHIP);
-	Assert((still_objp->instance >= 0) && (still_objp->instance < MAX_OBJECTS));
+	Assert((still_objp->instance >= 0) && (still_objp->instance < MAX_SHIPS));
 
 	shipp = &Ships[still_objp->instance];
 	Assert((shipp->ai_index >= 0) && (shipp->ai_index < MAX_AI_INFO));
@@ -4170,7 +4173,7 @@ float ai_path_0()
 	gobjp = &Objects[aip->goal_objnum];
 
 	if (aip->path_start == -1) {
-		Assert(aip->goal_objnum >= 0 && aip->goal_objnum < MAX_OBJECTS);
+		Assert(aip->goal_objnum >= 0 && aip->goal_objnum < (int)Objects.size());
 		int path_num;
 		Assert(aip->active_goal >= 0);
 		ai_goal *aigp = &aip->goals[aip->active_goal];
@@ -4313,7 +4316,7 @@ float ai_path_1()
 	gobjp = &Objects[aip->goal_objnum];
 
 	if (aip->path_start == -1) {
-		Assert(aip->goal_objnum >= 0 && aip->goal_objnum < MAX_OBJECTS);
+		Assert(aip->goal_objnum >= 0 && aip->goal_objnum < (int)Objects.size());
 		int path_num;
 		Assert(aip->active_goal >= 0);
 		ai_goal *aigp = &aip->goals[aip->active_goal];
@@ -5974,7 +5977,7 @@ void set_primary_weapon_linkage(object *objp)
 
 	shipp = &Ships[objp->instance];
 
-	if (Num_weapons > (int) (MAX_WEAPONS * 0.75f)) {
+	if (Num_weapons > (int) (AI_WEAPON_SLOT_BUDGET * 0.75f)) {
 		if (shipp->flags[Ship::Ship_Flags::Primary_linked]) {
 			nprintf(("AI", "Frame %i, ship %s: Unlinking primaries.\n", Framecount, shipp->ship_name));
 			shipp->flags.remove(Ship::Ship_Flags::Primary_linked);
@@ -6253,7 +6256,7 @@ int ai_fire_primary_weapon(object *objp)
 	aip = &Ai_info[shipp->ai_index];
 
 	//	If low on slots, fire a little less often.
-	if (Num_weapons > (int) (0.9f * MAX_WEAPONS)) {
+	if (Num_weapons > (int) (0.9f * AI_WEAPON_SLOT_BUDGET)) {
 		if (frand() > 0.5f) {
 			nprintf(("AI", "Frame %i, %s not fire.\n", Framecount, shipp->ship_name));
 			return 0;
@@ -8256,7 +8259,7 @@ void ai_set_guard_wing(object *objp, int wingnum)
 		leader_shipnum = Wings[wingnum].ship_index[0];
 		leader_objnum = Ships[leader_shipnum].objnum;
 
-		Assert((leader_objnum >= 0) && (leader_objnum < MAX_OBJECTS));
+		Assert((leader_objnum >= 0) && (leader_objnum < (int)Objects.size()));
 		
 		if (leader_objnum == OBJ_INDEX(objp)) {
 			return;
@@ -10493,7 +10496,7 @@ int ai_guard_find_nearby_bomb(object *guarding_objp, object *guarded_objp)
 	weapon_info	*wip;
 
 	for ( mo = GET_NEXT(&Missile_obj_list); mo != END_OF_LIST(&Missile_obj_list); mo = GET_NEXT(mo) ) {
-		Assert(mo->objnum >= 0 && mo->objnum < MAX_OBJECTS);
+		Assert(mo->objnum >= 0 && mo->objnum < (int)Objects.size());
 		bomb_objp = &Objects[mo->objnum];
 		if (bomb_objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
@@ -11502,7 +11505,7 @@ void ai_still()
 	ai_info	*aip;
 
 	Assert(Pl_objp->type == OBJ_SHIP);
-	Assert((Pl_objp->instance >= 0) && (Pl_objp->instance < MAX_OBJECTS));
+	Assert((Pl_objp->instance >= 0) && (Pl_objp->instance < MAX_SHIPS));
 
 	shipp = &Ships[Pl_objp->instance];
 	Assert((shipp->ai_index >= 0) && (shipp->ai_index < MAX_AI_INFO));
@@ -11860,7 +11863,7 @@ void ai_dock()
 	{
 		//	This mode is only for rearming/repairing.
 		//	The ship that is performing the rearm enters this mode after it docks.
-		Assert((aip->goal_objnum >= -1) && (aip->goal_objnum < MAX_OBJECTS));
+		Assert((aip->goal_objnum >= -1) && (aip->goal_objnum < (int)Objects.size()));
 
 		float dist = dock_orient_and_approach(Pl_objp, docker_index, goal_objp, dockee_index, DOA_DOCK);
 		Assert(dist != UNINITIALIZED_VALUE);
@@ -12461,7 +12464,7 @@ float get_wing_largest_radius(object *objp, bool formation_object_flag)
 	ship		*shipp;
 
 	Assert(objp->type == OBJ_SHIP || objp->type == OBJ_START);
-	Assert((objp->instance >= 0) && (objp->instance < MAX_OBJECTS));
+	Assert((objp->instance >= 0) && (objp->instance < MAX_SHIPS));
 	shipp = &Ships[objp->instance];
 
 	if (formation_object_flag) {
@@ -12680,7 +12683,7 @@ int ai_formation()
 	//	Determine which kind of formation flying.
 	//	If tracking an object, not in waypoint mode:
 	if (aip->ai_flags[AI::AI_Flags::Formation_object]) {
-		if ((aip->goal_objnum < 0) || (aip->goal_objnum >= MAX_OBJECTS) || (aip->mode == AIM_BAY_DEPART)) {
+		if ((aip->goal_objnum < 0) || (aip->goal_objnum >= (int)Objects.size()) || (aip->mode == AIM_BAY_DEPART)) {
 			aip->ai_flags.remove(AI::AI_Flags::Formation_object);
 			return 1;
 		}
@@ -14586,13 +14589,13 @@ static int ai_find_shockwave_weapon(const object *objp)
 		weapon		*wp;
 		weapon_info	*wip;
 	
-		Assert(mo->objnum >= 0 && mo->objnum < MAX_OBJECTS);
+		Assert(mo->objnum >= 0 && mo->objnum < (int)Objects.size());
 		A = &Objects[mo->objnum];
 		if (A->flags[Object::Object_Flags::Should_be_dead])
 			continue;
 
 		Assert(A->type == OBJ_WEAPON);
-		Assert((A->instance >= 0) && (A->instance < MAX_WEAPONS));
+		Assert((A->instance >= 0) && (A->instance < (int)Weapons.size()));
 		wp = &Weapons[A->instance];
 		wip = &Weapon_info[wp->weapon_info_index];
 		Assert( wip->subtype == WP_MISSILE );
@@ -14654,7 +14657,7 @@ static int ai_find_shockwave_ship(object *objp)
 		object		*A;
 		ship			*shipp;
 	
-		Assert(so->objnum >= 0 && so->objnum < MAX_OBJECTS);
+		Assert(so->objnum >= 0 && so->objnum < (int)Objects.size());
 		A = &Objects[so->objnum];
 		if (A->flags[Object::Object_Flags::Should_be_dead])
 			continue;
@@ -16216,7 +16219,7 @@ void ai_ship_hit(object *objp_ship, object *hit_objp, const vec3d *hit_normal)
 			// Added OBJ_BEAM for traitor detection - FUBAR
 			if ((hit_objp->type == OBJ_WEAPON) || (hit_objp->type == OBJ_BEAM)) {
 				hitter_objnum = hit_objp->parent;
-				Assert((hitter_objnum < MAX_OBJECTS));
+				Assert((hitter_objnum < (int)Objects.size()));
 				if (hitter_objnum == -1) {
 					return; // Possible SSM, bail while we still can.
 				}
@@ -16265,7 +16268,7 @@ void ai_ship_hit(object *objp_ship, object *hit_objp, const vec3d *hit_normal)
 			return;
 		
 		hitter_objnum = hit_objp->parent;
-		Assertion((hitter_objnum >= 0) && (hitter_objnum < MAX_OBJECTS), "hitter_objnum in this function is an invalid index of %d.  This can cause random behavior, and is a coder mistake.  Please report!", hitter_objnum);
+		Assertion((hitter_objnum >= 0) && (hitter_objnum < (int)Objects.size()), "hitter_objnum in this function is an invalid index of %d.  This can cause random behavior, and is a coder mistake.  Please report!", hitter_objnum);
 		objp_hitter = &Objects[hitter_objnum];
 
 		// Only work through hits by objects that are still in the game
@@ -16516,7 +16519,7 @@ void ai_ship_destroy(int shipnum)
 {
 	Assert((shipnum >= 0) && (shipnum < MAX_SHIPS));
 	auto dead_shipp = &Ships[shipnum];
-	Assert((dead_shipp->objnum >= 0) && (dead_shipp->objnum < MAX_OBJECTS));
+	Assert((dead_shipp->objnum >= 0) && (dead_shipp->objnum < (int)Objects.size()));
 	auto dead_objp = &Objects[dead_shipp->objnum];
 	Assert((dead_shipp->ai_index >= 0) && (dead_shipp->ai_index < MAX_AI_INFO));
 	auto dead_aip = &Ai_info[dead_shipp->ai_index];
@@ -147,11 +147,10 @@ bool object_in_turret_fov(const object *objp, const ship_subsys *ss, const vec3d
 		}
 
 		auto pm = model_get(model_num);
-		for (int i = 0; i < 8; i++) {
-			vec3d bbox_point;
-			vm_vec_unrotate(&bbox_point, &pm->bounding_box[i], &objp->orient);
-			bbox_point += objp->pos;
+		vec3d bbox_points[8];
+		vm_vec_unrotate_add_n(bbox_points, pm->bounding_box, 8, &objp->orient, &objp->pos);
 
+		for (const auto &bbox_point : bbox_points) {
 			vm_vec_normalized_dir(&v2e, &bbox_point, tpos);
 			in_fov = turret_fov_test(ss, tvec, &v2e, -0.2f);
 
@@ -2272,7 +2271,7 @@ void ai_turret_execute_behavior(const ship *shipp, ship_subsys *ss)
 	}
 
 	// AL 09/14/97: ensure ss->turret_enemy_objnum != -1 before setting lep
-	if ( (ss->turret_enemy_objnum >= 0 && ss->turret_enemy_objnum < MAX_OBJECTS) && (ss->turret_enemy_sig == Objects[ss->turret_enemy_objnum].signature) )
+	if ( (ss->turret_enemy_objnum >= 0 && ss->turret_enemy_objnum < (int)Objects.size()) && (ss->turret_enemy_sig == Objects[ss->turret_enemy_objnum].signature) )
 	{
 		lep = &Objects[ss->turret_enemy_objnum];
 	}
@@ -2284,7 +2283,7 @@ void ai_turret_execute_behavior(const ship *shipp, ship_subsys *ss)
 		ss->flags.remove(Ship::Subsystem_Flags::Forced_subsys_target);
 	}
 
-	Assert((shipp->objnum >= 0) && (shipp->objnum < MAX_OBJECTS));
+	Assert((shipp->objnum >= 0) && (shipp->objnum < (int)Objects.size()));
 	int parent_objnum = shipp->objnum;
 	objp = &Objects[shipp->objnum];
 	Assert(objp->type == OBJ_SHIP);
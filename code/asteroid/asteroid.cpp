@@ -31,6 +31,7 @@
 #include "network/multiutil.h"
 #include "object/objcollide.h"
 #include "object/object.h"
+#include "object/objectgrid.h"
 #include "parse/parselo.h"
 #include "particle/ParticleEffect.h"
 #include "scripting/global_hooks.h"
@@ -40,9 +41,12 @@
 #include "ship/shipfx.h"
 #include "ship/shiphit.h"
 #include "stats/scoring.h"
+#include "tracing/tracing.h"
+#include "weapon/beam.h"
 #include "weapon/weapon.h"
 
 #include <algorithm>
+#include <cfloat>
 #include <random>
 
 #define			ASTEROID_OBJ_USED	(1<<0)				// flag used in asteroid_obj struct
@@ -84,6 +88,125 @@ typedef struct asteroid_target {
 // if not, then this is whatever number of mission-specified ships (after they arrive, list is sanitized when they exit)
 SCP_vector<asteroid_target> Asteroid_targets;
 
+// With Bulk_asteroid_fields, the asteroids of a field which are far from every ship, weapon, beam and shockwave aren't
+// objects.  Nothing can hit them and they can't hit anything, so all they do is drift, spin and wrap around the field,
+// which is done for all of them at once with each value kept in its own array.  They become objects again when something
+// comes close, and go back to sleep once everything has left.
+#define	ASTEROID_DORMANT_WAKE_DIST		300.0f	// how close something has to come for a dormant asteroid to wake up
+#define	ASTEROID_DORMANT_LOOKAHEAD		1.0f	// plus how far both move in this many seconds
+#define	ASTEROID_DORMANT_SLEEP_FACTOR	2.0f	// everything has to be this many times as far away for an asteroid to go dormant
+#define	ASTEROID_DORMANT_BEAM_REACH		(ASTEROID_DORMANT_WAKE_DIST * 1.5f)	// each sphere along a beam, so that they overlap
+#define	ASTEROID_DORMANT_GRID_DIM		32		// cells per axis of the grid which finds the asteroids something is close to
+#define	ASTEROID_DORMANT_MAX_WAKER_CELLS	512		// anything touching more cells than this is checked against every asteroid
+
+class asteroid_dormant_list
+{
+	// calls func on every array, to keep them all the same size
+	template <typename Func>
+	void for_each_array(Func func)
+	{
+		func(pos_x); func(pos_y); func(pos_z);
+		func(vel_x); func(vel_y); func(vel_z);
+		func(desired_vel_x); func(desired_vel_y); func(desired_vel_z);
+		func(gravity_const); func(spin_angle); func(spin_rate); func(reach);
+		func(radius); func(spin_axis); func(start_orient);
+		func(asteroid_type); func(asteroid_subtype); func(model_num);
+	}
+
+public:
+	// moved every frame
+	SCP_vector<float>	pos_x, pos_y, pos_z;
+	SCP_vector<float>	vel_x, vel_y, vel_z;
+	SCP_vector<float>	desired_vel_x, desired_vel_y, desired_vel_z;
+	SCP_vector<float>	gravity_const;
+	SCP_vector<float>	spin_angle, spin_rate;		// how far and how fast it has turned around spin_axis
+	SCP_vector<float>	reach;						// radius plus how far it moves in ASTEROID_DORMANT_LOOKAHEAD
+
+	// only needed to render or wake up an asteroid
+	SCP_vector<float>	radius;
+	SCP_vector<vec3d>	spin_axis;
+	SCP_vector<matrix>	start_orient;				// orientation at a spin angle of 0
+	SCP_vector<int>		asteroid_type, asteroid_subtype, model_num;
+
+	size_t size() const { return pos_x.size(); }
+
+	void add(int type, int subtype, const vec3d *pos, const matrix *orient, const vec3d *vel, const vec3d *desired_vel, const vec3d *rotvel)
+	{
+		auto asip = &Asteroid_info[type];
+		int model = asip->subtypes[subtype].model_number;
+
+		pos_x.push_back(pos->xyz.x); pos_y.push_back(pos->xyz.y); pos_z.push_back(pos->xyz.z);
+		vel_x.push_back(vel->xyz.x); vel_y.push_back(vel->xyz.y); vel_z.push_back(vel->xyz.z);
+		desired_vel_x.push_back(desired_vel->xyz.x); desired_vel_y.push_back(desired_vel->xyz.y); desired_vel_z.push_back(desired_vel->xyz.z);
+		gravity_const.push_back(asip->gravity_const);
+
+		// the physics turn asteroids by their rotvel in local coordinates, which is a turn around a fixed axis
+		vec3d axis = *rotvel;
+		float rate = vm_vec_mag(&axis);
+		if (rate > 0.0f) {
+			vm_vec_scale(&axis, 1.0f / rate);
+		} else {
+			axis = vmd_z_vector;
+		}
+
+		spin_angle.push_back(0.0f);
+		spin_rate.push_back(rate);
+		spin_axis.push_back(axis);
+		start_orient.push_back(*orient);
+
+		radius.push_back(model_get_radius(model));
+		reach.push_back(radius.back() + vm_vec_mag(vel) * ASTEROID_DORMANT_LOOKAHEAD);
+
+		asteroid_type.push_back(type);
+		asteroid_subtype.push_back(subtype);
+		model_num.push_back(model);
+	}
+
+	// moves the last asteroid into slot i
+	void remove(size_t i)
+	{
+		for_each_array([i](auto &values) {
+			values[i] = values.back();
+			values.pop_back();
+		});
+	}
+
+	void clear()
+	{
+		for_each_array([](auto &values) { values.clear(); });
+	}
+
+	void get_orient(size_t i, matrix *orient) const
+	{
+		matrix spin;
+		vm_quaternion_rotate(&spin, spin_angle[i], &spin_axis[i]);
+		vm_matrix_x_matrix(orient, &start_orient[i], &spin);
+	}
+};
+
+static asteroid_dormant_list Asteroid_dormant;
+
+// what wakes up dormant asteroids within reach of pos
+typedef struct asteroid_waker {
+	vec3d	pos;
+	float	reach;
+} asteroid_waker;
+
+static SCP_vector<asteroid_waker> Asteroid_wakers;
+static SCP_vector<uint> Asteroid_waker_cell_start;		// where each cell starts in Asteroid_waker_cells, one extra at the end
+static SCP_vector<int> Asteroid_waker_cells;
+static SCP_vector<int> Asteroid_large_wakers;
+static SCP_vector<size_t> Asteroid_dormant_waking;
+
+/**
+ * Whether the asteroids of the current field may go dormant
+ */
+static bool asteroid_dormant_allowed()
+{
+	// multiplayer keeps asteroids in sync as objects
+	return Bulk_asteroid_fields && (Game_mode & GM_NORMAL) && !Fred_running;
+}
+
 
 /**
  * Return number of asteroids expected to collide with a ship.
@@ -299,39 +422,23 @@ int get_asteroid_subtype_index_by_name(const SCP_string &name, int asteroid_idx)
 }
 
 /**
- * Create a single asteroid 
+ * Where and how a new asteroid starts out
  */
-object *asteroid_create(asteroid_field *asfieldp, int asteroid_type, int asteroid_subtype, bool check_visibility)
-{
-	int				n, objnum;
-	matrix			orient;
-	object			*objp;
-	asteroid			*asp;
-	asteroid_info	*asip;
-	vec3d			pos, delta_bound;
-	angles			angs;
-	float				radius;
-	ushort			signature;
-	int				rand_base;
-
-	// bogus
-	if(asfieldp == nullptr) {
-		return nullptr;
-	}
-
-	for (n=0; n<MAX_ASTEROIDS; n++) {
-		if (!(Asteroids[n].flags & AF_USED)) {
-			break;
-		}
-	}
-
-	if (n >= MAX_ASTEROIDS) {
-		nprintf(("Warning","Could not create asteroid, no more slots left\n"));
-		return nullptr;
-	}
+typedef struct asteroid_spawn {
+	vec3d	pos;
+	matrix	orient;
+	vec3d	vel;
+	vec3d	rotvel;
+	ushort	signature;
+} asteroid_spawn;
 
+/**
+ * Check that an asteroid of this type and subtype can be created
+ */
+static bool asteroid_type_is_valid(int asteroid_type, int &asteroid_subtype)
+{
 	if (!SCP_vector_inbounds(Asteroid_info, asteroid_type)) {
-		return nullptr;
+		return false;
 	}
 
 	// HACK: multiplayer asteroid subtype always 0 to keep subtype in sync
@@ -339,76 +446,140 @@ object *asteroid_create(asteroid_field *asfieldp, int asteroid_type, int asteroi
 		asteroid_subtype = 0;
 	}	
 
-	asip = &Asteroid_info[asteroid_type];
+	asteroid_info *asip = &Asteroid_info[asteroid_type];
 
 	if (!SCP_vector_inbounds(asip->subtypes, asteroid_subtype)) {
-		return nullptr;
+		return false;
 	}
 
 	// if the model is not loaded then abort
 	if(asip->subtypes[asteroid_subtype].model_number == -1) {
-		return nullptr;
+		return false;
 	}	
 
-	asp = &Asteroids[n];
-	asp->asteroid_type = asteroid_type;
-	asp->asteroid_subtype = asteroid_subtype;
-	asp->flags = 0;
-	asp->flags |= AF_USED;
-	asp->check_for_wrap = _timestamp_rand(0, ASTEROID_CHECK_WRAP_TIMESTAMP);
-	asp->check_for_collide = _timestamp_rand(0, ASTEROID_UPDATE_COLLIDE_TIMESTAMP);
-	asp->final_death_time = TIMESTAMP::invalid();
-	asp->collide_objnum = -1;
-	asp->collide_objsig = -1;
-	asp->target_objnum = -1;
+	return true;
+}
 
-	radius = model_get_radius(asip->subtypes[asteroid_subtype].model_number);
+/**
+ * Find an unused slot in ::Asteroids
+ * @return the slot, or -1 if they are all used
+ */
+static int asteroid_find_free_slot()
+{
+	for (int n=0; n<MAX_ASTEROIDS; n++) {
+		if (!(Asteroids[n].flags & AF_USED)) {
+			return n;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * Hull strength of a newly created asteroid
+ */
+static float asteroid_initial_strength(int asteroid_type)
+{
+	return Asteroid_info[asteroid_type].initial_asteroid_strength * (0.8f + (float)Game_skill_level/NUM_SKILL_LEVELS)/2.0f;
+}
+
+/**
+ * Pick a random position, orientation and velocity inside the field for a new asteroid
+ */
+static void asteroid_random_spawn(asteroid_field *asfieldp, int asteroid_type, asteroid_spawn *spawn)
+{
+	asteroid_info	*asip = &Asteroid_info[asteroid_type];
+	vec3d			delta_bound;
+	angles			angs;
+	int				rand_base;
+	float			speed;
 
 	vm_vec_sub(&delta_bound, &asfieldp->max_bound, &asfieldp->min_bound);
 
 	// for multiplayer, we want to do a static_rand so that everything behaves the same on all machines
-	signature = 0;
+	spawn->signature = 0;
 	rand_base = 0;
 	if ( Game_mode & GM_NORMAL ) {
-		pos.xyz.x = asfieldp->min_bound.xyz.x + delta_bound.xyz.x * frand();
-		pos.xyz.y = asfieldp->min_bound.xyz.y + delta_bound.xyz.y * frand();
-		pos.xyz.z = asfieldp->min_bound.xyz.z + delta_bound.xyz.z * frand();
+		spawn->pos.xyz.x = asfieldp->min_bound.xyz.x + delta_bound.xyz.x * frand();
+		spawn->pos.xyz.y = asfieldp->min_bound.xyz.y + delta_bound.xyz.y * frand();
+		spawn->pos.xyz.z = asfieldp->min_bound.xyz.z + delta_bound.xyz.z * frand();
 
-		inner_bound_pos_fixup(asfieldp, &pos);
+		inner_bound_pos_fixup(asfieldp, &spawn->pos);
 		angs.p = frand() * PI2;
 		angs.b = frand() * PI2;
 		angs.h = frand() * PI2;
 	} else {
-		signature = multi_assign_network_signature( MULTI_SIG_ASTEROID );
-		rand_base = signature;
+		spawn->signature = multi_assign_network_signature( MULTI_SIG_ASTEROID );
+		rand_base = spawn->signature;
 
-		pos.xyz.x = asfieldp->min_bound.xyz.x + delta_bound.xyz.x * static_randf( rand_base++ );
-		pos.xyz.y = asfieldp->min_bound.xyz.y + delta_bound.xyz.y * static_randf( rand_base++ );
-		pos.xyz.z = asfieldp->min_bound.xyz.z + delta_bound.xyz.z * static_randf( rand_base++ );
+		spawn->pos.xyz.x = asfieldp->min_bound.xyz.x + delta_bound.xyz.x * static_randf( rand_base++ );
+		spawn->pos.xyz.y = asfieldp->min_bound.xyz.y + delta_bound.xyz.y * static_randf( rand_base++ );
+		spawn->pos.xyz.z = asfieldp->min_bound.xyz.z + delta_bound.xyz.z * static_randf( rand_base++ );
 
-		inner_bound_pos_fixup(asfieldp, &pos);
+		inner_bound_pos_fixup(asfieldp, &spawn->pos);
 		angs.p = static_randf( rand_base++ ) * PI2;
 		angs.b = static_randf( rand_base++ ) * PI2;
 		angs.h = static_randf( rand_base++ ) * PI2;
 	}
 
-	// If the generated asteroid position is within the player view then abort
-	// I'm unsure how Eyepoint is handled for multiplayer, so this may need to move up into the SP
-	// only section - Mjn
-	if (check_visibility && asteroid_is_within_view(&pos, -1.0f, true)) {
-		return nullptr;
+	vm_angles_2_matrix(&spawn->orient, &angs);
+
+	if ( Game_mode & GM_NORMAL ) {
+		vm_vec_rand_vec_quick(&spawn->rotvel);
+		vm_vec_scale(&spawn->rotvel, asip->rotational_vel_multiplier * (frand()/4.0f + 0.1f));
+		vm_vec_rand_vec_quick(&spawn->vel);
+	} else {
+		static_randvec( rand_base++, &spawn->rotvel );
+		vm_vec_scale(&spawn->rotvel, asip->rotational_vel_multiplier * (static_randf(rand_base++)/4.0f + 0.1f));
+		static_randvec( rand_base++, &spawn->vel );
 	}
 
-	vm_angles_2_matrix(&orient, &angs);
+	if ( Game_mode & GM_NORMAL ) {
+		speed = asteroid_cap_speed(asteroid_type, asfieldp->speed*frand_range(0.5f + (float) Game_skill_level/NUM_SKILL_LEVELS, 2.0f + (float) (2*Game_skill_level)/NUM_SKILL_LEVELS));
+	} else {
+		speed = asteroid_cap_speed(asteroid_type, asfieldp->speed*static_randf_range(rand_base++, 0.5f + (float) Game_skill_level/NUM_SKILL_LEVELS, 2.0f + (float) (2*Game_skill_level)/NUM_SKILL_LEVELS));
+	}
+	
+	vm_vec_scale(&spawn->vel, speed);
+}
+
+/**
+ * Create the object of an asteroid in slot n of ::Asteroids
+ */
+static object *asteroid_create_object(int n, int asteroid_type, int asteroid_subtype, const asteroid_spawn *spawn)
+{
+	int				objnum;
+	object			*objp;
+	asteroid			*asp;
+	asteroid_info	*asip;
+	float				radius;
+
+	asip = &Asteroid_info[asteroid_type];
+
+	asp = &Asteroids[n];
+	asp->asteroid_type = asteroid_type;
+	asp->asteroid_subtype = asteroid_subtype;
+	asp->flags = 0;
+	asp->flags |= AF_USED;
+	asp->check_for_wrap = _timestamp_rand(0, ASTEROID_CHECK_WRAP_TIMESTAMP);
+	asp->check_for_collide = _timestamp_rand(0, ASTEROID_UPDATE_COLLIDE_TIMESTAMP);
+	asp->final_death_time = TIMESTAMP::invalid();
+	asp->collide_objnum = -1;
+	asp->collide_objsig = -1;
+	asp->target_objnum = -1;
+
+	radius = model_get_radius(asip->subtypes[asteroid_subtype].model_number);
+
     flagset<Object::Object_Flags> asteroid_default_flagset;
     asteroid_default_flagset += Object::Object_Flags::Renders;
     asteroid_default_flagset += Object::Object_Flags::Physics;
     asteroid_default_flagset += Object::Object_Flags::Collides;
     
-    objnum = obj_create(OBJ_ASTEROID, -1, n, &orient, &pos, radius, asteroid_default_flagset, false);
+    objnum = obj_create(OBJ_ASTEROID, -1, n, &spawn->orient, &spawn->pos, radius, asteroid_default_flagset, false);
 	
-	if ( (objnum == -1) || (objnum >= MAX_OBJECTS) ) {
+	if ( (objnum == -1) || (objnum >= (int)Objects.size()) ) {
 		mprintf(("Couldn't create asteroid -- out of object slots\n"));
+		asp->flags = 0;
 		return NULL;
 	}
 
@@ -425,38 +596,13 @@ object *asteroid_create(asteroid_field *asfieldp, int asteroid_type, int asteroi
 	objp = &Objects[objnum];
 
 	if ( Game_mode & GM_MULTIPLAYER ){
-		objp->net_signature = signature;
+		objp->net_signature = spawn->signature;
 	}
 
 	Num_asteroids++;
 
-	if (radius < 1.0) {
-		radius = 1.0f;
-	}
-
-	vec3d rotvel;
-	if ( Game_mode & GM_NORMAL ) {
-		vm_vec_rand_vec_quick(&rotvel);
-		vm_vec_scale(&rotvel, asip->rotational_vel_multiplier * (frand()/4.0f + 0.1f));
-		objp->phys_info.rotvel = rotvel;
-		vm_vec_rand_vec_quick(&objp->phys_info.vel);
-	} else {
-		static_randvec( rand_base++, &rotvel );
-		vm_vec_scale(&rotvel, asip->rotational_vel_multiplier * (static_randf(rand_base++)/4.0f + 0.1f));
-		objp->phys_info.rotvel = rotvel;
-		static_randvec( rand_base++, &objp->phys_info.vel );
-	}
-
-
-	float speed;
-
-	if ( Game_mode & GM_NORMAL ) {
-		speed = asteroid_cap_speed(asteroid_type, asfieldp->speed*frand_range(0.5f + (float) Game_skill_level/NUM_SKILL_LEVELS, 2.0f + (float) (2*Game_skill_level)/NUM_SKILL_LEVELS));
-	} else {
-		speed = asteroid_cap_speed(asteroid_type, asfieldp->speed*static_randf_range(rand_base++, 0.5f + (float) Game_skill_level/NUM_SKILL_LEVELS, 2.0f + (float) (2*Game_skill_level)/NUM_SKILL_LEVELS));
-	}
-	
-	vm_vec_scale(&objp->phys_info.vel, speed);
+	objp->phys_info.rotvel = spawn->rotvel;
+	objp->phys_info.vel = spawn->vel;
 	objp->phys_info.desired_vel = objp->phys_info.vel;
 
 	// blow out his reverse thrusters. Or drag, same thing.
@@ -475,7 +621,7 @@ object *asteroid_create(asteroid_field *asfieldp, int asteroid_type, int asteroi
 	objp->phys_info.I_body_inv.vec.rvec.xyz.x = 1.0f / (objp->phys_info.mass*model_get(asip->subtypes[asteroid_subtype].model_number)->rad);
 	objp->phys_info.I_body_inv.vec.uvec.xyz.y = objp->phys_info.I_body_inv.vec.rvec.xyz.x;
 	objp->phys_info.I_body_inv.vec.fvec.xyz.z = objp->phys_info.I_body_inv.vec.rvec.xyz.x;
-	objp->hull_strength = asip->initial_asteroid_strength * (0.8f + (float)Game_skill_level/NUM_SKILL_LEVELS)/2.0f;
+	objp->hull_strength = asteroid_initial_strength(asteroid_type);
 
 	// ensure vel is valid
 	Assert( !vm_is_vec_nan(&objp->phys_info.vel) );	
@@ -489,6 +635,61 @@ object *asteroid_create(asteroid_field *asfieldp, int asteroid_type, int asteroi
 	return objp;
 }
 
+/**
+ * Create a single asteroid 
+ */
+object *asteroid_create(asteroid_field *asfieldp, int asteroid_type, int asteroid_subtype, bool check_visibility)
+{
+	int				n;
+	asteroid_spawn	spawn;
+
+	// bogus
+	if(asfieldp == nullptr) {
+		return nullptr;
+	}
+
+	n = asteroid_find_free_slot();
+
+	if (n < 0) {
+		nprintf(("Warning","Could not create asteroid, no more slots left\n"));
+		return nullptr;
+	}
+
+	if (!asteroid_type_is_valid(asteroid_type, asteroid_subtype)) {
+		return nullptr;
+	}
+
+	asteroid_random_spawn(asfieldp, asteroid_type, &spawn);
+
+	// If the generated asteroid position is within the player view then abort
+	// I'm unsure how Eyepoint is handled for multiplayer, so this may need to move up into the SP
+	// only section - Mjn
+	if (check_visibility && asteroid_is_within_view(&spawn.pos, -1.0f, true)) {
+		return nullptr;
+	}
+
+	return asteroid_create_object(n, asteroid_type, asteroid_subtype, &spawn);
+}
+
+/**
+ * Create one of the asteroids a field starts out with, which may start out dormant
+ */
+static void asteroid_create_in_field(int asteroid_type, int asteroid_subtype)
+{
+	if (asteroid_dormant_allowed() && (Asteroid_dormant.size() < MAX_DORMANT_ASTEROIDS) && asteroid_type_is_valid(asteroid_type, asteroid_subtype)) {
+		// models with intrinsic motion need a model instance, which only asteroid objects have
+		if (!(model_get(Asteroid_info[asteroid_type].subtypes[asteroid_subtype].model_number)->flags & PM_FLAG_HAS_INTRINSIC_MOTION)) {
+			asteroid_spawn spawn;
+			asteroid_random_spawn(&Asteroid_field, asteroid_type, &spawn);
+
+			Asteroid_dormant.add(asteroid_type, asteroid_subtype, &spawn.pos, &spawn.orient, &spawn.vel, &spawn.vel, &spawn.rotvel);
+			return;
+		}
+	}
+
+	asteroid_create(&Asteroid_field, asteroid_type, asteroid_subtype);
+}
+
 /**
  * Create asteroids when parent_objp blows up.
  */
@@ -684,7 +885,7 @@ void asteroid_create_all()
 			int subtype = get_asteroid_subtype_index_by_name(pick_random_asteroid_type(), ASTEROID_TYPE_LARGE);
 
 			if (subtype >= 0)
-				asteroid_create(&Asteroid_field, ASTEROID_TYPE_LARGE, subtype);
+				asteroid_create_in_field(ASTEROID_TYPE_LARGE, subtype);
 		} else {
 			Assert(num_debris_types > 0);
 
@@ -693,7 +894,7 @@ void asteroid_create_all()
 			for (idx = 0; idx < static_cast<int>(Asteroid_field.field_debris_type.size()); idx++) {
 				// for ship debris, choose type according to odds table
 				if (rand_choice < shipDebrisOddsTable[idx].random_threshold) {
-					asteroid_create(&Asteroid_field, shipDebrisOddsTable[idx].debris_type, 0);
+					asteroid_create_in_field(shipDebrisOddsTable[idx].debris_type, 0);
 					break;
 				}
 			}
@@ -710,10 +911,12 @@ void remove_all_asteroids()
 	for (int i = 0; i < MAX_ASTEROIDS; i++) {
 		if (Asteroids[i].flags & AF_USED) {
 			Asteroids[i].flags &= ~AF_USED;
-			Assert(Asteroids[i].objnum >= 0 && Asteroids[i].objnum < MAX_OBJECTS);
+			Assert(Asteroids[i].objnum >= 0 && Asteroids[i].objnum < (int)Objects.size());
 			Objects[Asteroids[i].objnum].flags.set(Object::Object_Flags::Should_be_dead);
 		}
 	}
+	Asteroid_dormant.clear();
+
 	// This feels hackish, but we need to make sure all the asteroids are actually gone before we continue-Mjn
 	obj_delete_all_that_should_be_dead();
 }
@@ -834,6 +1037,8 @@ void asteroid_level_init()
 		Num_asteroids = 0;
 		asteroid_obj_list_init();
 		Asteroid_targets.clear();
+		Asteroid_dormant.clear();
+		Asteroid_wakers.clear();
 	}
 }
 
@@ -843,40 +1048,40 @@ void asteroid_level_init()
  *
  * @return !0 if asteroid should be wrapped, 0 otherwise.  
  */
-static int asteroid_should_wrap(object *objp, asteroid_field *asfieldp)
+static int asteroid_should_wrap(const vec3d *pos, asteroid_field *asfieldp)
 {
 	if ( MULTIPLAYER_CLIENT )
 		return 0;
 
-	if (objp->pos.xyz.x < asfieldp->min_bound.xyz.x) {
+	if (pos->xyz.x < asfieldp->min_bound.xyz.x) {
 		return 1;
 	}
 
-	if (objp->pos.xyz.y < asfieldp->min_bound.xyz.y) {
+	if (pos->xyz.y < asfieldp->min_bound.xyz.y) {
 		return 1;
 	}
 
-	if (objp->pos.xyz.z < asfieldp->min_bound.xyz.z) {
+	if (pos->xyz.z < asfieldp->min_bound.xyz.z) {
 		return 1;
 	}
 
-	if (objp->pos.xyz.x > asfieldp->max_bound.xyz.x) {
+	if (pos->xyz.x > asfieldp->max_bound.xyz.x) {
 		return 1;
 	}
 
-	if (objp->pos.xyz.y > asfieldp->max_bound.xyz.y) {
+	if (pos->xyz.y > asfieldp->max_bound.xyz.y) {
 		return 1;
 	}
 
-	if (objp->pos.xyz.z > asfieldp->max_bound.xyz.z) {
+	if (pos->xyz.z > asfieldp->max_bound.xyz.z) {
 		return 1;
 	}
 
 	// check against inner bound
 	if (asfieldp->has_inner_bound) {
-		if ( (objp->pos.xyz.x > asfieldp->inner_min_bound.xyz.x) && (objp->pos.xyz.x < asfieldp->inner_max_bound.xyz.x)
-		  && (objp->pos.xyz.y > asfieldp->inner_min_bound.xyz.y) && (objp->pos.xyz.y < asfieldp->inner_max_bound.xyz.y)
-		  && (objp->pos.xyz.z > asfieldp->inner_min_bound.xyz.z) && (objp->pos.xyz.z < asfieldp->inner_max_bound.xyz.z) ) {
+		if ( (pos->xyz.x > asfieldp->inner_min_bound.xyz.x) && (pos->xyz.x < asfieldp->inner_max_bound.xyz.x)
+		  && (pos->xyz.y > asfieldp->inner_min_bound.xyz.y) && (pos->xyz.y < asfieldp->inner_max_bound.xyz.y)
+		  && (pos->xyz.z > asfieldp->inner_min_bound.xyz.z) && (pos->xyz.z < asfieldp->inner_max_bound.xyz.z) ) {
 
 			return 1;
 		}
@@ -1105,7 +1310,7 @@ static void asteroid_maybe_reposition(object *objp, asteroid_field *asfieldp)
 		return;
 	}
 
-	if (asteroid_should_wrap(objp, asfieldp)) {
+	if (asteroid_should_wrap(&objp->pos, asfieldp)) {
 
 		// Generate a possible new position if we do end up wrapping, but don't move the asteroid yet
 		vec3d new_pos = objp->pos;
@@ -1178,6 +1383,549 @@ static void asteroid_maybe_reposition(object *objp, asteroid_field *asfieldp)
 	}
 }
 
+/**
+ * Wake up dormant asteroid i by making it an object again
+ * @return the object, or nullptr if there was no room for it
+ */
+static object *asteroid_dormant_wake(size_t i)
+{
+	int n = asteroid_find_free_slot();
+
+	if (n < 0) {
+		return nullptr;
+	}
+
+	asteroid_spawn spawn;
+	vm_vec_make(&spawn.pos, Asteroid_dormant.pos_x[i], Asteroid_dormant.pos_y[i], Asteroid_dormant.pos_z[i]);
+	vm_vec_make(&spawn.vel, Asteroid_dormant.vel_x[i], Asteroid_dormant.vel_y[i], Asteroid_dormant.vel_z[i]);
+	vm_vec_copy_scale(&spawn.rotvel, &Asteroid_dormant.spin_axis[i], Asteroid_dormant.spin_rate[i]);
+	Asteroid_dormant.get_orient(i, &spawn.orient);
+	spawn.signature = 0;
+
+	object *objp = asteroid_create_object(n, Asteroid_dormant.asteroid_type[i], Asteroid_dormant.asteroid_subtype[i], &spawn);
+
+	if (objp == nullptr) {
+		return nullptr;
+	}
+
+	vm_vec_make(&objp->phys_info.desired_vel, Asteroid_dormant.desired_vel_x[i], Asteroid_dormant.desired_vel_y[i], Asteroid_dormant.desired_vel_z[i]);
+	vm_vec_scale_add(&objp->last_pos, &objp->pos, &objp->phys_info.vel, -flFrametime);
+
+	Asteroid_dormant.remove(i);
+
+	return objp;
+}
+
+/**
+ * Whether nothing cares about an asteroid object, so that it could go dormant once everything is far enough away
+ */
+static bool asteroid_can_sleep(object *objp)
+{
+	asteroid *asp = &Asteroids[objp->instance];
+
+	// anything which is about to happen to it needs the object
+	if ((asp->target_objnum >= 0) || (asp->collide_objnum >= 0) || (asp->model_instance_num >= 0) || asp->final_death_time.isValid()) {
+		return false;
+	}
+
+	if (objp->flags[Object::Object_Flags::Should_be_dead] || (objp->phys_info.flags & PF_IN_SHOCKWAVE)) {
+		return false;
+	}
+
+	// dormant asteroids can't remember damage
+	if (objp->hull_strength < asteroid_initial_strength(asp->asteroid_type)) {
+		return false;
+	}
+
+	if (asteroid_is_targeted(objp)) {
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Turn an asteroid object into a dormant asteroid.  Its slot is free once the object has been deleted.
+ */
+static void asteroid_sleep(object *objp)
+{
+	asteroid *asp = &Asteroids[objp->instance];
+
+	Asteroid_dormant.add(asp->asteroid_type, asp->asteroid_subtype, &objp->pos, &objp->orient, &objp->phys_info.vel, &objp->phys_info.desired_vel, &objp->phys_info.rotvel);
+	objp->flags.set(Object::Object_Flags::Should_be_dead);
+}
+
+/**
+ * Put an asteroid object to sleep if nothing is anywhere near it and nothing cares about it
+ * @return true if it went dormant
+ */
+static bool asteroid_maybe_sleep(object *objp)
+{
+	if (!asteroid_dormant_allowed() || (Asteroid_dormant.size() >= MAX_DORMANT_ASTEROIDS)) {
+		return false;
+	}
+
+	if (!asteroid_can_sleep(objp)) {
+		return false;
+	}
+
+	float reach = objp->radius + vm_vec_mag(&objp->phys_info.vel) * ASTEROID_DORMANT_LOOKAHEAD;
+
+	for (const auto &waker : Asteroid_wakers) {
+		float dist = ASTEROID_DORMANT_SLEEP_FACTOR * (waker.reach + reach);
+
+		if (vm_vec_dist_squared(&waker.pos, &objp->pos) < dist * dist) {
+			return false;
+		}
+	}
+
+	asteroid_sleep(objp);
+
+	return true;
+}
+
+/**
+ * Put the asteroid object which is farthest from everything to sleep, to make room for one which has to wake up
+ * @return false if every asteroid object is in reach of something or can't go dormant
+ */
+static bool asteroid_recycle_farthest()
+{
+	object *farthest_objp = nullptr;
+	float farthest_clearance = 0.0f;
+
+	for (auto aop : list_range(&Asteroid_obj_list)) {
+		object *objp = &Objects[aop->objnum];
+
+		if (!asteroid_can_sleep(objp)) {
+			continue;
+		}
+
+		// how much farther away than waking it up needs the closest waker is
+		float reach = objp->radius + vm_vec_mag(&objp->phys_info.vel) * ASTEROID_DORMANT_LOOKAHEAD;
+		float clearance = FLT_MAX;
+
+		for (const auto &waker : Asteroid_wakers) {
+			clearance = MIN(clearance, vm_vec_dist(&waker.pos, &objp->pos) - (waker.reach + reach));
+		}
+
+		if (clearance > farthest_clearance) {
+			farthest_objp = objp;
+			farthest_clearance = clearance;
+		}
+	}
+
+	if (farthest_objp == nullptr) {
+		return false;
+	}
+
+	asteroid_sleep(farthest_objp);
+
+	return true;
+}
+
+/**
+ * Find everything which wakes up the dormant asteroids around it.  Called before objects move, so that the asteroid
+ * objects which go dormant know about everything that is there this frame, and again once everything has moved.
+ */
+void asteroid_find_wakers()
+{
+	Asteroid_wakers.clear();
+
+	// with no asteroids at all, nothing can wake up or go to sleep
+	if (!asteroid_dormant_allowed() || ((Num_asteroids == 0) && (Asteroid_dormant.size() == 0))) {
+		return;
+	}
+
+	float max_dormant_reach = -1.0f;
+
+	for (object *objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp)) {
+		if (objp->flags[Object::Object_Flags::Should_be_dead]) {
+			continue;
+		}
+
+		if ((objp->type == OBJ_SHIP) || (objp->type == OBJ_WEAPON) || (objp->type == OBJ_SHOCKWAVE)) {
+			Asteroid_wakers.push_back({ objp->pos, objp->radius + ASTEROID_DORMANT_WAKE_DIST + vm_vec_mag(&objp->phys_info.vel) * ASTEROID_DORMANT_LOOKAHEAD });
+		} else if (objp->type == OBJ_BEAM) {
+			beam *bm = &Beams[objp->instance];
+			vec3d dir;
+			float length = vm_vec_normalized_dir(&dir, &bm->last_shot, &bm->last_start);
+
+			if (length <= 0.0f) {
+				continue;
+			}
+
+			if (max_dormant_reach < 0.0f) {
+				max_dormant_reach = Asteroid_dormant.reach.empty() ? 0.0f : *std::max_element(Asteroid_dormant.reach.begin(), Asteroid_dormant.reach.end());
+			}
+
+			// only the part of the beam which is close enough to the field can wake anything up
+			const float margin = ASTEROID_DORMANT_BEAM_REACH + max_dormant_reach;
+			float start = 0.0f, end = MIN(length, bm->range);
+
+			for (int axis = 0; (axis < 3) && (start <= end); ++axis) {
+				float lo = Asteroid_field.min_bound.a1d[axis] - margin - bm->last_start.a1d[axis];
+				float hi = Asteroid_field.max_bound.a1d[axis] + margin - bm->last_start.a1d[axis];
+
+				if (fabsf(dir.a1d[axis]) < 0.0001f) {
+					if ((lo > 0.0f) || (hi < 0.0f)) {
+						start = end + 1.0f;
+					}
+					continue;
+				}
+
+				float t0 = lo / dir.a1d[axis], t1 = hi / dir.a1d[axis];
+				if (t0 > t1) {
+					std::swap(t0, t1);
+				}
+
+				start = MAX(start, t0);
+				end = MIN(end, t1);
+			}
+
+			// cover that part with overlapping spheres
+			for (float dist = start; dist <= end; dist += ASTEROID_DORMANT_WAKE_DIST) {
+				asteroid_waker waker;
+				vm_vec_scale_add(&waker.pos, &bm->last_start, &dir, MIN(dist + ASTEROID_DORMANT_WAKE_DIST * 0.5f, end));
+				waker.reach = ASTEROID_DORMANT_BEAM_REACH;
+				Asteroid_wakers.push_back(waker);
+			}
+		}
+	}
+}
+
+/**
+ * The cells of the waker grid a sphere touches
+ */
+static void asteroid_dormant_cells(const vec3d *pos, float radius, const vec3d *scale, int lo[3], int hi[3])
+{
+	for (int axis = 0; axis < 3; ++axis) {
+		float l = (pos->a1d[axis] - radius - Asteroid_field.min_bound.a1d[axis]) * scale->a1d[axis];
+		float h = (pos->a1d[axis] + radius - Asteroid_field.min_bound.a1d[axis]) * scale->a1d[axis];
+
+		// anything outside of the field goes into the cells at its edge, and far outside of it doesn't fit in an int
+		CLAMP(l, 0.0f, static_cast<float>(ASTEROID_DORMANT_GRID_DIM - 1));
+		CLAMP(h, 0.0f, static_cast<float>(ASTEROID_DORMANT_GRID_DIM - 1));
+
+		lo[axis] = static_cast<int>(l);
+		hi[axis] = static_cast<int>(h);
+	}
+}
+
+/**
+ * Wake up every dormant asteroid which something has come close to
+ */
+static void asteroid_dormant_wake_all(float max_reach)
+{
+	if (Asteroid_wakers.empty()) {
+		return;
+	}
+
+	// sort the wakers into cells so that each asteroid only has to look at the ones in its own cell
+	const size_t num_cells = ASTEROID_DORMANT_GRID_DIM * ASTEROID_DORMANT_GRID_DIM * ASTEROID_DORMANT_GRID_DIM;
+	vec3d scale;
+
+	for (int axis = 0; axis < 3; ++axis) {
+		scale.a1d[axis] = ASTEROID_DORMANT_GRID_DIM / (Asteroid_field.max_bound.a1d[axis] - Asteroid_field.min_bound.a1d[axis]);
+	}
+
+	Asteroid_waker_cell_start.assign(num_cells + 1, 0);
+	Asteroid_large_wakers.clear();
+
+	for (int pass = 0; pass < 2; ++pass) {
+		for (int w = 0; w < static_cast<int>(Asteroid_wakers.size()); ++w) {
+			int lo[3], hi[3];
+			asteroid_dormant_cells(&Asteroid_wakers[w].pos, Asteroid_wakers[w].reach + max_reach, &scale, lo, hi);
+
+			if ((hi[0] - lo[0] + 1) * (hi[1] - lo[1] + 1) * (hi[2] - lo[2] + 1) > ASTEROID_DORMANT_MAX_WAKER_CELLS) {
+				if (pass == 0) {
+					Asteroid_large_wakers.push_back(w);
+				}
+				continue;
+			}
+
+			for (int z = lo[2]; z <= hi[2]; ++z) {
+				for (int y = lo[1]; y <= hi[1]; ++y) {
+					for (int x = lo[0]; x <= hi[0]; ++x) {
+						size_t cell = (static_cast<size_t>(z) * ASTEROID_DORMANT_GRID_DIM + y) * ASTEROID_DORMANT_GRID_DIM + x;
+
+						if (pass == 0) {
+							++Asteroid_waker_cell_start[cell + 1];
+						} else {
+							Asteroid_waker_cells[Asteroid_waker_cell_start[cell]++] = w;
+						}
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			for (size_t cell = 0; cell < num_cells; ++cell) {
+				Asteroid_waker_cell_start[cell + 1] += Asteroid_waker_cell_start[cell];
+			}
+			Asteroid_waker_cells.resize(Asteroid_waker_cell_start[num_cells]);
+		} else {
+			// filling the cells moved each start to the start of the next cell
+			for (size_t cell = num_cells; cell > 0; --cell) {
+				Asteroid_waker_cell_start[cell] = Asteroid_waker_cell_start[cell - 1];
+			}
+			Asteroid_waker_cell_start[0] = 0;
+		}
+	}
+
+	auto in_reach = [](const asteroid_waker &waker, float x, float y, float z, float reach) {
+		float dx = waker.pos.xyz.x - x, dy = waker.pos.xyz.y - y, dz = waker.pos.xyz.z - z;
+		float dist = waker.reach + reach;
+		return dx * dx + dy * dy + dz * dz < dist * dist;
+	};
+
+	Asteroid_dormant_waking.clear();
+
+	for (size_t i = 0; i < Asteroid_dormant.size(); ++i) {
+		float x = Asteroid_dormant.pos_x[i], y = Asteroid_dormant.pos_y[i], z = Asteroid_dormant.pos_z[i];
+		float reach = Asteroid_dormant.reach[i];
+		bool wake = false;
+
+		for (int w : Asteroid_large_wakers) {
+			if (in_reach(Asteroid_wakers[w], x, y, z, reach)) {
+				wake = true;
+				break;
+			}
+		}
+
+		if (!wake) {
+			vec3d pos = vm_vec_new(x, y, z);
+			int lo[3], hi[3];
+			asteroid_dormant_cells(&pos, 0.0f, &scale, lo, hi);
+
+			size_t cell = (static_cast<size_t>(lo[2]) * ASTEROID_DORMANT_GRID_DIM + lo[1]) * ASTEROID_DORMANT_GRID_DIM + lo[0];
+
+			for (uint j = Asteroid_waker_cell_start[cell]; j < Asteroid_waker_cell_start[cell + 1]; ++j) {
+				if (in_reach(Asteroid_wakers[Asteroid_waker_cells[j]], x, y, z, reach)) {
+					wake = true;
+					break;
+				}
+			}
+		}
+
+		if (wake) {
+			Asteroid_dormant_waking.push_back(i);
+		}
+	}
+
+	// from the back, since waking one up moves the last dormant asteroid into its place
+	for (auto it = Asteroid_dormant_waking.rbegin(); it != Asteroid_dormant_waking.rend(); ++it) {
+		if (asteroid_dormant_wake(*it) != nullptr) {
+			continue;
+		}
+
+		// an asteroid which can't wake up could be flown through, so an idle one makes room for it by the next frame,
+		// which the lookahead in its reach allows for
+		if (!asteroid_recycle_farthest()) {
+			nprintf(("Warning", "Could not wake up dormant asteroid, no more slots left\n"));
+			break;
+		}
+	}
+}
+
+/**
+ * Move all the dormant asteroids, the same way the physics move asteroid objects
+ */
+static void asteroid_dormant_move_all(float frametime, float *max_reach)
+{
+	const size_t count = Asteroid_dormant.size();
+	const vec3d gravity = The_mission.gravity;
+
+	float *pos_x = Asteroid_dormant.pos_x.data(), *pos_y = Asteroid_dormant.pos_y.data(), *pos_z = Asteroid_dormant.pos_z.data();
+	float *vel_x = Asteroid_dormant.vel_x.data(), *vel_y = Asteroid_dormant.vel_y.data(), *vel_z = Asteroid_dormant.vel_z.data();
+	const float *desired_x = Asteroid_dormant.desired_vel_x.data(), *desired_y = Asteroid_dormant.desired_vel_y.data(), *desired_z = Asteroid_dormant.desired_vel_z.data();
+	const float *gravity_const = Asteroid_dormant.gravity_const.data();
+	float *spin_angle = Asteroid_dormant.spin_angle.data();
+	const float *spin_rate = Asteroid_dormant.spin_rate.data();
+	float *reach = Asteroid_dormant.reach.data();
+	const float *radius = Asteroid_dormant.radius.data();
+
+	float reach_max = 0.0f;
+
+	// no branches in here, so that the compiler can do several asteroids at once
+	for (size_t i = 0; i < count; ++i) {
+		// asteroid_process_pre(), then ballistic physics_sim()
+		vel_x[i] += (desired_x[i] - vel_x[i]) * frametime;
+		vel_y[i] += (desired_y[i] - vel_y[i]) * frametime;
+		vel_z[i] += (desired_z[i] - vel_z[i]) * frametime;
+
+		float g = gravity_const[i] * frametime;
+
+		pos_x[i] += (vel_x[i] + gravity.xyz.x * g * 0.5f) * frametime;
+		pos_y[i] += (vel_y[i] + gravity.xyz.y * g * 0.5f) * frametime;
+		pos_z[i] += (vel_z[i] + gravity.xyz.z * g * 0.5f) * frametime;
+
+		vel_x[i] += gravity.xyz.x * g;
+		vel_y[i] += gravity.xyz.y * g;
+		vel_z[i] += gravity.xyz.z * g;
+
+		float angle = spin_angle[i] + spin_rate[i] * frametime;
+		spin_angle[i] = angle - PI2 * floorf(angle * (1.0f / PI2));
+
+		reach[i] = radius[i] + sqrtf(vel_x[i] * vel_x[i] + vel_y[i] * vel_y[i] + vel_z[i] * vel_z[i]) * ASTEROID_DORMANT_LOOKAHEAD;
+		reach_max = MAX(reach_max, reach[i]);
+	}
+
+	*max_reach = reach_max;
+}
+
+/**
+ * Wrap dormant asteroids which left the field, like asteroid_maybe_reposition() does for asteroid objects
+ */
+static void asteroid_dormant_wrap_all(asteroid_field *asfieldp)
+{
+	// passive field does not wrap if there is no gravity
+	if (IS_VEC_NULL(&The_mission.gravity) && (asfieldp->field_type == FT_PASSIVE)) {
+		return;
+	}
+
+	vec3d center;
+	vm_vec_avg(&center, &asfieldp->min_bound, &asfieldp->max_bound);
+
+	for (size_t i = 0; i < Asteroid_dormant.size(); ++i) {
+		vec3d pos = vm_vec_new(Asteroid_dormant.pos_x[i], Asteroid_dormant.pos_y[i], Asteroid_dormant.pos_z[i]);
+
+		if (!asteroid_should_wrap(&pos, asfieldp)) {
+			continue;
+		}
+
+		vec3d new_pos = pos;
+		asteroid_wrap_pos(&new_pos, asfieldp);
+
+		// dormant asteroids are never targeted, and don't count against MAX_ASTEROIDS
+		if (asteroid_is_within_view(&pos, asfieldp->bound_rad, asfieldp->enhanced_visibility_checks)) {
+			continue;
+		}
+
+		if (asteroid_is_within_view(&new_pos, (asfieldp->bound_rad * 1.3f), asfieldp->enhanced_visibility_checks)) {
+			// reverse instead, unless that already happened, since this is checked every frame
+			vec3d vel = vm_vec_new(Asteroid_dormant.vel_x[i], Asteroid_dormant.vel_y[i], Asteroid_dormant.vel_z[i]);
+			vec3d outward;
+			vm_vec_sub(&outward, &pos, &center);
+
+			if (IS_VEC_NULL(&The_mission.gravity) && (vm_vec_dot(&vel, &outward) > 0.0f)) {
+				Asteroid_dormant.vel_x[i] = -Asteroid_dormant.vel_x[i];
+				Asteroid_dormant.vel_y[i] = -Asteroid_dormant.vel_y[i];
+				Asteroid_dormant.vel_z[i] = -Asteroid_dormant.vel_z[i];
+				Asteroid_dormant.desired_vel_x[i] = Asteroid_dormant.vel_x[i];
+				Asteroid_dormant.desired_vel_y[i] = Asteroid_dormant.vel_y[i];
+				Asteroid_dormant.desired_vel_z[i] = Asteroid_dormant.vel_z[i];
+			}
+			continue;
+		}
+
+		Asteroid_dormant.pos_x[i] = new_pos.xyz.x;
+		Asteroid_dormant.pos_y[i] = new_pos.xyz.y;
+		Asteroid_dormant.pos_z[i] = new_pos.xyz.z;
+	}
+}
+
+/**
+ * Move, wrap and maybe wake up the dormant asteroids
+ */
+static void asteroid_dormant_frame()
+{
+	if (!asteroid_dormant_allowed()) {
+		return;
+	}
+
+	TRACE_SCOPE(tracing::DormantAsteroids);
+
+	// everything has moved since obj_move_all() found them, and new objects may have been created
+	asteroid_find_wakers();
+
+	if (Asteroid_dormant.size() == 0) {
+		return;
+	}
+
+	float max_reach = 0.0f;
+
+	if (!physics_paused) {
+		asteroid_dormant_move_all(flFrametime, &max_reach);
+		asteroid_dormant_wrap_all(&Asteroid_field);
+	} else {
+		for (float reach : Asteroid_dormant.reach) {
+			max_reach = MAX(max_reach, reach);
+		}
+	}
+
+	asteroid_dormant_wake_all(max_reach);
+}
+
+/**
+ * Render the dormant asteroids, which aren't objects
+ */
+void asteroid_render_dormant(model_draw_list *scene)
+{
+	if (!Asteroids_enabled) {
+		return;
+	}
+
+	for (size_t i = 0; i < Asteroid_dormant.size(); ++i) {
+		vec3d pos = vm_vec_new(Asteroid_dormant.pos_x[i], Asteroid_dormant.pos_y[i], Asteroid_dormant.pos_z[i]);
+		float radius = Asteroid_dormant.radius[i];
+
+		// most of them are behind the viewer, which is cheaper to check first
+		vec3d to_asteroid;
+		vm_vec_sub(&to_asteroid, &pos, &Eye_position);
+
+		if (vm_vec_dot(&to_asteroid, &Eye_matrix.vec.fvec) < -radius) {
+			continue;
+		}
+
+		if (!obj_sphere_in_view_cone(&pos, radius)) {
+			continue;
+		}
+
+		matrix orient;
+		Asteroid_dormant.get_orient(i, &orient);
+
+		model_clear_instance(Asteroid_dormant.model_num[i]);
+
+		model_render_params render_info;
+		render_info.set_flags(MR_IS_ASTEROID);
+
+		model_render_queue(&render_info, scene, Asteroid_dormant.model_num[i], &orient, &pos);
+	}
+}
+
+/**
+ * Return the number of asteroids which aren't objects right now
+ */
+int asteroid_dormant_count()
+{
+	return static_cast<int>(Asteroid_dormant.size());
+}
+
+/**
+ * Get the position and velocity of dormant asteroid i
+ */
+void asteroid_dormant_get(int i, vec3d *pos, vec3d *vel)
+{
+	Assertion(i >= 0 && i < asteroid_dormant_count(), "Invalid dormant asteroid %d!", i);
+
+	vm_vec_make(pos, Asteroid_dormant.pos_x[i], Asteroid_dormant.pos_y[i], Asteroid_dormant.pos_z[i]);
+	vm_vec_make(vel, Asteroid_dormant.vel_x[i], Asteroid_dormant.vel_y[i], Asteroid_dormant.vel_z[i]);
+}
+
+/**
+ * Return how many asteroids a field can have
+ */
+int asteroid_max_field_asteroids()
+{
+	// the editors have to allow for the fields which will go dormant in the game
+	if (Fred_running) {
+		return Bulk_asteroid_fields ? MAX_DORMANT_ASTEROIDS : MAX_ASTEROIDS;
+	}
+
+	// dormant asteroids don't need a slot, but there is still a limit to how many can be moved every frame
+	return asteroid_dormant_allowed() ? MAX_DORMANT_ASTEROIDS : MAX_ASTEROIDS;
+}
+
 static void lerp(float *goal, float f1, float f2, float scale)
 {
 	*goal = (f2 - f1) * scale + f1;
@@ -1655,7 +2403,6 @@ static void asteroid_do_area_effect(object *asteroid_objp)
 {
 	object			*ship_objp;
 	float				damage, blast;
-	ship_obj			*so;
 	asteroid			*asp;
 	asteroid_info	*asip;
 
@@ -1666,8 +2413,19 @@ static void asteroid_do_area_effect(object *asteroid_objp)
 		return;
 	}
 
-	for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
-		ship_objp = &Objects[so->objnum];
+	SCP_frame_vector<int> candidates;
+
+	if (obj_grid_covers(OBJ_GRID_TYPE(OBJ_SHIP))) {
+		obj_find_in_sphere(candidates, &asteroid_objp->pos, asip->outer_rad, OBJ_GRID_TYPE(OBJ_SHIP));
+	} else {
+		// without a grid the ship list is much shorter than all the objects, and the damage check does the rest
+		for (ship_obj *so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so)) {
+			candidates.push_back(so->objnum);
+		}
+	}
+
+	for (int objnum : candidates) {
+		ship_objp = &Objects[objnum];
 		if (ship_objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
 
@@ -1781,11 +2539,14 @@ void asteroid_level_close()
 	for (int i=0; i<MAX_ASTEROIDS; i++) {
 		if (Asteroids[i].flags & AF_USED) {
 			Asteroids[i].flags &= ~AF_USED;
-			Assert(Asteroids[i].objnum >=0 && Asteroids[i].objnum < MAX_OBJECTS);
+			Assert(Asteroids[i].objnum >=0 && Asteroids[i].objnum < (int)Objects.size());
 			Objects[Asteroids[i].objnum].flags.set(Object::Object_Flags::Should_be_dead);
 		}
 	}
 
+	Asteroid_dormant.clear();
+	Asteroid_wakers.clear();
+
 	//when a level is closed, all models are cleared, so let's make sure that
 	//is tracked for asteroids as well -Mjn
 	for (size_t i = 0; i < Asteroid_info.size(); i++) {
@@ -2089,6 +2850,10 @@ void asteroid_process_post(object * obj)
 		//Passive fields might wrap if there's gravity so do
 		//this for all fields now-Mjn
 		if ( timestamp_elapsed(asp->check_for_wrap) ) {
+			if (asteroid_maybe_sleep(obj)) {
+				return;
+			}
+
 			asteroid_maybe_reposition(obj, &Asteroid_field);
 			asp->check_for_wrap = _timestamp(ASTEROID_CHECK_WRAP_TIMESTAMP);
 		}
@@ -2738,6 +3503,8 @@ static int set_asteroid_throw_objnum()
 
 void asteroid_frame()
 {
+	asteroid_dormant_frame();
+
 	if (Num_asteroids < 1)
 		return;
 
@@ -25,6 +25,7 @@ struct collision_info_struct;
 class model_draw_list;
 
 #define	MAX_ASTEROIDS			2000	//Increased from 512 to 2000 in 2022
+#define	MAX_DORMANT_ASTEROIDS	32768	//Dormant asteroids don't take a slot in Asteroids[], but still have to be moved every frame
 
 #define	NUM_ASTEROID_SIZES		3
 
@@ -188,12 +189,17 @@ void	asteroid_create_all();
 void	asteroid_create_asteroid_field(int num_asteroids, int field_type, int asteroid_speed, vec3d o_min, vec3d o_max, bool inner_box, vec3d i_min, vec3d i_max, SCP_vector<SCP_string> asteroid_types);
 void	asteroid_create_debris_field(int num_asteroids, int asteroid_speed, SCP_vector<int> debris_types, vec3d o_min, vec3d o_max, bool enhanced);
 void	asteroid_render(object* obj, model_draw_list* scene);
+void	asteroid_render_dormant(model_draw_list* scene);
 void	asteroid_delete( object *asteroid_objp );
+void	asteroid_find_wakers();
 void	asteroid_process_pre( object *asteroid_objp );
 void	asteroid_process_post( object *asteroid_objp);
 int	asteroid_check_collision( object *asteroid_objp, object * other_obj, vec3d * hitpos, collision_info_struct *asteroid_hit_info=NULL, vec3d* hitnormal=NULL );
 void	asteroid_hit( object *pasteroid_objp, object *other_objp, vec3d *hitpos, float damage, vec3d* force );
 int	asteroid_count();
+int	asteroid_dormant_count();
+void	asteroid_dormant_get(int i, vec3d *pos, vec3d *vel);	// for testing
+int	asteroid_max_field_asteroids();
 int	asteroid_collide_objnum(object *asteroid_objp);
 float asteroid_time_to_impact(object *asteroid_objp);
 void	asteroid_show_brackets();
@@ -62,6 +62,7 @@ struct bitmap_entry {
 	signed char ref_count;  //!< Number of locks on bitmap.  Can't unload unless ref_count is 0.
 
 	int dir_type;           //!< which directory this was loaded from (to skip other locations with same name)
+	char cache_filename[MAX_FILENAME_LEN];  //!< compressed copy in the cache directory that is loaded instead, if not empty
 
 	// compressed bitmap stuff (.dds) - RT please take a look at this and tell me if we really need it
 	size_t mem_taken;          //!< How much memory does this bitmap use? - UnknownPlayer
@@ -73,6 +74,10 @@ struct bitmap_entry {
 	ushort used_flags;       //!< What flags it was accessed thru
 	int   load_count;
 
+	// Stuff to keep the textures within their memory budget
+	int    last_used_frame; //!< Bm_frame_count when the graphics API last used this, animations only use the first frame's
+	size_t resident_size;   //!< How much memory the graphics API has uploaded of this, 0 if it isn't resident
+
 	bitmap bm;              //!< Bitmap info
 
 	bm_extra_info info;     //!< Data for animations and user bitmaps
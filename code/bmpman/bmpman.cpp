@@ -16,6 +16,7 @@
 #include "anim/animplay.h"
 #include "anim/packunpack.h"
 #include "bmpman/bm_internal.h"
+#include "cmdline/cmdline.h"
 #include "ddsutils/ddsutils.h"
 #include "debugconsole/console.h"
 #include "globalincs/systemvars.h"
@@ -33,6 +34,7 @@
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
 
+#include <algorithm>
 #include <cctype>
 #include <climits>
 #include <iomanip>
@@ -49,6 +51,8 @@
 // Monitor variables
 MONITOR(NumBitmapPage)
 MONITOR(SizeBitmapPage)
+MONITOR(ResidentTextureKB)
+MONITOR(EvictedTextures)
 
 // --------------------------------------------------------------------------------------------------------------------
 // Definition of public variables (declared as extern in bmpman.h).
@@ -87,11 +91,17 @@ SCP_map<int,ubyte*> bm_lookup_cache;
 /**
  * How much RAM bmpman can use for textures.
  *
- * @details Set to <1 to make it use all it wants.
+ * @details Set to 0 to make it use all it wants. Comes from -texture_budget, and can be changed with the bmpman DCF.
  *
  * @note was initialized to 16*1024*1024 at some point to "use only 16MB for textures"
  */
-static int Bm_max_ram = 0;
+static size_t Bm_max_ram = 0;
+
+// the textures are unloaded down to this fraction of Bm_max_ram, so that going over it doesn't unload one every frame
+static const float Bm_evict_target = 0.9f;
+
+static int Bm_frame_count = 0;
+static size_t Bm_resident_ram = 0;		// bytes of textures the graphics API has uploaded
 
 static int Bm_ignore_duplicates = 0;
 static int Bm_ignore_load_count = 0;
@@ -462,12 +472,14 @@ DCF(bmpman, "Shows/changes bitmap caching parameters and usage") {
 	if (dc_optional_string_either("status", "--status") || dc_optional_string_either("?", "--?")) {
 		dc_printf("Total RAM usage: " SIZE_T_ARG " bytes\n", bm_texture_ram);
 
+		dc_printf("Resident texture memory: " SIZE_T_ARG " bytes\n", Bm_resident_ram);
+
 		if (Bm_max_ram > 1024 * 1024) {
-			dc_printf("\tMax RAM allowed: %.1f MB\n", i2fl(Bm_max_ram) / (1024.0f*1024.0f));
+			dc_printf("\tMax RAM allowed: %.1f MB\n", Bm_max_ram / (1024.0f*1024.0f));
 		} else if (Bm_max_ram > 1024) {
-			dc_printf("\tMax RAM allowed: %.1f KB\n", i2fl(Bm_max_ram) / (1024.0f));
+			dc_printf("\tMax RAM allowed: %.1f KB\n", Bm_max_ram / (1024.0f));
 		} else if (Bm_max_ram > 0) {
-			dc_printf("\tMax RAM allowed: %d bytes\n", Bm_max_ram);
+			dc_printf("\tMax RAM allowed: " SIZE_T_ARG " bytes\n", Bm_max_ram);
 		} else {
 			dc_printf("\tNo RAM limit\n");
 		}
@@ -486,13 +498,15 @@ DCF(bmpman, "Shows/changes bitmap caching parameters and usage") {
 		}
 		dc_printf("Total RAM after flush: " SIZE_T_ARG " bytes\n", bm_texture_ram);
 	} else if (dc_optional_string("ram")) {
-		dc_stuff_int(&Bm_max_ram);
+		int max_ram;
+		dc_stuff_int(&max_ram);
 
-		if (Bm_max_ram > 0) {
-			dc_printf("BmpMan limited to %i, MB's\n", Bm_max_ram);
-			Bm_max_ram *= 1024 * 1024;
-		} else if (Bm_max_ram == 0) {
+		if (max_ram > 0) {
+			dc_printf("BmpMan limited to %i, MB's\n", max_ram);
+			Bm_max_ram = static_cast<size_t>(max_ram) * 1024 * 1024;
+		} else if (max_ram == 0) {
 			dc_printf("!!BmpMan memory is unlimited!!\n");
+			Bm_max_ram = 0;
 		} else {
 			dc_printf("Illegal value. Must be non-negative.");
 		}
@@ -501,6 +515,77 @@ DCF(bmpman, "Shows/changes bitmap caching parameters and usage") {
 	}
 }
 
+// what the resident textures are used for, for the bm_resident DCF
+static const char* bm_residency_category(bitmap_entry* entry) {
+	if (bm_is_anim(entry))
+		return "Animations";
+
+	switch (entry->dir_type) {
+	case CF_TYPE_MAPS:
+		return "Model textures";
+	case CF_TYPE_INTERFACE:
+	case CF_TYPE_HUD:
+	case CF_TYPE_FONT:
+		return "Interface";
+	case CF_TYPE_EFFECTS:
+		return "Effects";
+	default:
+		return "Other";
+	}
+}
+
+DCF(bm_resident, "Shows the resident textures by category and by how recently they were used") {
+	if (dc_optional_string_either("help", "--help")) {
+		dc_printf("Usage: bm_resident\n");
+		dc_printf("\tShows the texture memory in use, split up by category and by the frames since each texture was last used\n");
+		return;
+	}
+
+	// frames since the last use, from hot to cold
+	const int ages[] = { 1, 60, 600, INT_MAX };
+	const int num_ages = sizeof(ages) / sizeof(ages[0]);
+
+	struct residency {
+		int count = 0;
+		size_t size = 0;
+		size_t by_age[num_ages] = {};
+	};
+	SCP_map<SCP_string, residency> categories;
+
+	for (auto& block : bm_blocks) {
+		for (auto& slot : block) {
+			auto& entry = slot.entry;
+
+			if ((entry.type == BM_TYPE_NONE) || (entry.resident_size == 0))
+				continue;
+
+			auto last_used = bm_is_anim(&entry) ? bm_get_entry(entry.info.ani.first_frame)->last_used_frame : entry.last_used_frame;
+			auto age = Bm_frame_count - last_used;
+			auto& category = categories[bm_residency_category(&entry)];
+
+			category.count++;
+			category.size += entry.resident_size;
+
+			for (int i = 0; i < num_ages; ++i) {
+				if (age < ages[i]) {
+					category.by_age[i] += entry.resident_size;
+					break;
+				}
+			}
+		}
+	}
+
+	dc_printf("Resident textures: %.1f MB of %.1f MB (0 = no limit)\n", Bm_resident_ram / (1024.0f * 1024.0f), Bm_max_ram / (1024.0f * 1024.0f));
+	dc_printf("%-16s %6s %9s %9s %9s %9s %9s\n", "Category", "Count", "MB", "Now", "<1s", "<10s", "Older");
+
+	for (auto& category : categories) {
+		auto& r = category.second;
+
+		dc_printf("%-16s %6d %9.1f %9.1f %9.1f %9.1f %9.1f\n", category.first.c_str(), r.count, r.size / (1024.0f * 1024.0f),
+			r.by_age[0] / (1024.0f * 1024.0f), r.by_age[1] / (1024.0f * 1024.0f), r.by_age[2] / (1024.0f * 1024.0f), r.by_age[3] / (1024.0f * 1024.0f));
+	}
+}
+
 DCF(bmpslots, "Writes bitmap slot info to fs2_open.log") {
 	if (dc_optional_string_either("help", "--help")) {
 		dc_printf("Usage: bmpslots\n");
@@ -666,6 +751,94 @@ void bm_convert_format(bitmap *bmp, ushort flags) {
 	}
 }
 
+void bm_end_frame() {
+	Bm_frame_count++;
+
+	mon_ResidentTextureKB = static_cast<int>(Bm_resident_ram / 1024);
+
+	if ((Bm_max_ram == 0) || (Bm_resident_ram <= Bm_max_ram))
+		return;
+
+	// the whole animation is unloaded together, since its frames share one texture
+	struct eviction_candidate {
+		int handle;
+		int last_used_frame;
+	};
+	static SCP_vector<eviction_candidate> candidates;
+
+	candidates.clear();
+
+	for (auto& block : bm_blocks) {
+		for (auto& slot : block) {
+			auto& entry = slot.entry;
+
+			switch (entry.type) {
+			case BM_TYPE_NONE:
+			case BM_TYPE_USER:
+			case BM_TYPE_3D:
+			case BM_TYPE_RENDER_TARGET_STATIC:
+			case BM_TYPE_RENDER_TARGET_DYNAMIC:
+				continue;
+			default:
+				break;
+			}
+
+			int num_frames = 1;
+			bool resident = false;
+			bool locked = false;
+
+			if (bm_is_anim(&entry)) {
+				if (entry.handle != entry.info.ani.first_frame)
+					continue;
+
+				num_frames = entry.info.ani.num_frames;
+			}
+
+			for (int i = 0; i < num_frames; ++i) {
+				auto frame = bm_get_entry(entry.handle + i);
+
+				resident = resident || (frame->resident_size > 0);
+				locked = locked || (frame->ref_count > 0);
+			}
+
+			if (resident && !locked && (entry.last_used_frame < Bm_frame_count - 2)) {
+				candidates.push_back({ entry.handle, entry.last_used_frame });
+			}
+		}
+	}
+
+	std::sort(candidates.begin(), candidates.end(), [](const eviction_candidate& a, const eviction_candidate& b) {
+		return a.last_used_frame < b.last_used_frame;
+	});
+
+	const auto target = static_cast<size_t>(Bm_max_ram * Bm_evict_target);
+	int evicted = 0;
+
+	for (auto& candidate : candidates) {
+		if (Bm_resident_ram <= target)
+			break;
+
+		auto entry = bm_get_entry(candidate.handle);
+		int num_frames = bm_is_anim(entry) ? entry->info.ani.num_frames : 1;
+
+		nprintf(("BmpMan", "Evicting %s, last used %d frames ago\n", entry->filename, Bm_frame_count - candidate.last_used_frame));
+
+		for (int i = 0; i < num_frames; ++i) {
+			bm_free_data(bm_get_slot(candidate.handle + i), true);
+		}
+
+		++evicted;
+	}
+
+	if (evicted > 0) {
+		MONITOR_INC(EvictedTextures, evicted);
+	}
+
+	if (Bm_resident_ram > Bm_max_ram) {
+		nprintf(("BmpMan", "The textures used in the last frames need " SIZE_T_ARG " bytes, which is more than the budget of " SIZE_T_ARG " bytes\n", Bm_resident_ram, Bm_max_ram));
+	}
+}
+
 void bm_free_data(bitmap_slot* bs, bool release)
 {
 	bitmap *bmp;
@@ -675,6 +848,12 @@ void bm_free_data(bitmap_slot* bs, bool release)
 
 	gr_bm_free_data(bs, release);
 
+	// the graphics API may not have had a texture for this, or may not have said that it freed it
+	if (release && (be->resident_size > 0)) {
+		Bm_resident_ram -= be->resident_size;
+		be->resident_size = 0;
+	}
+
 	// If there isn't a bitmap in this structure, don't
 	// do anything but clear out the bitmap info
 	if (be->type==BM_TYPE_NONE)
@@ -1020,6 +1199,8 @@ void bm_init() {
 	// Allocate one block by default
 	allocate_new_block();
 
+	Bm_max_ram = static_cast<size_t>(Cmdline_texture_budget) * 1024 * 1024;
+
 	bm_inited = true;
 }
 
@@ -1189,6 +1370,104 @@ static int bm_load_info(BM_TYPE type, const char *filename, CFILE *img_cfp, int
 	return 0;
 }
 
+// e.g. "tc1_DXT5_1234abcd00015800.dds", which fits in MAX_FILENAME_LEN
+static void bm_cached_texture_name(char *cache_filename, uint fourcc, uint chksum, uint length) {
+	const char format[4] = { static_cast<char>(fourcc & 0xFF), static_cast<char>((fourcc >> 8) & 0xFF),
+		static_cast<char>((fourcc >> 16) & 0xFF), static_cast<char>((fourcc >> 24) & 0xFF) };
+
+	sprintf(cache_filename, "tc%d_%.4s_%08x%08x.dds", DDS_COMPRESS_VERSION, format, chksum, length);
+}
+
+/**
+ * @brief Finds or makes a compressed copy of an uncompressed texture in the cache directory
+ *
+ * @param[in] type The type of the original image, only TGA, PNG and JPG images are compressed
+ * @param[in] filename The name of the original image, with its extension
+ * @param[in] img_cfp The open original image
+ * @param[in] w, h, bpp The size of the original image as returned by bm_load_info()
+ * @param[in] dir_type The directory the original image is in
+ * @param[out] cache_filename The name of the compressed copy, MAX_FILENAME_LEN long
+ *
+ * @returns true if the compressed copy can be loaded instead of the original image
+ */
+static bool bm_find_cached_texture(BM_TYPE type, const char *filename, CFILE *img_cfp, int w, int h, int bpp, int dir_type, char *cache_filename) {
+	if ((type != BM_TYPE_TGA) && (type != BM_TYPE_PNG) && (type != BM_TYPE_JPG))
+		return false;
+
+	// the compressed formats need whole blocks, and non power of 2 textures aren't worth the trouble
+	if ((w < 4) || (h < 4) || (w & (w - 1)) || (h & (h - 1)) || (bpp < 24))
+		return false;
+
+	if ( !dds_compressed_cache_format(false) )
+		return false;
+
+	// the copy is named after the contents of the original so that a changed image gets compressed again
+	uint chksum = 0;
+
+	if ( !cf_chksum_long(img_cfp, &chksum) )
+		return false;
+
+	// the name also has the format and the compressor version in it, so a copy made in a format this hardware can't
+	// use (or by an older compressor) is never picked up. Whether the image has alpha isn't known until it is read,
+	// so look for a copy in either of the formats it could have been saved in.
+	const uint chklen = static_cast<uint>(cfilelength(img_cfp));
+
+	for (bool alpha : {false, true}) {
+		bm_cached_texture_name(cache_filename, dds_compressed_cache_format(alpha), chksum, chklen);
+
+		if (cf_exists(cache_filename, CF_TYPE_CACHE))
+			return true;
+	}
+
+	SCP_vector<ubyte> data(static_cast<size_t>(w) * h * 4);
+	int read_bpp = bpp;
+	int error;
+
+	if (type == BM_TYPE_TGA) {
+		error = targa_read_bitmap(filename, data.data(), nullptr, bpp >> 3, dir_type);
+		error = (error == TARGA_ERROR_NONE) ? 0 : -1;
+	} else if (type == BM_TYPE_PNG) {
+		error = png_read_bitmap(filename, data.data(), &read_bpp, 4, dir_type);
+		error = ((error == PNG_ERROR_NONE) && (read_bpp >= 24)) ? 0 : -1;
+	} else {
+		read_bpp = 24;
+		error = jpeg_read_bitmap(filename, data.data(), nullptr, 3, dir_type);
+		error = (error == JPEG_ERROR_NONE) ? 0 : -1;
+	}
+
+	if (error != 0) {
+		mprintf(("Unable to read '%s' for the texture cache\n", filename));
+		return false;
+	}
+
+	// the compressors want BGRA, so spread out 24-bit images in place from the back
+	bool alpha = false;
+	const size_t num_pixels = static_cast<size_t>(w) * h;
+
+	if (read_bpp == 24) {
+		for (size_t i = num_pixels; i-- > 0;) {
+			data[i * 4 + 3] = 255;
+			data[i * 4 + 2] = data[i * 3 + 2];
+			data[i * 4 + 1] = data[i * 3 + 1];
+			data[i * 4 + 0] = data[i * 3 + 0];
+		}
+	} else {
+		for (size_t i = 0; i < num_pixels && !alpha; ++i) {
+			alpha = (data[i * 4 + 3] != 255);
+		}
+	}
+
+	const uint fourcc = dds_compressed_cache_format(alpha);
+	bm_cached_texture_name(cache_filename, fourcc, chksum, chklen);
+
+	if ( !dds_save_compressed_image(cache_filename, fourcc, data.data(), static_cast<uint>(w), static_cast<uint>(h)) )
+		return false;
+
+	mprintf(("Compressed '%s' into the texture cache as '%s'\n", filename, cache_filename));
+
+	return true;
+}
+
 int bm_load(const char *real_filename, int dir_type) {
 	int free_slot = -1;
 	int w, h, bpp = 8;
@@ -1267,6 +1546,34 @@ int bm_load(const char *real_filename, int dir_type) {
 		return -1;
 	}
 
+	// use a compressed copy of uncompressed model textures, if there is or can be one
+	char cache_filename[MAX_FILENAME_LEN] = "";
+
+	if (Cmdline_cache_textures && (dir_type == CF_TYPE_MAPS) && (img_cfp != nullptr)
+		&& bm_find_cached_texture(type, filename, img_cfp, w, h, bpp, dir_type, cache_filename)) {
+		CFILE *cache_cfp = cfopen(cache_filename, "rb", CF_TYPE_CACHE);
+		int cache_w, cache_h, cache_bpp = 8, cache_mm_lvl = 0;
+		BM_TYPE cache_c_type = BM_TYPE_NONE;
+		size_t cache_size = 0;
+
+		// a copy that was renamed or saved by hand could still be in a format the hardware can't use
+		if ((cache_cfp != nullptr) && (bm_load_info(BM_TYPE_DDS, cache_filename, cache_cfp, &cache_w, &cache_h, &cache_bpp, &cache_c_type, &cache_mm_lvl, &cache_size) == 0)
+			&& ((cache_c_type != BM_TYPE_BC7) || gr_is_capable(gr_capability::CAPABILITY_BPTC))) {
+			type = BM_TYPE_DDS;
+			c_type = cache_c_type;
+			w = cache_w;
+			h = cache_h;
+			bpp = cache_bpp;
+			mm_lvl = cache_mm_lvl;
+			bm_size = cache_size;
+		} else {
+			cache_filename[0] = '\0';
+		}
+
+		if (cache_cfp != nullptr)
+			cfclose(cache_cfp);
+	}
+
 	if ((bm_size <= 0) && (w) && (h) && (bpp))
 		bm_size = (w * h * (bpp >> 3));
 
@@ -1281,6 +1588,7 @@ int bm_load(const char *real_filename, int dir_type) {
 	// Mark the slot as filled, because cf_read might load a new bitmap
 	// into this slot.
 	strcpy_s(entry->filename, filename);
+	strcpy_s(entry->cache_filename, cache_filename);
 	entry->type = type;
 	entry->comp_type = c_type;
 	entry->signature = Bm_next_signature++;
@@ -2239,7 +2547,10 @@ void bm_lock_dds(int handle, bitmap_slot *bs, bitmap *bmp, int /*bpp*/, ushort /
 	// this will populate filename[] whether it's EFF or not
 	EFF_FILENAME_CHECK;
 
-	error = dds_read_bitmap(filename, data, &dds_bpp, be->dir_type);
+	if (be->cache_filename[0] != '\0')
+		error = dds_read_bitmap(be->cache_filename, data, &dds_bpp, CF_TYPE_CACHE);
+	else
+		error = dds_read_bitmap(filename, data, &dds_bpp, be->dir_type);
 
 #if BYTE_ORDER == BIG_ENDIAN
 	// same as with TGA, we need to byte swap 16 & 32-bit, uncompressed, DDS images
@@ -2518,6 +2829,16 @@ void bm_lock_user(int /*handle*/, bitmap_slot *bs, bitmap *bmp, int bpp, ushort
 		bm_convert_format(bmp, flags);
 }
 
+void bm_mark_used(int handle) {
+	auto entry = bm_get_entry(handle);
+
+	if (bm_is_anim(entry)) {
+		entry = bm_get_entry(entry->info.ani.first_frame);
+	}
+
+	entry->last_used_frame = Bm_frame_count;
+}
+
 int bm_make_render_target(int width, int height, int flags) {
 	int mm_lvl = 0;
 	// final w and h may be different from passed width and height
@@ -2981,6 +3302,12 @@ int bm_reload(int bitmap_handle, const char* filename) {
 		return -1;
 	}
 
+	// the compressed copy is of the old image, and the new one may not have one
+	if (entry->cache_filename[0] != '\0') {
+		nprintf(("BmpMan", "Trying to reload a bitmap that was loaded from the texture cache. Filename: %s", entry->filename));
+		return -1;
+	}
+
 	strcpy_s(entry->filename, filename);
 	return bitmap_handle;
 }
@@ -3048,6 +3375,21 @@ void bm_set_low_mem(int mode) {
 	Bm_low_mem = mode;
 }
 
+void bm_set_resident_size(int handle, size_t size) {
+	auto entry = bm_get_entry(handle);
+
+	Assertion(Bm_resident_ram >= entry->resident_size, "Resident texture memory of %s is out of sync!", entry->filename);
+
+	Bm_resident_ram -= entry->resident_size;
+	Bm_resident_ram += size;
+	entry->resident_size = size;
+
+	// a texture that was just uploaded is about to be used, so it shouldn't be the first one unloaded again
+	if (size > 0) {
+		bm_mark_used(handle);
+	}
+}
+
 bool bm_set_render_target(int handle, int face) {
 	GR_DEBUG_SCOPE("Set render target");
 
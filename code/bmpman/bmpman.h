@@ -451,6 +451,29 @@ void bm_get_palette(int handle, ubyte *pal, char *name);
  */
 void bm_get_frame_usage(int *ntotal, int *nnew);
 
+/**
+ * @brief Marks a bitmap as used by the graphics API this frame
+ *
+ * @details The least recently used textures are the first ones unloaded when they go past the texture budget
+ */
+void bm_mark_used(int handle);
+
+/**
+ * @brief Records how much memory the graphics API uses for the texture of a bitmap
+ *
+ * @param[in] handle The bitmap handle, every frame of an animation is recorded separately
+ * @param[in] size   The size of the texture in bytes, or 0 if it was freed
+ */
+void bm_set_resident_size(int handle, size_t size);
+
+/**
+ * @brief Advances the frame counter and unloads the least recently used textures that don't fit into the budget
+ *
+ * @details Textures that were used during the last two frames and locked bitmaps are never unloaded. Their bitmaps stay
+ *   loaded, so the textures are read in again when they are used next.
+ */
+void bm_end_frame();
+
 /**
  * @brief Reloads an existing bmpman slot with different bitmap
  *
@@ -173,6 +173,8 @@ Flag exe_params[] =
 	{ "-no_deferred",		"Disable Deferred Lighting",				true,	EASY_DEFAULT | EASY_HI_MEM_OFF,		EASY_ALL_ON | EASY_HI_MEM_ON,	"Graphics",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-no_deferred"},
 	{ "-enable_shadows",	"Enable Shadows",							true,	EASY_ALL_ON  | EASY_HI_MEM_ON,		EASY_DEFAULT | EASY_HI_MEM_OFF,	"Graphics",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-enable_shadows"},
 	{ "-deferred_cockpit",	"Enable Deferred Lighting for Cockpits",	true,	EASY_ALL_ON	 | EASY_HI_MEM_ON,		EASY_DEFAULT | EASY_HI_MEM_OFF,	"Graphics",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-deferred_cockpit"},
+	{ "-cache_textures",	"Compress model textures into the cache",	true,	0,									EASY_DEFAULT,					"Graphics",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-cache_textures"},
+	{ "-occlusion_cull",	"Skip objects hidden behind big ships",		true,	0,									EASY_DEFAULT,					"Graphics",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-occlusion_cull"},
 
 	//flag					launcher text								FSO		on_flags							off_flags						category		reference URL
 	{ "-no_vsync",			"Disable vertical sync",					true,	0,									EASY_DEFAULT,					"Game Speed",	"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-no_vsync", },
@@ -300,6 +302,9 @@ cmdline_parm startgame_arg("-startgame", NULL, AT_NONE);		// Cmdline_start_netga
 cmdline_parm gameclosed_arg("-closed", NULL, AT_NONE);		// Cmdline_closed_game
 cmdline_parm gamerestricted_arg("-restricted", NULL, AT_NONE);	// Cmdline_restricted_game
 cmdline_parm port_arg("-port", "Multiplayer network port", AT_INT);
+cmdline_parm loadtest_arg("-loadtest", "Synthetic clients for a standalone server to load test with", AT_INT);	// Cmdline_loadtest_clients
+cmdline_parm capture_packets_arg("-capture_packets", "Write all multiplayer packets to this file", AT_STRING);	// Cmdline_capture_packets
+cmdline_parm replay_packets_arg("-replay_packets", "Replay the incoming packets of a capture on a server", AT_STRING);	// Cmdline_replay_packets
 cmdline_parm multilog_arg("-multilog", NULL, AT_NONE);		// Cmdline_multi_log
 cmdline_parm pof_spew("-pofspew", NULL, AT_NONE);			// Cmdline_spew_pof_info
 cmdline_parm weapon_spew("-weaponspew", nullptr, AT_STRING);			// Cmdline_spew_weapon_stats
@@ -307,6 +312,7 @@ cmdline_parm mouse_coords("-coords", NULL, AT_NONE);			// Cmdline_mouse_coords
 cmdline_parm timeout("-timeout", "Multiplayer network timeout (secs)", AT_INT);				// Cmdline_timeout
 cmdline_parm bit32_arg("-32bit", "Deprecated", AT_NONE);				// (only here for retail compatibility reasons, doesn't actually do anything)
 
+char *Cmdline_capture_packets = nullptr;
 char *Cmdline_connect_addr = NULL;
 char *Cmdline_game_name = NULL;
 char *Cmdline_game_password = NULL;
@@ -316,10 +322,12 @@ int Cmdline_cd_check = 1;
 int Cmdline_closed_game = 0;
 int Cmdline_freespace_no_music = 0;
 int Cmdline_freespace_no_sound = 0;
+int Cmdline_loadtest_clients = 0;
 int Cmdline_mouse_coords = 0;
 int Cmdline_multi_log = 0;
 int Cmdline_multi_stream_chat_to_file = 0;
 int Cmdline_network_port = -1;
+char *Cmdline_replay_packets = nullptr;
 int Cmdline_restricted_game = 0;
 int Cmdline_spew_pof_info = 0;
 WeaponSpewType Cmdline_spew_weapon_stats = WeaponSpewType::NONE;
@@ -358,6 +366,9 @@ cmdline_parm shadow_quality_arg("-shadow_quality", NULL, AT_INT);
 cmdline_parm enable_shadows_arg("-enable_shadows", NULL, AT_NONE);
 cmdline_parm no_deferred_lighting_arg("-no_deferred", NULL, AT_NONE);	// Cmdline_no_deferred
 cmdline_parm deferred_lighting_cockpit_arg("-deferred_cockpit", nullptr, AT_NONE);
+cmdline_parm cache_textures_arg("-cache_textures", "Compress uncompressed model textures and keep them in the cache", AT_NONE);	// Cmdline_cache_textures
+cmdline_parm occlusion_cull_arg("-occlusion_cull", "Skip rendering objects which are hidden behind the hulls of big ships", AT_NONE);	// Cmdline_occlusion_cull
+cmdline_parm texture_budget_arg("-texture_budget", "Texture memory in MB after which the least recently used textures are unloaded (0 = no limit)", AT_INT);	// Cmdline_texture_budget
 cmdline_parm anisotropy_level_arg("-anisotropic_filter", NULL, AT_INT);
 
 float Cmdline_ambient_power = 1.0f;
@@ -374,6 +385,9 @@ int Cmdline_height = 1;
 int Cmdline_softparticles = 0;
 int Cmdline_no_deferred_lighting = 0;
 bool Cmdline_deferred_lighting_cockpit = false;
+bool Cmdline_cache_textures = false;
+bool Cmdline_occlusion_cull = false;
+int Cmdline_texture_budget = 0;
 int Cmdline_aniso_level = 0;
 int Cmdline_msaa_enabled = 0;
 
@@ -1731,6 +1745,19 @@ bool SetCmdlineParams()
 		Cmdline_network_port = port_arg.get_int();
 	}
 
+	// number of synthetic clients a standalone server runs missions with
+	if ( loadtest_arg.found() ) {
+		Cmdline_loadtest_clients = loadtest_arg.get_int();
+	}
+
+	// multiplayer packet capture and replay
+	if ( capture_packets_arg.found() ) {
+		Cmdline_capture_packets = capture_packets_arg.str();
+	}
+	if ( replay_packets_arg.found() ) {
+		Cmdline_replay_packets = replay_packets_arg.str();
+	}
+
 	// get IP address of gateway, for auto port forwarding
 	if ( gateway_ip_arg.found() ) {
 		Cmdline_gateway_ip = gateway_ip_arg.str();
@@ -2254,6 +2281,21 @@ bool SetCmdlineParams()
 		Cmdline_deferred_lighting_cockpit = true;
 	}
 
+	if (cache_textures_arg.found())
+	{
+		Cmdline_cache_textures = true;
+	}
+
+	if (occlusion_cull_arg.found())
+	{
+		Cmdline_occlusion_cull = true;
+	}
+
+	if (texture_budget_arg.found())
+	{
+		Cmdline_texture_budget = std::max(0, texture_budget_arg.get_int());
+	}
+
 	if (anisotropy_level_arg.found()) 
 	{
 		Cmdline_aniso_level = anisotropy_level_arg.get_int();
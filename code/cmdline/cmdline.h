@@ -25,6 +25,7 @@ int parse_cmdline(int argc, char *argv[]);
 
 
 // RETAIL OPTIONS ----------------------------------------------
+extern char *Cmdline_capture_packets;
 extern char *Cmdline_connect_addr;
 extern char *Cmdline_game_name;
 extern char *Cmdline_game_password;
@@ -34,10 +35,12 @@ extern int Cmdline_cd_check;
 extern int Cmdline_closed_game;
 extern int Cmdline_freespace_no_music;
 extern int Cmdline_freespace_no_sound;
+extern int Cmdline_loadtest_clients;
 extern int Cmdline_mouse_coords;
 extern int Cmdline_multi_log;
 extern int Cmdline_multi_stream_chat_to_file;
 extern int Cmdline_network_port;
+extern char *Cmdline_replay_packets;
 extern int Cmdline_restricted_game;
 extern int Cmdline_spew_pof_info;
 extern int Cmdline_start_netgame;
@@ -65,6 +68,9 @@ extern int Cmdline_height;
 extern int Cmdline_softparticles;
 extern int Cmdline_no_deferred_lighting;
 extern bool Cmdline_deferred_lighting_cockpit;
+extern bool Cmdline_cache_textures;
+extern bool Cmdline_occlusion_cull;
+extern int Cmdline_texture_budget;
 extern int Cmdline_emissive;
 extern int Cmdline_aniso_level;
 extern int Cmdline_msaa_enabled;
@@ -0,0 +1,789 @@
+#include "ddsutils/ddsutils.h"
+#include "cfile/cfile.h"
+#include "tracing/tracing.h"
+#include "utils/threading.h"
+
+#include <cfloat>
+#include <climits>
+
+#ifdef WITH_OPENGL
+#include <glad/glad.h>
+#else
+static constexpr int GLAD_GL_EXT_texture_compression_s3tc = 0;
+static constexpr int GLAD_GL_ARB_texture_compression_bptc = 0;
+#endif
+
+/*	CPU block compression
+ *		BC1	(DXT1, opaque images only)
+ *		BC3	(DXT5)
+ *		BC7	(mode 6 only, a single RGBA endpoint pair with 4-bit indices)
+ *
+ *	The endpoints come from the principal axis of the block's colors and are refined once by least squares, which is
+ *	about what the drivers did when they were asked to compress textures at upload.
+ */
+
+// split large surfaces into bands of about this many blocks for the worker threads
+#define DDS_COMPRESS_BAND_BLOCKS			1024
+
+// fewer blocks than this (a 256x256 texture) aren't worth waking up the worker threads for
+#define DDS_COMPRESS_MIN_THREADED_BLOCKS	4096
+
+typedef ubyte dds_block_pixels[16][4];	// BGRA
+
+static void (*compress_dds)(const dds_block_pixels &block, ubyte *out) = nullptr;
+static uint32_t COMPRESS_BLOCK_SIZE = 0;
+
+typedef struct dds_compress_band {
+	const ubyte *src;	// the whole surface
+	ubyte *dst;			// the first block of the band
+	uint width;			// of the surface, in pixels
+	uint height;		// of the surface, in pixels
+	uint first_row;		// in blocks
+	uint num_rows;		// in blocks
+} dds_compress_band;
+
+static SCP_vector<dds_compress_band> Dds_compress_bands;
+static size_t Dds_compress_queued_blocks = 0;
+
+static const int Bc7_weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+template <int N>
+static void dds_compress_principal_axis(const float (&px)[16][N], float (&mean)[N], float (&axis)[N])
+{
+	float cov[N][N];
+	float lo[N], hi[N];
+
+	for (int c = 0; c < N; ++c) {
+		mean[c] = 0.0f;
+		lo[c] = hi[c] = px[0][c];
+	}
+
+	for (int i = 0; i < 16; ++i) {
+		for (int c = 0; c < N; ++c) {
+			mean[c] += px[i][c];
+			lo[c] = std::min(lo[c], px[i][c]);
+			hi[c] = std::max(hi[c], px[i][c]);
+		}
+	}
+
+	for (int c = 0; c < N; ++c) {
+		mean[c] /= 16.0f;
+	}
+
+	for (int a = 0; a < N; ++a) {
+		for (int b = 0; b < N; ++b) {
+			cov[a][b] = 0.0f;
+
+			for (int i = 0; i < 16; ++i) {
+				cov[a][b] += (px[i][a] - mean[a]) * (px[i][b] - mean[b]);
+			}
+		}
+	}
+
+	// power iteration, starting out along the bounding box diagonal
+	for (int c = 0; c < N; ++c) {
+		axis[c] = hi[c] - lo[c];
+	}
+
+	for (int iter = 0; iter < 6; ++iter) {
+		float next[N];
+		float largest = 0.0f;
+
+		for (int a = 0; a < N; ++a) {
+			next[a] = 0.0f;
+
+			for (int b = 0; b < N; ++b) {
+				next[a] += cov[a][b] * axis[b];
+			}
+
+			largest = std::max(largest, fabsf(next[a]));
+		}
+
+		if (largest < 1e-6f) {
+			break;
+		}
+
+		for (int c = 0; c < N; ++c) {
+			axis[c] = next[c] / largest;
+		}
+	}
+
+	float length = 0.0f;
+
+	for (int c = 0; c < N; ++c) {
+		length += axis[c] * axis[c];
+	}
+
+	length = sqrtf(length);
+
+	for (int c = 0; c < N; ++c) {
+		axis[c] = (length > 1e-6f) ? (axis[c] / length) : 0.0f;
+	}
+}
+
+// the ends of the colors along the principal axis, pulled in a bit since the ends are rarely hit exactly
+template <int N>
+static void dds_compress_initial_endpoints(const float (&px)[16][N], float inset, float (&e0)[N], float (&e1)[N])
+{
+	float mean[N], axis[N];
+	float t_min = 0.0f, t_max = 0.0f;
+
+	dds_compress_principal_axis(px, mean, axis);
+
+	for (int i = 0; i < 16; ++i) {
+		float t = 0.0f;
+
+		for (int c = 0; c < N; ++c) {
+			t += (px[i][c] - mean[c]) * axis[c];
+		}
+
+		t_min = std::min(t_min, t);
+		t_max = std::max(t_max, t);
+	}
+
+	for (int c = 0; c < N; ++c) {
+		e0[c] = mean[c] + axis[c] * t_max;
+		e1[c] = mean[c] + axis[c] * t_min;
+
+		const float d = (e0[c] - e1[c]) * inset;
+		e0[c] -= d;
+		e1[c] += d;
+	}
+}
+
+// Least squares endpoints for the given index weights, where a pixel is (1 - w) * e0 + w * e1
+template <int N>
+static bool dds_compress_refine_endpoints(const float (&px)[16][N], const float (&w)[16], float (&e0)[N], float (&e1)[N])
+{
+	float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+	float ax[N], bx[N];
+
+	for (int c = 0; c < N; ++c) {
+		ax[c] = bx[c] = 0.0f;
+	}
+
+	for (int i = 0; i < 16; ++i) {
+		const float a = 1.0f - w[i];
+		const float b = w[i];
+
+		aa += a * a;
+		ab += a * b;
+		bb += b * b;
+
+		for (int c = 0; c < N; ++c) {
+			ax[c] += a * px[i][c];
+			bx[c] += b * px[i][c];
+		}
+	}
+
+	const float det = aa * bb - ab * ab;
+
+	if (fabsf(det) < 1e-6f) {
+		return false;
+	}
+
+	for (int c = 0; c < N; ++c) {
+		e0[c] = (ax[c] * bb - bx[c] * ab) / det;
+		e1[c] = (bx[c] * aa - ax[c] * ab) / det;
+	}
+
+	return true;
+}
+
+static inline int dds_compress_clamp(float value, int max)
+{
+	return std::max(0, std::min(max, static_cast<int>(value + 0.5f)));
+}
+
+// colors are RGB
+static ushort dds_compress_pack_565(const float (&color)[3])
+{
+	const int r = dds_compress_clamp(color[0] * 31.0f / 255.0f, 31);
+	const int g = dds_compress_clamp(color[1] * 63.0f / 255.0f, 63);
+	const int b = dds_compress_clamp(color[2] * 31.0f / 255.0f, 31);
+
+	return static_cast<ushort>((r << 11) | (g << 5) | b);
+}
+
+// Picks the closest of the 4 colors for each pixel, with the same math the decoders use. Returns the squared error.
+static int dds_compress_color_indices(const float (&px)[16][3], ushort c0, ushort c1, uint &indices)
+{
+	int palette[4][3];
+
+	const int r0 = (c0 >> 11) & 0x1F, g0 = (c0 >> 5) & 0x3F, b0 = c0 & 0x1F;
+	const int r1 = (c1 >> 11) & 0x1F, g1 = (c1 >> 5) & 0x3F, b1 = c1 & 0x1F;
+
+	palette[0][0] = (r0 * 527 + 23) >> 6;
+	palette[0][1] = (g0 * 259 + 33) >> 6;
+	palette[0][2] = (b0 * 527 + 23) >> 6;
+
+	palette[1][0] = (r1 * 527 + 23) >> 6;
+	palette[1][1] = (g1 * 259 + 33) >> 6;
+	palette[1][2] = (b1 * 527 + 23) >> 6;
+
+	palette[2][0] = ((2 * r0 + r1) * 351 + 61) >> 7;
+	palette[2][1] = ((2 * g0 + g1) * 2763 + 1039) >> 11;
+	palette[2][2] = ((2 * b0 + b1) * 351 + 61) >> 7;
+
+	palette[3][0] = ((r0 + r1 * 2) * 351 + 61) >> 7;
+	palette[3][1] = ((g0 + g1 * 2) * 2763 + 1039) >> 11;
+	palette[3][2] = ((b0 + b1 * 2) * 351 + 61) >> 7;
+
+	int error = 0;
+	indices = 0;
+
+	for (int i = 0; i < 16; ++i) {
+		int best = 0;
+		int best_error = INT_MAX;
+
+		for (int p = 0; p < 4; ++p) {
+			int e = 0;
+
+			for (int c = 0; c < 3; ++c) {
+				const int d = static_cast<int>(px[i][c]) - palette[p][c];
+				e += d * d;
+			}
+
+			if (e < best_error) {
+				best = p;
+				best_error = e;
+			}
+		}
+
+		indices |= static_cast<uint>(best) << (i * 2);
+		error += best_error;
+	}
+
+	return error;
+}
+
+// Always the 4 color mode, so BC1 blocks made here have no transparent pixels
+static void dds_compress_color_block(const dds_block_pixels &block, ubyte *out)
+{
+	static const float index_weights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+	float px[16][3];
+	float e0[3], e1[3];
+	float w[16];
+
+	for (int i = 0; i < 16; ++i) {
+		px[i][0] = block[i][2];
+		px[i][1] = block[i][1];
+		px[i][2] = block[i][0];
+	}
+
+	dds_compress_initial_endpoints(px, 1.0f / 16.0f, e0, e1);
+
+	ushort c0 = dds_compress_pack_565(e0);
+	ushort c1 = dds_compress_pack_565(e1);
+	uint indices;
+	int error = dds_compress_color_indices(px, c0, c1, indices);
+
+	for (int i = 0; i < 16; ++i) {
+		w[i] = index_weights[(indices >> (i * 2)) & 0x03];
+	}
+
+	if (dds_compress_refine_endpoints(px, w, e0, e1)) {
+		const ushort r0 = dds_compress_pack_565(e0);
+		const ushort r1 = dds_compress_pack_565(e1);
+		uint refined_indices;
+
+		if (dds_compress_color_indices(px, r0, r1, refined_indices) < error) {
+			c0 = r0;
+			c1 = r1;
+			indices = refined_indices;
+		}
+	}
+
+	// the 4 color mode needs c0 > c1, swapping the endpoints swaps index 0 with 1 and 2 with 3
+	if (c0 < c1) {
+		std::swap(c0, c1);
+		indices ^= 0x55555555;
+	} else if (c0 == c1) {
+		indices = 0;
+	}
+
+	memcpy(out, &c0, sizeof(c0));
+	memcpy(out + 2, &c1, sizeof(c1));
+	memcpy(out + 4, &indices, sizeof(indices));
+}
+
+// Returns the squared error
+static int dds_compress_alpha_indices(const dds_block_pixels &block, int a0, int a1, uint64_t &indices)
+{
+	int palette[8];
+
+	palette[0] = a0;
+	palette[1] = a1;
+
+	if (a0 > a1) {
+		for (int i = 1; i < 7; ++i) {
+			palette[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+		}
+	} else {
+		for (int i = 1; i < 5; ++i) {
+			palette[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+		}
+
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+
+	int error = 0;
+	indices = 0;
+
+	for (int i = 0; i < 16; ++i) {
+		int best = 0;
+		int best_error = INT_MAX;
+
+		for (int p = 0; p < 8; ++p) {
+			const int d = block[i][3] - palette[p];
+
+			if (d * d < best_error) {
+				best = p;
+				best_error = d * d;
+			}
+		}
+
+		indices |= static_cast<uint64_t>(best) << (i * 3);
+		error += best_error;
+	}
+
+	return error;
+}
+
+static void dds_compress_alpha_block(const dds_block_pixels &block, ubyte *out)
+{
+	int lo = 255, hi = 0;
+	int inner_lo = 255, inner_hi = 0;
+
+	for (int i = 0; i < 16; ++i) {
+		const int a = block[i][3];
+
+		lo = std::min(lo, a);
+		hi = std::max(hi, a);
+
+		if (a != 0 && a != 255) {
+			inner_lo = std::min(inner_lo, a);
+			inner_hi = std::max(inner_hi, a);
+		}
+	}
+
+	int a0 = hi, a1 = lo;
+	uint64_t indices = 0;
+
+	if (hi != lo) {
+		// 8 alpha values between the extremes, or 6 between the values that aren't fully (in)visible plus 0 and 255
+		int error = dds_compress_alpha_indices(block, a0, a1, indices);
+
+		if (inner_lo <= inner_hi && (lo == 0 || hi == 255)) {
+			uint64_t inner_indices;
+
+			if (dds_compress_alpha_indices(block, inner_lo, inner_hi, inner_indices) < error) {
+				a0 = inner_lo;
+				a1 = inner_hi;
+				indices = inner_indices;
+			}
+		}
+	}
+
+	const uint64_t bits = static_cast<uint64_t>(a0) | (static_cast<uint64_t>(a1) << 8) | (indices << 16);
+	memcpy(out, &bits, sizeof(bits));
+}
+
+static void dds_compress_bc1(const dds_block_pixels &block, ubyte *out)
+{
+	dds_compress_color_block(block, out);
+}
+
+static void dds_compress_bc3(const dds_block_pixels &block, ubyte *out)
+{
+	dds_compress_alpha_block(block, out);
+	dds_compress_color_block(block, out + 8);
+}
+
+// 7 bits per channel plus a p-bit shared by the channels, so an endpoint channel is (q << 1) | p
+static void dds_compress_bc7_quantize(const float (&e)[4], int (&q)[4], int &p)
+{
+	float best_error = FLT_MAX;
+
+	for (int pbit = 0; pbit < 2; ++pbit) {
+		int cand[4];
+		float error = 0.0f;
+
+		for (int c = 0; c < 4; ++c) {
+			cand[c] = dds_compress_clamp((e[c] - pbit) / 2.0f, 127);
+
+			const float d = static_cast<float>((cand[c] << 1) | pbit) - e[c];
+			error += d * d;
+		}
+
+		if (error < best_error) {
+			best_error = error;
+			p = pbit;
+			memcpy(q, cand, sizeof(q));
+		}
+	}
+}
+
+// Returns the squared error
+static int dds_compress_bc7_indices(const float (&px)[16][4], const int (&q0)[4], int p0, const int (&q1)[4], int p1, int (&indices)[16])
+{
+	int palette[16][4];
+
+	for (int c = 0; c < 4; ++c) {
+		const int e0 = (q0[c] << 1) | p0;
+		const int e1 = (q1[c] << 1) | p1;
+
+		for (int i = 0; i < 16; ++i) {
+			palette[i][c] = (e0 * (64 - Bc7_weights[i]) + e1 * Bc7_weights[i] + 32) >> 6;
+		}
+	}
+
+	int error = 0;
+
+	for (int i = 0; i < 16; ++i) {
+		int best = 0;
+		int best_error = INT_MAX;
+
+		for (int p = 0; p < 16; ++p) {
+			int e = 0;
+
+			for (int c = 0; c < 4; ++c) {
+				const int d = static_cast<int>(px[i][c]) - palette[p][c];
+				e += d * d;
+			}
+
+			if (e < best_error) {
+				best = p;
+				best_error = e;
+			}
+		}
+
+		indices[i] = best;
+		error += best_error;
+	}
+
+	return error;
+}
+
+static void dds_compress_bc7(const dds_block_pixels &block, ubyte *out)
+{
+	float px[16][4];
+	float e0[4], e1[4];
+	float w[16];
+	int q0[4], q1[4], p0 = 0, p1 = 0;
+	int indices[16];
+
+	for (int i = 0; i < 16; ++i) {
+		px[i][0] = block[i][2];
+		px[i][1] = block[i][1];
+		px[i][2] = block[i][0];
+		px[i][3] = block[i][3];
+	}
+
+	dds_compress_initial_endpoints(px, 1.0f / 32.0f, e0, e1);
+
+	dds_compress_bc7_quantize(e0, q0, p0);
+	dds_compress_bc7_quantize(e1, q1, p1);
+	int error = dds_compress_bc7_indices(px, q0, p0, q1, p1, indices);
+
+	for (int i = 0; i < 16; ++i) {
+		w[i] = Bc7_weights[indices[i]] / 64.0f;
+	}
+
+	if (dds_compress_refine_endpoints(px, w, e0, e1)) {
+		int r0[4], r1[4], rp0 = 0, rp1 = 0;
+		int refined_indices[16];
+
+		dds_compress_bc7_quantize(e0, r0, rp0);
+		dds_compress_bc7_quantize(e1, r1, rp1);
+
+		if (dds_compress_bc7_indices(px, r0, rp0, r1, rp1, refined_indices) < error) {
+			memcpy(q0, r0, sizeof(q0));
+			memcpy(q1, r1, sizeof(q1));
+			memcpy(indices, refined_indices, sizeof(indices));
+			p0 = rp0;
+			p1 = rp1;
+		}
+	}
+
+	// the first index only has 3 bits, so its top bit has to be 0
+	if (indices[0] >= 8) {
+		std::swap(q0, q1);
+		std::swap(p0, p1);
+
+		for (auto &index : indices) {
+			index = 15 - index;
+		}
+	}
+
+	uint64_t bits[2] = { 0, 0 };
+	int pos = 0;
+
+	auto write = [&bits, &pos](uint64_t value, int count) {
+		if (pos >= 64) {
+			bits[1] |= value << (pos - 64);
+		} else {
+			bits[0] |= value << pos;
+
+			if (pos + count > 64) {
+				bits[1] |= value >> (64 - pos);
+			}
+		}
+
+		pos += count;
+	};
+
+	write(1 << 6, 7);
+
+	for (int c = 0; c < 4; ++c) {
+		write(static_cast<uint64_t>(q0[c]), 7);
+		write(static_cast<uint64_t>(q1[c]), 7);
+	}
+
+	write(static_cast<uint64_t>(p0), 1);
+	write(static_cast<uint64_t>(p1), 1);
+
+	for (int i = 0; i < 16; ++i) {
+		write(static_cast<uint64_t>(indices[i]), (i == 0) ? 3 : 4);
+	}
+
+	Assert(pos == 128);
+
+	memcpy(out, bits, sizeof(bits));
+}
+
+static bool dds_compress_set_format(uint fourcc)
+{
+	switch (fourcc) {
+		case FOURCC_DXT1:
+			compress_dds = dds_compress_bc1;
+			COMPRESS_BLOCK_SIZE = 8;
+			return true;
+		case FOURCC_DXT5:
+			compress_dds = dds_compress_bc3;
+			COMPRESS_BLOCK_SIZE = 16;
+			return true;
+		case FOURCC_DX10:
+			compress_dds = dds_compress_bc7;
+			COMPRESS_BLOCK_SIZE = 16;
+			return true;
+		default:
+			return false;
+	}
+}
+
+// blocks that stick out past the edge of the surface repeat its last row and column
+static void dds_compress_blocks(const dds_compress_band &band)
+{
+	const uint blocks_wide = (band.width + 3) / 4;
+	ubyte *dst = band.dst;
+	dds_block_pixels block;
+
+	for (uint by = band.first_row; by < band.first_row + band.num_rows; ++by) {
+		for (uint bx = 0; bx < blocks_wide; ++bx) {
+			for (uint i = 0; i < 4; ++i) {
+				const uint y = std::min(by * 4 + i, band.height - 1);
+
+				for (uint j = 0; j < 4; ++j) {
+					const uint x = std::min(bx * 4 + j, band.width - 1);
+					memcpy(block[i * 4 + j], band.src + (static_cast<size_t>(y) * band.width + x) * 4, 4);
+				}
+			}
+
+			compress_dds(block, dst);
+			dst += COMPRESS_BLOCK_SIZE;
+		}
+	}
+}
+
+// queue up a surface for dds_compress_run_queue(), returns the size of its blocks
+static size_t dds_compress_queue(const ubyte *src, ubyte *dst, uint width, uint height)
+{
+	const uint blocks_wide = (width + 3) / 4;
+	const uint blocks_high = (height + 3) / 4;
+	const uint band_blocks_high = std::max(1U, DDS_COMPRESS_BAND_BLOCKS / blocks_wide);
+
+	for (uint i = 0; i < blocks_high; i += band_blocks_high) {
+		dds_compress_band band;
+
+		band.src = src;
+		band.dst = dst + static_cast<size_t>(i) * blocks_wide * COMPRESS_BLOCK_SIZE;
+		band.width = width;
+		band.height = height;
+		band.first_row = i;
+		band.num_rows = std::min(band_blocks_high, blocks_high - i);
+
+		Dds_compress_bands.push_back(band);
+	}
+
+	Dds_compress_queued_blocks += static_cast<size_t>(blocks_wide) * blocks_high;
+
+	return static_cast<size_t>(blocks_wide) * blocks_high * COMPRESS_BLOCK_SIZE;
+}
+
+// compress everything queued up so far, split between this thread and the task pool if there is enough of it
+static void dds_compress_run_queue()
+{
+	// too little work to be worth waking up the worker threads for is done right here
+	size_t min_threaded_bands = (Dds_compress_queued_blocks >= DDS_COMPRESS_MIN_THREADED_BLOCKS) ? 2 : SIZE_MAX;
+
+	threading::parallel_for(Dds_compress_bands.size(), min_threaded_bands, [](size_t i) {
+		dds_compress_blocks(Dds_compress_bands[i]);
+	});
+
+	Dds_compress_bands.clear();
+	Dds_compress_queued_blocks = 0;
+}
+
+void dds_compress(uint fourcc, const ubyte *src, ubyte *dst, uint width, uint height)
+{
+	TRACE_SCOPE(tracing::DDSCompress);
+
+	if ( !dds_compress_set_format(fourcc) ) {
+		Error(LOCATION, "Invalid FourCC (%d) for DDS compression!", fourcc);
+		return;
+	}
+
+	dds_compress_queue(src, dst, width, height);
+	dds_compress_run_queue();
+}
+
+size_t dds_compressed_size(uint fourcc, uint width, uint height, int num_mipmaps)
+{
+	const size_t block_size = (fourcc == FOURCC_DXT1) ? 8 : 16;
+	size_t size = 0;
+
+	for (int i = 0; i < num_mipmaps; ++i) {
+		const uint w = std::max(1U, width >> i);
+		const uint h = std::max(1U, height >> i);
+
+		size += ((w + 3) / 4) * ((h + 3) / 4) * block_size;
+	}
+
+	return size;
+}
+
+uint dds_compressed_cache_format(bool alpha)
+{
+	// without hardware support the compressed copy would just be decompressed again when it is read
+	if ( !GLAD_GL_EXT_texture_compression_s3tc ) {
+		return 0;
+	}
+
+	if ( !alpha ) {
+		return FOURCC_DXT1;
+	}
+
+	return GLAD_GL_ARB_texture_compression_bptc ? FOURCC_DX10 : FOURCC_DXT5;
+}
+
+// box filter, an odd row or column is folded into the last pixel
+static void dds_compress_downsample(const ubyte *src, uint width, uint height, ubyte *dst)
+{
+	const uint d_width = std::max(1U, width / 2);
+	const uint d_height = std::max(1U, height / 2);
+
+	for (uint y = 0; y < d_height; ++y) {
+		const uint y0 = std::min(y * 2, height - 1);
+		const uint y1 = std::min(y * 2 + 1, height - 1);
+
+		for (uint x = 0; x < d_width; ++x) {
+			const uint x0 = std::min(x * 2, width - 1);
+			const uint x1 = std::min(x * 2 + 1, width - 1);
+
+			for (uint c = 0; c < 4; ++c) {
+				const uint sum = src[(y0 * width + x0) * 4 + c] + src[(y0 * width + x1) * 4 + c]
+					+ src[(y1 * width + x0) * 4 + c] + src[(y1 * width + x1) * 4 + c];
+
+				dst[(y * d_width + x) * 4 + c] = static_cast<ubyte>((sum + 2) / 4);
+			}
+		}
+	}
+}
+
+bool dds_save_compressed_image(const char *filename, uint fourcc, const ubyte *data, uint width, uint height)
+{
+	TRACE_SCOPE(tracing::DDSCompress);
+
+	Assert(filename != nullptr);
+	Assert(data != nullptr);
+
+	if ( !dds_compress_set_format(fourcc) ) {
+		Error(LOCATION, "Invalid FourCC (%d) for DDS compression!", fourcc);
+		return false;
+	}
+
+	int num_mipmaps = 1;
+
+	while ((width >> num_mipmaps) > 0 || (height >> num_mipmaps) > 0) {
+		++num_mipmaps;
+	}
+
+	// make all of the mipmap levels first, and then compress them together so that the small ones share the worker
+	// threads too
+	SCP_vector<SCP_vector<ubyte>> mipmaps(num_mipmaps - 1);
+	SCP_vector<ubyte> blocks(dds_compressed_size(fourcc, width, height, num_mipmaps));
+
+	const ubyte *level = data;
+	size_t offset = 0;
+
+	for (int i = 0; i < num_mipmaps; ++i) {
+		const uint w = std::max(1U, width >> i);
+		const uint h = std::max(1U, height >> i);
+
+		offset += dds_compress_queue(level, blocks.data() + offset, w, h);
+
+		if (i + 1 < num_mipmaps) {
+			mipmaps[i].resize(static_cast<size_t>(std::max(1U, w / 2)) * std::max(1U, h / 2) * 4);
+			dds_compress_downsample(level, w, h, mipmaps[i].data());
+			level = mipmaps[i].data();
+		}
+	}
+
+	dds_compress_run_queue();
+
+	CFILE *image = cfopen(filename, "wb", CF_TYPE_CACHE);
+
+	if (image == nullptr) {
+		mprintf(("Unable to open %s for saving a compressed texture!\n", filename));
+		return false;
+	}
+
+	DDS_HEADER dds_header;
+	memset(&dds_header, 0, sizeof(DDS_HEADER));
+
+	dds_header.dwSize				= 124;
+	dds_header.dwFlags				= DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE;
+	dds_header.dwHeight				= height;
+	dds_header.dwWidth				= width;
+	dds_header.dwPitchOrLinearSize	= static_cast<uint>(dds_compressed_size(fourcc, width, height, 1));
+	dds_header.dwMipMapCount		= num_mipmaps;
+
+	dds_header.ddspf.dwSize			= 32;
+	dds_header.ddspf.dwFlags		= DDPF_FOURCC;
+	dds_header.ddspf.dwFourCC		= fourcc;
+
+	dds_header.dwCaps				= DDSCAPS_TEXTURE | DDSCAPS_COMPLEX | DDSCAPS_MIPMAP;
+
+	uint dds_id = DDS_FILECODE;
+	cfwrite(&dds_id, 1, 4, image);
+	cfwrite(&dds_header, 1, sizeof(DDS_HEADER), image);
+
+	if (fourcc == FOURCC_DX10) {
+		DDS_HEADER_DXT10 dx10_header;
+		memset(&dx10_header, 0, sizeof(DDS_HEADER_DXT10));
+
+		dx10_header.dxgiFormat			= DXGI_FORMAT::DXGI_FORMAT_BC7_UNORM;
+		dx10_header.resourceDimension	= D3D10_RESOURCE_DIMENSION::D3D10_RESOURCE_DIMENSION_TEXTURE2D;
+		dx10_header.arraySize			= 1;
+
+		cfwrite(&dx10_header, 1, sizeof(DDS_HEADER_DXT10), image);
+	}
+
+	cfwrite(blocks.data(), 1, static_cast<int>(blocks.size()), image);
+	cfclose(image);
+
+	return true;
+}
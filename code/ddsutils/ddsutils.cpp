@@ -2,6 +2,8 @@
 #include "ddsutils/ddsutils.h"
 #include "cfile/cfile.h"
 #include "osapi/osregistry.h"
+#include "tracing/tracing.h"
+#include "utils/threading.h"
 
 #ifdef WITH_OPENGL
 #include <glad/glad.h>
@@ -15,6 +17,11 @@ PUSH_SUPPRESS_WARNINGS
 #include "ddsutils/bcdec.h"
 POP_SUPPRESS_WARNINGS
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DDS_DECOMPRESS_SSE2
+#include <emmintrin.h>
+#endif
+
 /*	Currently supported formats:
  *		DXT1a	(compressed)
  *		DXT1c	(compressed)
@@ -406,9 +413,268 @@ Done:
 	return retval;
 }
 
+// Decompression to BGRA
+//
+// The block decoders write BGRA directly, so the converted data needs no swizzle pass afterwards. Their block writes
+// have the same layout and order as the bcdec ones, including the rows that spill past the end of the surface when it
+// isn't a multiple of 4 pixels wide.
+
+// split large surfaces into bands of about this many blocks for the worker threads
+#define DDS_DECOMPRESS_BAND_BLOCKS			4096
+
+// fewer blocks than this (a 512x512 texture) aren't worth waking up the worker threads for
+#define DDS_DECOMPRESS_MIN_THREADED_BLOCKS	16384
+
 static void (*decompress_dds)(const void *in, void *out, int pitch) = nullptr;
 static uint32_t BLOCK_SIZE = 0;
 
+typedef struct dds_decompress_band {
+	const ubyte *src;
+	ubyte *dst;
+	uint width;			// in pixels, a multiple of 4
+	uint height;		// in pixels, a multiple of 4
+} dds_decompress_band;
+
+static SCP_vector<dds_decompress_band> Dds_decompress_bands;
+static size_t Dds_decompress_queued_blocks = 0;
+
+// Same math as bcdec__color_block(), with red and blue trading places in the reference colors
+static inline void dds_decompress_color_block(const ubyte *in, ubyte *out, int pitch, bool only_opaque)
+{
+	ushort c0, c1;
+	uint indices;
+	uint ref_colors[4];	// 0xAARRGGBB
+	uint r0, g0, b0, r1, g1, b1, r, g, b;
+
+	memcpy(&c0, in, sizeof(c0));
+	memcpy(&c1, in + 2, sizeof(c1));
+	memcpy(&indices, in + 4, sizeof(indices));
+
+	r0 = (c0 >> 11) & 0x1F;
+	g0 = (c0 >> 5) & 0x3F;
+	b0 = c0 & 0x1F;
+
+	r1 = (c1 >> 11) & 0x1F;
+	g1 = (c1 >> 5) & 0x3F;
+	b1 = c1 & 0x1F;
+
+	r = (r0 * 527 + 23) >> 6;
+	g = (g0 * 259 + 33) >> 6;
+	b = (b0 * 527 + 23) >> 6;
+	ref_colors[0] = 0xFF000000 | (r << 16) | (g << 8) | b;
+
+	r = (r1 * 527 + 23) >> 6;
+	g = (g1 * 259 + 33) >> 6;
+	b = (b1 * 527 + 23) >> 6;
+	ref_colors[1] = 0xFF000000 | (r << 16) | (g << 8) | b;
+
+	if (c0 > c1 || only_opaque) {
+		r = ((2 * r0 + r1) * 351 + 61) >> 7;
+		g = ((2 * g0 + g1) * 2763 + 1039) >> 11;
+		b = ((2 * b0 + b1) * 351 + 61) >> 7;
+		ref_colors[2] = 0xFF000000 | (r << 16) | (g << 8) | b;
+
+		r = ((r0 + r1 * 2) * 351 + 61) >> 7;
+		g = ((g0 + g1 * 2) * 2763 + 1039) >> 11;
+		b = ((b0 + b1 * 2) * 351 + 61) >> 7;
+		ref_colors[3] = 0xFF000000 | (r << 16) | (g << 8) | b;
+	} else {
+		// BC1 with 1-bit alpha, the last color is transparent black
+		r = ((r0 + r1) * 1053 + 125) >> 8;
+		g = ((g0 + g1) * 4145 + 1019) >> 11;
+		b = ((b0 + b1) * 1053 + 125) >> 8;
+		ref_colors[2] = 0xFF000000 | (r << 16) | (g << 8) | b;
+
+		ref_colors[3] = 0x00000000;
+	}
+
+#ifdef DDS_DECOMPRESS_SSE2
+	// Every lane masks out the 2 index bits of its own pixel in a row and then picks the reference color that matches
+	// them, so a whole row is written at once
+	const __m128i lane_bits = _mm_setr_epi32(0x03, 0x0C, 0x30, 0xC0);
+	const __m128i index1 = _mm_setr_epi32(0x01, 0x04, 0x10, 0x40);
+	const __m128i index2 = _mm_setr_epi32(0x02, 0x08, 0x20, 0x80);
+
+	const __m128i color0 = _mm_set1_epi32(static_cast<int>(ref_colors[0]));
+	const __m128i color1 = _mm_set1_epi32(static_cast<int>(ref_colors[1]));
+	const __m128i color2 = _mm_set1_epi32(static_cast<int>(ref_colors[2]));
+	const __m128i color3 = _mm_set1_epi32(static_cast<int>(ref_colors[3]));
+
+	for (int i = 0; i < 4; ++i) {
+		const __m128i row = _mm_and_si128(_mm_set1_epi32(static_cast<int>(indices >> (i * 8))), lane_bits);
+
+		__m128i pixels = _mm_and_si128(_mm_cmpeq_epi32(row, _mm_setzero_si128()), color0);
+		pixels = _mm_or_si128(pixels, _mm_and_si128(_mm_cmpeq_epi32(row, index1), color1));
+		pixels = _mm_or_si128(pixels, _mm_and_si128(_mm_cmpeq_epi32(row, index2), color2));
+		pixels = _mm_or_si128(pixels, _mm_and_si128(_mm_cmpeq_epi32(row, lane_bits), color3));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(out + i * pitch), pixels);
+	}
+#else
+	for (int i = 0; i < 4; ++i) {
+		uint row[4];
+
+		for (int j = 0; j < 4; ++j) {
+			row[j] = ref_colors[indices & 0x03];
+			indices >>= 2;
+		}
+
+		memcpy(out + i * pitch, row, sizeof(row));
+	}
+#endif
+}
+
+static void dds_decompress_bc1(const void *in, void *out, int pitch)
+{
+	dds_decompress_color_block(static_cast<const ubyte *>(in), static_cast<ubyte *>(out), pitch, false);
+}
+
+static void dds_decompress_bc2(const void *in, void *out, int pitch)
+{
+	// alpha is the 4th byte in both RGBA and BGRA, so the bcdec alpha blocks work as they are
+	dds_decompress_color_block(static_cast<const ubyte *>(in) + 8, static_cast<ubyte *>(out), pitch, true);
+	bcdec__sharp_alpha_block(in, static_cast<ubyte *>(out) + 3, pitch);
+}
+
+static void dds_decompress_bc3(const void *in, void *out, int pitch)
+{
+	dds_decompress_color_block(static_cast<const ubyte *>(in) + 8, static_cast<ubyte *>(out), pitch, true);
+	bcdec__smooth_alpha_block(in, static_cast<ubyte *>(out) + 3, pitch, 4);
+}
+
+static void dds_decompress_bc7(const void *in, void *out, int pitch)
+{
+	// BC7 is decoded by bcdec, so swap red and blue while the block is still in the cache. Rows of a block overlap
+	// in surfaces less than 4 pixels wide, so the swap has to happen before the rows are written out.
+	ubyte block[4 * 4 * 4];
+
+	bcdec_bc7(in, block, 4 * 4);
+
+	for (int i = 0; i < 4; ++i) {
+#ifdef DDS_DECOMPRESS_SSE2
+		const __m128i rgba = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i * 16));
+		const __m128i ga = _mm_and_si128(rgba, _mm_set1_epi32(static_cast<int>(0xFF00FF00)));
+		const __m128i rb = _mm_and_si128(rgba, _mm_set1_epi32(0x00FF00FF));
+		const __m128i bgra = _mm_or_si128(ga, _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16)));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(static_cast<ubyte *>(out) + i * pitch), bgra);
+#else
+		uint row[4];
+
+		memcpy(row, block + i * 16, sizeof(row));
+
+		for (auto &pixel : row) {
+			const uint rb = pixel & 0x00FF00FF;
+			pixel = (pixel & 0xFF00FF00) | (rb << 16) | (rb >> 16);
+		}
+
+		memcpy(static_cast<ubyte *>(out) + i * pitch, row, sizeof(row));
+#endif
+	}
+}
+
+static bool dds_decompress_set_format(uint fourcc)
+{
+	switch (fourcc) {
+		case FOURCC_DX10:
+			decompress_dds = dds_decompress_bc7;
+			BLOCK_SIZE = BCDEC_BC7_BLOCK_SIZE;
+			return true;
+		case FOURCC_DXT5:
+			decompress_dds = dds_decompress_bc3;
+			BLOCK_SIZE = BCDEC_BC3_BLOCK_SIZE;
+			return true;
+		case FOURCC_DXT1:
+			decompress_dds = dds_decompress_bc1;
+			BLOCK_SIZE = BCDEC_BC1_BLOCK_SIZE;
+			return true;
+		case FOURCC_DXT3:
+			decompress_dds = dds_decompress_bc2;
+			BLOCK_SIZE = BCDEC_BC2_BLOCK_SIZE;
+			return true;
+		default:
+			return false;
+	}
+}
+
+static void dds_decompress_blocks(const ubyte *src, ubyte *dst, uint width, uint height)
+{
+	const int pitch = static_cast<int>(width * 4);
+
+	for (uint i = 0; i < height; i += 4) {
+		for (uint j = 0; j < width; j += 4) {
+			decompress_dds(src, dst + ((i * width + j) * 4), pitch);
+			src += BLOCK_SIZE;
+		}
+	}
+}
+
+// Queue up a surface for dds_decompress_run_queue(), returns how much compressed data it has
+//
+// Surfaces that aren't a multiple of 4 pixels in size are done right away. Their blocks write past the end of the
+// surface, which is fine as long as whatever comes after it is written later on, and queued surfaces always are.
+static size_t dds_decompress_queue(const ubyte *src, ubyte *dst, uint width, uint height, uint depth)
+{
+	const uint blocks_wide = (width + 3) / 4;
+	const uint blocks_high = (height + 3) / 4;
+	const size_t slice_size = static_cast<size_t>(blocks_wide) * blocks_high * BLOCK_SIZE;
+
+	for (uint d = 0; d < depth; ++d) {
+		const ubyte *slice_src = src + d * slice_size;
+		ubyte *slice_dst = dst + static_cast<size_t>(d) * width * height * 4;
+
+		if ((width % 4) != 0 || (height % 4) != 0) {
+			dds_decompress_blocks(slice_src, slice_dst, width, height);
+			continue;
+		}
+
+		const uint band_blocks_high = std::max(1U, DDS_DECOMPRESS_BAND_BLOCKS / blocks_wide);
+
+		for (uint i = 0; i < blocks_high; i += band_blocks_high) {
+			dds_decompress_band band;
+
+			band.src = slice_src + static_cast<size_t>(i) * blocks_wide * BLOCK_SIZE;
+			band.dst = slice_dst + static_cast<size_t>(i) * 4 * width * 4;
+			band.width = width;
+			band.height = std::min(band_blocks_high, blocks_high - i) * 4;
+
+			Dds_decompress_bands.push_back(band);
+		}
+
+		Dds_decompress_queued_blocks += static_cast<size_t>(blocks_wide) * blocks_high;
+	}
+
+	return slice_size * depth;
+}
+
+// decompress everything queued up so far, split between this thread and the task pool if there is enough of it
+static void dds_decompress_run_queue()
+{
+	// too little work to be worth waking up the worker threads for is done right here
+	size_t min_threaded_bands = (Dds_decompress_queued_blocks >= DDS_DECOMPRESS_MIN_THREADED_BLOCKS) ? 2 : SIZE_MAX;
+
+	threading::parallel_for(Dds_decompress_bands.size(), min_threaded_bands, [](size_t i) {
+		const auto &band = Dds_decompress_bands[i];
+		dds_decompress_blocks(band.src, band.dst, band.width, band.height);
+	});
+
+	Dds_decompress_bands.clear();
+	Dds_decompress_queued_blocks = 0;
+}
+
+void dds_decompress(uint fourcc, const ubyte *src, ubyte *dst, uint width, uint height, uint depth)
+{
+	TRACE_SCOPE(tracing::DDSDecompress);
+
+	if ( !dds_decompress_set_format(fourcc) ) {
+		Error(LOCATION, "Invalid FourCC (%d) for DDS decompression!", fourcc);
+		return;
+	}
+
+	dds_decompress_queue(src, dst, width, height, depth);
+	dds_decompress_run_queue();
+}
+
 //reads pixel info from a dds file
 int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp, int cf_type)
 {
@@ -457,8 +723,9 @@ int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp, int cf_type)
 
 		cfread(comp_data, 1, (int)size, cfp);
 
-		ubyte *src = comp_data;
-		ubyte *dst = data;
+		TRACE_SCOPE(tracing::DDSDecompress);
+
+		const ubyte *src = comp_data;
 
 		uint d_width, d_height, d_depth;
 		size_t data_offset = 0;
@@ -470,26 +737,8 @@ int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp, int cf_type)
 		const int num_faces = (dds_header.dwCaps2 & DDSCAPS2_CUBEMAP) ? 6 : 1;
 		const bool has_depth = (dds_header.dwFlags & DDSD_DEPTH) == DDSD_DEPTH;
 
-		switch (dds_header.ddspf.dwFourCC) {
-			case FOURCC_DX10:
-				decompress_dds = bcdec_bc7;
-				BLOCK_SIZE = BCDEC_BC7_BLOCK_SIZE;
-				break;
-			case FOURCC_DXT5:
-				decompress_dds = bcdec_bc3;
-				BLOCK_SIZE = BCDEC_BC3_BLOCK_SIZE;
-				break;
-			case FOURCC_DXT1:
-				decompress_dds = bcdec_bc1;
-				BLOCK_SIZE = BCDEC_BC1_BLOCK_SIZE;
-				break;
-			case FOURCC_DXT3:
-				decompress_dds = bcdec_bc2;
-				BLOCK_SIZE = BCDEC_BC2_BLOCK_SIZE;
-				break;
-			default:
-				Error(LOCATION, "Invalid FourCC (%d) for DDS decompression!", dds_header.ddspf.dwFourCC);
-				break;
+		if ( !dds_decompress_set_format(dds_header.ddspf.dwFourCC) ) {
+			Error(LOCATION, "Invalid FourCC (%d) for DDS decompression!", dds_header.ddspf.dwFourCC);
 		}
 
 		for (int f = 0; f < num_faces; ++f) {
@@ -508,29 +757,16 @@ int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp, int cf_type)
 				d_height = std::max(1U, dds_header.dwHeight >> (m - mipmap_offset));
 				d_depth = std::max(1U, dds_header.dwDepth >> (m - mipmap_offset));
 
-				for (uint d = 0; d < d_depth; ++d) {
-					auto depth_offset = d * d_width * d_height * 4;
-
-					for (uint i = 0; i < d_height; i += 4) {
-						for (uint j = 0; j < d_width; j += 4) {
-							dst = data + data_offset + depth_offset + ((i * d_width + j) * 4);
-
-							decompress_dds(src, dst, d_width * 4);
-							src += BLOCK_SIZE;
-						}
-					}
-				}
-
-				// we need it in bgra, XOR to the rescue
-				for (size_t x = data_offset; x < (data_offset + (d_width * d_height * d_depth * 4)); x += 4) {
-					data[x] ^= data[x+2], data[x+2] ^= data[x], data[x] ^= data[x+2];
-				}
+				src += dds_decompress_queue(src, data + data_offset, d_width, d_height, d_depth);
 
 				// bump data offset to next layer
 				data_offset += (d_width * d_height * d_depth * 4);
 			}
 		}
 
+		// all faces and mipmaps are decompressed together so that the small ones share the worker threads too
+		dds_decompress_run_queue();
+
 		vm_free(comp_data);
 		comp_data = nullptr;
 
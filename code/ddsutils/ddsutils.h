@@ -285,6 +285,25 @@ int dds_read_header(const char *filename, CFILE *img_cfp = NULL, int *width = 0,
 //size of the data it stored in size
 int dds_read_bitmap(const char *filename, ubyte *data, ubyte *bpp = NULL, int cf_type = CF_TYPE_ANY);
 
+//decompresses one BC1/BC2/BC3 (FOURCC_DXT1/3/5) or BC7 (FOURCC_DX10) surface to BGRA
+//large surfaces are split up between the worker threads
+void dds_decompress(uint fourcc, const ubyte *src, ubyte *dst, uint width, uint height, uint depth = 1);
+
+//compresses one BGRA surface to BC1/BC3 (FOURCC_DXT1/5) or BC7 mode 6 (FOURCC_DX10), see ddscompress.cpp
+void dds_compress(uint fourcc, const ubyte *src, ubyte *dst, uint width, uint height);
+
+//size of the blocks of a compressed surface and its first num_mipmaps mipmap levels
+size_t dds_compressed_size(uint fourcc, uint width, uint height, int num_mipmaps);
+
+//bump this whenever dds_compress() changes its output, so that older cached copies are made again
+#define DDS_COMPRESS_VERSION	1
+
+//the compressed format to cache an image in, or 0 if the hardware can't use compressed textures
+uint dds_compressed_cache_format(bool alpha);
+
+//compresses a BGRA image with a full mipmap chain and saves it in the cache directory
+bool dds_save_compressed_image(const char *filename, uint fourcc, const ubyte *data, uint width, uint height);
+
 // writes a DDS file using given data
 void dds_save_image(int width, int height, int bpp, int num_mipmaps, ubyte *data = NULL, int cubemap = 0, const char *filename = NULL);
 
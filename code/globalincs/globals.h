@@ -60,7 +60,7 @@
 #define MAX_COMPLETE_ESCORT_LIST	20
              
 // from weapon.h
-#define MAX_WEAPONS	3000		//Increased from 2000 to 3000 in 2022
+#define MAX_WEAPONS	MAX_OBJECTS		//Weapons[] grows as needed, so this is only the upper limit
 
 #define MAX_WEAPON_TYPES				500
 
@@ -72,8 +72,8 @@
 #define MAX_POLYGON_MODELS  300
 
 // object.h
-//If this value exceeds 2^16-1, this will break collision pair caching as is. Proceed with caution.
-#define MAX_OBJECTS			5000	//Increased from 3500 to 5000 in 2022	
+//Objects[] grows in chunks as needed, so this is only the upper limit on object numbers
+#define MAX_OBJECTS			32768	//Increased from 3500 to 5000 in 2022, and made growable after that
 
 // from weapon.h (and beam.h)
 #define MAX_BEAM_SECTIONS				5
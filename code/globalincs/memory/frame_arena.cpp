@@ -0,0 +1,132 @@
+#include "globalincs/memory/frame_arena.h"
+
+#include "tracing/Monitor.h"
+
+#include <atomic>
+
+MONITOR(FrameArenaAllocations)
+MONITOR(FrameArenaBytes)
+MONITOR(FrameArenaChunks)
+
+namespace {
+
+const size_t FRAME_ARENA_CHUNK_SIZE = 256 * 1024;
+
+struct frame_arena_chunk {
+	ubyte* data;
+	size_t size;
+};
+
+struct frame_arena {
+	SCP_vector<frame_arena_chunk> chunks;
+	size_t current = 0;				// the chunk that is being allocated from
+	size_t offset = 0;				// where the next allocation starts in that chunk
+	void* last = nullptr;			// the last allocation, which can be given back
+	uint generation = 0;
+
+	~frame_arena()
+	{
+		for (auto& chunk : chunks) {
+			vm_free(chunk.data);
+		}
+	}
+
+	void reset(uint new_generation)
+	{
+		// If the last frame needed several chunks, replace them with one that fits all of it
+		if (chunks.size() > 1) {
+			size_t total = 0;
+			for (auto& chunk : chunks) {
+				total += chunk.size;
+				vm_free(chunk.data);
+			}
+
+			chunks.clear();
+			chunks.push_back(frame_arena_chunk{ static_cast<ubyte*>(vm_malloc(total)), total });
+		}
+
+		current = 0;
+		offset = 0;
+		last = nullptr;
+		generation = new_generation;
+	}
+};
+
+thread_local frame_arena Frame_arena;
+
+std::atomic<uint> Frame_arena_generation(1);
+
+std::atomic<size_t> Frame_arena_allocations(0);
+std::atomic<size_t> Frame_arena_bytes(0);
+std::atomic<size_t> Frame_arena_chunks(0);
+
+memory::frame_arena_stats Frame_arena_last_stats;
+
+}
+
+namespace memory {
+
+void* frame_arena_allocate(size_t size, size_t alignment)
+{
+	auto& arena = Frame_arena;
+
+	auto generation = Frame_arena_generation.load(std::memory_order_acquire);
+	if (arena.generation != generation) {
+		arena.reset(generation);
+	}
+
+	Frame_arena_allocations.fetch_add(1, std::memory_order_relaxed);
+	Frame_arena_bytes.fetch_add(size, std::memory_order_relaxed);
+
+	while (true) {
+		for (; arena.current < arena.chunks.size(); ++arena.current, arena.offset = 0) {
+			auto& chunk = arena.chunks[arena.current];
+			auto start = (arena.offset + alignment - 1) & ~(alignment - 1);
+
+			if (start + size <= chunk.size) {
+				arena.offset = start + size;
+				arena.last = chunk.data + start;
+				return arena.last;
+			}
+		}
+
+		// Out of space, so this frame gets another chunk that is large enough for the allocation
+		auto chunk_size = std::max(FRAME_ARENA_CHUNK_SIZE, size + alignment);
+		arena.chunks.push_back(frame_arena_chunk{ static_cast<ubyte*>(vm_malloc(chunk_size)), chunk_size });
+		arena.current = arena.chunks.size() - 1;
+		arena.offset = 0;
+
+		Frame_arena_chunks.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void frame_arena_deallocate(void* ptr, size_t /*size*/) noexcept
+{
+	auto& arena = Frame_arena;
+
+	// Only the last allocation of this thread can be given back, which lets a growing container reuse its memory
+	if (ptr != nullptr && ptr == arena.last && arena.generation == Frame_arena_generation.load(std::memory_order_relaxed)) {
+		arena.offset = static_cast<size_t>(static_cast<ubyte*>(ptr) - arena.chunks[arena.current].data);
+		arena.last = nullptr;
+	}
+}
+
+void frame_arena_reset()
+{
+	Frame_arena_last_stats.allocations = Frame_arena_allocations.exchange(0, std::memory_order_relaxed);
+	Frame_arena_last_stats.bytes = Frame_arena_bytes.exchange(0, std::memory_order_relaxed);
+	Frame_arena_last_stats.chunks = Frame_arena_chunks.exchange(0, std::memory_order_relaxed);
+
+	mon_FrameArenaAllocations = static_cast<int>(Frame_arena_last_stats.allocations);
+	mon_FrameArenaBytes = static_cast<int>(Frame_arena_last_stats.bytes);
+	mon_FrameArenaChunks = static_cast<int>(Frame_arena_last_stats.chunks);
+
+	Frame_arena_generation.fetch_add(1, std::memory_order_release);
+}
+
+const frame_arena_stats& frame_arena_last_frame_stats()
+{
+	return Frame_arena_last_stats;
+}
+
+}
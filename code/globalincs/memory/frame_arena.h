@@ -0,0 +1,30 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+namespace memory {
+
+// Every thread bump allocates its frame memory (see SCP_frame_allocator in vmallocator.h) out of its own chunks of
+// memory. Resetting the arenas doesn't touch the other threads, each arena resets itself on its next allocation. The
+// chunks are kept across frames, so after the first few frames no frame memory comes from the heap anymore.
+
+struct frame_arena_stats {
+	size_t allocations = 0;		// allocations made during the frame, on all threads
+	size_t bytes = 0;			// bytes requested during the frame
+	size_t chunks = 0;			// chunks that had to be taken from the heap during the frame
+};
+
+/**
+ * @brief Ends the current frame for the frame arenas
+ *
+ * All memory handed out by the frame arenas before this call becomes invalid once the thread it came from allocates
+ * again. Must be called by the main thread while no other thread uses frame memory.
+ */
+void frame_arena_reset();
+
+/**
+ * @brief The numbers of the frame that was ended by the last call to frame_arena_reset()
+ */
+const frame_arena_stats& frame_arena_last_frame_stats();
+
+}
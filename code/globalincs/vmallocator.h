@@ -175,6 +175,63 @@ public:
 	}
 };
 
+// Containers for data that is built and thrown away within one frame. Their memory comes from a per-thread arena that
+// is reset once per frame (see globalincs/memory/frame_arena.h), so they must never outlive the frame they were
+// created in. Freeing memory only gives it back if it was the last allocation of the arena.
+namespace memory {
+void* frame_arena_allocate(size_t size, size_t alignment);
+void frame_arena_deallocate(void* ptr, size_t size) noexcept;
+}
+
+template <typename T>
+struct SCP_frame_allocator
+{
+	typedef T value_type;
+
+	SCP_frame_allocator() noexcept = default;
+	template <typename U>
+	SCP_frame_allocator(const SCP_frame_allocator<U>&) noexcept {}
+
+	T* allocate(size_t n) { return static_cast<T*>(memory::frame_arena_allocate(n * sizeof(T), alignof(T))); }
+	void deallocate(T* ptr, size_t n) noexcept { memory::frame_arena_deallocate(ptr, n * sizeof(T)); }
+};
+
+template <typename T, typename U>
+bool operator==(const SCP_frame_allocator<T>&, const SCP_frame_allocator<U>&) { return true; }
+template <typename T, typename U>
+bool operator!=(const SCP_frame_allocator<T>&, const SCP_frame_allocator<U>&) { return false; }
+
+template <typename T>
+class SCP_frame_vector : public std::vector<T, SCP_frame_allocator<T>>
+{
+public:
+	using std::vector<T, SCP_frame_allocator<T>>::vector;	// inherit all constructors
+
+	// see SCP_vector
+	inline auto size() const noexcept { return std::vector<T, SCP_frame_allocator<T>>::size(); }
+
+	bool contains(const T& item) const
+	{
+		return std::find(this->begin(), this->end(), item) != this->end();
+	}
+
+	bool in_bounds(int idx) const
+	{
+		return (idx >= 0) && (static_cast<size_t>(idx) < this->size());
+	}
+
+	bool in_bounds(size_t idx) const
+	{
+		return idx < this->size();
+	}
+};
+
+template <typename T, typename U>
+using SCP_frame_map = std::map<T, U, std::less<T>, SCP_frame_allocator<std::pair<const T, U>>>;
+
+template <typename Key, typename T, typename Hash = SCP_hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using SCP_frame_unordered_map = std::unordered_map<Key, T, Hash, KeyEqual, SCP_frame_allocator<std::pair<const Key, T>>>;
+
 template <typename T, typename... Args>
 typename std::enable_if<!std::is_array<T>::value, std::unique_ptr<T>>::type make_unique(Args&&... args) {
 	return std::unique_ptr<T>(new T(std::forward<Args>(args)...));
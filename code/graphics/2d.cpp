@@ -2940,6 +2940,9 @@ void gr_flip(bool execute_scripting)
 	// Use this opportunity for retiring the uniform buffers
 	uniform_buffer_managers_retire_buffers();
 
+	// Unload the textures that haven't been used for the longest time if there are too many
+	bm_end_frame();
+
 	TRACE_SCOPE(tracing::PageFlip);
 
 	//Prevent a real page flip if OpenXR is on and claims that that wasn't the full image yet
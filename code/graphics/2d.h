@@ -842,7 +842,7 @@ typedef struct screen {
 
 	// new drawing functions
 	std::function<
-		void(model_material* material_info, indexed_vertex_source* vert_source, vertex_buffer* bufferp, size_t texi)>
+		void(model_material* material_info, indexed_vertex_source* vert_source, vertex_buffer* bufferp, size_t texi, int n_instances)>
 		gf_render_model;
 	std::function<void(shield_material* material_info,
 		primitive_type prim_type,
@@ -1251,9 +1251,9 @@ inline void gr_render_movie(movie_material* material_info,
 	gr_screen.gf_render_movie(material_info, prim_type, layout, n_verts, buffer, buffer_offset);
 }
 
-inline void gr_render_model(model_material* material_info, indexed_vertex_source *vert_source, vertex_buffer* bufferp, size_t texi)
+inline void gr_render_model(model_material* material_info, indexed_vertex_source *vert_source, vertex_buffer* bufferp, size_t texi, int n_instances = 1)
 {
-	gr_screen.gf_render_model(material_info, vert_source, bufferp, texi);
+	gr_screen.gf_render_model(material_info, vert_source, bufferp, texi, n_instances);
 }
 
 inline void gr_render_rocket_primitives(interface_material* material_info,
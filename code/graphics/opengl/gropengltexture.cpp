@@ -300,6 +300,10 @@ int opengl_free_texture(tcache_slot_opengl *t)
 	// First mark this as unused and then check if all frames are unused. If that's the case we can free the texture array
 	t->used = false;
 
+	if (t->bitmap_handle >= 0) {
+		bm_set_resident_size(t->bitmap_handle, 0);
+	}
+
 	// Check if the bitmap handle is valid
 	if (t->bitmap_handle >= 0) {
 		int num_frames = 0;
@@ -726,6 +730,8 @@ static int opengl_texture_set_level(int bitmap_handle, int bitmap_type, int bmap
 
 	GL_textures_in_frame += tSlot->size;
 
+	bm_set_resident_size(bitmap_handle, tSlot->size);
+
 	GL_CHECK_FOR_ERRORS("end of create_texture_sub()");
 
 	return ret_val;
@@ -1131,6 +1137,8 @@ int gr_opengl_tcache_set_internal(int bitmap_handle, int bitmap_type, float *u_s
 
 	// everything went ok
 	if (ret_val && t->texture_id) {
+		bm_mark_used(bitmap_handle);
+
 		*u_scale = t->u_scale;
 		*v_scale = t->v_scale;
 		*array_index = t->array_index;
@@ -581,7 +581,7 @@ void opengl_tnl_shutdown()
 	opengl_destroy_all_buffers();
 }
 
-void opengl_render_model_program(model_material* material_info, indexed_vertex_source *vert_source, vertex_buffer* bufferp, buffer_data *datap)
+void opengl_render_model_program(model_material* material_info, indexed_vertex_source *vert_source, vertex_buffer* bufferp, buffer_data *datap, int n_instances)
 {
 	GL_state.Texture.SetShaderMode(GL_TRUE);
 
@@ -608,6 +608,16 @@ void opengl_render_model_program(model_material* material_info, indexed_vertex_s
 										  ibuffer + datap->index_offset,
 										  4,
 										  (GLint) (vert_source->Base_vertex_offset + bufferp->vertex_num_offset));
+	} else if (n_instances > 1) {
+		// the shader picks the transforms of each instance from the transform buffer
+		Assertion(!Rendering_to_shadow_map, "Instanced models can't be rendered to the shadow map!");
+
+		glDrawElementsInstancedBaseVertex(GL_TRIANGLES,
+										  (GLsizei) datap->n_verts,
+										  element_type,
+										  ibuffer + datap->index_offset,
+										  n_instances,
+										  (GLint) (vert_source->Base_vertex_offset + bufferp->vertex_num_offset));
 	} else {
 		if (Cmdline_drawelements) {
 			glDrawElementsBaseVertex(GL_TRIANGLES,
@@ -630,7 +640,7 @@ void opengl_render_model_program(model_material* material_info, indexed_vertex_s
 	GL_state.Texture.SetShaderMode(GL_FALSE);
 }
 
-void gr_opengl_render_model(model_material* material_info, indexed_vertex_source *vert_source, vertex_buffer* bufferp, size_t texi)
+void gr_opengl_render_model(model_material* material_info, indexed_vertex_source *vert_source, vertex_buffer* bufferp, size_t texi, int n_instances)
 {
 	Verify(bufferp != NULL);
 
@@ -638,7 +648,7 @@ void gr_opengl_render_model(model_material* material_info, indexed_vertex_source
 
 	buffer_data *datap = &bufferp->tex_buf[texi];
 
-	opengl_render_model_program(material_info, vert_source, bufferp, datap);
+	opengl_render_model_program(material_info, vert_source, bufferp, datap, n_instances);
 
 	GL_CHECK_FOR_ERRORS("end of render_buffer()");
 }
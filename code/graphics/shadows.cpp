@@ -19,7 +19,9 @@
 #include "model/modelrender.h"
 #include "options/Option.h"
 #include "render/3d.h"
+#include "tracing/Monitor.h"
 #include "tracing/tracing.h"
+#include "utils/threading.h"
 
 extern vec3d check_offsets[8];
 
@@ -34,6 +36,15 @@ ShadowQuality Shadow_quality = ShadowQuality::Disabled;
 
 bool Shadow_quality_uses_mod_option = false; 
 
+// objects are culled against the cascades in chunks of this many, and only split between threads if there are enough chunks
+#define SHADOW_CULL_CHUNK_SIZE				128
+#define SHADOW_CULL_MIN_THREADED_CHUNKS		4
+
+// the cascades (as a bitmask) that each object casts a shadow into, indexed by object number
+static SCP_vector<ubyte> Shadow_caster_cascades;
+
+MONITOR(NumShadowCasters)
+
 static void parse_shadow_quality_func()
 {
 	SCP_string mode;
@@ -75,6 +86,20 @@ auto ShadowQualityOption = options::OptionBuilder<ShadowQuality>("Graphics.Shado
                      .parser(parse_shadow_quality_func)
                      .finish();
 
+// pos_rot is the center of the sphere, relative to the eye and rotated into the light's frame
+static inline bool shadows_sphere_in_frustum(const vec3d *pos_rot, float radius, const vec3d *min, const vec3d *max)
+{
+	if ( (pos_rot->xyz.x - radius) > max->xyz.x 
+		|| (pos_rot->xyz.x + radius) < min->xyz.x 
+		|| (pos_rot->xyz.y - radius) > max->xyz.y 
+		|| (pos_rot->xyz.y + radius) < min->xyz.y 
+		|| (pos_rot->xyz.z - radius) > max->xyz.z ) {
+		return false;
+	}
+
+	return true;
+}
+
 bool shadows_obj_in_frustum(object *objp, matrix *light_orient, vec3d *min, vec3d *max)
 {
 	vec3d pos, pos_rot;
@@ -82,15 +107,56 @@ bool shadows_obj_in_frustum(object *objp, matrix *light_orient, vec3d *min, vec3
 	vm_vec_sub(&pos, &objp->pos, &Eye_position);
 	vm_vec_rotate(&pos_rot, &pos, light_orient);
 
-	if ( (pos_rot.xyz.x - objp->radius) > max->xyz.x 
-		|| (pos_rot.xyz.x + objp->radius) < min->xyz.x 
-		|| (pos_rot.xyz.y - objp->radius) > max->xyz.y 
-		|| (pos_rot.xyz.y + objp->radius) < min->xyz.y 
-		|| (pos_rot.xyz.z - objp->radius) > max->xyz.z ) {
-		return false;
+	return shadows_sphere_in_frustum(&pos_rot, objp->radius, min, max);
+}
+
+// Finds all the cascades an object casts a shadow into, rotating it into the light's frame only once for all of them
+static ubyte shadows_obj_cascade_mask(const object *objp, const matrix *light_orient)
+{
+	switch (objp->type) {
+		case OBJ_RAW_POF:
+		case OBJ_SHIP:
+		case OBJ_ASTEROID:
+		case OBJ_DEBRIS:
+			break;
+
+		default:
+			return 0;
 	}
 
-	return true;
+	vec3d pos, pos_rot;
+	ubyte mask = 0;
+
+	vm_vec_sub(&pos, &objp->pos, &Eye_position);
+	vm_vec_rotate(&pos_rot, &pos, light_orient);
+
+	for ( int j = 0; j < MAX_SHADOW_CASCADES; ++j ) {
+		if ( shadows_sphere_in_frustum(&pos_rot, objp->radius, &Shadow_frustums[j].min, &Shadow_frustums[j].max) ) {
+			mask |= (1 << j);
+		}
+	}
+
+	return mask;
+}
+
+// split between this thread and the task pool if there are enough objects
+void shadows_cull_casters(const matrix *light_matrix, SCP_vector<ubyte> &cascades)
+{
+	TRACE_SCOPE(tracing::CullShadowCasters);
+
+	const int num_objects = Highest_object_index + 1;
+	const size_t num_chunks = static_cast<size_t>((num_objects + SHADOW_CULL_CHUNK_SIZE - 1) / SHADOW_CULL_CHUNK_SIZE);
+
+	cascades.resize(num_objects);
+
+	threading::parallel_for(num_chunks, SHADOW_CULL_MIN_THREADED_CHUNKS, [&](size_t i) {
+		int start = static_cast<int>(i) * SHADOW_CULL_CHUNK_SIZE;
+		int end = std::min(start + SHADOW_CULL_CHUNK_SIZE, num_objects);
+
+		for (int objnum = start; objnum < end; ++objnum) {
+			cascades[objnum] = shadows_obj_cascade_mask(&Objects[objnum], light_matrix);
+		}
+	});
 }
 
 void shadows_construct_light_proj(light_frustum_info *shadow_data)
@@ -489,23 +555,19 @@ void shadows_render_all(fov_t fov, matrix *eye_orient, vec3d *eye_pos)
 	// maybe we could use a more programmatic algorithim? 
 	matrix light_matrix = shadows_start_render(eye_orient, eye_pos, fov, gr_screen.clip_aspect, std::get<0>(Shadow_distances), std::get<1>(Shadow_distances), std::get<2>(Shadow_distances), std::get<3>(Shadow_distances));
 
-	model_draw_list scene;
-	object *objp = Objects;
-
-	for ( int i = 0; i <= Highest_object_index; i++, objp++ ) {
-		bool cull = true;
+	// all the cascades are drawn in one pass, so an object is queued once if it's in any of them
+	shadows_cull_casters(&light_matrix, Shadow_caster_cascades);
 
-		for ( int j = 0; j < MAX_SHADOW_CASCADES; ++j ) {
-			if ( shadows_obj_in_frustum(objp, &light_matrix, &Shadow_frustums[j].min, &Shadow_frustums[j].max) ) {
-				cull = false;
-				break;
-			}
-		}
-
-		if ( cull ) {
+	model_draw_list scene;
+	for ( int i = 0; i <= Highest_object_index; i++ ) {
+		if ( Shadow_caster_cascades[i] == 0 ) {
 			continue;
 		}
 
+		object *objp = &Objects[i];
+
+		MONITOR_INC(NumShadowCasters, 1);
+
 		switch(objp->type)
 		{
 		case OBJ_RAW_POF:
@@ -38,11 +38,15 @@ extern bool Shadow_quality_uses_mod_option;
 
 extern matrix4 Shadow_proj_matrix[MAX_SHADOW_CASCADES];
 extern float Shadow_cascade_distances[MAX_SHADOW_CASCADES];
+extern light_frustum_info Shadow_frustums[MAX_SHADOW_CASCADES];
 
 void shadows_construct_light_frustum(vec3d *min_out, vec3d *max_out, vec3d light_vec, matrix *orient, vec3d *pos, fov_t fov, float aspect, float z_near, float z_far);
-bool shadows_obj_in_frustum(object *objp, vec3d *min, vec3d *max, matrix *light_orient);
+bool shadows_obj_in_frustum(object *objp, matrix *light_orient, vec3d *min, vec3d *max);
 void shadows_render_all(fov_t fov, matrix *eye_orient, vec3d *eye_pos);
 
+// Finds the cascades (as a bitmask) that each object casts a shadow into, indexed by object number
+void shadows_cull_casters(const matrix *light_matrix, SCP_vector<ubyte> &cascades);
+
 matrix shadows_start_render(matrix *eye_orient, vec3d *eye_pos, fov_t fov, float aspect, float veryneardist, float neardist, float middist, float fardist);
 void shadows_end_render();
 
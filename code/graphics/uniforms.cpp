@@ -187,6 +187,9 @@ void convert_model_material(model_uniform_data* data_out,
 		data_out->buffer_matrix_offset = (int) transform_buffer_offset;
 	}
 
+	// only set by model_draw_list for instanced draws
+	data_out->instance_matrix_stride = 0;
+
 	// Team colors are passed to the shader here, but the shader needs to handle their application.
 	// By default, this is handled through the r and g channels of the misc map, but this can be changed
 	// in the shader; test versions of this used the normal map r and b channels
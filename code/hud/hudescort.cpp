@@ -503,7 +503,7 @@ void HudGaugeEscort::renderIconDogfight(int x, int y, int index)
 
 	// can we get the player object?
 	objp = NULL;
-	if((Net_players[np_index].m_player->objnum >= 0) && (Net_players[np_index].m_player->objnum < MAX_OBJECTS) && (Objects[Net_players[np_index].m_player->objnum].type == OBJ_SHIP)){
+	if((Net_players[np_index].m_player->objnum >= 0) && (Net_players[np_index].m_player->objnum < (int)Objects.size()) && (Objects[Net_players[np_index].m_player->objnum].type == OBJ_SHIP)){
 		objp = &Objects[Net_players[np_index].m_player->objnum];
 		if((objp->instance >= 0) && (objp->instance < MAX_SHIPS) && (Ships[objp->instance].ship_info_index >= 0) && (Ships[objp->instance].ship_info_index < MAX_SHIPS)){
 			//
@@ -627,8 +627,8 @@ void hud_create_complete_escort_list()
 	// all others 
 	else {
 		for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
-			Assert( so->objnum >= 0 && so->objnum < MAX_OBJECTS);
-			if((so->objnum < 0) || (so->objnum >= MAX_OBJECTS)){
+			Assert( so->objnum >= 0 && so->objnum < (int)Objects.size());
+			if((so->objnum < 0) || (so->objnum >= (int)Objects.size())){
 				continue;
 			}
 			objp = &Objects[so->objnum];
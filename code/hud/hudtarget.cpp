@@ -496,8 +496,8 @@ void hud_maybe_set_sorted_turret_subsys(ship *shipp)
 		return;
 	}
 
-	Assert((Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < MAX_OBJECTS));
-	if (!((Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < MAX_OBJECTS))) {
+	Assert((Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < (int)Objects.size()));
+	if (!((Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < (int)Objects.size()))) {
 		return;
 	}
 
@@ -2387,7 +2387,7 @@ void hud_target_targets_target()
 	object *tt_objp = NULL;
 	int		tt_objnum;
 
-	if ( Player_ai->target_objnum < 0 || Player_ai->target_objnum >= MAX_OBJECTS ) {
+	if ( Player_ai->target_objnum < 0 || Player_ai->target_objnum >= (int)Objects.size() ) {
 		goto ttt_fail;
 	}
 
@@ -2397,7 +2397,7 @@ void hud_target_targets_target()
 	}
 
 	tt_objnum = Ai_info[Ships[objp->instance].ai_index].target_objnum;
-	if ( tt_objnum < 0 || tt_objnum >= MAX_OBJECTS ) {
+	if ( tt_objnum < 0 || tt_objnum >= (int)Objects.size() ) {
 		goto ttt_fail;
 	}
 
@@ -3211,7 +3211,7 @@ void hud_process_homing_missiles()
 		if (A->flags[Object::Object_Flags::Should_be_dead])
 			continue;
 
-		Assert((A->instance >= 0) && (A->instance < MAX_WEAPONS));
+		Assert((A->instance >= 0) && (A->instance < (int)Weapons.size()));
 		wp = &Weapons[A->instance];
 
 		if (wp->homing_object == Player_obj) {
@@ -3302,7 +3302,7 @@ void HudGaugeMissileTriangles::render(float /*frametime*/, bool config)
 		if (A->flags[Object::Object_Flags::Should_be_dead])
 			continue;
 
-		Assert((A->instance >= 0) && (A->instance < MAX_WEAPONS));
+		Assert((A->instance >= 0) && (A->instance < (int)Weapons.size()));
 		wp = &Weapons[A->instance];
 
 		if (wp->homing_object == Player_obj) {
@@ -3367,7 +3367,7 @@ void hud_process_remote_detonate_missile()
 
 	// check for currently locked missiles (highest precedence)
 	for ( mo = GET_FIRST(&Missile_obj_list); mo != END_OF_LIST(&Missile_obj_list); mo = GET_NEXT(mo) ) {
-		Assert(mo->objnum >= 0 && mo->objnum < MAX_OBJECTS);
+		Assert(mo->objnum >= 0 && mo->objnum < (int)Objects.size());
 		mobjp = &Objects[mo->objnum];
 		if (mobjp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
@@ -4651,7 +4651,7 @@ void hud_cease_subsystem_targeting(bool print_message)
 {
 	int ship_index;
 
-	Assertion(Player_ai->target_objnum < MAX_OBJECTS, "Invalid player target objnum");
+	Assertion(Player_ai->target_objnum < (int)Objects.size(), "Invalid player target objnum");
 
 	if (Player_ai->target_objnum < 0) {
 		// Nothing selected
@@ -4771,7 +4771,7 @@ void hud_target_change_check()
 		}
 
 		player_stop_cargo_scan_sound();
-		if ( (Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < MAX_OBJECTS) ) {
+		if ( (Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < (int)Objects.size()) ) {
 			hud_shield_hit_reset(&Objects[Player_ai->target_objnum]);
 		}
 		hud_targetbox_init_flash();
@@ -4796,7 +4796,7 @@ void hud_target_change_check()
 
 		hud_lock_reset();
 
-		if ( (Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < MAX_OBJECTS) ) {
+		if ( (Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < (int)Objects.size()) ) {
 			if ( Objects[Player_ai->target_objnum].type == OBJ_SHIP ) {
 				hud_restore_subsystem_target(&Ships[Objects[Player_ai->target_objnum].instance]);
 			}
@@ -4817,7 +4817,7 @@ void hud_target_change_check()
 			Player_ai->current_target_dist_trend = NO_CHANGE;
 		}
 
-		if ( (Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < MAX_OBJECTS) ) {
+		if ( (Player_ai->target_objnum >= 0) && (Player_ai->target_objnum < (int)Objects.size()) ) {
 			current_speed = Objects[Player_ai->target_objnum].phys_info.speed;
 		}
 
@@ -5577,9 +5577,9 @@ void hud_target_last_transmit()
 	// Was just bogus code in the call to hud_restore_subsystem_target(). -- MK, 9/15/99, 1:59 pm.
 	int targeted_objnum;
 	targeted_objnum = Transmit_target_list[transmit_index].objnum;
-	Assert((targeted_objnum >= 0) && (targeted_objnum < MAX_OBJECTS));
+	Assert((targeted_objnum >= 0) && (targeted_objnum < (int)Objects.size()));
 
-	if ((targeted_objnum >= 0) && (targeted_objnum < MAX_OBJECTS)) {
+	if ((targeted_objnum >= 0) && (targeted_objnum < (int)Objects.size())) {
 		set_target_objnum( Player_ai, Transmit_target_list[transmit_index].objnum );
 		hud_shield_hit_reset(&Objects[Transmit_target_list[transmit_index].objnum]);
 		hud_restore_subsystem_target(&Ships[Objects[Transmit_target_list[transmit_index].objnum].instance]);
@@ -5593,7 +5593,7 @@ void hud_target_last_transmit_add(int ship_num)
 	int		ship_objnum;
 
 	ship_objnum = Ships[ship_num].objnum;
-	Assert(ship_objnum >= 0 && ship_objnum < MAX_OBJECTS);
+	Assert(ship_objnum >= 0 && ship_objnum < (int)Objects.size());
 	ship_objp = &Objects[ship_objnum];
 	Assert(ship_objp->type == OBJ_SHIP);
 
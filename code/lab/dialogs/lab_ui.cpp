@@ -832,7 +832,7 @@ void LabUi::build_subsystem_list_entry(SCP_string& subsys_name,
 		sprintf(node_name, "Destroy system##%s", subsys_name.c_str());
 
 		if (Button(node_name.c_str())) {
-			cur_subsys->current_hits = 0;
+			ship_subsys_set_hits(shipp, cur_subsys, 0.0f);
 			do_subobj_destroyed_stuff(shipp, cur_subsys, nullptr);
 		}
 	}
@@ -584,6 +584,12 @@ bool light_compare_by_type(const light &a, const light &b)
 	return a.type < b.type;
 }
 
+// below this many point and tube lights, testing all of them is cheaper than building the grid
+#define LIGHT_GRID_MIN_LIGHTS			16
+#define LIGHT_GRID_MAX_DIM				32
+// lights covering more cells than this are tested by every filter instead of being listed in the cells
+#define LIGHT_GRID_MAX_LIGHT_CELLS		64
+
 void scene_lights::addLight(const light *light_ptr)
 {
 	Assert(light_ptr != NULL);
@@ -593,61 +599,253 @@ void scene_lights::addLight(const light *light_ptr)
 	if ( light_ptr->type == Light_Type::Directional ) {
 		StaticLightIndices.push_back(AllLights.size() - 1);
 	}
+
+	LightGridDirty = true;
+}
+
+// whether a light reaches the sphere at pos
+static bool light_affects_sphere(const light *l, const vec3d *pos, float rad)
+{
+	float dist_squared, max_dist_squared;
+
+	switch ( l->type ) {
+		case Light_Type::Point:
+			dist_squared = vm_vec_dist_squared(&l->vec, pos);
+			break;
+
+		case Light_Type::Tube: {
+			vec3d nearest;
+			vm_vec_dist_squared_to_line(pos, &l->vec, &l->vec2, &nearest, &dist_squared);
+		}
+		break;
+
+		default:
+			return false;
+	}
+
+	max_dist_squared = l->radb+rad;
+	max_dist_squared *= max_dist_squared;
+
+	return dist_squared < max_dist_squared;
+}
+
+void scene_lights::lightGridCell(const vec3d *pos, int cell[3]) const
+{
+	for ( int axis = 0; axis < 3; ++axis ) {
+		int c = static_cast<int>((pos->a1d[axis] - LightGridMin.a1d[axis]) * LightGridScale.a1d[axis]);
+		CLAMP(c, 0, LightGridDims[axis] - 1);
+		cell[axis] = c;
+	}
+}
+
+void scene_lights::buildLightGrid()
+{
+	LightGridDirty = false;
+	LightGridEnabled = false;
+
+	LightGridCellStart.clear();
+	LightGridCellLights.clear();
+	LightGridLargeLights.clear();
+	LightBoundsMin.resize(AllLights.size());
+	LightBoundsMax.resize(AllLights.size());
+
+	LightFilterStamps.assign(AllLights.size(), 0);
+	LightFilterStamp = 0;
+
+	size_t num_local = 0;
+	float total_radius = 0.0f;
+
+	vm_vec_make(&LightGridMin, FLT_MAX, FLT_MAX, FLT_MAX);
+	vm_vec_make(&LightGridMax, -FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+	for ( size_t i = 0; i < AllLights.size(); ++i ) {
+		const auto &l = AllLights[i];
+		auto &bmin = LightBoundsMin[i];
+		auto &bmax = LightBoundsMax[i];
+
+		if ( l.type == Light_Type::Point ) {
+			bmin = l.vec;
+			bmax = l.vec;
+		} else if ( l.type == Light_Type::Tube ) {
+			vm_vec_min(&bmin, &l.vec, &l.vec2);
+			vm_vec_max(&bmax, &l.vec, &l.vec2);
+		} else {
+			continue;
+		}
+
+		for ( int axis = 0; axis < 3; ++axis ) {
+			bmin.a1d[axis] -= l.radb;
+			bmax.a1d[axis] += l.radb;
+
+			LightGridMin.a1d[axis] = MIN(LightGridMin.a1d[axis], bmin.a1d[axis]);
+			LightGridMax.a1d[axis] = MAX(LightGridMax.a1d[axis], bmax.a1d[axis]);
+		}
+
+		++num_local;
+		total_radius += l.radb;
+	}
+
+	if ( num_local < LIGHT_GRID_MIN_LIGHTS ) {
+		return;
+	}
+
+	// about one cell per light, but no smaller than the average light so that most lights only touch a few cells
+	vec3d extent;
+	vm_vec_sub(&extent, &LightGridMax, &LightGridMin);
+
+	float volume = MAX(extent.xyz.x, 1.0f) * MAX(extent.xyz.y, 1.0f) * MAX(extent.xyz.z, 1.0f);
+	float cell_size = MAX(powf(volume / num_local, 1.0f / 3.0f), total_radius / num_local);
+
+	size_t num_cells = 1;
+	for ( int axis = 0; axis < 3; ++axis ) {
+		int dim = static_cast<int>(ceilf(extent.a1d[axis] / cell_size));
+		CLAMP(dim, 1, LIGHT_GRID_MAX_DIM);
+
+		LightGridDims[axis] = dim;
+		LightGridScale.a1d[axis] = (extent.a1d[axis] > 0.0f) ? dim / extent.a1d[axis] : 0.0f;
+		num_cells *= dim;
+	}
+
+	// count the lights per cell first so that all cells can share one array
+	LightGridCellStart.assign(num_cells + 1, 0);
+
+	for ( int pass = 0; pass < 2; ++pass ) {
+		for ( size_t i = 0; i < AllLights.size(); ++i ) {
+			if ( AllLights[i].type != Light_Type::Point && AllLights[i].type != Light_Type::Tube ) {
+				continue;
+			}
+
+			int lo[3], hi[3];
+			lightGridCell(&LightBoundsMin[i], lo);
+			lightGridCell(&LightBoundsMax[i], hi);
+
+			if ( (hi[0] - lo[0] + 1) * (hi[1] - lo[1] + 1) * (hi[2] - lo[2] + 1) > LIGHT_GRID_MAX_LIGHT_CELLS ) {
+				if ( pass == 0 ) {
+					LightGridLargeLights.push_back(static_cast<uint>(i));
+				}
+				continue;
+			}
+
+			for ( int z = lo[2]; z <= hi[2]; ++z ) {
+				for ( int y = lo[1]; y <= hi[1]; ++y ) {
+					for ( int x = lo[0]; x <= hi[0]; ++x ) {
+						size_t cell = (static_cast<size_t>(z) * LightGridDims[1] + y) * LightGridDims[0] + x;
+
+						if ( pass == 0 ) {
+							++LightGridCellStart[cell + 1];
+						} else {
+							LightGridCellLights[LightGridCellStart[cell]++] = static_cast<uint>(i);
+						}
+					}
+				}
+			}
+		}
+
+		if ( pass == 0 ) {
+			for ( size_t cell = 0; cell < num_cells; ++cell ) {
+				LightGridCellStart[cell + 1] += LightGridCellStart[cell];
+			}
+			LightGridCellLights.resize(LightGridCellStart[num_cells]);
+		} else {
+			// filling the cells moved each start to the start of the next cell
+			for ( size_t cell = num_cells; cell > 0; --cell ) {
+				LightGridCellStart[cell] = LightGridCellStart[cell - 1];
+			}
+			LightGridCellStart[0] = 0;
+		}
+	}
+
+	LightGridEnabled = true;
 }
 
 void scene_lights::setLightFilter(const vec3d *pos, float rad)
 {
-	size_t i = 0;
 	// clear out current filtered lights
 	FilteredLights.clear();
 
-	for ( auto& l : AllLights ) {
-		switch ( l.type ) {
-			case Light_Type::Directional:
-				++i;
-				continue;
-			case Light_Type::Point: {
-				vec3d to_light;
-				float dist_squared, max_dist_squared;
-				vm_vec_sub( &to_light, &l.vec, pos );
-				dist_squared = vm_vec_mag_squared(&to_light);
+	if ( LightGridDirty ) {
+		buildLightGrid();
+	}
 
-				max_dist_squared = l.radb+rad;
-				max_dist_squared *= max_dist_squared;
+	int lo[3], hi[3];
+	bool use_grid = LightGridEnabled;
 
-				if ( dist_squared < max_dist_squared )	{
-					FilteredLights.push_back(i);
-				}
+	if ( use_grid ) {
+		vec3d filter_min, filter_max;
+		bool outside_grid = false;
+
+		for ( int axis = 0; axis < 3; ++axis ) {
+			filter_min.a1d[axis] = pos->a1d[axis] - rad;
+			filter_max.a1d[axis] = pos->a1d[axis] + rad;
+
+			if ( filter_max.a1d[axis] < LightGridMin.a1d[axis] || filter_min.a1d[axis] > LightGridMax.a1d[axis] ) {
+				outside_grid = true;
 			}
-			break;
-			case Light_Type::Tube: {
-				vec3d nearest;
-				float dist_squared, max_dist_squared;
-				vm_vec_dist_squared_to_line(pos,&l.vec,&l.vec2,&nearest,&dist_squared);
+		}
 
-				max_dist_squared = l.radb+rad;
-				max_dist_squared *= max_dist_squared;
+		if ( outside_grid ) {
+			// only the large lights could reach the object, so there are no cells to look at
+			lo[0] = lo[1] = lo[2] = 0;
+			hi[0] = hi[1] = hi[2] = -1;
+		} else {
+			lightGridCell(&filter_min, lo);
+			lightGridCell(&filter_max, hi);
 
-				if ( dist_squared < max_dist_squared ) {
-					FilteredLights.push_back(i);
-				}
+			// an object that spans most of the grid is better off testing every light
+			size_t num_filter_cells = static_cast<size_t>(hi[0] - lo[0] + 1) * (hi[1] - lo[1] + 1) * (hi[2] - lo[2] + 1);
+			if ( num_filter_cells > AllLights.size() ) {
+				use_grid = false;
 			}
-			break;
+		}
+	}
+
+	if ( !use_grid ) {
+		for ( size_t i = 0; i < AllLights.size(); ++i ) {
+			if ( light_affects_sphere(&AllLights[i], pos, rad) ) {
+				FilteredLights.push_back(i);
+			}
+		}
+		return;
+	}
+
+	if ( ++LightFilterStamp == 0 ) {
+		std::fill(LightFilterStamps.begin(), LightFilterStamps.end(), 0);
+		LightFilterStamp = 1;
+	}
+
+	for ( int z = lo[2]; z <= hi[2]; ++z ) {
+		for ( int y = lo[1]; y <= hi[1]; ++y ) {
+			for ( int x = lo[0]; x <= hi[0]; ++x ) {
+				size_t cell = (static_cast<size_t>(z) * LightGridDims[1] + y) * LightGridDims[0] + x;
+
+				for ( uint j = LightGridCellStart[cell]; j < LightGridCellStart[cell + 1]; ++j ) {
+					uint i = LightGridCellLights[j];
 
-			case Light_Type::Cone:
-				break;
+					if ( LightFilterStamps[i] == LightFilterStamp ) {
+						continue;
+					}
+					LightFilterStamps[i] = LightFilterStamp;
 
-			default:
-				break;
+					if ( light_affects_sphere(&AllLights[i], pos, rad) ) {
+						FilteredLights.push_back(i);
+					}
+				}
+			}
+		}
+	}
+
+	for ( auto i : LightGridLargeLights ) {
+		if ( light_affects_sphere(&AllLights[i], pos, rad) ) {
+			FilteredLights.push_back(i);
 		}
-		++i;
 	}
+
+	// keep the order the lights were added in, same as without the grid
+	std::sort(FilteredLights.begin(), FilteredLights.end());
 }
 
 light_indexing_info scene_lights::bufferLights()
 {
-	size_t i;
-
 	light_indexing_info light_info;
 
 	light_info.index_start = 0;
@@ -658,14 +856,18 @@ light_indexing_info scene_lights::bufferLights()
 		return light_info;
 	}
 
-	light_info.index_start = BufferedLights.size();
-	
-	for ( i = 0; i < FilteredLights.size(); ++i ) {
-		BufferedLights.push_back(FilteredLights[i]);
+	// the submodels of an object usually end up with the same lights, so reuse what was buffered for the last one
+	if ( LastBufferedLights.num_lights == FilteredLights.size()
+		&& std::equal(FilteredLights.begin(), FilteredLights.end(), BufferedLights.begin() + LastBufferedLights.index_start) ) {
+		return LastBufferedLights;
 	}
 
+	light_info.index_start = BufferedLights.size();
+	BufferedLights.insert(BufferedLights.end(), FilteredLights.begin(), FilteredLights.end());
 	light_info.num_lights = FilteredLights.size();
 
+	LastBufferedLights = light_info;
+
 	return light_info;
 }
 
@@ -75,9 +75,30 @@ class scene_lights
 	SCP_vector<size_t> FilteredLights;
 
 	SCP_vector<size_t> BufferedLights;
+	light_indexing_info LastBufferedLights = { 0, 0 };
 
 	size_t current_light_index;
 	size_t current_num_lights;
+
+	// A uniform grid over the areas of effect of the point and tube lights, so that setLightFilter only needs to test
+	// the lights near the object. It's built by the first filter after lights were added. Each cell lists the lights
+	// touching it, lights that cover too many cells are tested for every filter instead.
+	bool LightGridDirty = true;
+	bool LightGridEnabled = false;
+	vec3d LightGridMin, LightGridMax;
+	vec3d LightGridScale;						// cells per unit along each axis
+	int LightGridDims[3] = { 0, 0, 0 };
+	SCP_vector<uint> LightGridCellStart;		// where each cell starts in LightGridCellLights, one extra at the end
+	SCP_vector<uint> LightGridCellLights;
+	SCP_vector<uint> LightGridLargeLights;
+	SCP_vector<vec3d> LightBoundsMin, LightBoundsMax;
+
+	// lights that were already tested by the current filter, since a light can be listed in several cells
+	SCP_vector<uint> LightFilterStamps;
+	uint LightFilterStamp = 0;
+
+	void buildLightGrid();
+	void lightGridCell(const vec3d *pos, int cell[3]) const;
 public:
 	scene_lights()
 	{
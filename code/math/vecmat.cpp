@@ -11,7 +11,8 @@
 
 #include <cstdio>
 #include <numeric>
-#if _M_IX86_FP >= 1
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#define VM_BATCH_SSE
 	#include <xmmintrin.h>
 #endif
 
@@ -1059,6 +1060,70 @@ vec3d *vm_vec_unrotate(vec3d *dest, const vec3d *src, const matrix *m)
 	return dest;
 }
 
+// The batch functions below work on four points at a time, which are loaded as three registers and shuffled
+// into one register per component.  Anything past the last group of four goes through the scalar code.
+static_assert(sizeof(vec3d) == 3 * sizeof(float), "The batch functions require tightly packed vectors!");
+
+#ifdef VM_BATCH_SSE
+static inline void vm_batch_load4(const vec3d *src, __m128 &x, __m128 &y, __m128 &z)
+{
+	const float *f = &src->xyz.x;
+	__m128 a = _mm_loadu_ps(f);		// x0 y0 z0 x1
+	__m128 b = _mm_loadu_ps(f + 4);	// y1 z1 x2 y2
+	__m128 c = _mm_loadu_ps(f + 8);	// z2 x3 y3 z3
+
+	x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+	y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+	z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+static inline void vm_batch_store4(vec3d *dest, __m128 x, __m128 y, __m128 z)
+{
+	float *f = &dest->xyz.x;
+
+	_mm_storeu_ps(f, _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+	_mm_storeu_ps(f + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+	_mm_storeu_ps(f + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+#endif
+
+// dest[i] = m * src[i] + add, where each row of m gives one component of the result
+static void vm_vec_transform_n(vec3d *dest, const vec3d *src, size_t n, const matrix *m, const vec3d *add)
+{
+	size_t i = 0;
+
+#ifdef VM_BATCH_SSE
+	const __m128 m00 = _mm_set1_ps(m->a2d[0][0]), m01 = _mm_set1_ps(m->a2d[0][1]), m02 = _mm_set1_ps(m->a2d[0][2]);
+	const __m128 m10 = _mm_set1_ps(m->a2d[1][0]), m11 = _mm_set1_ps(m->a2d[1][1]), m12 = _mm_set1_ps(m->a2d[1][2]);
+	const __m128 m20 = _mm_set1_ps(m->a2d[2][0]), m21 = _mm_set1_ps(m->a2d[2][1]), m22 = _mm_set1_ps(m->a2d[2][2]);
+	const __m128 ax = _mm_set1_ps(add->xyz.x), ay = _mm_set1_ps(add->xyz.y), az = _mm_set1_ps(add->xyz.z);
+
+	for (; i + 4 <= n; i += 4) {
+		__m128 x, y, z;
+		vm_batch_load4(&src[i], x, y, z);
+
+		__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), _mm_add_ps(_mm_mul_ps(m02, z), ax));
+		__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), _mm_add_ps(_mm_mul_ps(m12, z), ay));
+		__m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, x), _mm_mul_ps(m21, y)), _mm_add_ps(_mm_mul_ps(m22, z), az));
+
+		vm_batch_store4(&dest[i], rx, ry, rz);
+	}
+#endif
+
+	for (; i < n; ++i) {
+		dest[i] = (*m) * src[i] + *add;
+	}
+}
+
+// transforms n points from the local space of an object at pos/orient to world space
+void vm_vec_unrotate_add_n(vec3d *dest, const vec3d *src, size_t n, const matrix *orient, const vec3d *pos)
+{
+	matrix mt;
+
+	vm_copy_transpose(&mt, orient);
+	vm_vec_transform_n(dest, src, n, &mt, pos);
+}
+
 //transpose a matrix in place. returns ptr to matrix
 matrix *vm_transpose(matrix *m)
 {
@@ -359,6 +359,12 @@ vec3d *vm_vec_rotate(vec3d *dest, const vec3d *src, const matrix *m);
 // vm_vec_transpose() / vm_vec_rotate() technique.
 vec3d *vm_vec_unrotate(vec3d *dest, const vec3d *src, const matrix *m);
 
+// Batch version of vm_vec_unrotate() plus an offset, vectorized where the compiler allows it, for the arrays of
+// model points that are moved to world space every frame.  dest may be the same array as src, but the two must
+// not otherwise overlap.
+// dest[i] = pos + unrotate(src[i], orient), i.e. from the local space of an object to world space
+void vm_vec_unrotate_add_n(vec3d *dest, const vec3d *src, size_t n, const matrix *orient, const vec3d *pos);
+
 //transpose a matrix in place. returns ptr to matrix
 matrix *vm_transpose(matrix *m);
 
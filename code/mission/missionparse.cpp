@@ -7917,7 +7917,7 @@ int mission_did_ship_arrive(p_object *objp, bool force_arrival)
 
 		// create the ship
 		int object_num = parse_create_object(objp);
-		Assert(object_num >= 0 && object_num < MAX_OBJECTS);
+		Assert(object_num >= 0 && object_num < (int)Objects.size());
 		
 		// Play the music track for an arrival
 		if ( !(Ships[Objects[object_num].instance].flags[Ship::Ship_Flags::No_arrival_music]) )
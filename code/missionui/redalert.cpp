@@ -629,7 +629,7 @@ void red_alert_bash_subsys_status(const red_alert_ship_status *ras, ship *shipp)
 			// using at() here for the bounds check, although out-of-bounds should
 			// probably never happen here
 			try {
-				ss->current_hits = ras->subsys_current_hits.at(count);
+				ship_subsys_set_hits(shipp, ss, ras->subsys_current_hits.at(count));
 			} catch (const std::out_of_range&) {
 				break;
 			}
@@ -177,6 +177,7 @@ EscapeKeyBehaviorInOptions Escape_key_behavior_in_options;
 bool Target_bomb_or_bomber_use_distance;
 TargetBomborBomberBehaviorOptions Target_bomb_or_bomber_behavior;
 bool Fix_asteroid_bounding_box_check;
+bool Bulk_asteroid_fields;
 bool Disable_intro_movie;
 bool Show_locked_status_scramble_missions;
 bool Disable_expensive_turret_target_check;
@@ -1611,6 +1612,10 @@ void parse_mod_table(const char *filename)
 				stuff_boolean(&Fix_asteroid_bounding_box_check);
 			}
 
+			if (optional_string("$Simulate distant asteroids in bulk:")) {
+				stuff_boolean(&Bulk_asteroid_fields);
+			}
+
 			if (optional_string("$Disable intro cutscene:")) {
 				stuff_boolean(&Disable_intro_movie);
 			}
@@ -1879,6 +1884,7 @@ void mod_table_reset()
 	Target_bomb_or_bomber_use_distance = false;
 	Target_bomb_or_bomber_behavior = TargetBomborBomberBehaviorOptions::BOMBS_AND_BOMBERS;
 	Fix_asteroid_bounding_box_check = false;
+	Bulk_asteroid_fields = false;
 	Disable_intro_movie = false;
 	Show_locked_status_scramble_missions = false;
 	Disable_expensive_turret_target_check = false;
@@ -199,6 +199,7 @@ extern EscapeKeyBehaviorInOptions Escape_key_behavior_in_options;
 extern bool Target_bomb_or_bomber_use_distance;
 extern TargetBomborBomberBehaviorOptions Target_bomb_or_bomber_behavior;
 extern bool Fix_asteroid_bounding_box_check;
+extern bool Bulk_asteroid_fields;
 extern bool Disable_intro_movie;
 extern bool Show_locked_status_scramble_missions;
 extern bool Disable_expensive_turret_target_check;
@@ -453,6 +453,8 @@ namespace animation {
 
 		submodel->canonical_prev_offset = submodel->canonical_offset;
 		submodel->canonical_offset = data.position;
+
+		submodel_instance_moved(submodel);
 		
 		vec3d delta_vec;
 		vm_vec_sub(&delta_vec, &submodel->canonical_offset, &submodel->canonical_prev_offset);
@@ -630,6 +632,8 @@ namespace animation {
 		submodel->canonical_prev_offset = submodel->canonical_offset;
 		submodel->canonical_offset = data.position;
 
+		submodel_instance_moved(submodel);
+
 		submodel->translation_axis = sm->translation_axis;
 
 		// figure out the sign of the displacement based on whether it is along or against the axis
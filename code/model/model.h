@@ -152,8 +152,25 @@ struct submodel_instance
 	//SMI-Specific movement axis. Only valid in MOVEMENT_TYPE_TRIGGERED.
 	vec3d	rotation_axis = vmd_zero_vector;
 	vec3d	translation_axis = vmd_zero_vector;
+
+	// Bumped by submodel_instance_moved() whenever canonical_orient or canonical_offset change
+	uint	transform_version = 0;
+
+	// The transform from this submodel to the whole model, filled in at most once per frame by the
+	// model_instance_* point and direction functions.  See model_instance_find_submodel_transform().
+	mutable matrix	cached_model_orient = vmd_identity_matrix;
+	mutable vec3d	cached_model_offset = vmd_zero_vector;
+	mutable int		cached_frame = -1;
+	mutable uint	cached_version = 0;
 };
 
+// Must be called after changing a submodel instance's canonical_orient or canonical_offset, so that the cached
+// transforms of it and of the submodels attached to it are rebuilt
+inline void submodel_instance_moved(submodel_instance *smi)
+{
+	++smi->transform_version;
+}
+
 #define TM_BASE_TYPE		0		// the standard base map
 #define TM_GLOW_TYPE		1		// optional glow map
 #define TM_SPECULAR_TYPE	2		// optional specular map
@@ -1153,6 +1170,11 @@ extern void model_local_to_global_point(vec3d *outpnt, const vec3d *mpnt, int mo
 // If objorient and objpos are supplied, this will be world space; otherwise it will be the model's space.
 extern void model_local_to_global_point(vec3d *outpnt, const vec3d *mpnt, const polymodel *pm, int submodel_num, const matrix *objorient = nullptr, const vec3d *objpos = nullptr);
 
+// Finds the transform from a submodel's frame of reference to the model's, taking into account submodel rotations, such that
+// a point in the model's frame is unrotate(submodel point, orient) + offset.  This is cached in the submodel instance until the
+// next frame, or until the submodel or one of its parents moves (see submodel_instance_moved).
+extern void model_instance_find_submodel_transform(matrix *orient, vec3d *offset, const polymodel *pm, const polymodel_instance *pmi, int submodel_num);
+
 // Given a point in a submodel's local frame of reference, transform it to a global frame of reference, taking into account submodel rotations.
 // If objorient and objpos are supplied, this will be world space; otherwise it will be the model's space.
 extern void model_instance_local_to_global_point(vec3d *outpnt, const vec3d *mpnt, int model_instance_num, int submodel_num, const matrix *objorient = nullptr, const vec3d *objpos = nullptr, bool use_last_frame = false);
@@ -1242,11 +1242,10 @@ int model_collide(mc_info *mc_info_obj)
 		
 		// do the same for the list of hitpoints, if necessary
 		if (Mc->flags & MC_COLLIDE_ALL) {
-			for (size_t i = 0; i < Mc->hit_points_all.size(); i++) {
-				if (Mc->flags & MC_SUBMODEL) {
-					vm_vec_unrotate(&Mc->hit_points_all[i], &Mc->hit_points_all[i], Mc->orient);
-					vm_vec_add2(&Mc->hit_points_all[i], Mc->pos);
-				} else {
+			if (Mc->flags & MC_SUBMODEL) {
+				vm_vec_unrotate_add_n(Mc->hit_points_all.data(), Mc->hit_points_all.data(), Mc->hit_points_all.size(), Mc->orient, Mc->pos);
+			} else {
+				for (size_t i = 0; i < Mc->hit_points_all.size(); i++) {
 					if (Mc_pmi) {
 						model_instance_local_to_global_point(&Mc->hit_points_all[i], &Mc->hit_points_all[i], Mc_pm, Mc_pmi, Mc->hit_submodels_all[i], Mc->orient, Mc->pos);
 					}
@@ -39,7 +39,9 @@
 #include "starfield/starfield.h"
 #include "graphics/shadows.h"
 #include "weapon/weapon.h"
+#include "tracing/Monitor.h"
 #include "tracing/tracing.h"
+#include "utils/threading.h"
 
 #define MODEL_SDR_FLAG_MODE_CPP
 #include "def_files/data/effects/model_shader_flags.h"
@@ -3612,7 +3614,7 @@ int model_load(const  char* filename, ship_info* sip, ErrorType error_type, bool
 
 int model_create_instance(int objnum, int model_num)
 {
-	Assertion(objnum > OBJNUM_SPECIAL_MIN && objnum < MAX_OBJECTS, "objnum must be -1 (none), -2 (player cockpit) or a valid object index!");
+	Assertion(objnum > OBJNUM_SPECIAL_MIN && objnum < (int)Objects.size(), "objnum must be -1 (none), -2 (player cockpit) or a valid object index!");
 
 	// this will also run a bunch of Assertions
 	auto pm = model_get(model_num);
@@ -4159,6 +4161,8 @@ void submodel_canonicalize_rotation(bsp_info *sm, submodel_instance *smi, bool c
 			vm_quaternion_rotate(&smi->canonical_orient, smi->cur_angle, &sm->rotation_axis);
 			break;
 	}
+
+	submodel_instance_moved(smi);
 }
 
 // Convert float displacement to vector, but no normalization (clamping) is needed
@@ -4185,6 +4189,8 @@ void submodel_canonicalize_translation(bsp_info *sm, submodel_instance *smi)
 			vm_vec_copy_scale(&smi->canonical_offset, &sm->translation_axis, smi->cur_offset);
 			break;
 	}
+
+	submodel_instance_moved(smi);
 }
 
 // Does stepped rotation of a submodel
@@ -4524,6 +4530,7 @@ bool model_rotate_gun(const object *objp, const polymodel *pm, const polymodel_i
 		// Pretend the base is pointing directly at the target
 		save_base_orient = base_smi->canonical_orient;
 		vm_quaternion_rotate(&base_smi->canonical_orient, desired_base_angle, &base_sm->rotation_axis);
+		submodel_instance_moved(base_smi);
 
 		//------------
 		// Project the destination point onto the turret gun plane with the base in the desired orientation
@@ -4547,6 +4554,7 @@ bool model_rotate_gun(const object *objp, const polymodel *pm, const polymodel_i
 		//------------
 		// Restore the base
 		base_smi->canonical_orient = save_base_orient;
+		submodel_instance_moved(base_smi);
 
 	} else {
 		desired_base_angle = base_smi->turret_idle_angle;
@@ -4666,6 +4674,56 @@ void model_local_to_global_point(vec3d *outpnt, const vec3d *mpnt, const polymod
 	}
 }
 
+MONITOR(SubmodelTransformHits)
+MONITOR(SubmodelTransformMisses)
+
+void model_instance_find_submodel_transform(matrix *orient, vec3d *offset, const polymodel *pm, const polymodel_instance *pmi, int submodel_num)
+{
+	Assert(pm->id == pmi->model_num);
+
+	if ( (submodel_num < 0) || (pm->submodel[submodel_num].parent < 0) ) {
+		*orient = vmd_identity_matrix;
+		*offset = vmd_zero_vector;
+		return;
+	}
+
+	auto sm = &pm->submodel[submodel_num];
+	auto smi = &pmi->submodel[submodel_num];
+
+	// the versions only ever go up, so if anything between here and the root has moved, the sum will be different
+	uint version = 0;
+	for (int mn = submodel_num; (mn >= 0) && (pm->submodel[mn].parent >= 0); mn = pm->submodel[mn].parent)
+		version += pmi->submodel[mn].transform_version;
+
+	// collisions are checked on the worker threads, which mustn't write to the cache while the main thread uses it
+	bool use_cache = !threading::is_worker_thread();
+
+	if (use_cache && smi->cached_frame == Framecount && smi->cached_version == version) {
+		MONITOR_INC(SubmodelTransformHits, 1);
+		*orient = smi->cached_model_orient;
+		*offset = smi->cached_model_offset;
+		return;
+	}
+
+	matrix parent_orient;
+	vec3d parent_offset, local_offset;
+	model_instance_find_submodel_transform(&parent_orient, &parent_offset, pm, pmi, sm->parent);
+
+	// move into the parent's frame, and from there into the model's
+	vm_vec_add(&local_offset, &smi->canonical_offset, &sm->offset);
+	vm_vec_unrotate(offset, &local_offset, &parent_orient);
+	vm_vec_add2(offset, &parent_offset);
+	*orient = smi->canonical_orient * parent_orient;
+
+	if (use_cache) {
+		MONITOR_INC(SubmodelTransformMisses, 1);
+		smi->cached_model_orient = *orient;
+		smi->cached_model_offset = *offset;
+		smi->cached_frame = Framecount;
+		smi->cached_version = version;
+	}
+}
+
 void model_instance_local_to_global_point(vec3d *outpnt, const vec3d *mpnt, int model_instance_num, int submodel_num, const matrix *objorient, const vec3d *objpos, bool use_last_frame)
 {
 	auto pmi = model_get_instance(model_instance_num);
@@ -4680,16 +4738,25 @@ void model_instance_local_to_global_point(vec3d *outpnt, const vec3d *mpnt, cons
 	int mn;
 	Assert(pm->id == pmi->model_num);
 
-	pnt = *mpnt;
-	mn = submodel_num;
+	if (use_last_frame) {
+		pnt = *mpnt;
+		mn = submodel_num;
 
-	//instance up the tree for this point
-	while ( (mn >= 0) && (pm->submodel[mn].parent >= 0) ) {
-		vm_vec_unrotate(&tpnt, &pnt, use_last_frame ? &pmi->submodel[mn].canonical_prev_orient : &pmi->submodel[mn].canonical_orient);
-		vm_vec_add(&pnt, &tpnt, use_last_frame ? &pmi->submodel[mn].canonical_prev_offset : &pmi->submodel[mn].canonical_offset);
-		vm_vec_add2(&pnt, &pm->submodel[mn].offset);
+		//instance up the tree for this point
+		while ( (mn >= 0) && (pm->submodel[mn].parent >= 0) ) {
+			vm_vec_unrotate(&tpnt, &pnt, &pmi->submodel[mn].canonical_prev_orient);
+			vm_vec_add(&pnt, &tpnt, &pmi->submodel[mn].canonical_prev_offset);
+			vm_vec_add2(&pnt, &pm->submodel[mn].offset);
 
-		mn = pm->submodel[mn].parent;
+			mn = pm->submodel[mn].parent;
+		}
+	} else {
+		matrix sm_orient;
+		vec3d sm_offset;
+		model_instance_find_submodel_transform(&sm_orient, &sm_offset, pm, pmi, submodel_num);
+
+		vm_vec_unrotate(&tpnt, mpnt, &sm_orient);
+		vm_vec_add(&pnt, &tpnt, &sm_offset);
 	}
 
 	//now instance for the entire object
@@ -4703,25 +4770,15 @@ void model_instance_local_to_global_point(vec3d *outpnt, const vec3d *mpnt, cons
 
 void model_instance_local_to_global_point_dir(vec3d *out_pnt, vec3d *out_dir, const vec3d *in_pnt, const vec3d *in_dir, const polymodel *pm, const polymodel_instance *pmi, int submodel_num, const matrix *objorient, const vec3d *objpos)
 {
-	vec3d pnt, tpnt, dir, tdir;
-	int mn;
-	Assert(pm->id == pmi->model_num);
-
-	pnt = *in_pnt;
-	dir = *in_dir;
-	mn = submodel_num;
+	vec3d pnt, tpnt, dir, sm_offset;
+	matrix sm_orient;
 
 	// instance up the tree for this point
-	while ( (mn >= 0) && (pm->submodel[mn].parent >= 0) ) {
-		vm_vec_unrotate(&tpnt, &pnt, &pmi->submodel[mn].canonical_orient);
-		vm_vec_add(&pnt, &tpnt, &pmi->submodel[mn].canonical_offset);
-		vm_vec_add2(&pnt, &pm->submodel[mn].offset);
+	model_instance_find_submodel_transform(&sm_orient, &sm_offset, pm, pmi, submodel_num);
 
-		vm_vec_unrotate(&tdir, &dir, &pmi->submodel[mn].canonical_orient);
-		dir = tdir;
-
-		mn = pm->submodel[mn].parent;
-	}
+	vm_vec_unrotate(&tpnt, in_pnt, &sm_orient);
+	vm_vec_add(&pnt, &tpnt, &sm_offset);
+	vm_vec_unrotate(&dir, in_dir, &sm_orient);
 
 	// now instance for the entire object
 	if (objorient && objpos) {
@@ -4737,25 +4794,15 @@ void model_instance_local_to_global_point_dir(vec3d *out_pnt, vec3d *out_dir, co
 
 void model_instance_local_to_global_point_orient(vec3d *outpnt, matrix *outorient, const vec3d *submodel_pnt, const matrix *submodel_orient, const polymodel *pm, const polymodel_instance *pmi, int submodel_num, const matrix *objorient, const vec3d *objpos)
 {
-	vec3d pnt, tpnt;
-	matrix orient;
-	int mn;
-	Assert(pm->id == pmi->model_num);
-
-	pnt = *submodel_pnt;
-	orient = *submodel_orient;
-	mn = submodel_num;
+	vec3d pnt, tpnt, sm_offset;
+	matrix orient, sm_orient;
 
 	// instance up the tree for this point
-	while ( (mn >= 0) && (pm->submodel[mn].parent >= 0) ) {
-		vm_vec_unrotate(&tpnt, &pnt, &pmi->submodel[mn].canonical_orient);
-		vm_vec_add(&pnt, &tpnt, &pmi->submodel[mn].canonical_offset);
-		vm_vec_add2(&pnt, &pm->submodel[mn].offset);
+	model_instance_find_submodel_transform(&sm_orient, &sm_offset, pm, pmi, submodel_num);
 
-		orient = orient * pmi->submodel[mn].canonical_orient;
-
-		mn = pm->submodel[mn].parent;
-	}
+	vm_vec_unrotate(&tpnt, submodel_pnt, &sm_orient);
+	vm_vec_add(&pnt, &tpnt, &sm_offset);
+	orient = *submodel_orient * sm_orient;
 
 	// now instance for the entire object
 	if (objorient && objpos) {
@@ -4778,6 +4825,27 @@ void model_instance_global_to_local_point(vec3d* outpnt, const vec3d* mpnt, int
 void model_instance_global_to_local_point(vec3d* outpnt, const vec3d* mpnt, const polymodel* pm, const polymodel_instance* pmi, int submodel_num, const matrix* objorient, const vec3d* objpos, bool use_last_frame) {
 	Assert(pm->id == pmi->model_num);
 
+	if (!use_last_frame) {
+		matrix sm_orient;
+		vec3d sm_offset, pnt;
+
+		// back into the model's frame first
+		if (objorient != nullptr && objpos != nullptr) {
+			vm_vec_sub(&pnt, mpnt, objpos);
+			vm_vec_rotate(&pnt, &pnt, objorient);
+		} else {
+			pnt = *mpnt;
+		}
+
+		// and then down the tree to the submodel
+		model_instance_find_submodel_transform(&sm_orient, &sm_offset, pm, pmi, submodel_num);
+
+		vm_vec_sub2(&pnt, &sm_offset);
+		vm_vec_rotate(outpnt, &pnt, &sm_orient);
+		return;
+	}
+
+	// the last frame's transforms aren't cached, so go up the tree the long way
 	constexpr int preallocatedStackDepth = 5;
 	std::tuple<const matrix*, const vec3d*, const vec3d*> preallocatedStack[preallocatedStackDepth];
 
@@ -4788,13 +4856,8 @@ void model_instance_global_to_local_point(vec3d* outpnt, const vec3d* mpnt, cons
 
 	//Go up the chain of parents to build a stack of transformations from parent -> child
 	while ((mn >= 0) && (pm->submodel[mn].parent >= 0)) {
-		if(use_last_frame) {
-			std::get<0>(submodelStack[stackCounter]) = &pmi->submodel[mn].canonical_prev_orient;
-			std::get<1>(submodelStack[stackCounter]) = &pmi->submodel[mn].canonical_prev_offset;
-		} else {
-			std::get<0>(submodelStack[stackCounter]) = &pmi->submodel[mn].canonical_orient;
-			std::get<1>(submodelStack[stackCounter]) = &pmi->submodel[mn].canonical_offset;
-		}
+		std::get<0>(submodelStack[stackCounter]) = &pmi->submodel[mn].canonical_prev_orient;
+		std::get<1>(submodelStack[stackCounter]) = &pmi->submodel[mn].canonical_prev_offset;
 		std::get<2>(submodelStack[stackCounter++]) = &pm->submodel[mn].offset;
 		mn = pm->submodel[mn].parent;
 	}
@@ -4831,6 +4894,21 @@ void model_instance_global_to_local_dir(vec3d* out_dir, const vec3d* in_dir, int
 void model_instance_global_to_local_dir(vec3d* out_dir, const vec3d* in_dir, const polymodel* pm, const polymodel_instance* pmi, int submodel_num, const matrix* objorient, bool use_last_frame) {
 	Assert(pm->id == pmi->model_num);
 
+	if (!use_last_frame) {
+		matrix sm_orient;
+		vec3d sm_offset, dir;
+
+		if (objorient != nullptr)
+			vm_vec_rotate(&dir, in_dir, objorient);
+		else
+			dir = *in_dir;
+
+		model_instance_find_submodel_transform(&sm_orient, &sm_offset, pm, pmi, submodel_num);
+		vm_vec_rotate(out_dir, &dir, &sm_orient);
+		return;
+	}
+
+	// the last frame's transforms aren't cached, so go up the tree the long way
 	constexpr int preallocatedStackDepth = 5;
 	const matrix* preallocatedStack[preallocatedStackDepth];
 
@@ -4841,10 +4919,7 @@ void model_instance_global_to_local_dir(vec3d* out_dir, const vec3d* in_dir, con
 
 	//Go up the chain of parents to build a stack of transformations from parent -> child
 	while ((mn >= 0) && (pm->submodel[mn].parent >= 0)) {
-		if (use_last_frame)
-			submodelStack[stackCounter++] = &pmi->submodel[mn].canonical_prev_orient;
-		else
-			submodelStack[stackCounter++] = &pmi->submodel[mn].canonical_orient;
+		submodelStack[stackCounter++] = &pmi->submodel[mn].canonical_prev_orient;
 		mn = pm->submodel[mn].parent;
 	}
 
@@ -4868,48 +4943,25 @@ void model_instance_global_to_local_dir(vec3d* out_dir, const vec3d* in_dir, con
 }
 
 void model_instance_global_to_local_point_orient(vec3d* outpnt, matrix* outorient, const vec3d* submodel_pnt, const matrix* submodel_orient, const polymodel* pm, const polymodel_instance* pmi, int submodel_num, const matrix* objorient, const vec3d* objpos) {
-	Assert(pm->id == pmi->model_num);
-
-	constexpr int preallocatedStackDepth = 5;
-	std::tuple<const matrix*, const vec3d*, const vec3d*> preallocatedStack[preallocatedStackDepth];
-
-	auto submodelStack = submodel_num < 0 || pm->submodel[submodel_num].depth <= preallocatedStackDepth ? preallocatedStack : new std::tuple<const matrix*, const vec3d*, const vec3d*>[pm->submodel[submodel_num].depth];
-	int stackCounter = 0;
-
-	int mn = submodel_num;
-
-	//Go up the chain of parents to build a stack of transformations from parent -> child
-	while ((mn >= 0) && (pm->submodel[mn].parent >= 0)) {
-		std::get<0>(submodelStack[stackCounter]) = &pmi->submodel[mn].canonical_orient;
-		std::get<1>(submodelStack[stackCounter]) = &pmi->submodel[mn].canonical_offset;
-		std::get<2>(submodelStack[stackCounter++]) = &pm->submodel[mn].offset;
-		mn = pm->submodel[mn].parent;
-	}
+	matrix sm_orient, orient;
+	vec3d sm_offset, pnt;
 
+	// back into the model's frame first
 	if (objorient != nullptr && objpos != nullptr) {
-		std::get<0>(submodelStack[stackCounter]) = objorient;
-		std::get<1>(submodelStack[stackCounter]) = &vmd_zero_vector;
-		std::get<2>(submodelStack[stackCounter++]) = objpos;
-	}
-	stackCounter--;
-
-	vec3d resultPnt = *submodel_pnt;
-	matrix resultMat = *submodel_orient;
-
-	while (stackCounter >= 0) {
-		const auto& transform = submodelStack[stackCounter--];
-
-		vm_vec_sub2(&resultPnt, std::get<2>(transform));
-		vm_vec_sub2(&resultPnt, std::get<1>(transform));
-		vm_vec_rotate(&resultPnt, &resultPnt, std::get<0>(transform));
-		resultMat = *std::get<0>(transform) * resultMat;
+		vm_vec_sub(&pnt, submodel_pnt, objpos);
+		vm_vec_rotate(&pnt, &pnt, objorient);
+		orient = *objorient * *submodel_orient;
+	} else {
+		pnt = *submodel_pnt;
+		orient = *submodel_orient;
 	}
 
-	*outpnt = resultPnt;
-	*outorient = resultMat;
+	// and then down the tree to the submodel
+	model_instance_find_submodel_transform(&sm_orient, &sm_offset, pm, pmi, submodel_num);
 
-	if (submodel_num >= 0 && pm->submodel[submodel_num].depth > preallocatedStackDepth)
-		delete[] submodelStack;
+	vm_vec_sub2(&pnt, &sm_offset);
+	vm_vec_rotate(outpnt, &pnt, &sm_orient);
+	*outorient = sm_orient * orient;
 }
 
 /*
@@ -5021,21 +5073,12 @@ void model_instance_local_to_global_dir(vec3d *out_dir, const vec3d *in_dir, int
 
 void model_instance_local_to_global_dir(vec3d *out_dir, const vec3d *in_dir, const polymodel *pm, const polymodel_instance *pmi, int submodel_num, const matrix *objorient)
 {
-	vec3d pnt;
-	vec3d tpnt;
-	int mn;
-	Assert(pm->id == pmi->model_num);
-
-	pnt = *in_dir;
-	mn = submodel_num;
+	vec3d pnt, sm_offset;
+	matrix sm_orient;
 
 	// instance up the tree for this point
-	while ( (mn >= 0) && (pm->submodel[mn].parent >= 0) ) {
-		vm_vec_unrotate(&tpnt, &pnt, &pmi->submodel[mn].canonical_orient);
-		pnt = tpnt;
-
-		mn = pm->submodel[mn].parent;
-	}
+	model_instance_find_submodel_transform(&sm_orient, &sm_offset, pm, pmi, submodel_num);
+	vm_vec_unrotate(&pnt, in_dir, &sm_orient);
 
 	// now instance for the entire object
 	if (objorient) {
@@ -5127,6 +5170,8 @@ void model_replicate_submodel_instance_sub(polymodel *pm, polymodel_instance *pm
 				r_smi->cur_offset = copy_from->cur_offset;
 				r_smi->canonical_offset = copy_from->canonical_offset;
 				r_smi->canonical_prev_offset = copy_from->canonical_prev_offset;
+
+				submodel_instance_moved(r_smi);
 			} else {
 				r_smi->cur_angle = smi->cur_angle;
 				r_smi->canonical_orient = smi->canonical_orient;
@@ -5135,6 +5180,8 @@ void model_replicate_submodel_instance_sub(polymodel *pm, polymodel_instance *pm
 				r_smi->cur_offset = smi->cur_offset;
 				r_smi->canonical_offset = smi->canonical_offset;
 				r_smi->canonical_prev_offset = smi->canonical_prev_offset;
+
+				submodel_instance_moved(r_smi);
 			}
 		}
 	} else {
@@ -5155,6 +5202,8 @@ void model_replicate_submodel_instance_sub(polymodel *pm, polymodel_instance *pm
 		smi->cur_offset = copy_from->cur_offset;
 		smi->canonical_offset = copy_from->canonical_offset;
 		smi->canonical_prev_offset = copy_from->canonical_prev_offset;
+
+		submodel_instance_moved(smi);
 	}
 
 	// For all the detail levels of this submodel, set them also.
@@ -30,6 +30,7 @@
 #include "ship/ship.h"
 #include "ship/shipfx.h"
 #include "starfield/starfield.h"
+#include "tracing/Monitor.h"
 #include "tracing/tracing.h"
 #include "weapon/weapon.h"
 
@@ -51,6 +52,9 @@ int model_render_determine_elapsed_time(int objnum, uint64_t flags);
 
 model_batch_buffer TransformBufferHandler;
 
+MONITOR(NumModelDrawCalls)
+MONITOR(ModelUniformBytesSaved)
+
 model_render_params::model_render_params() :
 	Model_flags(MR_NORMAL),
 	Debug_flags(0),
@@ -339,6 +343,7 @@ void model_batch_buffer::reset()
 	Submodel_matrices.clear();
 
 	Current_offset = 0;
+	Current_count = 0;
 }
 
 void model_batch_buffer::set_num_models(int n_models)
@@ -348,6 +353,7 @@ void model_batch_buffer::set_num_models(int n_models)
 	vm_matrix4_set_identity(&init_mat);
 
 	Current_offset = Submodel_matrices.size();
+	Current_count = n_models;
 
 	for ( int i = 0; i < n_models; ++i ) {
 		Submodel_matrices.push_back(init_mat);
@@ -364,11 +370,33 @@ void model_batch_buffer::add_matrix(const matrix4 &mat)
 	Submodel_matrices.push_back(mat);
 }
 
+// Copies count matrices from offset to the end of the buffer, and returns where the copy starts
+size_t model_batch_buffer::add_copy(size_t offset, size_t count)
+{
+	Assertion(offset + count <= Submodel_matrices.size(), "Can't copy matrices from outside of the buffer!");
+
+	size_t copy_offset = Submodel_matrices.size();
+
+	// no reallocation while copying, since the source is in the same vector
+	Submodel_matrices.reserve(copy_offset + count);
+
+	for ( size_t i = 0; i < count; ++i ) {
+		Submodel_matrices.push_back(Submodel_matrices[offset + i]);
+	}
+
+	return copy_offset;
+}
+
 size_t model_batch_buffer::get_buffer_offset() const
 {
 	return Current_offset;
 }
 
+size_t model_batch_buffer::get_num_models() const
+{
+	return Current_count;
+}
+
 void model_batch_buffer::allocate_memory()
 {
 	auto size = Submodel_matrices.size() * sizeof(matrix4);
@@ -414,6 +442,8 @@ void model_draw_list::reset()
 	Current_scale.xyz.z = 1.0f;
 
 	Render_initialized = false;
+
+	Stats = model_draw_stats();
 }
 
 void model_draw_list::sort_draws()
@@ -499,6 +529,7 @@ void model_draw_list::add_buffer_draw(const model_material *render_material, con
 		draw_data.scale.xyz.z = 1.0f;
 
 		draw_data.transform_buffer_offset = TransformBufferHandler.get_buffer_offset();
+		draw_data.transform_buffer_count = TransformBufferHandler.get_num_models();
 
 		draw_data.render_material.set_batching(true);
 	} else {
@@ -518,6 +549,8 @@ void model_draw_list::add_buffer_draw(const model_material *render_material, con
 
 	Render_elements.push_back(draw_data);
 	Render_keys.push_back((int) (Render_elements.size() - 1));
+
+	++Stats.queued_draws;
 }
 
 void model_draw_list::render_buffer(const queued_buffer_draw &render_elements)
@@ -528,7 +561,14 @@ void model_draw_list::render_buffer(const queued_buffer_draw &render_elements)
 	gr_bind_uniform_buffer(uniform_block_type::ModelData, render_elements.uniform_buffer_offset,
 	                       sizeof(graphics::model_uniform_data), _dataBuffer.bufferHandle());
 
-	gr_render_model(const_cast<model_material*>(&render_elements.render_material), const_cast<indexed_vertex_source*>(render_elements.vert_src), const_cast<vertex_buffer*>(render_elements.buffer), render_elements.texi);
+	gr_render_model(const_cast<model_material*>(&render_elements.render_material), const_cast<indexed_vertex_source*>(render_elements.vert_src), const_cast<vertex_buffer*>(render_elements.buffer), render_elements.texi, render_elements.n_instances);
+
+	++Stats.draw_calls;
+	if ( render_elements.n_instances > 1 ) {
+		++Stats.instanced_draw_calls;
+	}
+
+	MONITOR_INC(NumModelDrawCalls, 1);
 }
 
 vec3d model_draw_list::get_view_position() const
@@ -594,9 +634,11 @@ void model_draw_list::init_render(bool sort)
 		sort_draws();
 	}
 
-	TransformBufferHandler.submit_buffer_data();
+	// the shadow map shaders already use the instances for the cascades
+	build_uniform_buffer(!Rendering_to_shadow_map);
 
-	build_uniform_buffer();
+	// instancing can add transforms, so this has to come after the uniforms
+	TransformBufferHandler.submit_buffer_data();
 
 	Render_initialized = true;
 }
@@ -621,6 +663,11 @@ void model_draw_list::render_all(gr_zbuffer_type depth_mode)
 	gr_alpha_mask_set(0, 1.0f);
 }
 
+const model_draw_stats& model_draw_list::get_stats() const
+{
+	return Stats;
+}
+
 void model_draw_list::render_arc(const arc_effect &arc)
 {
 	g3_start_instance_matrix(&arc.transform);	
@@ -726,15 +773,131 @@ bool model_draw_list::sort_draw_pair(const model_draw_list* target, const int a,
 		return draw_call_a->render_material.get_texture_map(TM_MISC_TYPE) < draw_call_b->render_material.get_texture_map(TM_MISC_TYPE);
 	}
 
+	// keep the draws of the same buffer together so that they can be instanced
+	if ( draw_call_a->buffer != draw_call_b->buffer ) {
+		return std::less<const vertex_buffer*>()(draw_call_a->buffer, draw_call_b->buffer);
+	}
+
+	if ( draw_call_a->texi != draw_call_b->texi ) {
+		return draw_call_a->texi < draw_call_b->texi;
+	}
+
 	return draw_call_a->lights.index_start < draw_call_b->lights.index_start;
 }
-void model_draw_list::build_uniform_buffer() {
+
+// Whether the render state of two batched draws is the same, so that they could be drawn as instances of one draw call.
+// Their uniform data has to be compared as well.
+static bool model_draw_can_instance(const queued_buffer_draw &a, const queued_buffer_draw &b)
+{
+	if ( !a.render_material.is_batched() || !b.render_material.is_batched() ) {
+		return false;
+	}
+
+	if ( a.vert_src != b.vert_src || a.buffer != b.buffer || a.texi != b.texi || a.flags != b.flags
+		|| a.sdr_flags != b.sdr_flags || a.transform_buffer_count != b.transform_buffer_count ) {
+		return false;
+	}
+
+	auto &mat_a = a.render_material;
+	auto &mat_b = b.render_material;
+
+	for ( int i = 0; i < TM_NUM_TYPES; ++i ) {
+		if ( mat_a.get_texture_map(i) != mat_b.get_texture_map(i) ) {
+			return false;
+		}
+	}
+
+	if ( mat_a.has_buffer_blend_modes() != mat_b.has_buffer_blend_modes() ) {
+		return false;
+	}
+
+	for ( int i = 0; i < (int)material::NUM_BUFFER_BLENDS; ++i ) {
+		if ( mat_a.get_blend_mode(i) != mat_b.get_blend_mode(i) ) {
+			return false;
+		}
+	}
+
+	auto &mask_a = mat_a.get_color_mask();
+	auto &mask_b = mat_b.get_color_mask();
+
+	if ( mask_a.x != mask_b.x || mask_a.y != mask_b.y || mask_a.z != mask_b.z || mask_a.w != mask_b.w ) {
+		return false;
+	}
+
+	auto same_stencil_op = [](const material::StencilOp &op_a, const material::StencilOp &op_b) {
+		return op_a.stencilFailOperation == op_b.stencilFailOperation && op_a.depthFailOperation == op_b.depthFailOperation
+			&& op_a.successOperation == op_b.successOperation;
+	};
+
+	auto &func_a = mat_a.get_stencil_func();
+	auto &func_b = mat_b.get_stencil_func();
+
+	return mat_a.get_depth_mode() == mat_b.get_depth_mode()
+		&& mat_a.get_cull_mode() == mat_b.get_cull_mode()
+		&& mat_a.get_fill_mode() == mat_b.get_fill_mode()
+		&& mat_a.get_depth_bias() == mat_b.get_depth_bias()
+		&& mat_a.get_texture_addressing() == mat_b.get_texture_addressing()
+		&& mat_a.is_clipped() == mat_b.is_clipped()
+		&& mat_a.get_center_alpha() == mat_b.get_center_alpha()
+		&& mat_a.is_shadow_casting() == mat_b.is_shadow_casting()
+		&& mat_a.is_stencil_enabled() == mat_b.is_stencil_enabled()
+		&& mat_a.get_stencil_mask() == mat_b.get_stencil_mask()
+		&& func_a.compare == func_b.compare && func_a.ref == func_b.ref && func_a.mask == func_b.mask
+		&& same_stencil_op(mat_a.get_front_stencil_op(), mat_b.get_front_stencil_op())
+		&& same_stencil_op(mat_a.get_back_stencil_op(), mat_b.get_back_stencil_op());
+}
+void model_draw_list::build_uniform_buffer(bool instancing) {
 	GR_DEBUG_SCOPE("Build model uniform buffer");
 
 	TRACE_SCOPE(tracing::BuildModelUniforms);
 
 	_dataBuffer = gr_get_uniform_buffer(uniform_block_type::ModelData, Render_keys.size());
 
+	// Consecutive batched draws which only differ in their transforms are merged into an instanced draw of the first
+	// one, which then needs the transforms of all its instances one after the other in the transform buffer
+	SCP_vector<int> draw_keys;
+	draw_keys.reserve(Render_keys.size());
+
+	queued_buffer_draw* group_draw = nullptr;
+	graphics::model_uniform_data* group_element = nullptr;
+	SCP_vector<size_t> group_offsets;
+
+	auto finish_group = [&]() {
+		if ( group_offsets.size() < 2 ) {
+			return;
+		}
+
+		size_t count = group_draw->transform_buffer_count;
+		size_t offset = group_offsets.front();
+
+		// objects of the same model queued one after another already have their transforms in the right place
+		bool in_place = true;
+		for ( size_t i = 1; i < group_offsets.size(); ++i ) {
+			if ( group_offsets[i] != offset + i * count ) {
+				in_place = false;
+				break;
+			}
+		}
+
+		if ( !in_place ) {
+			offset = TransformBufferHandler.add_copy(group_offsets.front(), count);
+
+			for ( size_t i = 1; i < group_offsets.size(); ++i ) {
+				TransformBufferHandler.add_copy(group_offsets[i], count);
+			}
+		}
+
+		group_element->buffer_matrix_offset = (int) offset;
+		group_element->instance_matrix_stride = (int) count;
+		group_draw->n_instances = (int) group_offsets.size();
+
+		size_t bytes_saved = (group_offsets.size() - 1) * sizeof(graphics::model_uniform_data);
+		Stats.uniform_bytes_saved += bytes_saved;
+		MONITOR_INC(ModelUniformBytesSaved, (int) bytes_saved);
+	};
+
+	graphics::model_uniform_data draw_data;
+
 	for (auto render_index : Render_keys) {
 		auto& queued_draw = Render_elements[render_index];
 
@@ -746,15 +909,44 @@ void model_draw_list::build_uniform_buffer() {
 			Scene_light_handler.resetLightState();
 		}
 
-		auto element = _dataBuffer.aligner().addTypedElement<graphics::model_uniform_data>();
-		graphics::uniforms::convert_model_material(element,
+		// cleared first so that the padding and the fields which aren't used can be compared as well
+		memset(&draw_data, 0, sizeof(draw_data));
+		graphics::uniforms::convert_model_material(&draw_data,
 												   queued_draw.render_material,
 												   queued_draw.transform,
 												   queued_draw.scale,
 												   queued_draw.transform_buffer_offset);
+
+		if ( instancing && group_draw != nullptr && model_draw_can_instance(*group_draw, queued_draw) ) {
+			draw_data.buffer_matrix_offset = group_element->buffer_matrix_offset;
+
+			if ( memcmp(&draw_data, group_element, sizeof(draw_data)) == 0 ) {
+				group_offsets.push_back(queued_draw.transform_buffer_offset);
+				continue;
+			}
+
+			draw_data.buffer_matrix_offset = (int) queued_draw.transform_buffer_offset;
+		}
+
+		finish_group();
+
+		auto element = _dataBuffer.aligner().addTypedElement<graphics::model_uniform_data>();
+		memcpy(element, &draw_data, sizeof(draw_data));
 		queued_draw.uniform_buffer_offset = _dataBuffer.getCurrentAlignerOffset();
+		queued_draw.n_instances = 1;
+
+		draw_keys.push_back(render_index);
+
+		group_draw = &queued_draw;
+		group_element = element;
+		group_offsets.clear();
+		group_offsets.push_back(queued_draw.transform_buffer_offset);
 	}
 
+	finish_group();
+
+	Render_keys.swap(draw_keys);
+
 	TRACE_SCOPE(tracing::UploadModelUniforms);
 
 	_dataBuffer.submitData();
@@ -187,8 +187,11 @@ struct insignia_draw_data
 struct queued_buffer_draw
 {
 	size_t transform_buffer_offset = 0;
+	size_t transform_buffer_count = 0;	// the number of submodel transforms of a batched draw
 	size_t uniform_buffer_offset = 0;
 
+	int n_instances = 1;
+
 	model_material render_material;
 
 	matrix4 transform;
@@ -223,20 +226,32 @@ class model_batch_buffer
 	size_t Mem_alloc_size;
 
 	size_t Current_offset;
+	size_t Current_count;
 
 	void allocate_memory();
 public:
-	model_batch_buffer() : Mem_alloc(NULL), Mem_alloc_size(0), Current_offset(0) {};
+	model_batch_buffer() : Mem_alloc(NULL), Mem_alloc_size(0), Current_offset(0), Current_count(0) {};
 
 	void reset();
 
 	size_t get_buffer_offset() const;
+	size_t get_num_models() const;
 	void set_num_models(int n_models);
 	void set_model_transform(const matrix4 &transform, int model_id);
 
 	void submit_buffer_data();
 
 	void add_matrix(const matrix4 &mat);
+	size_t add_copy(size_t offset, size_t count);
+};
+
+// What a draw list sent to the renderer, so that the savings of instancing can be checked
+struct model_draw_stats
+{
+	size_t queued_draws = 0;		// buffer draws added to the list
+	size_t draw_calls = 0;			// model draw calls made by render_all()
+	size_t instanced_draw_calls = 0;	// the draw calls among those which drew more than one instance
+	size_t uniform_bytes_saved = 0;	// model uniform data that didn't have to be uploaded thanks to instancing
 };
 
 class model_draw_list
@@ -261,11 +276,13 @@ class model_draw_list
 	graphics::util::UniformBuffer _dataBuffer;
 
 	bool Render_initialized = false; //!< A flag for checking if init_render has been called before a render_all call
+
+	model_draw_stats Stats;
 	
 	static bool sort_draw_pair(const model_draw_list* target, const int a, const int b);
 	void sort_draws();
 
-	void build_uniform_buffer();
+	void build_uniform_buffer(bool instancing);
 public:
 	model_draw_list();
 	~model_draw_list();
@@ -296,6 +313,8 @@ public:
 	void init_render(bool sort = true);
 	void render_all(gr_zbuffer_type depth_mode = ZBUFFER_TYPE_DEFAULT);
 	void reset();
+
+	const model_draw_stats& get_stats() const;
 };
 
 void model_render_only_glowpoint_lights(const model_render_params* interp, int model_num, int model_instance_num, const matrix* orient, const vec3d* pos);
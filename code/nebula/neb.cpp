@@ -717,7 +717,7 @@ float neb2_get_lod_scale(int objnum)
 
 	// bogus
 	if ( (objnum < 0) 
-		|| (objnum >= MAX_OBJECTS) 
+		|| (objnum >= (int)Objects.size()) 
 		|| (Objects[objnum].type != OBJ_SHIP) 
 		|| (Objects[objnum].instance < 0) 
 		|| (Objects[objnum].instance >= MAX_SHIPS)) {
@@ -56,6 +56,8 @@
 #include "debugconsole/console.h"
 #include "network/psnet2.h"
 #include "network/multi_mdns.h"
+#include "network/multi_loadtest.h"
+#include "network/multi_capture.h"
 #include "cmdline/cmdline.h"
 
 // Stupid windows workaround...
@@ -500,6 +502,9 @@ void process_packet_normal(ubyte* data, header *header_info, bool reliable)
 		mprintf(("Game packet type of %d received.\n", data[0]));
 	}
 
+	// time the handler when capturing or replaying packets, until this function is left
+	multi_capture_timer packet_timer(data[0]);
+
 	switch ( data[0] ) {
 
 		case JOIN:
@@ -1150,6 +1155,9 @@ DCF(eye_tog, "Toggles setting of the local player eyepoint on every frame (Multi
 
 void multi_do_frame()
 {	
+	// synthetic load test clients send before we read, so they get handled this frame
+	multi_loadtest_do_frame();
+
 	PSNET_TOP_LAYER_PROCESS();
 
 	// always set the local player eye position/orientation here so we know its valid throughout all multiplayer
@@ -1181,6 +1189,9 @@ void multi_do_frame()
 	// get the other net players data
 	multi_process_incoming();		
 
+	// and any captured packets that are being replayed
+	multi_replay_do_frame();
+
 	// process object update datarate stuff (for clients and server both)
 	multi_oo_rate_process();
 
@@ -1285,7 +1296,10 @@ void multi_do_frame()
 		} else {
 
 			// right before sending new positions, we should do any rollback shots and resimulation
-			multi_ship_record_do_rollback();
+			{
+				multi_capture_timer rollback_timer(CAPTURE_TIMING_ROLLBACK);
+				multi_ship_record_do_rollback();
+			}
 
 			// sending new objects from here is dependent on having objects only created after
 			// the game is done moving the objects.  I think that I can enforce this.				
@@ -76,9 +76,10 @@ class player;
 // Version 60 - 3/27/2023 - Added generic lua data packet
 // Version 61 - 4/17/2023 - Added compatibility for whackable asteroids (added force)
 // Version 62 - 5/26/2025 - Added some modular curve input data to turret firing packets; 5/31/2025 - Added another input
+// Version 63 - 10/19/2026 - Delta compressed positions in object updates, with packet acknowledgement from clients
 // STANDALONE_ONLY
 
-#define MULTI_FS_SERVER_VERSION							62
+#define MULTI_FS_SERVER_VERSION							63
 
 #define MULTI_FS_SERVER_COMPATIBLE_VERSION			MULTI_FS_SERVER_VERSION
 
@@ -739,6 +740,7 @@ typedef struct network_buffer {
 #define NETINFO_FLAG_MT_SEND_FAILED			(1<<24)		// set during MT stats update process indicating we didn't properly send his stats
 #define NETINFO_FLAG_MT_DONE				(1<<25)		// set when a player has been processed for stats (fail, succeed, or otherwise)
 #define NETINFO_FLAG_HAXOR					(1<<26)		// the player has some form of hacked client data
+#define NETINFO_FLAG_LOADTEST				(1<<27)		// synthetic load test client on this machine (server side only), has no reliable socket
 
 #define NETPLAYER_IS_OBSERVER(player)		(player->flags & (NETINFO_FLAG_OBSERVER|NETINFO_FLAG_OBS_PLAYER))
 #define NETPLAYER_IS_DEAD(player)			(player->flags & (NETINFO_FLAG_LIMBO|NETINFO_FLAG_RESPAWNING))
@@ -954,7 +956,7 @@ void multi_do_frame();
 void multi_pause_do_frame();
 
 // process all incoming packets
-// void multi_process_bigdata(ubyte* data, int size, net_addr* from_addr);
+void multi_process_bigdata(ubyte *data, int len, net_addr *from_addr, int reliable);
 
 // process all reliable socket details
 void multi_process_reliable_details();
@@ -0,0 +1,288 @@
+#include "network/multi_capture.h"
+
+#include "cfile/cfile.h"
+#include "cmdline/cmdline.h"
+#include "io/timer.h"
+#include "network/multi.h"
+#include "network/multi_log.h"
+#include "network/psnet2.h"
+
+#include <algorithm>
+#include <climits>
+
+
+// capture file layout:  the header, then one record per packet
+//    header:  int CAPTURE_FILE_ID, int CAPTURE_FILE_VERSION
+//    record:  uint time (high), uint time (low), ubyte flags, ubyte addr[16], ushort port, ushort len, ubyte data[len]
+#define CAPTURE_FILE_ID				0x43505346		// "FSPC"
+#define CAPTURE_FILE_VERSION		1
+
+#define CAPTURE_FLAG_OUT			(1<<0)
+#define CAPTURE_FLAG_RELIABLE		(1<<1)
+
+typedef struct capture_record {
+	std::uint64_t time;				// microseconds since the capture started
+	ubyte flags;
+	net_addr addr;
+	size_t offset;					// where the packet data starts in Replay_data
+	int len;
+} capture_record;
+
+typedef struct capture_timing {
+	int count;
+	std::uint64_t total;			// microseconds
+	std::uint64_t max;				// microseconds
+} capture_timing;
+
+static CFILE *Capture_file = nullptr;
+static std::uint64_t Capture_start = 0;
+
+static SCP_vector<capture_record> Replay_records;
+static SCP_vector<ubyte> Replay_data;
+static size_t Replay_next = 0;
+static std::uint64_t Replay_start = 0;
+static bool Replay_loaded = false;
+static bool Replay_started = false;
+
+static capture_timing Capture_packet_timing[256];
+static capture_timing Capture_rollback_timing;
+
+
+static void multi_capture_add_timing(capture_timing *timing, std::uint64_t microseconds)
+{
+	timing->count++;
+	timing->total += microseconds;
+	timing->max = std::max(timing->max, microseconds);
+}
+
+static void multi_capture_clear_timing()
+{
+	memset(Capture_packet_timing, 0, sizeof(Capture_packet_timing));
+	memset(&Capture_rollback_timing, 0, sizeof(Capture_rollback_timing));
+}
+
+// write the handler timing to the multi log, the most expensive handlers first
+static void multi_capture_report_timing()
+{
+	SCP_vector<int> types;
+
+	for (int idx = 0; idx < 256; idx++) {
+		if (Capture_packet_timing[idx].count > 0) {
+			types.push_back(idx);
+		}
+	}
+
+	if (types.empty() && (Capture_rollback_timing.count == 0)) {
+		return;
+	}
+
+	std::sort(types.begin(), types.end(), [](int a, int b) {
+		return Capture_packet_timing[a].total > Capture_packet_timing[b].total;
+	});
+
+	ml_string("Packet handler timing (type, count, total ms, avg us, max us):");
+
+	for (int type : types) {
+		const auto &timing = Capture_packet_timing[type];
+		ml_printf("  0x%02x  %8d  %10.2f  %8.1f  %8d", type, timing.count, timing.total / 1000.0,
+			static_cast<double>(timing.total) / timing.count, static_cast<int>(timing.max));
+	}
+
+	if (Capture_rollback_timing.count > 0) {
+		ml_printf("  rollback  %8d  %10.2f  %8.1f  %8d", Capture_rollback_timing.count, Capture_rollback_timing.total / 1000.0,
+			static_cast<double>(Capture_rollback_timing.total) / Capture_rollback_timing.count, static_cast<int>(Capture_rollback_timing.max));
+	}
+}
+
+// read the whole capture into memory, so that disk access doesn't show up in the replay
+static bool multi_replay_load(const char *filename)
+{
+	CFILE *cfp = cfopen(filename, "rb", CF_TYPE_ANY);
+
+	if (cfp == nullptr) {
+		ml_printf("Packet replay: unable to open %s", filename);
+		return false;
+	}
+
+	if ((cfread_int(cfp) != CAPTURE_FILE_ID) || (cfread_int(cfp) != CAPTURE_FILE_VERSION)) {
+		ml_printf("Packet replay: %s is not a packet capture this build can read", filename);
+		cfclose(cfp);
+		return false;
+	}
+
+	Replay_records.clear();
+	Replay_data.clear();
+
+	while (!cfeof(cfp)) {
+		capture_record record;
+		ubyte data[MAX_TOP_LAYER_PACKET_SIZE];
+
+		memset(&record, 0, sizeof(record));
+
+		uint time_high = cfread_uint(cfp);
+		uint time_low = cfread_uint(cfp);
+		record.time = (static_cast<std::uint64_t>(time_high) << 32) | time_low;
+		record.flags = cfread_ubyte(cfp);
+
+		if (cfread(record.addr.addr, sizeof(record.addr.addr), 1, cfp) != 1) {
+			break;
+		}
+
+		record.addr.port = cfread_ushort(cfp);
+		record.len = cfread_ushort(cfp);
+
+		if ((record.len <= 0) || (record.len > static_cast<int>(sizeof(data))) || (cfread(data, record.len, 1, cfp) != 1)) {
+			break;
+		}
+
+		record.offset = Replay_data.size();
+		Replay_data.insert(Replay_data.end(), data, data + record.len);
+		Replay_records.push_back(record);
+	}
+
+	cfclose(cfp);
+
+	ml_printf("Packet replay: loaded %d packets from %s", static_cast<int>(Replay_records.size()), filename);
+
+	return !Replay_records.empty();
+}
+
+void multi_capture_init()
+{
+	multi_capture_clear_timing();
+
+	if (Cmdline_capture_packets != nullptr) {
+		Capture_file = cfopen(Cmdline_capture_packets, "wb", CF_TYPE_DATA);
+
+		if (Capture_file == nullptr) {
+			ml_printf("Packet capture: unable to open %s", Cmdline_capture_packets);
+		} else {
+			cfwrite_int(CAPTURE_FILE_ID, Capture_file);
+			cfwrite_int(CAPTURE_FILE_VERSION, Capture_file);
+
+			Capture_start = timer_get_microseconds();
+
+			ml_printf("Packet capture: writing packets to %s", Cmdline_capture_packets);
+		}
+	}
+
+	if (Cmdline_replay_packets != nullptr) {
+		Replay_loaded = multi_replay_load(Cmdline_replay_packets);
+		Replay_started = false;
+		Replay_next = 0;
+	}
+}
+
+void multi_capture_close()
+{
+	if (Capture_file != nullptr) {
+		cfclose(Capture_file);
+		Capture_file = nullptr;
+	}
+
+	multi_capture_report_timing();
+	multi_capture_clear_timing();
+
+	Replay_records.clear();
+	Replay_records.shrink_to_fit();
+	Replay_data.clear();
+	Replay_data.shrink_to_fit();
+	Replay_loaded = false;
+	Replay_started = false;
+}
+
+void multi_capture_packet(int direction, bool reliable, const net_addr *addr, const void *data, int len)
+{
+	if ((Capture_file == nullptr) || (len <= 0)) {
+		return;
+	}
+
+	std::uint64_t time = timer_get_microseconds() - Capture_start;
+	ubyte flags = 0;
+
+	if (direction == CAPTURE_DIRECTION_OUT) {
+		flags |= CAPTURE_FLAG_OUT;
+	}
+
+	if (reliable) {
+		flags |= CAPTURE_FLAG_RELIABLE;
+	}
+
+	cfwrite_uint(static_cast<uint>(time >> 32), Capture_file);
+	cfwrite_uint(static_cast<uint>(time & 0xffffffff), Capture_file);
+	cfwrite_ubyte(flags, Capture_file);
+	cfwrite(addr->addr, sizeof(addr->addr), 1, Capture_file);
+	cfwrite_ushort(addr->port, Capture_file);
+	cfwrite_ushort(static_cast<ushort>(len), Capture_file);
+	cfwrite(data, len, 1, Capture_file);
+}
+
+bool multi_replay_active()
+{
+	return Replay_loaded && (Replay_next < Replay_records.size());
+}
+
+void multi_replay_do_frame()
+{
+	if (!multi_replay_active() || !MULTIPLAYER_MASTER) {
+		return;
+	}
+
+	std::uint64_t now = timer_get_microseconds();
+
+	// the capture's clock starts with the first frame this server can take packets on
+	if (!Replay_started) {
+		Replay_started = true;
+		Replay_start = now - Replay_records[0].time;
+
+		multi_capture_clear_timing();
+	}
+
+	ubyte data[MAX_TOP_LAYER_PACKET_SIZE];
+
+	while ((Replay_next < Replay_records.size()) && (Replay_records[Replay_next].time <= now - Replay_start)) {
+		auto &record = Replay_records[Replay_next++];
+
+		// what the server sent back then is only in the capture for reference
+		if (record.flags & CAPTURE_FLAG_OUT) {
+			continue;
+		}
+
+		// the handlers are allowed to scribble on the packet, so give them a copy
+		memcpy(data, &Replay_data[record.offset], static_cast<size_t>(record.len));
+
+		multi_process_bigdata(data, record.len, &record.addr, (record.flags & CAPTURE_FLAG_RELIABLE) ? 1 : 0);
+	}
+
+	if (Replay_next >= Replay_records.size()) {
+		ml_printf("Packet replay: finished after %.2f seconds", (now - Replay_start) / 1000000.0);
+		multi_capture_report_timing();
+		multi_capture_clear_timing();
+	}
+}
+
+bool multi_capture_timing_active()
+{
+	return (Capture_file != nullptr) || multi_replay_active();
+}
+
+multi_capture_timer::multi_capture_timer(int what)
+	: _what(what), _active(multi_capture_timing_active()), _start(_active ? timer_get_microseconds() : 0)
+{
+	Assert((what == CAPTURE_TIMING_ROLLBACK) || ((what >= 0) && (what <= UCHAR_MAX)));
+}
+
+multi_capture_timer::~multi_capture_timer()
+{
+	if ( !_active ) {
+		return;
+	}
+
+	std::uint64_t microseconds = timer_get_microseconds() - _start;
+
+	if (_what == CAPTURE_TIMING_ROLLBACK) {
+		multi_capture_add_timing(&Capture_rollback_timing, microseconds);
+	} else {
+		multi_capture_add_timing(&Capture_packet_timing[_what], microseconds);
+	}
+}
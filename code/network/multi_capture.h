@@ -0,0 +1,53 @@
+#ifndef MULTI_CAPTURE_H
+#define MULTI_CAPTURE_H
+
+#include "globalincs/pstypes.h"
+
+struct net_addr;
+
+// Packet capture and replay for looking into multiplayer performance.  With "-capture_packets <file>", every game
+// packet that goes through psnet (unreliable and reliable, in and out) is written to the file along with when it was
+// seen.  With "-replay_packets <file>", a server feeds the incoming packets of a capture back through the normal
+// packet handlers at the times they were recorded, and reports how long each kind of packet took to handle.
+
+// psnet_get() and friends tell the capture which way a packet went
+#define CAPTURE_DIRECTION_IN		0
+#define CAPTURE_DIRECTION_OUT		1
+
+// open the capture or replay file given on the command line, call after psnet_init()
+void multi_capture_init();
+
+// finish the capture or replay, writing out the handler timing if there is any
+void multi_capture_close();
+
+// record a packet, does nothing unless capturing
+void multi_capture_packet(int direction, bool reliable, const net_addr *addr, const void *data, int len);
+
+// true while a capture is being replayed, real outgoing traffic is dropped during that time
+bool multi_replay_active();
+
+// hand the server the captured packets that are due, call once per frame after the real incoming packets
+void multi_replay_do_frame();
+
+// Handler timing, gathered while capturing or replaying
+bool multi_capture_timing_active();
+
+// what multi_capture_timer times when it isn't a packet handler
+#define CAPTURE_TIMING_ROLLBACK		-1
+
+// Times everything done while it is in scope, however the scope is left, as the handler of a packet type (the first
+// byte of a game packet) or as CAPTURE_TIMING_ROLLBACK.  Does nothing unless timing is active when it is made.
+class multi_capture_timer {
+	int _what;
+	bool _active;
+	std::uint64_t _start;
+
+ public:
+	explicit multi_capture_timer(int what);
+	~multi_capture_timer();
+
+	multi_capture_timer(const multi_capture_timer&) = delete;
+	multi_capture_timer& operator=(const multi_capture_timer&) = delete;
+};
+
+#endif
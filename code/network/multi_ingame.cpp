@@ -1027,7 +1027,7 @@ void process_ingame_ships_packet( ubyte *data, header *hinfo )
 
 		// delete all ships
 		for(idx=0; idx<MAX_SHIPS; idx++){
-			if((Ships[idx].objnum >= 0) && (Ships[idx].objnum < MAX_OBJECTS)){
+			if((Ships[idx].objnum >= 0) && (Ships[idx].objnum < (int)Objects.size())){
 				obj_delete(Ships[idx].objnum);
 			}
 		}
@@ -1684,6 +1684,9 @@ void process_ingame_ship_request_packet(ubyte *data, header *hinfo)
 
 		// initialize datarate limiting for this guy
 		multi_oo_rate_init(&Net_players[player_num]);
+
+		// he has none of our old object updates, so don't send him deltas against them
+		multi_oo_reset_delta_info(&Net_players[player_num]);
 		
 		// ack him
 		send_ingame_ship_request_packet(INGAME_SR_CONFIRM,OBJ_INDEX(objp),&Net_players[player_num]);
@@ -0,0 +1,401 @@
+#include "network/multi_loadtest.h"
+
+#include "cmdline/cmdline.h"
+#include "io/timer.h"
+#include "math/vecmat.h"
+#include "network/multi.h"
+#include "network/multi_data.h"
+#include "network/multi_log.h"
+#include "network/multi_obj.h"
+#include "network/multimsgs.h"
+#include "network/multiutil.h"
+#include "network/psnet2.h"
+#include "object/object.h"
+#include "physics/physics.h"
+#include "playerman/player.h"
+#include "ship/ship.h"
+
+
+// how often clients send control info, about what the client rate limit in multi_obj.cpp allows
+static constexpr std::uint64_t LOADTEST_SEND_INTERVAL = 66 * 1000;				// microseconds
+
+// how long a client waits on a ship request before trying another ship
+static constexpr std::uint64_t LOADTEST_REQUEST_INTERVAL = 1000 * 1000;			// microseconds
+
+// how often the metrics are updated and logged
+static constexpr std::uint64_t LOADTEST_REPORT_INTERVAL = 5 * 1000 * 1000;		// microseconds
+
+// how the clients fly, a wide circle at a steady speed
+static constexpr float LOADTEST_SPEED = 40.0f;				// meters per second
+static constexpr float LOADTEST_TURN_RATE = 0.25f;			// radians per second
+
+// and shoot, in control info packets
+static constexpr int LOADTEST_TRIGGER_PERIOD = 60;			// primaries are held down for the first third of this
+static constexpr int LOADTEST_SECONDARY_PERIOD = 75;		// a secondary is fired once per this
+
+typedef struct loadtest_client {
+	PSNET_SOCKET socket;
+	net_addr addr;
+	int net_player_num;
+	int objnum;							// the ship we are flying, -1 until the server gives us one
+	ushort requested_sig;				// the ship we last asked for
+
+	std::uint64_t next_send;
+	std::uint64_t next_request;
+	int frame;
+
+	// our copy of the ship, which we move and report just like a real client
+	vec3d pos;
+	matrix orient;
+	physics_info pi;
+
+	// object update packets received, so they can be acknowledged
+	bool ack_valid;
+	ushort acked_seq;
+	uint acked_mask;
+
+	// traffic since the last report
+	int packets_sent;
+	int bytes_sent;
+	int packets_recv;
+	int bytes_recv;
+} loadtest_client;
+
+static SCP_vector<loadtest_client> Loadtest_clients;
+static bool Loadtest_spawned = false;
+
+static std::uint64_t Loadtest_frame_start = 0;		// 0 until the first frame after the clients spawned starts
+static std::uint64_t Loadtest_last_report = 0;
+static std::uint64_t Loadtest_frame_time_total = 0;
+static std::uint64_t Loadtest_frame_time_max = 0;
+static int Loadtest_frame_count = 0;
+
+loadtest_metrics Multi_loadtest_metrics;
+
+
+// find a ship that an ingame joiner could take, which none of our clients has asked for yet
+static ushort multi_loadtest_find_ship()
+{
+	for (object *objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp)) {
+		if ((objp->type != OBJ_SHIP) || !(objp->flags[Object::Object_Flags::Could_be_player])) {
+			continue;
+		}
+
+		bool taken = false;
+		for (auto &client : Loadtest_clients) {
+			if (client.requested_sig == objp->net_signature) {
+				taken = true;
+				break;
+			}
+		}
+
+		if (!taken) {
+			return objp->net_signature;
+		}
+	}
+
+	return 0;
+}
+
+// add one synthetic client as a connected player, returns false if there is no room for it
+static bool multi_loadtest_add_client(int index)
+{
+	loadtest_client client;
+	char callsign[CALLSIGN_LEN + 1];
+
+	int net_player_num = multi_find_open_netplayer_slot();
+	int player_num = multi_find_open_player_slot();
+
+	if ((net_player_num < 0) || (player_num < 0)) {
+		return false;
+	}
+
+	memset(&client, 0, sizeof(client));
+
+	client.socket = psnet_loopback_open(&client.addr);
+	if (client.socket == PSNET_INVALID_SOCKET) {
+		return false;
+	}
+
+	client.net_player_num = net_player_num;
+	client.objnum = -1;
+
+	// the server side of a join, without the reliable connection handshake
+	sprintf(callsign, "loadtest%d", index + 1);
+	multi_create_player(net_player_num, &Players[player_num], callsign, &client.addr, -1, multi_get_new_id());
+	multi_data_handle_join(net_player_num);
+
+	net_player *np = &Net_players[net_player_num];
+
+	np->flags |= (NETINFO_FLAG_CONNECTED | NETINFO_FLAG_LOADTEST);
+	np->flags &= ~NETINFO_FLAG_GAME_HOST;
+	np->state = NETPLAYER_STATE_INGAME_SHIP_SELECT;
+	np->tracker_player_id = -1;
+	np->s_info.reliable_connect_time = -1;
+
+	// let everybody know he's here
+	send_new_player_packet(net_player_num, nullptr);
+
+	Loadtest_clients.push_back(client);
+
+	return true;
+}
+
+// ask for a ship, with the same packet a real ingame joiner sends
+static void multi_loadtest_request_ship(loadtest_client *client)
+{
+	ubyte data[MAX_PACKET_SIZE];
+	int packet_size = 0;
+	int code = INGAME_SR_REQUEST;
+
+	client->requested_sig = multi_loadtest_find_ship();
+	if (client->requested_sig == 0) {
+		return;
+	}
+
+	BUILD_HEADER(INGAME_SHIP_REQUEST);
+	ADD_INT(code);
+	ADD_USHORT(client->requested_sig);
+
+	if (psnet_loopback_send(client->socket, data, packet_size)) {
+		client->packets_sent++;
+		client->bytes_sent += packet_size;
+	}
+}
+
+// read everything the server sent this client
+static void multi_loadtest_receive(loadtest_client *client)
+{
+	ubyte data[MAX_PACKET_SIZE];
+	int size;
+
+	while ((size = psnet_loopback_get(client->socket, data, MAX_PACKET_SIZE)) > 0) {
+		client->packets_recv++;
+		client->bytes_recv += size;
+
+		// object updates are batched up at the end of the server frame, so they usually lead the
+		// datagram.  Only those are acknowledged, which is enough to keep delta updates going.
+		if ((data[0] == OBJECT_UPDATE) && (size >= HEADER_LENGTH + 2 * (int)sizeof(int) + (int)sizeof(ushort))) {
+			ushort packet_seq;
+
+			memcpy(&packet_seq, data + HEADER_LENGTH + 2 * sizeof(int), sizeof(ushort));
+			packet_seq = INTEL_SHORT(packet_seq);
+
+			multi_oo_record_seq(packet_seq, &client->acked_seq, &client->acked_mask, &client->ack_valid);
+		}
+	}
+}
+
+// fly a little further and tell the server about it
+static void multi_loadtest_send_control_info(loadtest_client *client, float frametime)
+{
+	ubyte data[MAX_PACKET_SIZE];
+	oo_control_info ctrl;
+	matrix rot, new_orient;
+	angles turn;
+
+	// turn, and keep going forward
+	turn.p = 0.0f;
+	turn.b = 0.0f;
+	turn.h = LOADTEST_TURN_RATE * frametime;
+	vm_angles_2_matrix(&rot, &turn);
+	vm_matrix_x_matrix(&new_orient, &client->orient, &rot);
+	vm_orthogonalize_matrix(&new_orient);
+	client->orient = new_orient;
+
+	vm_vec_copy_scale(&client->pi.vel, &client->orient.vec.fvec, LOADTEST_SPEED);
+	client->pi.desired_vel = client->pi.vel;
+	vm_vec_make(&client->pi.rotvel, 0.0f, LOADTEST_TURN_RATE, 0.0f);
+	client->pi.desired_rotvel = client->pi.rotvel;
+	vm_vec_scale_add2(&client->pos, &client->pi.vel, frametime);
+
+	ctrl.pos = client->pos;
+	ctrl.orient = client->orient;
+	ctrl.pi = &client->pi;
+	ctrl.target_signature = 0;
+	ctrl.frame = client->frame;
+	ctrl.ack_valid = client->ack_valid;
+	ctrl.acked_seq = client->acked_seq;
+	ctrl.acked_mask = client->acked_mask;
+
+	ctrl.button_flags = 0;
+	if ((client->frame % LOADTEST_TRIGGER_PERIOD) < (LOADTEST_TRIGGER_PERIOD / 3)) {
+		ctrl.button_flags |= OOC_TRIGGER_DOWN;
+	}
+	if ((client->frame % LOADTEST_SECONDARY_PERIOD) == 0) {
+		ctrl.button_flags |= OOC_FIRE_CONTROL_PRESSED;
+	}
+
+	int packet_size = multi_oo_build_control_info(data, &ctrl);
+
+	if (psnet_loopback_send(client->socket, data, packet_size)) {
+		client->packets_sent++;
+		client->bytes_sent += packet_size;
+	}
+
+	client->frame++;
+}
+
+static void multi_loadtest_report(std::uint64_t elapsed)
+{
+	float seconds = elapsed / 1000000.0f;
+	int packets_in = 0, packets_out = 0, bytes_in = 0, bytes_out = 0;
+
+	Multi_loadtest_metrics.num_clients = 0;
+
+	for (auto &client : Loadtest_clients) {
+		if (client.objnum >= 0) {
+			Multi_loadtest_metrics.num_clients++;
+		}
+
+		packets_in += client.packets_sent;
+		bytes_in += client.bytes_sent;
+		packets_out += client.packets_recv;
+		bytes_out += client.bytes_recv;
+
+		client.packets_sent = client.bytes_sent = client.packets_recv = client.bytes_recv = 0;
+	}
+
+	Multi_loadtest_metrics.frame_time_avg = (Loadtest_frame_count > 0) ? (Loadtest_frame_time_total / 1000.0f) / Loadtest_frame_count : 0.0f;
+	Multi_loadtest_metrics.frame_time_max = Loadtest_frame_time_max / 1000.0f;
+	Multi_loadtest_metrics.packets_in = packets_in / seconds;
+	Multi_loadtest_metrics.packets_out = packets_out / seconds;
+	Multi_loadtest_metrics.bytes_in = bytes_in / seconds;
+	Multi_loadtest_metrics.bytes_out = bytes_out / seconds;
+	Multi_loadtest_metrics.bytes_per_player = Loadtest_clients.empty() ? 0.0f : Multi_loadtest_metrics.bytes_out / Loadtest_clients.size();
+
+	Loadtest_frame_time_total = 0;
+	Loadtest_frame_time_max = 0;
+	Loadtest_frame_count = 0;
+
+	ml_printf("Load test: %d clients flying, frame %.2f ms avg / %.2f ms max, in %.0f pkt/s %.0f B/s, out %.0f pkt/s %.0f B/s, %.0f B/s per player",
+		Multi_loadtest_metrics.num_clients, Multi_loadtest_metrics.frame_time_avg, Multi_loadtest_metrics.frame_time_max,
+		Multi_loadtest_metrics.packets_in, Multi_loadtest_metrics.bytes_in, Multi_loadtest_metrics.packets_out,
+		Multi_loadtest_metrics.bytes_out, Multi_loadtest_metrics.bytes_per_player);
+}
+
+void multi_loadtest_do_frame()
+{
+	if ((Cmdline_loadtest_clients <= 0) || !(Game_mode & GM_STANDALONE_SERVER)) {
+		return;
+	}
+
+	// clients only live for the length of a mission
+	if (!(Game_mode & GM_IN_MISSION)) {
+		if (Loadtest_spawned) {
+			multi_loadtest_close();
+		}
+
+		return;
+	}
+
+	std::uint64_t now = timer_get_microseconds();
+
+	if (!Loadtest_spawned) {
+		Loadtest_spawned = true;
+
+		for (int idx = 0; idx < Cmdline_loadtest_clients; idx++) {
+			if (!multi_loadtest_add_client(idx)) {
+				ml_printf("Load test: only room for %d of %d synthetic clients, all players share MAX_PLAYERS (%d) slots", idx, Cmdline_loadtest_clients, MAX_PLAYERS);
+				break;
+			}
+		}
+
+		Loadtest_frame_start = 0;
+		Loadtest_last_report = now;
+		memset(&Multi_loadtest_metrics, 0, sizeof(Multi_loadtest_metrics));
+	}
+
+	for (auto &client : Loadtest_clients) {
+		net_player *np = &Net_players[client.net_player_num];
+
+		// kicked, or otherwise dropped by the server
+		if (!MULTI_CONNECTED(Net_players[client.net_player_num]) || !(np->flags & NETINFO_FLAG_LOADTEST)) {
+			continue;
+		}
+
+		multi_loadtest_receive(&client);
+
+		// waiting on a ship.  The confirmation goes out on the reliable channel, which we don't have, so
+		// look at what the server did with the request directly.
+		if (np->m_player->objnum < 0) {
+			if (now >= client.next_request) {
+				multi_loadtest_request_ship(&client);
+				client.next_request = now + LOADTEST_REQUEST_INTERVAL;
+			}
+			continue;
+		}
+
+		// a new ship (or a respawn), so start over from where the server put it
+		if (np->m_player->objnum != client.objnum) {
+			object *objp = &Objects[np->m_player->objnum];
+
+			client.objnum = np->m_player->objnum;
+			client.pos = objp->pos;
+			client.orient = objp->orient;
+			client.pi = objp->phys_info;
+			client.next_send = now;
+		}
+
+		// dead players don't send control info
+		if ((Objects[client.objnum].type != OBJ_SHIP) || Ships[Objects[client.objnum].instance].flags[Ship::Ship_Flags::Dying]) {
+			continue;
+		}
+
+		if (now >= client.next_send) {
+			float frametime = (now - client.next_send + LOADTEST_SEND_INTERVAL) / 1000000.0f;
+
+			multi_loadtest_send_control_info(&client, frametime);
+			client.next_send = now + LOADTEST_SEND_INTERVAL;
+		}
+	}
+
+	if (now - Loadtest_last_report >= LOADTEST_REPORT_INTERVAL) {
+		multi_loadtest_report(now - Loadtest_last_report);
+		Loadtest_last_report = now;
+	}
+}
+
+void multi_loadtest_frame_start()
+{
+	if (Loadtest_spawned) {
+		Loadtest_frame_start = timer_get_microseconds();
+	}
+}
+
+void multi_loadtest_frame_end()
+{
+	if (!Loadtest_spawned || (Loadtest_frame_start == 0)) {
+		return;
+	}
+
+	std::uint64_t frame_time = timer_get_microseconds() - Loadtest_frame_start;
+
+	Loadtest_frame_time_total += frame_time;
+	Loadtest_frame_time_max = std::max(Loadtest_frame_time_max, frame_time);
+	Loadtest_frame_count++;
+}
+
+void multi_loadtest_close()
+{
+	for (auto &client : Loadtest_clients) {
+		if (MULTI_CONNECTED(Net_players[client.net_player_num]) && (Net_players[client.net_player_num].flags & NETINFO_FLAG_LOADTEST)) {
+			delete_player(client.net_player_num);
+		}
+
+		psnet_loopback_close(client.socket);
+	}
+
+	Loadtest_clients.clear();
+	Loadtest_spawned = false;
+}
+
+void multi_loadtest_reliable_data(net_player *pl, int size)
+{
+	for (auto &client : Loadtest_clients) {
+		if (&Net_players[client.net_player_num] == pl) {
+			client.bytes_recv += size;
+			break;
+		}
+	}
+}
@@ -0,0 +1,40 @@
+#ifndef MULTI_LOADTEST_H
+#define MULTI_LOADTEST_H
+
+#include "globalincs/pstypes.h"
+
+struct net_player;
+
+// Synthetic clients for load testing a standalone server.  With "-loadtest <n>", the standalone adds n
+// fake players over the loopback interface whenever a mission starts.  They request ships and then
+// send control info and fire like real clients do, while the server gathers the numbers below.
+// The clients take ordinary player slots, so there can be no more than MAX_PLAYERS - 1 of them.
+
+// server numbers while synthetic clients are running, refreshed every few seconds
+typedef struct loadtest_metrics {
+	int num_clients;				// clients that have a ship and are flying
+	float frame_time_avg;			// milliseconds of work per server frame, not counting the frame cap sleep
+	float frame_time_max;			// milliseconds
+	float packets_in;				// per second, from the synthetic clients to the server
+	float packets_out;				// per second, from the server to the synthetic clients
+	float bytes_in;					// per second
+	float bytes_out;				// per second, unreliable and reliable together
+	float bytes_per_player;			// bytes_out divided among the synthetic clients
+} loadtest_metrics;
+
+extern loadtest_metrics Multi_loadtest_metrics;
+
+// spawn, run and clean up the synthetic clients, call once per frame on the server
+void multi_loadtest_do_frame();
+
+// bracket the work of each server frame, leaving out the frame cap sleep between them
+void multi_loadtest_frame_start();
+void multi_loadtest_frame_end();
+
+// remove all synthetic clients
+void multi_loadtest_close();
+
+// a synthetic client has no reliable socket, so the server hands its reliable data here instead
+void multi_loadtest_reliable_data(net_player *pl, int size);
+
+#endif
@@ -41,16 +41,16 @@
 
 extern const std::uint32_t MAX_TIME;
 constexpr int OO_MAIN_HEADER_SIZE = 9;  // two ints and a ubyte (recall! fix is basically an int)
+constexpr int OO_SERVER_MAIN_HEADER_SIZE = OO_MAIN_HEADER_SIZE + 2;	// the server also adds a ushort packet sequence number
 
 
-// One frame record per ship with each contained array holding one element for each frame.
-struct rollback_ship_position_records {
-	vec3d positions[MAX_FRAMES_RECORDED];							// The recorded ship positions, cur_frame_index is the index.
-	matrix orientations[MAX_FRAMES_RECORDED];						// The recorded ship orientations, cur_frame_index is the index. 
-	vec3d velocities[MAX_FRAMES_RECORDED];							// The recorded ship velocities (required for additive velocity shots and auto aim), cur_frame_index is the index.
-	vec3d rotational_velocities[MAX_FRAMES_RECORDED];				// The recorded ship rotational velocities (required for auto aim if certain ), cur_frame_index is the index.
-
-	vec3d first_pos; 												// The "last_pos" of the oldest recorded frame.
+// One record per frame, with each contained vector holding one element for each ship.  Rolling every ship back
+// to a frame then reads straight through a few arrays instead of hopping between large per-ship blocks.
+struct rollback_frame_record {
+	SCP_vector<vec3d> positions;							// The recorded ship positions, net_signature is the index.
+	SCP_vector<matrix> orientations;						// The recorded ship orientations, net_signature is the index.
+	SCP_vector<vec3d> velocities;							// The recorded ship velocities (required for additive velocity shots and auto aim), net_signature is the index.
+	SCP_vector<vec3d> rotational_velocities;				// The recorded ship rotational velocities (required for auto aim if certain ), net_signature is the index.
 };
 
 // keeps track of what has been sent to each player, helps cut down on bandwidth, allowing only new information to be sent instead of old.
@@ -77,10 +77,17 @@ struct oo_info_sent_to_players {
 	SCP_vector<float> subsystem_x;
 	SCP_vector<float> subsystem_y;
 	SCP_vector<float> subsystem_z;
+
+	oo_delta_history delta;			// the positions sent to this player, to use as baselines for delta updates.
 };
 
 struct oo_netplayer_records{
 	SCP_vector<oo_info_sent_to_players> last_sent;			// Subcategory of which player did I send this info to?  Corresponds to net_player index.
+
+	ushort packet_seq;										// the sequence number of the object update packet currently being built for this player
+	ushort acked_seq;										// the most recent object update packet the player told us they received
+	uint acked_mask;										// bit n set means packet acked_seq - n - 1 was received, too.
+	bool ack_valid;											// have we heard any acknowledgement from this player yet
 	// This is not yet implemented, but may be necessary for autoaim to work in more busy scenes.  Basically, if you're switching targets,
 	// autoaim may succeed on the client but head to the wrong target on the server.
 //	int player_target_record[MAX_FRAMES_RECORDED];			// For rollback, we need to keep track of the player's targets. Uses frame as its index.
@@ -120,7 +127,9 @@ struct oo_general_info {
 	ubyte cur_frame_index;									// the current frame index (to access the recorded info)
 
 	TIMESTAMP timestamps[MAX_FRAMES_RECORDED];					// The timestamp for the recorded frame
-	SCP_vector<rollback_ship_position_records> frame_info;		// Actually keeps track of ship physics info.  Uses net_signature as its index.
+	rollback_time_index time_index;								// Which frame number was running at each recent millisecond
+	rollback_frame_record frame_records[MAX_FRAMES_RECORDED];	// Actually keeps track of ship physics info.  Uses cur_frame_index as its index.
+	SCP_vector<vec3d> first_positions;							// The "last_pos" of the oldest recorded frame.  Uses net_signature as its index.
 	SCP_vector<oo_netplayer_records> player_frame_info;		// keeps track of player targets and what has been sent to each player. Uses player as the index
 
 	// rollback info
@@ -129,12 +138,19 @@ struct oo_general_info {
 	SCP_vector<int> rollback_weapon_object_number;						// a list of the weapons that were created, so that we can roll them into the current simulation
 
 	SCP_vector<int> rollback_ships;						// a list of ships that take part in roll back, no quick index, must be iterated through.
+	SCP_vector<ushort> rollback_ship_signatures;		// the net_signature of each ship in rollback_ships, so restoring a frame does not have to look it up
 	SCP_vector<rollback_restore_record> restore_points;	// where to move ships back to when done with rollback. no quick index, must be iterated through.
 	SCP_vector<rollback_unsimulated_shots> 
 		rollback_shots_to_be_fired[MAX_FRAMES_RECORDED];				// the shots we will need to fire and simulate during rollback, organized into the frames they will be fired
 	SCP_vector<int>rollback_collide_list;					// the list of ships and weapons that we need to pass to collision detection during rollback.
 														
 	SCP_vector<const ship_registry_entry*> rotation_list;	// subsystem rotation
+
+	// client side delta tracking
+	ushort received_packet_seq;							// the most recent object update packet received from the server
+	uint received_packet_mask;							// bit n set means packet received_packet_seq - n - 1 was received, too.
+	bool received_packet_valid;							// have we received any object update packet yet
+	SCP_vector<oo_delta_history> received_baselines;	// the positions received from the server.  Uses net_signature as its index
 };
 
 oo_general_info Oo_info;
@@ -166,6 +182,10 @@ void multi_ship_record_rank_seq_num(object* objp, int seq_num);
 // recalculate how much time is between position packets
 float multi_oo_calc_pos_time_difference(int player_id, int net_sig_idx);
 
+// turn delta compressed position updates on and off, to compare bandwidth use
+bool Multi_oo_delta_enabled = true;
+DCF_BOOL(oo_delta, Multi_oo_delta_enabled);
+
 // new improved - more compacted info type
 #define OO_POS_AND_ORIENT_NEW		(1<<0)		// To update position and orientation. Because getting accurate velocity requires orientation, and accurate orienation requires velocity
 #define OO_FULL_PHYSICS				(1<<1)		// Since AI don't use all phys_info values, we need a flag to confirm when all have been transmitted.
@@ -179,6 +199,7 @@ float multi_oo_calc_pos_time_difference(int player_id, int net_sig_idx);
 #define OO_PRIMARY_LINKED			(1<<9)		// if this is set, banks are linked
 #define OO_TRIGGER_DOWN				(1<<10)		// if this is set, trigger is DOWN
 #define OO_SUPPORT_SHIP				(1<<11)		// Send extra info for the support ship.
+#define OO_POS_DELTA				(1<<12)		// Position and orientation are a delta from a baseline the client acknowledged
 
 #define OO_SBUSYS_ROTATION_CUTOFF	0.1f		// if the squared difference between the old and new angles is less than this, don't send.
 
@@ -290,13 +311,26 @@ int OO_update_index = -1;							// The player index that allows us to look up mu
 // POSITION AND ORIENTATION RECORDING
 // if it breaks, find Cyborg17
 
-// We record positions and orientations in Oo_info.frame_info so that we can create a weapon in the same relative 
+// We record positions and orientations in Oo_info.frame_records so that we can create a weapon in the same relative 
 // circumstances as on the client.  I was directly in front, 600 meters away when I fired?  Well, now the client 
 // will tell the server that and the server will rewind part of its simulation to recreate that shot and then 
 // redo its simulation. There will still be some very small differences between server and client caused by the 
 // fact that the flFrametimes will be different, but changing that would be impossible.
 // ---------------------------------------------------------------------------------------------------
 
+// grow every frame record so that it has room for the given number of net_signatures
+static void multi_ship_record_resize(int size)
+{
+	for (auto& record : Oo_info.frame_records) {
+		record.positions.resize(size, vmd_zero_vector);
+		record.orientations.resize(size, vmd_identity_matrix);
+		record.velocities.resize(size, vmd_zero_vector);
+		record.rotational_velocities.resize(size, vmd_zero_vector);
+	}
+
+	Oo_info.first_positions.resize(size, vmd_zero_vector);
+}
+
 // Add a new ship to the tracking struct
 void multi_rollback_ship_record_add_ship(int obj_num)
 {
@@ -310,26 +344,18 @@ void multi_rollback_ship_record_add_ship(int obj_num)
 	}
 
 	// our target size is the number of ships in the vector plus one because net_signatures start at 1 and size gives the number of elements, and this should be a new element.
-	int current_size = (int)Oo_info.frame_info.size();
+	int current_size = (int)Oo_info.first_positions.size();
 	
 	if (objp->type == OBJ_SHIP) {
 		int subsystem_count = Ship_info[Ships[objp->instance].ship_info_index].n_subsystems;
 		Interp_info[obj_num].reset(subsystem_count);
 	}
 	
-	// if we're right where we should be.
-	if (net_sig_idx == current_size) {
-		Oo_info.frame_info.push_back(Oo_info.frame_info[0]);
-
-		for (int i = 0; i < MAX_PLAYERS; i++) {
-			Oo_info.player_frame_info[i].last_sent.push_back( Oo_info.player_frame_info[i].last_sent[0] );
-		}
+	// if this is a new net_signature, create the storage for it (and any skipped ones).
+	if (net_sig_idx >= current_size) {
+		multi_ship_record_resize(net_sig_idx + 1);
 
-	} // if not, create the storage for it.
-	else if (net_sig_idx > current_size) {
 		while (net_sig_idx >= current_size) {
-			Oo_info.frame_info.push_back(Oo_info.frame_info[0]);
-
 			for (int i = 0; i < MAX_PLAYERS; i++) {
 				Oo_info.player_frame_info[i].last_sent.push_back( Oo_info.player_frame_info[i].last_sent[0] );
 			}
@@ -370,11 +396,13 @@ void multi_rollback_ship_record_add_ship(int obj_num)
 	if (Game_mode & GM_IN_MISSION) {
 
 		// only add positional info if they are in the mission.
-		Oo_info.frame_info[net_sig_idx].positions[Oo_info.cur_frame_index] = objp->pos;
-		Oo_info.frame_info[net_sig_idx].first_pos = objp->last_pos;
-		Oo_info.frame_info[net_sig_idx].orientations[Oo_info.cur_frame_index] = objp->orient;
-		Oo_info.frame_info[net_sig_idx].velocities[Oo_info.cur_frame_index] = objp->phys_info.vel;
-		Oo_info.frame_info[net_sig_idx].rotational_velocities[Oo_info.cur_frame_index] = objp->phys_info.rotvel;
+		auto record = &Oo_info.frame_records[Oo_info.cur_frame_index];
+
+		record->positions[net_sig_idx] = objp->pos;
+		record->orientations[net_sig_idx] = objp->orient;
+		record->velocities[net_sig_idx] = objp->phys_info.vel;
+		record->rotational_velocities[net_sig_idx] = objp->phys_info.rotvel;
+		Oo_info.first_positions[net_sig_idx] = objp->last_pos;
 	}
 }
 
@@ -390,6 +418,16 @@ void multi_ship_record_update_all()
 	int net_sig_idx;
 	object* objp;
 
+	auto record = &Oo_info.frame_records[Oo_info.cur_frame_index];
+
+	// if we have enough frames, the oldest frame is the one after this one, and its positions are the "last_pos" of the whole record
+	int oldest_frame = 0;
+	if (Oo_info.number_of_frames > MAX_FRAMES_RECORDED) {
+		oldest_frame = (Oo_info.cur_frame_index == MAX_FRAMES_RECORDED - 1) ? 0 : Oo_info.cur_frame_index + 1;
+	}
+
+	auto oldest_record = &Oo_info.frame_records[oldest_frame];
+
 	for (ship & cur_ship : Ships) {
 		// apparently this occasionally happens.
 		if (cur_ship.objnum == -1) {
@@ -410,18 +448,12 @@ void multi_ship_record_update_all()
 			 continue;
 		}
 
-		Oo_info.frame_info[net_sig_idx].positions[Oo_info.cur_frame_index] = objp->pos;
-		Oo_info.frame_info[net_sig_idx].orientations[Oo_info.cur_frame_index] = objp->orient;
-		Oo_info.frame_info[net_sig_idx].velocities[Oo_info.cur_frame_index] = objp->phys_info.vel;
-		Oo_info.frame_info[net_sig_idx].rotational_velocities[Oo_info.cur_frame_index] = objp->phys_info.rotvel;
-
-		// if we have enough frames, set last position to the prev frame
-		if (Oo_info.number_of_frames > MAX_FRAMES_RECORDED){
-			Oo_info.frame_info[net_sig_idx].first_pos = Oo_info.frame_info[net_sig_idx].positions[(Oo_info.cur_frame_index == MAX_FRAMES_RECORDED - 1) ? 0 : Oo_info.cur_frame_index + 1];
-		} else {
-			Oo_info.frame_info[net_sig_idx].first_pos = Oo_info.frame_info[net_sig_idx].positions[0];
-		}
+		record->positions[net_sig_idx] = objp->pos;
+		record->orientations[net_sig_idx] = objp->orient;
+		record->velocities[net_sig_idx] = objp->phys_info.vel;
+		record->rotational_velocities[net_sig_idx] = objp->phys_info.rotvel;
 
+		Oo_info.first_positions[net_sig_idx] = oldest_record->positions[net_sig_idx];
 	}
 }
 
@@ -438,11 +470,45 @@ void multi_ship_record_increment_frame()
 
 	// update the rollback record for timestamps
 	Oo_info.timestamps[Oo_info.cur_frame_index] = _timestamp();
+	multi_rollback_time_index_add(&Oo_info.time_index, Oo_info.number_of_frames, Oo_info.timestamps[Oo_info.cur_frame_index]);
 
 	// Let's also now update the other timing system from multi_interpolate
 	Multi_Timing_Info.update_current_time();
 }
 
+void multi_rollback_time_index_reset(rollback_time_index *index, int frame, TIMESTAMP start)
+{
+	std::fill(std::begin(index->frames), std::end(index->frames), -1);
+	index->newest_frame = frame;
+	index->newest_start = start.value();
+}
+
+void multi_rollback_time_index_add(rollback_time_index *index, int frame, TIMESTAMP start)
+{
+	// the frame before this one ran for every millisecond up to its start, or at least the ones we have room for
+	int end = start.value();
+	int begin = std::max(index->newest_start, end - ROLLBACK_TIME_INDEX_SIZE);
+
+	for (int ms = begin; ms < end; ms++) {
+		index->frames[ms & (ROLLBACK_TIME_INDEX_SIZE - 1)] = index->newest_frame;
+	}
+
+	index->newest_frame = frame;
+	index->newest_start = end;
+}
+
+int multi_rollback_time_index_find(const rollback_time_index *index, TIMESTAMP time)
+{
+	int age = index->newest_start - time.value();
+
+	// still running, in the future, or so long ago that newer frames have overwritten it
+	if ((age <= 0) || (age > ROLLBACK_TIME_INDEX_SIZE)) {
+		return -1;
+	}
+
+	return index->frames[time.value() & (ROLLBACK_TIME_INDEX_SIZE - 1)];
+}
+
 // returns the last frame's index.
 int multi_find_prev_frame_idx() 
 {
@@ -480,68 +546,30 @@ int multi_ship_record_find_frame(int client_frame, int time_elapsed)
 		return frame;
 	};
 
-	for (int i = Oo_info.cur_frame_index - 2; i > -1; i--) {
-
-		// need to try to make rollback shot make some kind of sense if we have invalid timestamps,
-		// and print to debug if it is.	  No need to trigger the Assert in timestamp_in_between, as it is minor here. (i + 1 should be check on previous iteration, most of the time)
-		if (!Oo_info.timestamps[i].isFinite()) {
-			mprintf(("timestamps[i] is %s, get ~~Allender~~ Cyborg!\n", (Oo_info.timestamps[i].isValid()) ? "isNever" : "invalid"));
-			return frame;
-		}
-
-		// Check to see if the client's timestamp matches the recorded frames.
-		if (timestamp_in_between(target_timestamp, Oo_info.timestamps[i], Oo_info.timestamps[i + 1])) {		
-			return i;
-		}
-
-		// there is no need to check for an invalid frame here because, logically, the search cannot reach frame until the next section
-	}
-
-
-	// need to try to make rollback shot make some kind of sense if we have invalid timestamps,
-	// and print to debug if it is. No need to trigger the Assert in timestamp_in_between, as it is minor here.
-	if (!Oo_info.timestamps[MAX_FRAMES_RECORDED - 1].isFinite()) {
-			mprintf(("timestamps[MAX_FRAMES_FRAMES_RECORDED - 1] is %s, get ~~Allender~~ Cyborg!\n", (Oo_info.timestamps[MAX_FRAMES_RECORDED - 1].isValid()) ? "isNever" : "invalid"));
-			return frame;
-	}
+	int found;
 
-
-	// Check for an end of the wrap condition.
-	if (timestamp_in_between(target_timestamp, Oo_info.timestamps[MAX_FRAMES_RECORDED - 1], Oo_info.timestamps[0])) {
-		return MAX_FRAMES_RECORDED - 1;
+	// A target right at the start of the previous frame belongs to the frame before it, as the physics after the
+	// previous frame are not finished yet.
+	if (timestamp_compare(target_timestamp, Oo_info.timestamps[multi_find_prev_frame_idx()]) == 0) {
+		found = Oo_info.number_of_frames - 2;
+	} else {
+		found = multi_rollback_time_index_find(&Oo_info.time_index, target_timestamp);
 	}
 
-	// Check for the received frame being passed
-	if (frame == 0){
+	// We can only go back to frames that are still recorded, up to the frame before last, whose successor is the
+	// last one with finished physics.
+	if ((found < 0) || (found > Oo_info.number_of_frames - 2) || (Oo_info.number_of_frames - found >= MAX_FRAMES_RECORDED)) {
 		return -1;
 	}
 
-
-	// Check the oldest frames.
-	for (int i = MAX_FRAMES_RECORDED - 2; i > Oo_info.cur_frame_index; i--) {
-		// need to try to make rollback shot make some kind of sense if we have invalid timestamps,
-		// and print to debug if it is. No need to trigger the Assert in timestamp_in_between, as it is minor here.
-		if (!Oo_info.timestamps[i].isFinite()) {
-			mprintf(("timestamps[i] is %s, get ~~Allender~~ Cyborg!\n", (Oo_info.timestamps[i].isValid()) ? "isNever" : "invalid"));
-			return frame;
-		}
-
-		if (timestamp_in_between(target_timestamp, Oo_info.timestamps[i], Oo_info.timestamps[i + 1])) {
-			return i;
-		} else if (i < frame) {
-			return -1;
-		}
-	}
-
-	// shouldn't be reachable... somehow wasn't caught earlier.  Just let the old system handle this one.
-	return -1;
+	return found % MAX_FRAMES_RECORDED;
 }
 
 // Quick lookup for the record of position.
 vec3d multi_ship_record_lookup_position(object* objp, int frame) 
 {
 	Assertion(objp != nullptr, "nullptr given to multi_ship_record_lookup_position. \nThis should be handled earlier in the code, please report!");
-	return Oo_info.frame_info[objp->net_signature].positions[frame];
+	return Oo_info.frame_records[frame].positions[objp->net_signature];
 }
 
 // Quick lookup for the record of orientation.
@@ -551,7 +579,7 @@ matrix multi_ship_record_lookup_orientation(object* objp, int frame)
 	if (objp == nullptr) {
 		return vmd_identity_matrix;
 	}
-	return Oo_info.frame_info[objp->net_signature].orientations[frame];
+	return Oo_info.frame_records[frame].orientations[objp->net_signature];
 }
 
 // quickly lookup how much time has passed between two frames.
@@ -586,7 +614,7 @@ bool multi_ship_record_get_rollback_wep_mode()
 void multi_ship_record_add_rollback_wep(int wep_objnum) 
 {
 	// check for valid weapon
-	if (wep_objnum < 0 || wep_objnum >= MAX_OBJECTS){
+	if (wep_objnum < 0 || wep_objnum >= (int)Objects.size()){
 		mprintf(("Invalid object number passed when trying to add weapons to the weapon rollback tracker.\n"));
 		return;
 	}
@@ -659,6 +687,7 @@ void multi_ship_record_do_rollback()
 		}
 
 		Oo_info.rollback_ships.push_back(cur_ship.objnum);
+		Oo_info.rollback_ship_signatures.push_back((ushort)net_sig_idx);
 
 		rollback_restore_record restore_point;
 
@@ -741,6 +770,7 @@ void multi_ship_record_do_rollback()
 	Oo_info.rollback_collide_list.clear();
 	Oo_info.rollback_mode = false;
 	Oo_info.rollback_ships.clear();
+	Oo_info.rollback_ship_signatures.clear();
 	for (auto & shots_to_be_fired : Oo_info.rollback_shots_to_be_fired) {
 		shots_to_be_fired.clear();
 	}
@@ -773,27 +803,26 @@ void multi_oo_fire_rollback_shots(int frame_idx)
 // moves all rollbacked ships back to the original frame
 void multi_oo_restore_frame(int frame_idx)
 {
+	// get the prev frame
+	int temp_prev_frame = (frame_idx == 0) ? MAX_FRAMES_RECORDED - 1 : frame_idx - 1;
+
+	const auto& record = Oo_info.frame_records[frame_idx];
+
+	// because of the way collision code, we must set last_pos as well. But it gets complicated.
+	// first figure out if the current frame is actually the oldest frame on record
+	// if so, use the special first_pos value, if not (most likely), use the previous frame's position.
+	const auto& last_positions = (Oo_info.cur_frame_index == temp_prev_frame) ? Oo_info.first_positions : Oo_info.frame_records[temp_prev_frame].positions;
+
 	// set the position, orientation, and velocity for each object
-	for (auto& objnum : Oo_info.rollback_ships) {
-		object* objp = &Objects[objnum];
-		Assertion(objp != nullptr, "Nullptr somehow got into the rollback ship vector, please report!");
-		objp->pos = Oo_info.frame_info[objp->net_signature].positions[frame_idx];
-		objp->orient = Oo_info.frame_info[objp->net_signature].orientations[frame_idx];
-		objp->phys_info.vel = Oo_info.frame_info[objp->net_signature].velocities[frame_idx];
-		objp->phys_info.rotvel = Oo_info.frame_info[objp->net_signature].rotational_velocities[frame_idx];
-
-		// get the prev frame
-		int temp_prev_frame = (frame_idx == 0) ? MAX_FRAMES_RECORDED - 1 : frame_idx - 1;
-
-		// because of the way collision code, we must set last_pos as well. But it gets complicated.
-		// first figure out if the current frame is actually the oldest frame on record
-		if (Oo_info.cur_frame_index == temp_prev_frame) {
-			// if so, use the special first_pos value
-			objp->last_pos = Oo_info.frame_info[objp->net_signature].first_pos;
-		// if not (most likely), use the previous frame's position.
-		} else {
-			objp->last_pos = Oo_info.frame_info[objp->net_signature].positions[temp_prev_frame];
-		}
+	for (size_t i = 0; i < Oo_info.rollback_ships.size(); i++) {
+		object* objp = &Objects[Oo_info.rollback_ships[i]];
+		int net_sig_idx = Oo_info.rollback_ship_signatures[i];
+
+		objp->pos = record.positions[net_sig_idx];
+		objp->orient = record.orientations[net_sig_idx];
+		objp->phys_info.vel = record.velocities[net_sig_idx];
+		objp->phys_info.rotvel = record.rotational_velocities[net_sig_idx];
+		objp->last_pos = last_positions[net_sig_idx];
 	}
 }
 
@@ -911,13 +940,15 @@ void multi_ship_record_signal_update(int objnum, TIMESTAMP lower_time_limit, TIM
 		return;
 	}
 
-	auto info = &Oo_info.frame_info[Objects[objnum].net_signature];
+	int net_sig_idx = Objects[objnum].net_signature;
 
 	// now that we have valid values, we need to fix the affected values in the record.
 	do {
+		auto info = &Oo_info.frame_records[prev_index];
+
 		Interp_info[objnum].reinterpolate_previous(
 			Oo_info.timestamps[prev_index], prev_packet_index, current_packet_index,  
-			info->positions[prev_index], info->orientations[prev_index], info->velocities[prev_index], info->rotational_velocities[prev_index]
+			info->positions[net_sig_idx], info->orientations[net_sig_idx], info->velocities[net_sig_idx], info->rotational_velocities[net_sig_idx]
 			);
 		++prev_index;
 
@@ -946,6 +977,244 @@ int multi_client_lookup_frame_timestamp()
 	return Oo_info.rollback_reference_timestamp;
 }
 
+// ---------------------------------------------------------------------------------------------------
+// DELTA COMPRESSION
+// The server remembers the last few positions it sent each player for each ship, tagged with the packet
+// they went out in.  Clients acknowledge the object update packets they receive in their control info,
+// and once a packet is acknowledged, the server can send positions as a small delta from what is in it.
+
+// is sequence number a more recent than b?  Accounts for wrapping.
+static bool multi_oo_seq_newer(ushort a, ushort b)
+{
+	return (short)(a - b) > 0;
+}
+
+// record that the given packet sequence number has been received
+void multi_oo_record_seq(ushort seq, ushort *latest, uint *mask, bool *valid)
+{
+	if (!*valid) {
+		*latest = seq;
+		*mask = 0;
+		*valid = true;
+	} else if (multi_oo_seq_newer(seq, *latest)) {
+		int shift = (ushort)(seq - *latest);
+
+		if (shift > 32) {
+			*mask = 0;
+		} else if (shift == 32) {
+			*mask = 1U << 31;
+		} else {
+			*mask = (*mask << shift) | (1U << (shift - 1));
+		}
+		*latest = seq;
+	} else {
+		int age = (ushort)(*latest - seq);
+
+		if (age >= 1 && age <= 32) {
+			*mask |= 1U << (age - 1);
+		}
+	}
+}
+
+void multi_oo_delta_history_clear(oo_delta_history *history)
+{
+	for (auto &snapshot : history->snapshots) {
+		snapshot.valid = false;
+	}
+
+	history->next_slot = 0;
+	history->deltas_in_a_row = 0;
+	history->pending.valid = false;
+}
+
+static void multi_oo_delta_history_add(oo_delta_history *history, ushort packet_seq, const int *quantized)
+{
+	auto &snapshot = history->snapshots[history->next_slot];
+
+	snapshot.packet_seq = packet_seq;
+	snapshot.valid = true;
+	snapshot.acked = false;
+	memcpy(snapshot.quantized, quantized, sizeof(snapshot.quantized));
+
+	history->next_slot = (history->next_slot + 1) % OO_DELTA_HISTORY;
+}
+
+static void multi_oo_reset_netplayer_delta_info(oo_netplayer_records *record)
+{
+	record->packet_seq = 0;
+	record->acked_seq = 0;
+	record->acked_mask = 0;
+	record->ack_valid = false;
+
+	for (auto &sent : record->last_sent) {
+		multi_oo_delta_history_clear(&sent.delta);
+	}
+}
+
+// has the player told us that they received this packet?
+static bool multi_oo_packet_acked(ushort acked_seq, uint acked_mask, bool ack_valid, ushort packet_seq)
+{
+	if (!ack_valid) {
+		return false;
+	}
+
+	if (packet_seq == acked_seq) {
+		return true;
+	}
+
+	int age = (ushort)(acked_seq - packet_seq);
+
+	return (age >= 1) && (age <= 32) && (acked_mask & (1U << (age - 1)));
+}
+
+// Server only, find the most recent snapshot of this ship that the player is known to have, or nullptr if we must send a full update.
+static const oo_delta_snapshot *multi_oo_find_acked_baseline(oo_delta_history *history, ushort acked_seq, uint acked_mask, bool ack_valid)
+{
+	if (!Multi_oo_delta_enabled || history->deltas_in_a_row >= OO_DELTA_MAX_IN_A_ROW) {
+		return nullptr;
+	}
+
+	const oo_delta_snapshot *best = nullptr;
+
+	for (auto &snapshot : history->snapshots) {
+		if (!snapshot.valid) {
+			continue;
+		}
+
+		// acknowledgements only go back 32 packets, so remember them once we see them.
+		if (!snapshot.acked && multi_oo_packet_acked(acked_seq, acked_mask, ack_valid, snapshot.packet_seq)) {
+			snapshot.acked = true;
+		}
+
+		if (snapshot.acked && (best == nullptr || multi_oo_seq_newer(snapshot.packet_seq, best->packet_seq))) {
+			best = &snapshot;
+		}
+	}
+
+	return best;
+}
+
+// Server only, the delta is usually 6 to 14 bytes against the 16 of a full update.
+int multi_oo_pack_pos_orient(ubyte *data, oo_delta_history *history, ushort acked_seq, uint acked_mask, bool ack_valid, const vec3d *pos, const angles *angs, bool *delta_out)
+{
+	int quantized[OO_DELTA_COMPONENTS];
+	multi_quantize_position(pos, quantized);
+	multi_quantize_orient(angs, quantized + 3);
+
+	int packet_size = 0;
+	const oo_delta_snapshot *baseline = multi_oo_find_acked_baseline(history, acked_seq, acked_mask, ack_valid);
+
+	*delta_out = false;
+
+	if (baseline != nullptr) {
+		int ret = multi_pack_unpack_pos_orient_delta(1, data + sizeof(ushort), baseline->quantized, quantized);
+
+		if (ret > 0) {
+			ushort swap = INTEL_SHORT(baseline->packet_seq);
+			memcpy(data, &swap, sizeof(ushort));
+			packet_size = (int)sizeof(ushort) + ret;
+			history->deltas_in_a_row++;
+			*delta_out = true;
+		}
+	}
+
+	if (!*delta_out) {
+		vec3d temp_pos = *pos;
+		angles temp_angles = *angs;
+
+		packet_size = multi_pack_unpack_position(1, data, &temp_pos);	// 10 bytes
+		packet_size += multi_pack_unpack_orient(1, data + packet_size, &temp_angles);	// 6 bytes
+		history->deltas_in_a_row = 0;
+	}
+
+	// remember what we sent, so it can be a baseline once the client acknowledges it.
+	history->pending.valid = true;
+	memcpy(history->pending.quantized, quantized, sizeof(history->pending.quantized));
+
+	return packet_size;
+}
+
+void multi_oo_delta_history_commit(oo_delta_history *history, ushort packet_seq)
+{
+	if (history->pending.valid) {
+		multi_oo_delta_history_add(history, packet_seq, history->pending.quantized);
+		history->pending.valid = false;
+	}
+}
+
+// Server only, assign the snapshot packed by multi_oo_pack_data() to the packet it ended up in.
+static void multi_oo_commit_delta_snapshot(net_player *pl, object *objp)
+{
+	auto record = &Oo_info.player_frame_info[pl->player_id];
+
+	multi_oo_delta_history_commit(&record->last_sent[objp->net_signature].delta, record->packet_seq);
+}
+
+int multi_oo_unpack_pos_orient(ubyte *data, bool delta, oo_delta_history *received, ushort packet_seq, vec3d *pos, angles *angs, bool *valid_out)
+{
+	int quantized[OO_DELTA_COMPONENTS];
+	int offset = 0;
+
+	*valid_out = true;
+
+	if (delta) {
+		ushort baseline_seq;
+		memcpy(&baseline_seq, data, sizeof(ushort));
+		baseline_seq = INTEL_SHORT(baseline_seq);
+		offset += (int)sizeof(ushort);
+
+		// if we somehow lost the baseline, we still have to read past the delta, but can't use it.
+		const oo_delta_snapshot *baseline = nullptr;
+
+		if (received != nullptr) {
+			for (auto &snapshot : received->snapshots) {
+				if (snapshot.valid && snapshot.packet_seq == baseline_seq) {
+					baseline = &snapshot;
+					break;
+				}
+			}
+		}
+
+		*valid_out = (baseline != nullptr);
+		offset += multi_pack_unpack_pos_orient_delta(0, data + offset, *valid_out ? baseline->quantized : nullptr, quantized);
+
+		multi_dequantize_position(quantized, pos);
+		multi_dequantize_orient(quantized + 3, angs);
+	} else {
+		offset += multi_pack_unpack_position(0, data + offset, pos, quantized);
+		offset += multi_pack_unpack_orient(0, data + offset, angs, quantized + 3);
+	}
+
+	// keep what the server sent us so it can be used as a baseline for later deltas.
+	if (received != nullptr && *valid_out) {
+		multi_oo_delta_history_add(received, packet_seq, quantized);
+	}
+
+	return offset;
+}
+
+// Client only, the positions received from the server for the ship with this net_signature.
+static oo_delta_history *multi_oo_get_received_baselines(ushort net_sig)
+{
+	if (net_sig >= Oo_info.received_baselines.size()) {
+		oo_delta_history empty;
+		multi_oo_delta_history_clear(&empty);
+		Oo_info.received_baselines.resize(net_sig + 1, empty);
+	}
+
+	return &Oo_info.received_baselines[net_sig];
+}
+
+// Server only, start over with delta compression for a player that just joined.
+void multi_oo_reset_delta_info(net_player *pl)
+{
+	if ((pl == nullptr) || (pl->player_id < 0) || (pl->player_id >= (int)Oo_info.player_frame_info.size())) {
+		return;
+	}
+
+	multi_oo_reset_netplayer_delta_info(&Oo_info.player_frame_info[pl->player_id]);
+}
+
 // Resets what info we have sent and interpolation info for a respawn
 // To be safe, I believe that most info should be reset.
 void multi_oo_respawn_reset_info(object* objp) 
@@ -965,6 +1234,7 @@ void multi_oo_respawn_reset_info(object* objp)
 		player_record.last_sent[objp->net_signature].ai_submode = -1;
 		player_record.last_sent[objp->net_signature].target_signature = -1;
 		player_record.last_sent[objp->net_signature].perfect_shields_sent = false;
+		multi_oo_delta_history_clear(&player_record.last_sent[objp->net_signature].delta);
 		for (int i = 0; i < (int)player_record.last_sent[objp->net_signature].subsystem_health.size(); i++) {
 			player_record.last_sent[objp->net_signature].subsystem_health[i] = -1.0f;
 			player_record.last_sent[objp->net_signature].subsystem_1b[i] = -1.0f;
@@ -979,6 +1249,10 @@ void multi_oo_respawn_reset_info(object* objp)
 		}
 	}
 
+	if (objp->net_signature < Oo_info.received_baselines.size()) {
+		multi_oo_delta_history_clear(&Oo_info.received_baselines[objp->net_signature]);
+	}
+
 	// To ensure clean interpolation, we should probably just reset everything.
 	int subsystem_count = Ship_info[Ships[objp->instance].ship_info_index].n_subsystems;
 	Interp_info[OBJ_INDEX(objp)].reset(subsystem_count);
@@ -1151,6 +1425,11 @@ int multi_oo_pack_client_data(ubyte *data, ship* shipp)
 		}
 	}
 
+	// we can acknowledge object update packets once we have gotten one
+	if (Oo_info.received_packet_valid) {
+		out_flags |= OOC_PACKET_ACK;
+	}
+
 	// copy the final flags in
 	ADD_DATA( out_flags );
 
@@ -1182,6 +1461,12 @@ int multi_oo_pack_client_data(ubyte *data, ship* shipp)
 	ADD_USHORT( tnet_signature );
 	ADD_USHORT( t_subsys );
 	ADD_USHORT( l_subsys );
+
+	// tell the server which of its packets made it, so it can send positions as deltas against them
+	if (out_flags & OOC_PACKET_ACK) {
+		ADD_USHORT( Oo_info.received_packet_seq );
+		ADD_UINT( Oo_info.received_packet_mask );
+	}
 	
 	// multilock object update patch
 	ushort count = 0;
@@ -1280,22 +1565,38 @@ int multi_oo_pack_data(net_player *pl, object *objp, ushort oo_flags, ubyte *dat
 	// position - Now includes, position, orientation, velocity, rotational velocity, desired velocity and desired rotational velocity.
 	// this should always be sent when it is determined to be needed.
 	if ( oo_flags & OO_POS_AND_ORIENT_NEW ) {	
-		ret = multi_pack_unpack_position( 1, data + packet_size + header_bytes, &objp->pos ); // 10 bytes
-		packet_size += ret;
-
-		// datarate tracking.
-		multi_rate_add(NET_PLAYER_NUM(pl), "pos", ret);
-
 		// orientation (now done via angles)
 		angles temp_angles;
 		vm_extract_angles_matrix_alternate(&temp_angles, &objp->orient);	
 
-		// actual packing function, 6 bytes
-		ret = multi_pack_unpack_orient( 1, data + packet_size + header_bytes, &temp_angles); 
+		// the server sends a delta against a position the client has acknowledged when it can
+		if (MULTIPLAYER_MASTER) {
+			auto record = &Oo_info.player_frame_info[pl->player_id];
+			bool delta;
 
-		packet_size += ret;
-		// datarate tracking.
-		multi_rate_add(NET_PLAYER_NUM(pl), "ori", ret);	
+			ret = multi_oo_pack_pos_orient(data + packet_size + header_bytes, &record->last_sent[objp->net_signature].delta, record->acked_seq, record->acked_mask, record->ack_valid, &objp->pos, &temp_angles, &delta);
+			packet_size += ret;
+
+			if (delta) {
+				oo_flags |= OO_POS_DELTA;
+			}
+
+			// datarate tracking.
+			multi_rate_add(NET_PLAYER_NUM(pl), "pos", ret);
+		} else {
+			ret = multi_pack_unpack_position( 1, data + packet_size + header_bytes, &objp->pos ); // 10 bytes
+			packet_size += ret;
+
+			// datarate tracking.
+			multi_rate_add(NET_PLAYER_NUM(pl), "pos", ret);
+
+			// actual packing function, 6 bytes
+			ret = multi_pack_unpack_orient( 1, data + packet_size + header_bytes, &temp_angles); 
+
+			packet_size += ret;
+			// datarate tracking.
+			multi_rate_add(NET_PLAYER_NUM(pl), "ori", ret);	
+		}
 
 		// velocity, 4 bytes-- Tried to do this by calculation instead but kept running into issues. 
 		ret = multi_pack_unpack_vel(1, data + packet_size + header_bytes, &objp->orient, &objp->phys_info);
@@ -1534,7 +1835,7 @@ int multi_oo_pack_data(net_player *pl, object *objp, ushort oo_flags, ubyte *dat
 		PACK_INT( Ai_info[shipp->ai_index].mode );
 		PACK_INT( Ai_info[shipp->ai_index].submode );
 
-		if((Ai_info[shipp->ai_index].support_ship_objnum < 0) || (Ai_info[shipp->ai_index].support_ship_objnum >= MAX_OBJECTS)){
+		if((Ai_info[shipp->ai_index].support_ship_objnum < 0) || (Ai_info[shipp->ai_index].support_ship_objnum >= (int)Objects.size())){
 			dock_sig = 0;
 		} else {
 			dock_sig = Objects[Ai_info[shipp->ai_index].support_ship_objnum].net_signature;
@@ -1674,6 +1975,25 @@ int multi_oo_unpack_client_data(net_player* pl, ubyte* data, bool keep_data)
 	GET_USHORT(t_subsys);
 	GET_USHORT(l_subsys);
 
+	// acknowledgements are always useful, even from out of date packets
+	if (in_flags & OOC_PACKET_ACK) {
+		ushort acked_seq;
+		uint acked_mask;
+
+		GET_USHORT(acked_seq);
+		GET_UINT(acked_mask);
+
+		auto record = &Oo_info.player_frame_info[pl->player_id];
+
+		if (!record->ack_valid || multi_oo_seq_newer(acked_seq, record->acked_seq)) {
+			record->acked_seq = acked_seq;
+			record->acked_mask = acked_mask;
+			record->ack_valid = true;
+		} else if (acked_seq == record->acked_seq) {
+			record->acked_mask |= acked_mask;
+		}
+	}
+
 	if (keep_data){
 		// try and find the targeted object
 		object* tobj = nullptr;
@@ -1770,7 +2090,7 @@ int multi_oo_unpack_client_data(net_player* pl, ubyte* data, bool keep_data)
 // more recently, but the packet has the newest AI info, we will still use the AI info, even though it's not the newest
 // packet.
 #define UNPACK_PERCENT(v)					{ ubyte temp_byte; memcpy(&temp_byte, data + offset, sizeof(ubyte)); v = (float)temp_byte / 255.0f; offset++;}
-int multi_oo_unpack_data(net_player* pl, ubyte* data, int seq_num, int time_delta)
+int multi_oo_unpack_data(net_player* pl, ubyte* data, int seq_num, int time_delta, ushort packet_seq)
 {
 	int offset = 0;
 	object* pobjp;
@@ -1856,14 +2176,9 @@ int multi_oo_unpack_data(net_player* pl, ubyte* data, int seq_num, int time_delt
 	physics_info new_phys_info = pobjp->phys_info;
 
 	if ( oo_flags & OO_POS_AND_ORIENT_NEW) {
-
-		// unpack position
-		int r1 = multi_pack_unpack_position(0, data + offset, &new_pos);
-		offset += r1;
-
-		// unpack orientation
-		int r2 = multi_pack_unpack_orient( 0, data + offset, &new_angles );
-		offset += r2;
+		// clients keep what the server sent them so it can be used as a baseline for later deltas.
+		bool position_valid;
+		offset += multi_oo_unpack_pos_orient(data + offset, (oo_flags & OO_POS_DELTA) != 0, MULTIPLAYER_CLIENT ? multi_oo_get_received_baselines(net_sig) : nullptr, packet_seq, &new_pos, &new_angles, &position_valid);
 
 		// new version of the orient packer sends angles instead to save on bandwidth, so we'll need the orienation from that.
 		vm_angles_2_matrix(&new_orient, &new_angles);
@@ -1891,7 +2206,11 @@ int multi_oo_unpack_data(net_player* pl, ubyte* data, int seq_num, int time_delt
 			new_phys_info.desired_rotvel = new_phys_info.rotvel;
 		}
 
-		Interp_info[objnum].add_packet(objnum, seq_num, time_delta, &new_pos, &new_phys_info.vel, &new_phys_info.rotvel, &new_phys_info.desired_vel, &new_phys_info.desired_rotvel, &new_angles, pl->player_id);
+		if (position_valid) {
+			Interp_info[objnum].add_packet(objnum, seq_num, time_delta, &new_pos, &new_phys_info.vel, &new_phys_info.rotvel, &new_phys_info.desired_vel, &new_phys_info.desired_rotvel, &new_angles, pl->player_id);
+		} else {
+			nprintf(("Network", "Lost the delta baseline for %s, waiting for a full update.\n", shipp->ship_name));
+		}
 	}
 
 	// Packet processing needs to stop here if the ship is still arriving, leaving, dead or dying to prevent bugs.
@@ -2060,18 +2379,21 @@ int multi_oo_unpack_data(net_player* pl, ubyte* data, int seq_num, int time_delt
 					if (flags[i] & OO_SUBSYS_ROTATION_1) {
 						vm_angles_2_matrix(&subsysp->submodel_instance_1->canonical_prev_orient, &prev_angs_1);
 						vm_angles_2_matrix(&subsysp->submodel_instance_1->canonical_orient, &angs_1);
+						submodel_instance_moved(subsysp->submodel_instance_1);
 					}
 
 					// fix up the subsystem orientation matrixes based on received data
 					if (flags[i] & OO_SUBSYS_ROTATION_2) {
 						vm_angles_2_matrix(&subsysp->submodel_instance_2->canonical_prev_orient, &prev_angs_2);
 						vm_angles_2_matrix(&subsysp->submodel_instance_2->canonical_orient, &angs_2);
+						submodel_instance_moved(subsysp->submodel_instance_2);
 					}
 
 					if (flags[i] & OO_SUBSYS_TRANSLATION_x) {
 						if (animations_valid) {
 							subsysp->submodel_instance_1->canonical_prev_offset.xyz.x = subsysp->submodel_instance_1->canonical_offset.xyz.x;
 							subsysp->submodel_instance_1->canonical_offset.xyz.x = subsys_data[data_idx];
+							submodel_instance_moved(subsysp->submodel_instance_1);
 						}
 
 						data_idx++;
@@ -2081,6 +2403,7 @@ int multi_oo_unpack_data(net_player* pl, ubyte* data, int seq_num, int time_delt
 						if (animations_valid) {						
 							subsysp->submodel_instance_1->canonical_prev_offset.xyz.y = subsysp->submodel_instance_1->canonical_offset.xyz.y;
 							subsysp->submodel_instance_1->canonical_offset.xyz.y = subsys_data[data_idx];
+							submodel_instance_moved(subsysp->submodel_instance_1);
 						}
 
 						data_idx++;
@@ -2090,6 +2413,7 @@ int multi_oo_unpack_data(net_player* pl, ubyte* data, int seq_num, int time_delt
 						if (animations_valid) {						
 							subsysp->submodel_instance_1->canonical_prev_offset.xyz.z = subsysp->submodel_instance_1->canonical_offset.xyz.z;
 							subsysp->submodel_instance_1->canonical_offset.xyz.z = subsys_data[data_idx];
+							submodel_instance_moved(subsysp->submodel_instance_1);
 						}
 
 						data_idx++;
@@ -2481,6 +2805,8 @@ void multi_oo_process_all(net_player *pl)
 	// build the list of ships to check against
 	multi_oo_build_ship_list(pl);
 
+	auto record = &Oo_info.player_frame_info[pl->player_id];
+
 	// build the header
 	BUILD_HEADER(OBJECT_UPDATE);		
 
@@ -2490,6 +2816,7 @@ void multi_oo_process_all(net_player *pl)
 	int time_out = Multi_Timing_Info.get_current_time();
 
 	ADD_INT(time_out);
+	ADD_USHORT(record->packet_seq);
 
 	ubyte stop;
 	int add_size;	
@@ -2512,6 +2839,7 @@ void multi_oo_process_all(net_player *pl)
 
 			memcpy(data + packet_size, data_add, add_size);
 			packet_size += add_size;		
+			multi_oo_commit_delta_snapshot(pl, targ_obj);
 		}
 	}
 	
@@ -2541,12 +2869,14 @@ void multi_oo_process_all(net_player *pl)
 			multi_io_send(pl, data, packet_size);
 			packet_sent = true;
 			pl->s_info.rate_bytes += packet_size + UDP_HEADER_SIZE;
+			record->packet_seq++;
 
 			packet_size = 0;
 			BUILD_HEADER(OBJECT_UPDATE);
 			// Cyborg17 - regurgitate shared header
 			ADD_INT(Oo_info.number_of_frames);
 			ADD_INT(time_out);
+			ADD_USHORT(record->packet_seq);
 		}
 
 		if(add_size){
@@ -2557,6 +2887,7 @@ void multi_oo_process_all(net_player *pl)
 			// copy in the data
 			memcpy(data + packet_size,data_add,add_size);
 			packet_size += add_size;
+			multi_oo_commit_delta_snapshot(pl, moveup);
 		}
 
 		// next ship
@@ -2564,13 +2895,14 @@ void multi_oo_process_all(net_player *pl)
 	}
 
 	// Cyborg17 - Now that this is basically an object update and timing update packet, we always should send at least one.
-	if (packet_size > OO_MAIN_HEADER_SIZE || !packet_sent) {
+	if (packet_size > OO_SERVER_MAIN_HEADER_SIZE || !packet_sent) {
 		stop = 0x00;		
 		multi_rate_add(NET_PLAYER_NUM(pl), "stp", 1);
 		ADD_DATA(stop);
 
 		multi_io_send(pl, data, packet_size);
 		pl->s_info.rate_bytes += packet_size + UDP_HEADER_SIZE;
+		record->packet_seq++;
 	}
 }
 
@@ -2614,16 +2946,24 @@ void multi_oo_process_update(ubyte *data, header *hinfo)
 
 	int seq_num;
 	int timestamp;
+	ushort packet_seq = 0;
 	ubyte stop;	
 
 	// TODO: ADD COMPLICATED TIMESTAMP LOGIC HERE
 	GET_INT(seq_num);
 	GET_INT(timestamp);
+
+	// packets from the server are numbered so that we can acknowledge them
+	if (MULTIPLAYER_CLIENT) {
+		GET_USHORT(packet_seq);
+		multi_oo_record_seq(packet_seq, &Oo_info.received_packet_seq, &Oo_info.received_packet_mask, &Oo_info.received_packet_valid);
+	}
+
 	GET_DATA(stop);
 	
 	while(stop == 0xff){
 		// process the data
-		offset += multi_oo_unpack_data(pl, data + offset, seq_num, timestamp);
+		offset += multi_oo_unpack_data(pl, data + offset, seq_num, timestamp, packet_seq);
 
 		GET_DATA(stop);
 	}
@@ -2650,10 +2990,13 @@ void multi_init_oo_and_ship_tracker()
 		Oo_info.timestamps[i] = _timestamp(); // as of Interpolate overhaul 2, this can be something besides infinite
 	}
 
+	multi_rollback_time_index_reset(&Oo_info.time_index, 0, Oo_info.timestamps[0]);
+
 	Oo_info.rollback_mode = false;
 	Oo_info.rollback_weapon_object_number.clear();
 	Oo_info.rollback_collide_list.clear();
 	Oo_info.rollback_ships.clear();
+	Oo_info.rollback_ship_signatures.clear();
 
 	for (int i = 0; i < MAX_FRAMES_RECORDED; i++) { // NOLINT
 		Oo_info.rollback_shots_to_be_fired[i].clear();
@@ -2661,24 +3004,26 @@ void multi_init_oo_and_ship_tracker()
 	}
 
 	// Part 2: Init/Reset the repeating parts of the struct. 
-	Oo_info.frame_info.clear();		
+	for (auto& record : Oo_info.frame_records) {
+		record.positions.clear();
+		record.orientations.clear();
+		record.velocities.clear();
+		record.rotational_velocities.clear();
+
+		// Reserving up to a reasonable number of ships here should help optimize a little bit.
+		record.positions.reserve(MAX_SHIPS);
+		record.orientations.reserve(MAX_SHIPS);
+		record.velocities.reserve(MAX_SHIPS);
+		record.rotational_velocities.reserve(MAX_SHIPS);
+	}
+	Oo_info.first_positions.clear();
+	Oo_info.first_positions.reserve(MAX_SHIPS);
 	Oo_info.player_frame_info.clear();
 
-	Oo_info.frame_info.reserve(MAX_SHIPS); // Reserving up to a reasonable number of ships here should help optimize a little bit.
 	Oo_info.player_frame_info.reserve(MAX_PLAYERS); // Reserve up to the max players
 
-	rollback_ship_position_records temp_position_records;
 	oo_netplayer_records temp_netplayer_records;
 
-	for (int i = 0; i < MAX_FRAMES_RECORDED; i++) {
-		temp_position_records.orientations[i] = vmd_identity_matrix;
-		temp_position_records.positions[i] = vmd_zero_vector;
-		temp_position_records.velocities[i] = vmd_zero_vector;
-		temp_position_records.rotational_velocities[i] = vmd_zero_vector;
-	}
-
-	temp_position_records.first_pos = vmd_zero_vector;
-
 	int cur = 0;
 	oo_info_sent_to_players temp_sent_to_player;
 
@@ -2689,6 +3034,7 @@ void multi_init_oo_and_ship_tracker()
 	temp_sent_to_player.ai_submode = -1;
 	temp_sent_to_player.target_signature = 0;
 	temp_sent_to_player.perfect_shields_sent = false;
+	multi_oo_delta_history_clear(&temp_sent_to_player.delta);
 
 	// See if *any* of the subsystems changed, so we have to allow for a variable number of subsystems within a variable number of ships.
 	temp_sent_to_player.subsystem_health.reserve(MAX_MODEL_SUBSYSTEMS);
@@ -2722,7 +3068,15 @@ void multi_init_oo_and_ship_tracker()
 	temp_sent_to_player.subsystem_z.push_back(0.0f);
 
 	temp_netplayer_records.last_sent.push_back(temp_sent_to_player);
-	Oo_info.frame_info.push_back(temp_position_records);
+	multi_oo_reset_netplayer_delta_info(&temp_netplayer_records);
+
+	// net_signature 0 is never used, but keeps the indexes lined up
+	multi_ship_record_resize(1);
+
+	Oo_info.received_packet_seq = 0;
+	Oo_info.received_packet_mask = 0;
+	Oo_info.received_packet_valid = false;
+	Oo_info.received_baselines.clear();
 	
 	for (int i = 0; i < MAX_PLAYERS; i++) {
 		Oo_info.player_frame_info.push_back(temp_netplayer_records);
@@ -2757,6 +3111,8 @@ void multi_close_oo_and_ship_tracker()
 		Oo_info.timestamps[i] = _timestamp(); // // as of Interpolate overhaul 2, this can be something besides infinite
 	}
 
+	multi_rollback_time_index_reset(&Oo_info.time_index, 0, Oo_info.timestamps[0]);
+
 	Oo_info.rollback_mode = false;
 	Oo_info.rollback_weapon_object_number.clear();
 	Oo_info.rollback_weapon_object_number.shrink_to_fit();
@@ -2764,6 +3120,8 @@ void multi_close_oo_and_ship_tracker()
 	Oo_info.rollback_collide_list.shrink_to_fit();
 	Oo_info.rollback_ships.clear();
 	Oo_info.rollback_ships.shrink_to_fit();
+	Oo_info.rollback_ship_signatures.clear();
+	Oo_info.rollback_ship_signatures.shrink_to_fit();
 
 	for (int i = 0; i < MAX_FRAMES_RECORDED; i++) { // NOLINT
 		Oo_info.rollback_shots_to_be_fired[i].clear();
@@ -2771,10 +3129,24 @@ void multi_close_oo_and_ship_tracker()
 	}
 
 	// Part 2: Init/Reset the repeating parts of the struct.
-	Oo_info.frame_info.clear();
-	Oo_info.frame_info.shrink_to_fit();
+	for (auto& record : Oo_info.frame_records) {
+		record.positions.clear();
+		record.positions.shrink_to_fit();
+		record.orientations.clear();
+		record.orientations.shrink_to_fit();
+		record.velocities.clear();
+		record.velocities.shrink_to_fit();
+		record.rotational_velocities.clear();
+		record.rotational_velocities.shrink_to_fit();
+	}
+	Oo_info.first_positions.clear();
+	Oo_info.first_positions.shrink_to_fit();
 	Oo_info.player_frame_info.clear();
 	Oo_info.player_frame_info.shrink_to_fit();
+
+	Oo_info.received_packet_valid = false;
+	Oo_info.received_baselines.clear();
+	Oo_info.received_baselines.shrink_to_fit();
 }
 
 
@@ -2831,6 +3203,82 @@ void multi_oo_send_control_info()
 	}
 }
 
+// Builds the same control info packet multi_oo_send_control_info() sends, but from the passed in
+// state instead of the local player, so synthetic load test clients can speak the real protocol.
+int multi_oo_build_control_info(ubyte *data, oo_control_info *ctrl)
+{
+	ubyte stop, out_flags;
+	ushort oo_flags, data_size;
+	int packet_size = 0;
+
+	BUILD_HEADER(OBJECT_UPDATE);
+
+	ADD_INT(ctrl->frame);
+
+	int time_out = Multi_Timing_Info.get_current_time();
+
+	ADD_INT(time_out);
+
+	stop = 0xff;
+	ADD_DATA(stop);
+
+	// leave room for the flags and size, which we only know at the end
+	int section_start = packet_size;
+	packet_size += 2 * sizeof(ushort);
+
+	// client specific info, in the order multi_oo_pack_client_data() uses
+	out_flags = ctrl->button_flags;
+	if (ctrl->ack_valid) {
+		out_flags |= OOC_PACKET_ACK;
+	}
+	ADD_DATA(out_flags);
+
+	ushort no_subsys = OOC_INDEX_NULLPTR_SUBSYSEM;
+	ADD_USHORT(ctrl->target_signature);
+	ADD_USHORT(no_subsys);
+	ADD_USHORT(no_subsys);
+
+	if (ctrl->ack_valid) {
+		ADD_USHORT(ctrl->acked_seq);
+		ADD_UINT(ctrl->acked_mask);
+	}
+
+	// no missile locks
+	ushort count = 0;
+	ADD_USHORT(count);
+
+	// position, orientation and physics, exactly as multi_oo_pack_data() does it for a player ship
+	angles temp_angles;
+	vm_extract_angles_matrix_alternate(&temp_angles, &ctrl->orient);
+
+	packet_size += multi_pack_unpack_position(1, data + packet_size, &ctrl->pos);
+	packet_size += multi_pack_unpack_orient(1, data + packet_size, &temp_angles);
+	packet_size += multi_pack_unpack_vel(1, data + packet_size, &ctrl->orient, ctrl->pi);
+	packet_size += multi_pack_unpack_rotvel(1, data + packet_size, ctrl->pi);
+
+	vec3d local_desired_vel;
+	vm_vec_rotate(&local_desired_vel, &ctrl->pi->desired_vel, &ctrl->orient);
+	packet_size += multi_pack_unpack_desired_vel_and_desired_rotvel(1, true, data + packet_size, ctrl->pi, &local_desired_vel);
+
+	// now go back and fill in the section header
+	oo_flags = OO_POS_AND_ORIENT_NEW | OO_FULL_PHYSICS;
+	if (ctrl->pi->flags & PF_AFTERBURNER_ON) {
+		oo_flags |= OO_AFTERBURNER_NEW;
+	}
+	data_size = (ushort)(packet_size - section_start - 2 * sizeof(ushort));
+
+	ushort swap = INTEL_SHORT(oo_flags);
+	memcpy(data + section_start, &swap, sizeof(ushort));
+	swap = INTEL_SHORT(data_size);
+	memcpy(data + section_start + sizeof(ushort), &swap, sizeof(ushort));
+
+	// add the final stop byte
+	stop = 0x0;
+	ADD_DATA(stop);
+
+	return packet_size;
+}
+
 // Sends a packet from the server to the client, syncing the player's position/orientation to the
 // Server's. Allows for use of certain SEXPs in multiplayer.
 void multi_oo_send_changed_object(object *changedobj)
@@ -2866,6 +3314,9 @@ void multi_oo_send_changed_object(object *changedobj)
 
 	ADD_INT(time_out);
 
+	auto record = &Oo_info.player_frame_info[Net_players[idx].player_id];
+	ADD_USHORT(record->packet_seq);
+
 	// pos and orient always
 	oo_flags = (OO_POS_AND_ORIENT_NEW);
 
@@ -2881,6 +3332,7 @@ void multi_oo_send_changed_object(object *changedobj)
 
 		memcpy(data + packet_size, data_add, add_size);
 		packet_size += add_size;		
+		multi_oo_commit_delta_snapshot(&Net_players[idx], changedobj);
 	}
 
 	// add the final stop byte
@@ -2889,6 +3341,7 @@ void multi_oo_send_changed_object(object *changedobj)
 	ADD_DATA(stop);
 
 	multi_io_send(&Net_players[idx], data, packet_size);
+	record->packet_seq++;
 }
 
 
@@ -16,6 +16,7 @@
 // OBJECT UPDATE DEFINES/VARS
 //
 #include "globalincs/pstypes.h"
+#include "network/multiutil.h"
 
 class object;
 struct header;
@@ -32,7 +33,8 @@ class TIMESTAMP;
 #define OOC_PRIMARY_BANK			(1<<3)
 #define OOC_PRIMARY_LINKED			(1<<4)
 #define OOC_AFTERBURNER_ON			(1<<5)
-// two spots now left for more OOC flags
+#define OOC_PACKET_ACK				(1<<6)		// client is acknowledging object update packets from the server
+// one spot now left for more OOC flags
 
 // Cyborg17, Server will be tracking only the last 0.5-1.0 second of frames
 #define MAX_FRAMES_RECORDED		30
@@ -75,6 +77,27 @@ void multi_ship_record_increment_frame();
 // find the right frame to start our weapon simulation
 int multi_ship_record_find_frame(int client_frame, int time_elapsed);
 
+// How many milliseconds back the rollback frame lookup reaches, must be a power of two
+#define ROLLBACK_TIME_INDEX_SIZE	4096
+
+// Which frame was running at each millisecond, so that the frame a client shot in can be found without a search.
+// Indexed by timestamp value, wrapping every ROLLBACK_TIME_INDEX_SIZE milliseconds.
+struct rollback_time_index {
+	int frames[ROLLBACK_TIME_INDEX_SIZE];		// frame number (not ring index), or -1 before the first frame
+	int newest_frame;							// the frame that is still running
+	int newest_start;							// and the timestamp value it started at
+};
+
+// start over with the given first frame
+void multi_rollback_time_index_reset(rollback_time_index *index, int frame, TIMESTAMP start);
+
+// a new frame started, which also ends the one before it
+void multi_rollback_time_index_add(rollback_time_index *index, int frame, TIMESTAMP start);
+
+// returns the number of the frame that was running at the given time, or -1 if that is the frame still running,
+// or the time is in the future, before the first frame or more than ROLLBACK_TIME_INDEX_SIZE milliseconds ago.
+int multi_rollback_time_index_find(const rollback_time_index *index, TIMESTAMP time);
+
 // a quick lookups for position and orientation
 vec3d multi_ship_record_lookup_position(object* objp, int frame);
 
@@ -134,10 +157,67 @@ void multi_close_oo_and_ship_tracker();
 void multi_oo_send_control_info();
 void multi_oo_send_changed_object(object *changedobj);
 
+// what a client reports about its ship in a control info packet
+typedef struct oo_control_info {
+	vec3d pos;
+	matrix orient;
+	physics_info *pi;
+	ubyte button_flags;			// OOC_* flags
+	ushort target_signature;
+	int frame;					// the client's own frame count
+	bool ack_valid;
+	ushort acked_seq;			// newest object update packet received, and a mask of the ones before it
+	uint acked_mask;
+} oo_control_info;
+
+// build a control info packet from the given state rather than the local player, returns its size
+int multi_oo_build_control_info(ubyte *data, oo_control_info *ctrl);
+
 
 // reset all sequencing info
 void multi_oo_reset_sequencing();
 
+// start delta compressed position updates over for a player, call when they join
+void multi_oo_reset_delta_info(net_player *pl);
+
+// record that an object update packet was received, into the newest sequence number and the mask of the 32 before it
+void multi_oo_record_seq(ushort seq, ushort *latest, uint *mask, bool *valid);
+
+// How many position/orientation snapshots we remember per ship so that we can send deltas against one the client has acknowledged.
+#define OO_DELTA_HISTORY			8
+// Send a full position at least this often, so that a client which somehow lost its baseline can recover.
+#define OO_DELTA_MAX_IN_A_ROW		16
+
+// One quantized position and orientation, tagged with the object update packet it was sent in.
+struct oo_delta_snapshot {
+	ushort packet_seq;							// which packet this was sent or received in
+	bool valid;									// has this slot been filled yet
+	bool acked;									// server only, has the client confirmed that it received this packet
+	int quantized[OO_DELTA_COMPONENTS];			// position then angles, see multi_quantize_position() and multi_quantize_orient()
+};
+
+// The most recent snapshots of one ship, either sent to a player (server) or received from the server (client).
+struct oo_delta_history {
+	oo_delta_snapshot snapshots[OO_DELTA_HISTORY];
+	int next_slot;								// the slot the next snapshot will overwrite
+	int deltas_in_a_row;						// server only, how many deltas were sent since the last full update
+	oo_delta_snapshot pending;					// server only, packed but not yet assigned to an outgoing packet
+};
+
+void multi_oo_delta_history_clear(oo_delta_history *history);
+
+// Server only, packs a position and orientation, as a delta against the newest snapshot in history that the client
+// acknowledged if there is one, or in full.  Returns the number of bytes written and whether it was a delta.
+int multi_oo_pack_pos_orient(ubyte *data, oo_delta_history *history, ushort acked_seq, uint acked_mask, bool ack_valid, const vec3d *pos, const angles *angs, bool *delta_out);
+
+// Server only, remember the snapshot packed by multi_oo_pack_pos_orient() as sent in the given packet.
+void multi_oo_delta_history_commit(oo_delta_history *history, ushort packet_seq);
+
+// Unpacks a position and orientation sent by multi_oo_pack_pos_orient() in the given packet, and remembers it in received
+// as a baseline for later deltas, if received is not null.  Returns the number of bytes read.  valid_out is false if
+// the delta's baseline was lost, in which case pos and angs must not be used.
+int multi_oo_unpack_pos_orient(ubyte *data, bool delta, oo_delta_history *received, ushort packet_seq, vec3d *pos, angles *angs, bool *valid_out);
+
 
 // ---------------------------------------------------------------------------------------------------
 // DATARATE DEFINES/VARS
@@ -794,7 +794,7 @@ void multi_respawn_place(object *new_obj, int team)
 		if((Multi_respawn_priority_ships[idx].team == team) || !(Netgame.type_flags & NG_TYPE_TEAM)){
 
 			lookup = ship_name_lookup(Multi_respawn_priority_ships[idx].ship_name);
-			if( (lookup >= 0) && ((pri == NULL) || (Ships[lookup].respawn_priority > pri->respawn_priority)) && (Ships[lookup].objnum >= 0) && (Ships[lookup].objnum < MAX_OBJECTS)){
+			if( (lookup >= 0) && ((pri == NULL) || (Ships[lookup].respawn_priority > pri->respawn_priority)) && (Ships[lookup].objnum >= 0) && (Ships[lookup].objnum < (int)Objects.size())){
 				pri = &Ships[lookup];
 				pri_obj = &Objects[Ships[lookup].objnum];
 			}
@@ -60,7 +60,7 @@ public:
     void add_incoming_packet(int time_in, int parent_ship, short subsys_index, ushort target_netsig, std::pair<bool, float> ang1_in, std::pair<bool, float> ang2_in) 
     {
         // if the data is nonsense, return
-        if (parent_ship < 0 || parent_ship > MAX_OBJECTS || Objects[parent_ship].net_signature == 0){
+        if (parent_ship < 0 || parent_ship >= (int)Objects.size() || Objects[parent_ship].net_signature == 0){
             return;
         }
 
@@ -77,6 +77,7 @@
 #include "network/multi_sw.h"
 #include "network/multi_sexp.h"
 #include "network/multi_mdns.h"
+#include "network/multi_loadtest.h"
 #include "mission/missiongoals.h"
 #include "network/multi_interpolate.h"
 #include "network/multi_turret_manager.h"
@@ -546,6 +547,13 @@ void multi_io_send_reliable_force(net_player *pl)
 		return;
 	}
 
+	// synthetic load test clients have no reliable socket, just account for the data
+	if(pl->flags & NETINFO_FLAG_LOADTEST){
+		multi_loadtest_reliable_data(pl, pl->s_info.reliable_buffer_size);
+		pl->s_info.reliable_buffer_size = 0;
+		return;
+	}
+
 	// send everything in 
 	if(MULTIPLAYER_MASTER) {
 		psnet_rel_send(pl->reliable_socket, pl->s_info.reliable_buffer, pl->s_info.reliable_buffer_size, NET_PLAYER_NUM(pl));
@@ -4676,7 +4684,7 @@ void process_subsystem_destroyed_packet( ubyte *data, header *hinfo )
 		}
 
 		// Cyborg17 - We need to do this here because otherwise FSO will not mark subsystem strength as zero (It used to rely on the object Update packet)
-		subsysp->current_hits = 0;
+		ship_subsys_set_hits(shipp, subsysp, 0.0f);
 
 		vm_vec_unrotate( &world_hit_pos, &local_hit_pos, &objp->orient );
 		vm_vec_add2( &world_hit_pos, &objp->pos );
@@ -9079,7 +9087,7 @@ void process_self_destruct_packet(ubyte *data, header *hinfo)
 	if(Net_players[np_index].m_player == NULL){
 		return;
 	}
-	if((Net_players[np_index].m_player->objnum < 0) || (Net_players[np_index].m_player->objnum >= MAX_OBJECTS)){
+	if((Net_players[np_index].m_player->objnum < 0) || (Net_players[np_index].m_player->objnum >= (int)Objects.size())){
 		return;
 	}
 	if(Objects[Net_players[np_index].m_player->objnum].net_signature != net_sig){
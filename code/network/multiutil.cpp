@@ -603,7 +603,7 @@ int multi_find_player_by_ship_name(const char *ship_name, bool inc_respawning)
 	}
 
 	for(idx=0; idx<MAX_PLAYERS; idx++){
-		if(MULTI_CONNECTED(Net_players[idx]) && !MULTI_OBSERVER(Net_players[idx]) && (Net_players[idx].m_player != nullptr) && (Net_players[idx].m_player->objnum >= 0) && (Net_players[idx].m_player->objnum < MAX_OBJECTS) && (Objects[Net_players[idx].m_player->objnum].type == OBJ_SHIP) && 
+		if(MULTI_CONNECTED(Net_players[idx]) && !MULTI_OBSERVER(Net_players[idx]) && (Net_players[idx].m_player != nullptr) && (Net_players[idx].m_player->objnum >= 0) && (Net_players[idx].m_player->objnum < (int)Objects.size()) && (Objects[Net_players[idx].m_player->objnum].type == OBJ_SHIP) && 
 			(Objects[Net_players[idx].m_player->objnum].instance >= 0) && (Objects[Net_players[idx].m_player->objnum].instance < MAX_SHIPS) && !stricmp(ship_name, Ships[Objects[Net_players[idx].m_player->objnum].instance].ship_name) ){
 			return idx;
 		}
@@ -630,7 +630,7 @@ int multi_get_player_ship(int np_index)
 
 	// cool?
 	if(MULTI_CONNECTED(Net_players[np_index]) && !MULTI_OBSERVER(Net_players[np_index]) && !MULTI_STANDALONE(Net_players[np_index]) && 
-		(Net_players[np_index].m_player != nullptr) && (Net_players[np_index].m_player->objnum >= 0) && (Net_players[np_index].m_player->objnum < MAX_OBJECTS) && (Objects[Net_players[np_index].m_player->objnum].type == OBJ_SHIP) && 
+		(Net_players[np_index].m_player != nullptr) && (Net_players[np_index].m_player->objnum >= 0) && (Net_players[np_index].m_player->objnum < (int)Objects.size()) && (Objects[Net_players[np_index].m_player->objnum].type == OBJ_SHIP) && 
 		(Objects[Net_players[np_index].m_player->objnum].instance >= 0) && (Objects[Net_players[np_index].m_player->objnum].instance < MAX_SHIPS) ){
 
 		return Objects[Net_players[np_index].m_player->objnum].instance;
@@ -969,7 +969,7 @@ void delete_player(int player_num,int kicked_reason)
 		}
 	} else {
 		// otherwise mark it so that he can return to it later if possible
-		if ( (Net_players[player_num].m_player->objnum >= 0) && (Net_players[player_num].m_player->objnum < MAX_OBJECTS) && (Objects[Net_players[player_num].m_player->objnum].type == OBJ_SHIP) && (Objects[Net_players[player_num].m_player->objnum].instance >= 0) && (Objects[Net_players[player_num].m_player->objnum].instance < MAX_SHIPS)) {
+		if ( (Net_players[player_num].m_player->objnum >= 0) && (Net_players[player_num].m_player->objnum < (int)Objects.size()) && (Objects[Net_players[player_num].m_player->objnum].type == OBJ_SHIP) && (Objects[Net_players[player_num].m_player->objnum].instance >= 0) && (Objects[Net_players[player_num].m_player->objnum].instance < MAX_SHIPS)) {
 			multi_make_player_ai( &Objects[Net_players[player_num].m_player->objnum] );
 		} else {
 			multi_respawn_player_leave(&Net_players[player_num]);
@@ -3379,44 +3379,88 @@ int bitbuffer_get_signed( bitbuffer *bitbuf, int bit_count )
 	
 
 
+// Quantizes a position the same way multi_pack_unpack_position() does, so that the values can be used
+// as a baseline for multi_pack_unpack_pos_orient_delta().
+void multi_quantize_position(const vec3d *pos, int *quantized)
+{
+	quantized[0] = (int)round(pos->xyz.x*512.0f);
+	quantized[1] = (int)round(pos->xyz.y*512.0f);
+	quantized[2] = (int)round(pos->xyz.z*512.0f);
+	CAP(quantized[0], -67108864, 67108863);
+	CAP(quantized[1], -33554432, 33554431);
+	CAP(quantized[2], -67108864, 67108863);
+}
+
+void multi_dequantize_position(const int *quantized, vec3d *pos)
+{
+	pos->xyz.x = i2fl(quantized[0])/512.0f;
+	pos->xyz.y = i2fl(quantized[1])/512.0f;
+	pos->xyz.z = i2fl(quantized[2])/512.0f;
+}
+
+// set up some constants to facilitate orientation compression
+constexpr float OO_ORIENT_SCALE = 32768.0f / PI;
+constexpr int OO_ORIENT_MIN_RANGE = -32768;
+constexpr int OO_ORIENT_MAX_RANGE = 32767;
+
+// Quantizes angles the same way multi_pack_unpack_orient() does.
+void multi_quantize_orient(const angles *angs, int *quantized)
+{
+	// Subtract PI/2 because the output of vm_extract_angles_matrix is from -PI/2 to 3PI/2
+	quantized[0] = fl2i(round((angs->b/* - PI/2*/) * OO_ORIENT_SCALE));
+	quantized[1] = fl2i(round((angs->h/* - PI/2*/) * OO_ORIENT_SCALE));
+	quantized[2] = fl2i(round((angs->p/* - PI/2*/) * OO_ORIENT_SCALE));
+	CAP(quantized[0], OO_ORIENT_MIN_RANGE, OO_ORIENT_MAX_RANGE);
+	CAP(quantized[1], OO_ORIENT_MIN_RANGE, OO_ORIENT_MAX_RANGE);
+	CAP(quantized[2], OO_ORIENT_MIN_RANGE, OO_ORIENT_MAX_RANGE);
+}
+
+void multi_dequantize_orient(const int *quantized, angles *angs)
+{
+	angs->b =/* PI/2 +*/ (i2fl(quantized[0])/OO_ORIENT_SCALE);
+	angs->h =/* PI/2 +*/ (i2fl(quantized[1])/OO_ORIENT_SCALE);
+	angs->p =/* PI/2 +*/ (i2fl(quantized[2])/OO_ORIENT_SCALE);
+}
+
 // Packs/unpacks an object position.
 // Returns number of bytes read or written.
 // Cyborg17 This packer saves 2 bytes over sending the whole vector.  
 // It now has a maximum effective range of ~130k in the x and z and ~65K in the y
-int multi_pack_unpack_position( int write, ubyte *data, vec3d *pos)
+int multi_pack_unpack_position( int write, ubyte *data, vec3d *pos, int *quantized_out)
 {
 	bitbuffer buf;
 
 	bitbuffer_init(&buf,data);
 
-	int a, b, c;
+	int q[3];
 
 	if ( write )	{
 
 		// Output pos
-		a = (int)round(pos->xyz.x*512.0f);
-		b = (int)round(pos->xyz.y*512.0f); 
-		c = (int)round(pos->xyz.z*512.0f);
-		CAP(a, -67108864, 67108863);		
-		CAP(b, -33554432, 33554431);		
-		CAP(c, -67108864, 67108863);		
-		
-		bitbuffer_put( &buf, (uint)a, 27 );
-		bitbuffer_put( &buf, (uint)b, 26 ); // Cyborg17 this is set to 26 bits on purpose.			
-		bitbuffer_put( &buf, (uint)c, 27 );
+		multi_quantize_position(pos, q);
+
+		bitbuffer_put( &buf, (uint)q[0], 27 );
+		bitbuffer_put( &buf, (uint)q[1], 26 ); // Cyborg17 this is set to 26 bits on purpose.			
+		bitbuffer_put( &buf, (uint)q[2], 27 );
+
+		if (quantized_out != nullptr) {
+			memcpy(quantized_out, q, sizeof(q));
+		}
 
 		return bitbuffer_write_flush(&buf);
 
 	} else {
 
 		// unpack pos
-		a = bitbuffer_get_signed(&buf,27);
-		b = bitbuffer_get_signed(&buf,26); // Cyborg17 this is set to 26 bits on purpose.
-		c = bitbuffer_get_signed(&buf,27);
+		q[0] = bitbuffer_get_signed(&buf,27);
+		q[1] = bitbuffer_get_signed(&buf,26); // Cyborg17 this is set to 26 bits on purpose.
+		q[2] = bitbuffer_get_signed(&buf,27);
 
-		pos->xyz.x = i2fl(a)/512.0f;
-		pos->xyz.y = i2fl(b)/512.0f;
-		pos->xyz.z = i2fl(c)/512.0f;
+		multi_dequantize_position(q, pos);
+
+		if (quantized_out != nullptr) {
+			memcpy(quantized_out, q, sizeof(q));
+		}
 
 		return bitbuffer_read_flush(&buf);
 	}
@@ -3427,48 +3471,118 @@ int multi_pack_unpack_position( int write, ubyte *data, vec3d *pos)
 // Cyborg17 - Because of testing and a bugfix from Wookiejedi, this is now used in tandem with
 // vm_extract_angles_matrix() to save bandwidth. We return the raw angles by reference
 // because they are also useful in rotational interpolation.
-int multi_pack_unpack_orient( int write, ubyte *data, angles *angles)
+int multi_pack_unpack_orient( int write, ubyte *data, angles *angles, int *quantized_out)
 {
 	bitbuffer buf;
 
 	bitbuffer_init(&buf, data);
 
-	int a, b, c;
-
-	// set up some constants to facilitate compression 
-	const float n_scale = 32768.0f/ PI;
-	const int n_min_range = -32768;
-	const int n_max_range =  32767;
+	int q[3];
 
 	if ( write )	{			
-		// Subtract PI/2 because the output of vm_extract_angles_matrix is from -PI/2 to 3PI/2
-		a = fl2i(round((angles->b/* - PI/2*/) * n_scale)); 
-		b = fl2i(round((angles->h/* - PI/2*/) * n_scale));
-		c = fl2i(round((angles->p/* - PI/2*/) * n_scale));
-
-		CAP(a, n_min_range, n_max_range);
-		CAP(b, n_min_range, n_max_range);
-		CAP(c, n_min_range, n_max_range);
+		multi_quantize_orient(angles, q);
 					
-		bitbuffer_put( &buf, (uint)a, 16 );
-		bitbuffer_put( &buf, (uint)b, 16 );
-		bitbuffer_put( &buf, (uint)c, 16 );
+		bitbuffer_put( &buf, (uint)q[0], 16 );
+		bitbuffer_put( &buf, (uint)q[1], 16 );
+		bitbuffer_put( &buf, (uint)q[2], 16 );
+
+		if (quantized_out != nullptr) {
+			memcpy(quantized_out, q, sizeof(q));
+		}
 
 		return bitbuffer_write_flush(&buf);
 	} else {
 
-		a = bitbuffer_get_signed(&buf,16);
-		b = bitbuffer_get_signed(&buf,16);
-		c = bitbuffer_get_signed(&buf,16);
+		q[0] = bitbuffer_get_signed(&buf,16);
+		q[1] = bitbuffer_get_signed(&buf,16);
+		q[2] = bitbuffer_get_signed(&buf,16);
 
-		angles->b =/* PI/2 +*/ (i2fl(a)/n_scale);
-		angles->h =/* PI/2 +*/ (i2fl(b)/n_scale);
-		angles->p =/* PI/2 +*/ (i2fl(c)/n_scale);
+		multi_dequantize_orient(q, angles);
+
+		if (quantized_out != nullptr) {
+			memcpy(quantized_out, q, sizeof(q));
+		}
 		
 		return bitbuffer_read_flush(&buf);
 	}
 }
 
+// The bit widths that each delta component may be sent with, chosen with a 2 bit prefix.  Position
+// is in 1/512ths of a meter, so the widest class still covers ~16km between the baseline and now.
+static const int Delta_position_widths[4] = { 5, 11, 17, 24 };
+// Orientation deltas wrap at 16 bits, so the widest class always fits.
+static const int Delta_orient_widths[4] = { 4, 8, 12, 16 };
+
+static int multi_delta_width_class(int delta, const int *widths)
+{
+	for (int i = 0; i < 4; i++) {
+		int limit = 1 << (widths[i] - 1);
+		if (delta >= -limit && delta < limit) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+// Packs/unpacks a quantized position and orientation (see multi_quantize_position() and multi_quantize_orient())
+// as the difference from a baseline that the receiver already has.  Each of the six components gets a 2 bit width
+// class followed by the delta in that many bits, so slow or stationary objects cost a handful of bytes.
+// When reading, base may be nullptr if the receiver lost the baseline; the data is still consumed so the
+// rest of the packet can be read, but the values in quantized are meaningless.
+// Returns number of bytes read or written, or 0 if the delta was too large to write.
+int multi_pack_unpack_pos_orient_delta(int write, ubyte *data, const int *base, int *quantized)
+{
+	bitbuffer buf;
+
+	bitbuffer_init(&buf, data);
+
+	if (write) {
+		Assertion(base != nullptr, "multi_pack_unpack_pos_orient_delta needs a baseline to write a delta. This is a coder error, please report.");
+
+		int deltas[OO_DELTA_COMPONENTS];
+		int classes[OO_DELTA_COMPONENTS];
+
+		// check everything first, so we never write a partial delta
+		for (int i = 0; i < OO_DELTA_COMPONENTS; i++) {
+			if (i < 3) {
+				deltas[i] = quantized[i] - base[i];
+				classes[i] = multi_delta_width_class(deltas[i], Delta_position_widths);
+			} else {
+				deltas[i] = (short)(quantized[i] - base[i]);
+				classes[i] = multi_delta_width_class(deltas[i], Delta_orient_widths);
+			}
+
+			if (classes[i] < 0) {
+				return 0;
+			}
+		}
+
+		for (int i = 0; i < OO_DELTA_COMPONENTS; i++) {
+			const int *widths = (i < 3) ? Delta_position_widths : Delta_orient_widths;
+			bitbuffer_put(&buf, (uint)classes[i], 2);
+			bitbuffer_put(&buf, (uint)deltas[i], widths[classes[i]]);
+		}
+
+		return bitbuffer_write_flush(&buf);
+	} else {
+		for (int i = 0; i < OO_DELTA_COMPONENTS; i++) {
+			const int *widths = (i < 3) ? Delta_position_widths : Delta_orient_widths;
+			int width_class = (int)bitbuffer_get_unsigned(&buf, 2);
+			int delta = bitbuffer_get_signed(&buf, widths[width_class]);
+			int base_value = (base != nullptr) ? base[i] : 0;
+
+			if (i < 3) {
+				quantized[i] = base_value + delta;
+			} else {
+				quantized[i] = (short)(base_value + delta);
+			}
+		}
+
+		return bitbuffer_read_flush(&buf);
+	}
+}
+
 // Packs/unpacks velocity
 // Returns number of bytes read or written.
 int multi_pack_unpack_vel( int write, ubyte *data, matrix *orient, physics_info *pi)
@@ -185,12 +185,25 @@ void multi_display_chat_msg(const char *msg, int player_index, int add_id);
 void multi_get_mission_checksum(const char *filename);
 
 // Packs/unpacks an object position.
-// Returns number of bytes read or written.
-int multi_pack_unpack_position(int write, ubyte *data, vec3d *pos);
+// Returns number of bytes read or written. If quantized_out is given, it receives the three quantized values sent.
+int multi_pack_unpack_position(int write, ubyte *data, vec3d *pos, int *quantized_out = nullptr);
 
 // Packs/unpacks an orientation matrix.
-// Returns number of bytes read or written.
-int multi_pack_unpack_orient(int write, ubyte *data, angles *angles_out);
+// Returns number of bytes read or written. If quantized_out is given, it receives the three quantized values sent.
+int multi_pack_unpack_orient(int write, ubyte *data, angles *angles_out, int *quantized_out = nullptr);
+
+// number of quantized values in a position and orientation delta (three position, then three angles)
+#define OO_DELTA_COMPONENTS		6
+
+// quantize/dequantize positions and angles exactly as the packers above do
+void multi_quantize_position(const vec3d *pos, int *quantized);
+void multi_dequantize_position(const int *quantized, vec3d *pos);
+void multi_quantize_orient(const angles *angs, int *quantized);
+void multi_dequantize_orient(const int *quantized, angles *angs);
+
+// Packs/unpacks a quantized position and orientation as a bit-packed delta from a baseline the receiver already has.
+// Returns number of bytes read or written, or 0 if the delta is too large to write.
+int multi_pack_unpack_pos_orient_delta(int write, ubyte *data, const int *base, int *quantized);
 
 // Packs/unpacks velocity
 // Returns number of bytes read or written.
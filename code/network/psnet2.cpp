@@ -37,6 +37,7 @@
 #include "io/timer.h"
 #include "network/multi_log.h"
 #include "network/multi_rate.h"
+#include "network/multi_capture.h"
 #include "cmdline/cmdline.h"
 
 // -------------------------------------------------------------------------------------------------------
@@ -193,6 +194,9 @@ static time_t Psnet_bad_packet_time = 0;
 // top layer buffers
 static network_packet_buffer_list Psnet_top_buffers[PSNET_NUM_TYPES];
 
+// extra unreliable sockets on the loopback interface (see psnet_loopback_open())
+static SCP_vector<SOCKET> Psnet_loopback_sockets;
+
 // -------------------------------------------------------------------------------------------------------
 // PSNET 2 FORWARD DECLARATIONS
 //
@@ -468,6 +472,9 @@ void psnet_init(uint16_t port_num)
 	}
 
 	Network_status = NETWORK_STATUS_RUNNING;
+
+	// start a packet capture or load one to replay, if asked for
+	multi_capture_init();
 }
 
 /**
@@ -479,10 +486,18 @@ void psnet_close()
 		return;
 	}
 
+	multi_capture_close();
+
 	// close down all reliable sockets - this forces them to
 	// send a disconnect to any remote machines
 	psnet_rel_close();
 
+	for (size_t idx = 0; idx < Psnet_loopback_sockets.size(); idx++) {
+		psnet_loopback_close(static_cast<PSNET_SOCKET>(idx));
+	}
+
+	Psnet_loopback_sockets.clear();
+
 	if (Psnet_socket != INVALID_SOCKET) {
 		shutdown(Psnet_socket, 1);
 		closesocket(Psnet_socket);
@@ -828,6 +843,13 @@ int psnet_send(net_addr *who_to_addr, void *data, int len, int np_index)	// NOLI
 	multi_rate_add(np_index, "udp(h)", len + UDP_HEADER_SIZE);
 	multi_rate_add(np_index, "udp", len);
 
+	multi_capture_packet(CAPTURE_DIRECTION_OUT, false, who_to_addr, data, len);
+
+	// the players of a replayed capture aren't really out there, so don't send them anything
+	if ( multi_replay_active() ) {
+		return 1;
+	}
+
 	ret = SENDTO(Psnet_socket, reinterpret_cast<char *>(data), len, 0,
 				 reinterpret_cast<LPSOCKADDR>(&who_to), sizeof(who_to),
 				 PSNET_TYPE_UNRELIABLE);
@@ -854,6 +876,7 @@ int psnet_get(void *data, net_addr *addr)
 	// try and get a free buffer and return its size
 	if ( psnet_buffer_get_next(&Psnet_top_buffers[PSNET_TYPE_UNRELIABLE], reinterpret_cast<ubyte *>(data), &buffer_size, &from_addr) ) {
 		psnet_sockaddr_to_addr(&from_addr, addr);
+		multi_capture_packet(CAPTURE_DIRECTION_IN, false, addr, data, static_cast<int>(buffer_size));
 		return static_cast<int>(buffer_size);
 	}
 
@@ -876,6 +899,150 @@ void psnet_flush()
 	while ( psnet_get(data, &from_addr) > 0 );
 }
 
+/**
+ * Open an extra unreliable socket on the loopback interface, so that something inside
+ * this process can talk to our own game socket as if it were a remote machine.
+ *
+ * @param addr filled in with the address the game socket will see packets come from
+ * @return handle for the other psnet_loopback_*() functions, or PSNET_INVALID_SOCKET on failure
+ */
+PSNET_SOCKET psnet_loopback_open(net_addr *addr)
+{
+	SOCKADDR_IN6 sockaddr;
+	SOCKLEN_T addrlen;
+	SOCKET sock;
+
+	if ( !Psnet_active ) {
+		return PSNET_INVALID_SOCKET;
+	}
+
+	sock = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+
+	if (sock == INVALID_SOCKET) {
+		ml_printf("Error %d creating loopback socket", WSAGetLastError());
+		return PSNET_INVALID_SOCKET;
+	}
+
+	memset(&sockaddr, 0, sizeof(sockaddr));
+	sockaddr.sin6_family = AF_INET6;
+	sockaddr.sin6_addr = in6addr_loopback;
+	sockaddr.sin6_port = 0;
+
+	if ( bind(sock, reinterpret_cast<LPSOCKADDR>(&sockaddr), sizeof(sockaddr)) == SOCKET_ERROR ) {
+		ml_printf("Couldn't bind loopback socket (%d)!", WSAGetLastError());
+		closesocket(sock);
+		return PSNET_INVALID_SOCKET;
+	}
+
+	// the system picked the port for us
+	addrlen = sizeof(sockaddr);
+
+	if ( getsockname(sock, reinterpret_cast<LPSOCKADDR>(&sockaddr), &addrlen) == SOCKET_ERROR ) {
+		closesocket(sock);
+		return PSNET_INVALID_SOCKET;
+	}
+
+	psnet_sockaddr_to_addr(&sockaddr, addr);
+
+	// reuse a closed slot if we have one
+	for (size_t idx = 0; idx < Psnet_loopback_sockets.size(); idx++) {
+		if (Psnet_loopback_sockets[idx] == INVALID_SOCKET) {
+			Psnet_loopback_sockets[idx] = sock;
+			return static_cast<PSNET_SOCKET>(idx);
+		}
+	}
+
+	Psnet_loopback_sockets.push_back(sock);
+
+	return static_cast<PSNET_SOCKET>(Psnet_loopback_sockets.size() - 1);
+}
+
+/**
+ * Close a socket opened with psnet_loopback_open()
+ */
+void psnet_loopback_close(PSNET_SOCKET socketid)
+{
+	if ( (socketid >= Psnet_loopback_sockets.size()) || (Psnet_loopback_sockets[socketid] == INVALID_SOCKET) ) {
+		return;
+	}
+
+	closesocket(Psnet_loopback_sockets[socketid]);
+	Psnet_loopback_sockets[socketid] = INVALID_SOCKET;
+}
+
+/**
+ * Send unreliable data from a loopback socket to our own game socket
+ */
+int psnet_loopback_send(PSNET_SOCKET socketid, void *data, int len)
+{
+	SOCKADDR_IN6 to_addr;
+
+	if ( (socketid >= Psnet_loopback_sockets.size()) || (Psnet_loopback_sockets[socketid] == INVALID_SOCKET) ) {
+		return 0;
+	}
+
+	memset(&to_addr, 0, sizeof(to_addr));
+	to_addr.sin6_family = AF_INET6;
+	to_addr.sin6_addr = in6addr_loopback;
+	to_addr.sin6_port = htons(Psnet_default_port);
+
+	if ( SENDTO(Psnet_loopback_sockets[socketid], reinterpret_cast<char *>(data), len, 0,
+				reinterpret_cast<LPSOCKADDR>(&to_addr), sizeof(to_addr), PSNET_TYPE_UNRELIABLE) == SOCKET_ERROR ) {
+		return 0;
+	}
+
+	return 1;
+}
+
+/**
+ * Get the next unreliable packet our game socket sent to a loopback socket, without blocking
+ *
+ * @return number of bytes copied into data, 0 if nothing is waiting
+ */
+int psnet_loopback_get(PSNET_SOCKET socketid, void *data, int max_len)
+{
+	fd_set rfds;
+	timeval timeout;
+	SSIZE_T read_len;
+	uint8_t packet_data[MAX_TOP_LAYER_PACKET_SIZE];
+
+	if ( (socketid >= Psnet_loopback_sockets.size()) || (Psnet_loopback_sockets[socketid] == INVALID_SOCKET) ) {
+		return 0;
+	}
+
+	SOCKET sock = Psnet_loopback_sockets[socketid];
+
+	while (true) {
+		FD_ZERO(&rfds);
+		FD_SET(sock, &rfds);
+		timeout.tv_sec = 0;
+		timeout.tv_usec = 0;
+
+		if ( select(static_cast<int>(sock + 1), &rfds, nullptr, nullptr, &timeout) == SOCKET_ERROR ) {
+			return 0;
+		}
+
+		if ( !FD_ISSET(sock, &rfds) ) {
+			return 0;
+		}
+
+		read_len = recv(sock, reinterpret_cast<char *>(packet_data), sizeof(packet_data), 0);
+
+		if (read_len <= 0) {
+			return 0;
+		}
+
+		// only game data is of interest, reliable traffic has its own sockets
+		if ( (packet_data[0] != PSNET_TYPE_UNRELIABLE) || ((read_len - 1) > max_len) ) {
+			continue;
+		}
+
+		memcpy(data, packet_data + 1, static_cast<size_t>(read_len - 1));
+
+		return static_cast<int>(read_len - 1);
+	}
+}
+
 /**
  * Convert from sockaddr_in6 to net_addr struct
  */
@@ -1449,6 +1616,10 @@ int psnet_rel_send(PSNET_SOCKET_RELIABLE socketid, ubyte *data, int length, int
 			send_header.send_time = INTEL_FLOAT( &send_header.send_time ) ;
 
 			if (send_this_packet) {
+				net_addr capture_addr;
+				psnet_sockaddr_to_addr(&rsocket->addr, &capture_addr);
+				multi_capture_packet(CAPTURE_DIRECTION_OUT, true, &capture_addr, data, length);
+
 				multi_rate_add(np_index, "tcp(h)", RELIABLE_PACKET_HEADER_ONLY_SIZE+rsocket->send_len[i]);
 
 				bytesout = SENDTO(Psnet_socket, reinterpret_cast<char *>(&send_header),
@@ -1513,6 +1684,10 @@ int psnet_rel_get(PSNET_SOCKET socketid, ubyte *buffer, int max_length)
 
 			memcpy(buffer, rsocket->rbuffers[i]->buffer, static_cast<size_t>(rsocket->recv_len[i]));
 
+			net_addr capture_addr;
+			psnet_sockaddr_to_addr(&rsocket->addr, &capture_addr);
+			multi_capture_packet(CAPTURE_DIRECTION_IN, true, &capture_addr, buffer, rsocket->recv_len[i]);
+
 			vm_free(rsocket->rbuffers[i]);
 			rsocket->rbuffers[i] = nullptr;
 
@@ -163,6 +163,12 @@ int psnet_get(void *data, net_addr *from_addr);
 // flush all sockets
 void psnet_flush();
 
+// extra unreliable sockets on the loopback interface, which talk to our own game socket
+PSNET_SOCKET psnet_loopback_open(net_addr *addr);
+void psnet_loopback_close(PSNET_SOCKET socketid);
+int psnet_loopback_send(PSNET_SOCKET socketid, void *data, int len);
+int psnet_loopback_get(PSNET_SOCKET socketid, void *data, int max_len);
+
 // if the passed string is a valid IP string
 bool psnet_is_valid_ip_string(const char *ip_string);
 
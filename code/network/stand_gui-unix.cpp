@@ -64,6 +64,7 @@ Container& split(Container& result, const typename Container::value_type& s,
 #include "network/multi_kick.h"
 #include "network/multi_endgame.h"
 #include "network/multi_fstracker.h"
+#include "network/multi_loadtest.h"
 
 #include "mongoose.h"
 #include "jansson.h"
@@ -240,6 +241,7 @@ netgame_info webapi_netgameInfo;
 std::map<short, net_player> webapiNetPlayers;
 float webui_fps;
 float webui_missiontime;
+loadtest_metrics webui_loadtest;
 std::list<mission_goal> webuiMissionGoals;
 LogResource webapi_chatLog;
 LogResource webapi_debugLog;
@@ -385,6 +387,21 @@ json_t* missionGet(ResourceContext * /*context*/) {
     return fpsEntity;
 }
 
+json_t* loadtestGet(ResourceContext * /*context*/) {
+    json_t *obj = json_object();
+
+    json_object_set_new(obj, "clients", json_integer(webui_loadtest.num_clients));
+    json_object_set_new(obj, "frameTimeAvg", json_real(webui_loadtest.frame_time_avg));
+    json_object_set_new(obj, "frameTimeMax", json_real(webui_loadtest.frame_time_max));
+    json_object_set_new(obj, "packetsIn", json_real(webui_loadtest.packets_in));
+    json_object_set_new(obj, "packetsOut", json_real(webui_loadtest.packets_out));
+    json_object_set_new(obj, "bytesIn", json_real(webui_loadtest.bytes_in));
+    json_object_set_new(obj, "bytesOut", json_real(webui_loadtest.bytes_out));
+    json_object_set_new(obj, "bytesPerPlayer", json_real(webui_loadtest.bytes_per_player));
+
+    return obj;
+}
+
 json_t* missionGoalsGet(ResourceContext * /*context*/) {
     json_t *goals = json_array();
 
@@ -570,6 +587,7 @@ struct Resource resources[] = {
     { "api/1/netgameInfo", "GET", &netgameInfoGet },
     { "api/1/mission", "GET", &missionGet },
     { "api/1/mission/goals", "GET", &missionGoalsGet },
+    { "api/1/loadtest", "GET", &loadtestGet },
     { "api/1/player", "GET", &playerGet },
     { "api/1/player/*", "DELETE", &playerDelete },
     { "api/1/player/*/score/mission", "GET", &playerMissionScoreMissionGet },
@@ -784,6 +802,7 @@ void std_do_gui_frame() {
 
     // Update mission data
     webui_missiontime = f2fl(Missiontime);
+    webui_loadtest = Multi_loadtest_metrics;
 
     webuiMissionGoals.clear();
     for (int idx = 0; idx < (int)Mission_goals.size(); idx++) {
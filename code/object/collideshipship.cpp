@@ -71,12 +71,12 @@ static bool check_for_docking_collision(object *objp1, object *objp2)
 	}
 
 
-	if (aip1->mode == AIM_DOCK && aip1->goal_objnum >= 0 && aip1->goal_objnum < MAX_OBJECTS) {
+	if (aip1->mode == AIM_DOCK && aip1->goal_objnum >= 0 && aip1->goal_objnum < (int)Objects.size()) {
 		if (dock_check_find_docked_object(&Objects[aip1->goal_objnum], objp2))
 			return true;
 	}
 
-	if (aip2->mode == AIM_DOCK && aip2->goal_objnum >= 0 && aip2->goal_objnum < MAX_OBJECTS) {
+	if (aip2->mode == AIM_DOCK && aip2->goal_objnum >= 0 && aip2->goal_objnum < (int)Objects.size()) {
 		if (dock_check_find_docked_object(&Objects[aip2->goal_objnum], objp1))
 			return true;
 	}
@@ -1320,7 +1320,7 @@ void collide_ship_ship_process(obj_pair * pair, const std::any& collision_data)
 					// iterate through each player
 					for (net_player & current_player : Net_players) {
 						// check that this player's ship is valid, and that it's not the server ship.
-						if ((current_player.m_player != nullptr) && !(current_player.flags & NETINFO_FLAG_AM_MASTER) && (current_player.m_player->objnum > 0) && current_player.m_player->objnum < MAX_OBJECTS) {
+						if ((current_player.m_player != nullptr) && !(current_player.flags & NETINFO_FLAG_AM_MASTER) && (current_player.m_player->objnum > 0) && current_player.m_player->objnum < (int)Objects.size()) {
 							// check that one of the colliding ships is this player's ship
 							if ((light_obj == &Objects[current_player.m_player->objnum]) || (heavy_obj == &Objects[current_player.m_player->objnum])) {
 								// finally if the host is also a player, ignore making these adjustments for him because he is in a pure simulation.
@@ -18,6 +18,7 @@
 #include "weapon/beam.h"
 #include "weapon/weapon.h"
 #include "tracing/Monitor.h"
+#include "utils/FlatHashMap.h"
 #include "utils/threading.h"
 
 #include <limits>
@@ -30,8 +31,6 @@ int Num_pairs_checked = 0;
 
 SCP_vector<int> Collision_sort_list;
 
-static_assert(1 << collision_cache_bitshift > MAX_OBJECTS, "Collision pair caching currently relies on the highest possible objnum being less than 2^collision_cache_bitshift.");
-
 class collider_pair
 {
 public:
@@ -50,10 +49,13 @@ public:
 };
 
 static SCP_set<object*> Collision_cache_stale_objects;
-static SCP_unordered_map<uint, collider_pair> Collision_cached_pairs;
+static util::FlatHashMap<collider_pair, uint64_t> Collision_cached_pairs;
 
-class checkobject;
-extern checkobject CheckObjects[MAX_OBJECTS];
+// both object numbers packed into one key, with room for any number of objects
+static uint64_t collision_pair_key(const object* A, const object* B)
+{
+	return (static_cast<uint64_t>(OBJ_INDEX(A)) << 32) | static_cast<uint32_t>(OBJ_INDEX(B));
+}
 
 // returns true if we should reject object pair if one is child of other.
 int reject_obj_pair_on_parent(object *A, object *B)
@@ -486,23 +488,24 @@ int collide_predict_large_ship(object *objp, float distance)
 
 #define CRW_MAX_TO_DELETE	4
 
-char crw_status[MAX_WEAPONS];
+static SCP_vector<char> crw_status;
 
 void crw_check_weapon( int weapon_num, int collide_next_check )
 {
 	weapon *wp = &Weapons[weapon_num];
 
 	// if this weapons life left > time before next collision, then we cannot remove it
-	crw_status[WEAPON_INDEX(wp)] = CRW_IN_PAIR;
+	crw_status[weapon_num] = CRW_IN_PAIR;
 	const float next_check_time = ((float)(timestamp_until(collide_next_check)) / 1000.0f);
 	if ( wp->lifeleft < next_check_time )
-		crw_status[WEAPON_INDEX(wp)] = CRW_CAN_DELETE;
+		crw_status[weapon_num] = CRW_CAN_DELETE;
 }
 
 int collide_remove_weapons( )
 {
 	// setup remove_weapon array.  assume we can remove it.
-	for (int i = 0; i < MAX_WEAPONS; i++ ) {
+	crw_status.resize(Weapons.size());
+	for (size_t i = 0; i < Weapons.size(); i++ ) {
 		if ( Weapons[i].objnum == -1 )
 			crw_status[i] = CRW_NO_OBJECT;
 		else
@@ -510,11 +513,11 @@ int collide_remove_weapons( )
 	}
 
 	// first pass is to see if any of the weapons don't have collision pairs.
-	for (auto& pair : Collision_cached_pairs) {
-        collider_pair* pair_obj = &pair.second;
+	Collision_cached_pairs.forEach([](uint64_t /*key*/, collider_pair& pair) {
+		collider_pair* pair_obj = &pair;
 
 		if (!pair_obj->initialized) {
-			continue;
+			return;
 		}
 
 		if (pair_obj->a->type == OBJ_WEAPON && pair_obj->signature_a == pair_obj->a->signature) {
@@ -532,11 +535,11 @@ int collide_remove_weapons( )
 				pair_obj->initialized = false;
 			}
 		}
-	}
+	});
 
 	// for each weapon which could be removed, delete the object
 	int num_deleted = 0;
-	for (int i = 0; i < MAX_WEAPONS; i++ ) {
+	for (size_t i = 0; i < Weapons.size(); i++ ) {
 		if ( crw_status[i] == CRW_CAN_DELETE ) {
 			Assert( Weapons[i].objnum != -1 );
 			obj_delete( Weapons[i].objnum );
@@ -616,17 +619,15 @@ void obj_collide_retime_stale_pairs()
 {
 	TRACE_SCOPE(tracing::RetimeCollisionCache);
 
-	auto it = Collision_cached_pairs.begin();
-	while (it != Collision_cached_pairs.end()) {
-		auto &pair = it->second;
+	Collision_cached_pairs.eraseIf([](uint64_t /*key*/, collider_pair& pair) {
 		if (pair.signature_a != pair.a->signature || pair.signature_b != pair.b->signature) {
-			it = Collision_cached_pairs.erase(it);
-		} else {
-			if (pair.a->flags[Object::Object_Flags::Collision_cache_stale] || pair.b->flags[Object::Object_Flags::Collision_cache_stale])
-				pair.next_check_time = timestamp(0);
-			it++;
+			return true;
 		}
-	}
+
+		if (pair.a->flags[Object::Object_Flags::Collision_cache_stale] || pair.b->flags[Object::Object_Flags::Collision_cache_stale])
+			pair.next_check_time = timestamp(0);
+		return false;
+	});
 
 	for (auto objp : Collision_cache_stale_objects)
 		objp->flags.remove(Object::Object_Flags::Collision_cache_stale);
@@ -787,7 +788,7 @@ void queue_mp_collision(uint ctype, const obj_pair& colliding) {
 }
 
 void post_process_threaded_collisions() {
-	SCP_map<size_t, size_t> workerThreads;
+	SCP_frame_map<size_t, size_t> workerThreads;
 	for (size_t i = 0; i < threading::get_num_workers(); i++)
 		workerThreads.emplace(i, 0);
 
@@ -804,12 +805,12 @@ void post_process_threaded_collisions() {
 					thread.queue_results.swap(thread.queue_send);
 				}
 				for (auto& collision : *thread.queue_send) {
-					uint key = (OBJ_INDEX(collision.objs.a) << collision_cache_bitshift) + OBJ_INDEX(collision.objs.b);
-					collider_pair *collision_info = &Collision_cached_pairs[key];
-
 					if (collision.collision_data.has_value())
 						collision.process_collision(&collision.objs, collision.collision_data);
 
+					auto key = collision_pair_key(collision.objs.a, collision.objs.b);
+					collider_pair *collision_info = &Collision_cached_pairs[key];
+
 					if (collision.never_recheck) {
 						collision_info->next_check_time = -1;
 					} else {
@@ -988,7 +989,7 @@ void obj_collide_pair(object *A, object *B)
     }
 
     bool valid = false;
-    uint key = (OBJ_INDEX(A) << collision_cache_bitshift) + OBJ_INDEX(B);
+    auto key = collision_pair_key(A, B);
 
     collider_pair* collision_info = &Collision_cached_pairs[key];
 
@@ -1090,7 +1091,12 @@ void obj_collide_pair(object *A, object *B)
 		queue_mp_collision(ctype, new_pair);
 	}
 	else {
-		if (check_collision(&new_pair)) {
+		bool never_recheck = check_collision(&new_pair) != 0;
+
+		// the check could have added pairs of its own, which can move this one around in the cache
+		collision_info = &Collision_cached_pairs[key];
+
+		if (never_recheck) {
 			// don't have to check ever again
 			collision_info->next_check_time = -1;
 		} else {
@@ -1104,7 +1110,7 @@ void obj_find_overlap_colliders(SCP_vector<int> &overlap_list_out, SCP_vector<in
     TRACE_SCOPE(tracing::FindOverlapColliders);
 
     bool first_not_added = true;
-    SCP_vector<int> overlappers;
+    SCP_frame_vector<int> overlappers;
 
     for (int in_index : list){
         bool overlapped = false;
@@ -1242,6 +1248,8 @@ void obj_sort_and_collide(SCP_vector<int>* Collision_list)
 
 	if (threading::is_threading())
 		post_process_threaded_collisions();
+
+	beam_collide_all_queued();
 }
 
 void collide_apply_gravity_flags_weapons() {
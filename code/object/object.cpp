@@ -69,11 +69,11 @@ object *Player_obj = NULL;
 object *Viewer_obj = NULL;
 
 //Data for objects
-object Objects[MAX_OBJECTS];
+util::ChunkedPool<object, MAX_OBJECTS, OBJECT_CHUNK_SIZE> Objects;
 SCP_map<int, raw_pof_obj> Pof_objects;
 
 #ifdef OBJECT_CHECK 
-checkobject CheckObjects[MAX_OBJECTS];
+SCP_vector<checkobject> CheckObjects;
 #endif
 
 int Num_objects=-1;
@@ -86,7 +86,7 @@ int Show_waypoints = 0;
 object_h::object_h(int in_objnum)
 	: objnum(in_objnum)
 {
-	if (objnum >= 0 && objnum < MAX_OBJECTS)
+	if (objnum >= 0 && objnum < (int)Objects.size())
 		sig = Objects[objnum].signature;
 	else
 		objnum = -1;
@@ -107,7 +107,7 @@ object_h::object_h()
 bool object_h::isValid() const
 {
 	// a signature of 0 is invalid, per obj_init()
-	if (objnum < 0 || sig <= 0 || objnum >= MAX_OBJECTS)
+	if (objnum < 0 || sig <= 0 || objnum >= (int)Objects.size())
 		return false;
 	return Objects[objnum].signature == sig;
 }
@@ -189,7 +189,7 @@ checkobject::checkobject()
 
 // all we need to set are the pointers, but type, parent, and instance are useful to set as well
 object::object()
-	: next(nullptr), prev(nullptr), signature(0), type(OBJ_NONE), parent(-1), parent_sig(0), instance(-1), pos(vmd_zero_vector), orient(vmd_identity_matrix),
+	: next(nullptr), prev(nullptr), objnum(-1), signature(0), type(OBJ_NONE), parent(-1), parent_sig(0), instance(-1), pos(vmd_zero_vector), orient(vmd_identity_matrix),
 	radius(0.0f), last_pos(vmd_zero_vector), last_orient(vmd_identity_matrix), hull_strength(0.0f), sim_hull_strength(0.0f), net_signature(0), num_pairs(0),
 	dock_list(nullptr), dead_dock_list(nullptr), collision_group_id(0)
 {
@@ -202,7 +202,7 @@ object::~object()
 	dock_free_dead_dock_list(this);
 }
 
-// DO NOT set next and prev to NULL because they keep the object on the free and used lists
+// DO NOT set next and prev to NULL because they keep the object on the free and used lists, nor objnum which never changes
 void object::clear()
 {
 	signature = num_pairs = collision_group_id = 0;
@@ -234,7 +234,8 @@ void object::clear()
 int free_object_slots(int target_num_used)
 {
 	int	i, olind, deleted_weapons;
-	int	obj_list[MAX_OBJECTS];
+	int	num_slots = static_cast<int>(Objects.size());
+	SCP_vector<int> obj_list(num_slots);
 	int	num_already_free, num_to_free, original_num_to_free;
 	object *objp;
 
@@ -245,19 +246,19 @@ int free_object_slots(int target_num_used)
 	for ( objp = GET_FIRST(&obj_free_list); objp != END_OF_LIST(&obj_free_list); objp = GET_NEXT(objp) )
 		num_already_free++;
 
-	if (MAX_OBJECTS - num_already_free < target_num_used)
+	if (num_slots - num_already_free < target_num_used)
 		return 0;
 
 	for ( objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp) ) {
 		if (objp->flags[Object::Object_Flags::Should_be_dead]) {
 			num_already_free++;
-			if (MAX_OBJECTS - num_already_free < target_num_used)
+			if (num_slots - num_already_free < target_num_used)
 				return num_already_free;
 		} else
 			switch (objp->type) {
 				case OBJ_NONE:
 					num_already_free++;
-					if (MAX_OBJECTS - num_already_free < target_num_used)
+					if (num_slots - num_already_free < target_num_used)
 						return 0;
 					break;
 				case OBJ_FIREBALL:
@@ -287,7 +288,7 @@ int free_object_slots(int target_num_used)
 
 	}
 
-	num_to_free = MAX_OBJECTS - target_num_used - num_already_free;
+	num_to_free = num_slots - target_num_used - num_already_free;
 	original_num_to_free = num_to_free;
 
 	if (num_to_free > olind) {
@@ -425,29 +426,51 @@ static void on_script_state_destroy(lua_State*) {
 	}
 }
 
+/**
+ * Adds another chunk of slots to Objects[] and puts them on the free list
+ *
+ * @return false if Objects[] is already as large as it can get
+ */
+static bool obj_grow_slots()
+{
+	size_t first_new = Objects.size();
+
+	if (Objects.grow() == 0)
+		return false;
+
+#ifdef OBJECT_CHECK
+	CheckObjects.resize(Objects.size());
+#endif
+
+	for (size_t i = first_new; i < Objects.size(); i++) {
+		Objects[i].objnum = static_cast<int>(i);
+		list_append(&obj_free_list, &Objects[i]);
+	}
+
+	nprintf(("Objects", "Grew object slots to %d\n", (int)Objects.size()));
+	return true;
+}
+
 /**
  * Sets up the free list & init player & whatever else
  */
 void obj_init()
 {
-	int i;
-	object *objp;
-	
 	Object_inited = 1;
-	for (i = 0; i < MAX_OBJECTS; ++i)
-		Objects[i].clear();
+	for (auto& obj : Objects)
+		obj.clear();
 	Viewer_obj = NULL;
 
 	list_init( &obj_free_list );
 	list_init( &obj_used_list );
 	list_init( &obj_create_list );
 
-	// Link all object slots into the free list
-	objp = Objects;
-	for (i=0; i<MAX_OBJECTS; i++)	{
-		list_append(&obj_free_list, objp);
-		objp++;
-	}
+	// Link all object slots into the free list; the slots from earlier missions are kept
+	for (auto& obj : Objects)
+		list_append(&obj_free_list, &obj);
+
+	if (Objects.size() == 0)
+		obj_grow_slots();
 
 	Object_next_signature = 1;	//0 is invalid, others start at 1
 	Num_objects = 0;
@@ -498,6 +521,11 @@ int obj_allocate(bool essential)
 		return -1;
 	}
 
+	// every slot so far is in use, but there is room for more
+	if (GET_FIRST(&obj_free_list) == END_OF_LIST(&obj_free_list)) {
+		obj_grow_slots();
+	}
+
 	// Find next available object
 	objp = GET_FIRST(&obj_free_list);
 	Assert ( objp != &obj_free_list );		// shouldn't have the dummy element
@@ -662,7 +690,7 @@ int obj_create(ubyte type, int parent_obj, int instance, const matrix *orient,
 void obj_delete_all() 
 {
 	int counter = 0;
-	for (int i = 0; i < MAX_OBJECTS; ++i) 
+	for (int i = 0; i < (int)Objects.size(); ++i) 
 	{
 		if (Objects[i].type == OBJ_NONE)
 			continue;
@@ -683,7 +711,7 @@ void obj_delete(int objnum)
 {
 	object *objp;
 
-	Assert(objnum >= 0 && objnum < MAX_OBJECTS);
+	Assert(objnum >= 0 && objnum < (int)Objects.size());
 	objp = &Objects[objnum];
 	if (objp->type == OBJ_NONE) {
 		mprintf(("obj_delete() called for already deleted object %d.\n", objnum));
@@ -1557,7 +1585,7 @@ void obj_move_all(float frametime)
 	TRACE_SCOPE(tracing::MoveObjects);
 
 	object *objp;	
-	SCP_vector<object*> cmeasure_list;
+	SCP_frame_vector<object*> cmeasure_list;
 	const bool global_cmeasure_timer = (Cmeasures_homing_check > 0);
 
 	Assertion(Cmeasures_homing_check >= 0, "Cmeasures_homing_check is %d in obj_move_all(); it should never be negative. Get a coder!\n", Cmeasures_homing_check);
@@ -1579,6 +1607,14 @@ void obj_move_all(float frametime)
 
 	MONITOR_INC( NumObjects, Num_objects );	
 
+	// with framerate independent turning, missiles steer before anything moves, so they can all be steered at once
+	if (Framerate_independent_turning && !physics_paused) {
+		weapon_home_all(frametime);
+	}
+
+	// asteroid objects decide whether to go dormant after they move, so they need to know what is around them now
+	asteroid_find_wakers();
+
 	for (objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp)) {
 		// skip objects which should be dead
 		if (objp->flags[Object::Object_Flags::Should_be_dead]) {
@@ -1903,7 +1939,7 @@ void obj_queue_render(object* obj, model_draw_list* scene)
 	switch ( obj->type ) {
 	case OBJ_NONE:
 #ifndef NDEBUG
-		mprintf(( "ERROR!!!! Bogus obj " PTRDIFF_T_ARG " is rendering!\n", obj-Objects ));
+		mprintf(( "ERROR!!!! Bogus obj %d is rendering!\n", OBJ_INDEX(obj) ));
 		Int3();
 #endif
 		break;
@@ -2038,7 +2074,7 @@ int obj_team(object *objp)
 			break;
 */
 		case OBJ_WEAPON:
-			Assert( objp->instance >= 0 && objp->instance < MAX_WEAPONS );
+			Assert( objp->instance >= 0 && objp->instance < (int)Weapons.size() );
 			team = Weapons[objp->instance].team;
 			break;
 
@@ -2083,8 +2119,8 @@ void obj_reset_all_collisions()
 {
 	// clear checkobjects
 #ifndef NDEBUG
-    for (int i = 0; i < MAX_OBJECTS; ++i) {
-        CheckObjects[i] = checkobject();
+    for (auto& check : CheckObjects) {
+        check = checkobject();
     }
 #endif
 
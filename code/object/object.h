@@ -19,6 +19,7 @@
 #include "physics/physics.h"
 #include "physics/physics_state.h"
 #include "io/timer.h"					// prevents some include issues with files in the actions folder
+#include "utils/ChunkedPool.h"
 #include "utils/event.h"
 
 #include <functional>
@@ -57,6 +58,8 @@
 
 #define UNUSED_OBJNUM		(-MAX_OBJECTS*2)	//	Newer systems use this instead of -1 for invalid object.
 
+#define OBJECT_CHUNK_SIZE	1024	// how many object slots are added when Objects[] runs out
+
 extern const char	*Object_type_names[MAX_OBJECT_TYPES];
 
 // each object type should have these functions:  (I will use weapon as example)
@@ -137,6 +140,7 @@ class object
 {
 public:
 	class object	*next, *prev;	// for linked lists of objects
+	int				objnum;			// This object's index into Objects[], which is allocated in chunks so the address doesn't tell
 	int				signature;		// Every object ever has a unique signature...
 	char			type;			// what type of object this is... ship, weapon, debris, asteroid, fireball, see OBJ_* defines above
 	int				parent;			// This object's parent.
@@ -174,7 +178,7 @@ public:
 	object(const object& other) = delete;
 	object& operator=(const object& other) = delete;
 
-	// Eventually we want to allow an object to be moved, especially when we get around to making Objects[] dynamic
+	// Objects[] grows without moving its elements, so there is no need to move an object either
 	object(object&& other) noexcept = delete;
 	object& operator=(object&& other) noexcept = delete;
 };
@@ -188,7 +192,7 @@ namespace luacpp {
 }
 
 extern int Num_objects;
-extern object Objects[];
+extern util::ChunkedPool<object, MAX_OBJECTS, OBJECT_CHUNK_SIZE> Objects;
 
 struct object_h final	// prevent subclassing because classes which might use this should have their own isValid member function
 {
@@ -221,6 +225,8 @@ public:
 
     checkobject();
 };
+
+extern SCP_vector<checkobject> CheckObjects;
 #endif
 
 /*
@@ -244,11 +250,15 @@ extern int render_order[MAX_OBJECTS];
 extern object *Viewer_obj;	// Which object is the viewer. Can be NULL.
 extern object *Player_obj;	// Which object is the player. Has to be valid.
 
-// Use this instead of "objp - Objects" to get an object number
-// given it's pointer.  This way, we can replace it with a macro
-// to check that the pointer is valid for debugging.
-// This code will break in 64 bit builds when we have more than 2^31 objects but that will probably never happen
-#define OBJ_INDEX(objp) static_cast<int>(objp-Objects)
+// Use this to get an object number given its pointer.  Objects[] is
+// allocated in chunks, so the number is kept in the object itself
+// rather than worked out from where the pointer is.  A null pointer
+// gives -1, the usual invalid object number.
+inline int obj_index(const object *objp)
+{
+	return objp ? objp->objnum : -1;
+}
+#define OBJ_INDEX(objp) obj_index(objp)
 
 /*
  *		FUNCTIONS
@@ -387,6 +397,9 @@ polymodel_instance *object_get_model_instance(const object *objp);
 
 void obj_render_queue_all();
 
+// Whether anything within obj_size of pos could be in the view cone
+int obj_sphere_in_view_cone(const vec3d *pos, float obj_size);
+
 /**
  * @brief Compares two object pointers and determines if they refer to the same object
  *
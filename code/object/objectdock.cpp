@@ -704,7 +704,7 @@ void dock_calc_total_docked_mass_helper(object *objp, dock_function_info *infop)
 // we take the square root of the final value.
 void dock_calc_max_cross_sectional_radius_squared_perpendicular_to_line_helper(object *objp, dock_function_info *infop)
 {
-	vec3d world_point, local_point[6], nearest;
+	vec3d world_point[6], local_point[6], nearest;
 	polymodel *pm;
 	int i;
 	float dist_squared;
@@ -730,15 +730,14 @@ void dock_calc_max_cross_sectional_radius_squared_perpendicular_to_line_helper(o
 	local_point[4].xyz.z = pm->maxs.xyz.z;	// front point (max z)
 	local_point[5].xyz.z = pm->mins.xyz.z;	// rear point (min z)
 
+	// calculate position of points
+	vm_vec_unrotate_add_n(world_point, local_point, 6, &objp->orient, &objp->pos);
+
 	// check points
 	for (i = 0; i < 6; i++)
 	{
-		// calculate position of point
-		vm_vec_unrotate(&world_point, &local_point[i], &objp->orient);
-		vm_vec_add2(&world_point, &objp->pos);
-
 		// calculate square of distance to line
-		vm_vec_dist_squared_to_line(&world_point, line_start, line_end, &nearest, &dist_squared);
+		vm_vec_dist_squared_to_line(&world_point[i], line_start, line_end, &nearest, &dist_squared);
 	
 		// update with farthest distance squared
 		if (dist_squared > infop->maintained_variables.float_value)
@@ -753,7 +752,7 @@ void dock_calc_max_cross_sectional_radius_squared_perpendicular_to_line_helper(o
 // objects (i.e. when we return to the parent function) we take the square root of the final value.
 void dock_calc_max_semilatus_rectum_squared_parallel_to_directrix_helper(object *objp, dock_function_info *infop)
 {
-	vec3d world_point, local_point[6], nearest;
+	vec3d world_point[6], local_point[6], nearest;
 	polymodel *pm;
 	int i;
 	float temp, dist_squared;
@@ -779,15 +778,14 @@ void dock_calc_max_semilatus_rectum_squared_parallel_to_directrix_helper(object
 	local_point[4].xyz.z = pm->maxs.xyz.z;	// front point (max z)
 	local_point[5].xyz.z = pm->mins.xyz.z;	// rear point (min z)
 
+	// calculate position of points
+	vm_vec_unrotate_add_n(world_point, local_point, 6, &objp->orient, &objp->pos);
+
 	// check points
 	for (i = 0; i < 6; i++)
 	{
-		// calculate position of point
-		vm_vec_unrotate(&world_point, &local_point[i], &objp->orient);
-		vm_vec_add2(&world_point, &objp->pos);
-
 		// find the nearest point along the line
-		vm_vec_dist_squared_to_line(&world_point, line_start, line_end, &nearest, &temp);
+		vm_vec_dist_squared_to_line(&world_point[i], line_start, line_end, &nearest, &temp);
 
 		// find the distance squared between the origin of the line and the point on the line
 		dist_squared = vm_vec_dist_squared(line_start, &nearest);
@@ -0,0 +1,365 @@
+#include "object/objectgrid.h"
+
+#include "globalincs/linklist.h"
+#include "model/model.h"
+#include "object/object.h"
+#include "ship/ship.h"
+#include "tracing/Monitor.h"
+#include "tracing/tracing.h"
+
+#include <algorithm>
+#include <cfloat>
+
+// the grid gets about one cell per object, but no more than this along each axis
+#define OBJ_GRID_MAX_DIM				32
+// objects which would touch more cells than this are looked at by every query instead
+#define OBJ_GRID_MAX_OBJECT_CELLS		64
+
+static bool Obj_grid_active = false;
+static uint Obj_grid_types = 0;
+
+static vec3d Obj_grid_min, Obj_grid_max;
+static vec3d Obj_grid_scale;					// cells per unit along each axis
+static int Obj_grid_dims[3] = { 0, 0, 0 };
+static SCP_vector<uint> Obj_grid_cell_start;	// where each cell starts in Obj_grid_cell_objects, one extra at the end
+static SCP_vector<int> Obj_grid_cell_objects;
+static SCP_vector<int> Obj_grid_large_objects;
+
+// indexed by object number
+static SCP_vector<float> Obj_grid_radius;
+static SCP_vector<uint> Obj_grid_stamps;		// so that an object in several cells is only tested once per query
+static uint Obj_grid_stamp = 0;
+static SCP_vector<uint> Obj_grid_order;			// where each object is in obj_used_list, so results can keep that order
+
+static SCP_vector<int> Obj_grid_binned;
+
+MONITOR(NumAreaEffectObjectsTested)
+
+float obj_area_effect_radius(const object *objp)
+{
+	// area effects use the bounding box of ships, whose corners can be outside the radius
+	if (objp->type == OBJ_SHIP) {
+		auto pm = model_get(Ship_info[Ships[objp->instance].ship_info_index].model_num);
+
+		vec3d corner;
+		for (int axis = 0; axis < 3; ++axis) {
+			corner.a1d[axis] = MAX(fabsf(pm->mins.a1d[axis]), fabsf(pm->maxs.a1d[axis]));
+		}
+
+		return MAX(objp->radius, vm_vec_mag(&corner));
+	}
+
+	return objp->radius;
+}
+
+static void obj_grid_cell(const vec3d *pos, int cell[3])
+{
+	for (int axis = 0; axis < 3; ++axis) {
+		int c = static_cast<int>((pos->a1d[axis] - Obj_grid_min.a1d[axis]) * Obj_grid_scale.a1d[axis]);
+		CLAMP(c, 0, Obj_grid_dims[axis] - 1);
+		cell[axis] = c;
+	}
+}
+
+// the range of cells the sphere touches, or false if it doesn't touch the grid at all
+static bool obj_grid_cells_touched(const vec3d *pos, float radius, int lo[3], int hi[3])
+{
+	vec3d bmin, bmax;
+
+	for (int axis = 0; axis < 3; ++axis) {
+		bmin.a1d[axis] = pos->a1d[axis] - radius;
+		bmax.a1d[axis] = pos->a1d[axis] + radius;
+
+		if (bmax.a1d[axis] < Obj_grid_min.a1d[axis] || bmin.a1d[axis] > Obj_grid_max.a1d[axis]) {
+			return false;
+		}
+	}
+
+	obj_grid_cell(&bmin, lo);
+	obj_grid_cell(&bmax, hi);
+
+	return true;
+}
+
+void obj_grid_begin(uint type_mask, float (*radius_func)(const object *objp))
+{
+	TRACE_SCOPE(tracing::BuildObjectGrid);
+
+	Obj_grid_active = true;
+	Obj_grid_types = type_mask;
+
+	Obj_grid_cell_start.clear();
+	Obj_grid_cell_objects.clear();
+	Obj_grid_large_objects.clear();
+	Obj_grid_binned.clear();
+
+	Obj_grid_radius.assign(Objects.size(), 0.0f);
+	Obj_grid_stamps.assign(Objects.size(), 0);
+	Obj_grid_stamp = 0;
+	Obj_grid_order.assign(Objects.size(), 0);
+
+	float total_radius = 0.0f;
+
+	vm_vec_make(&Obj_grid_min, FLT_MAX, FLT_MAX, FLT_MAX);
+	vm_vec_make(&Obj_grid_max, -FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+	for (object *objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp)) {
+		if (!(type_mask & OBJ_GRID_TYPE(objp->type)))
+			continue;
+
+		int objnum = OBJ_INDEX(objp);
+		float radius = radius_func(objp);
+
+		Obj_grid_radius[objnum] = radius;
+		Obj_grid_order[objnum] = static_cast<uint>(Obj_grid_binned.size());
+		Obj_grid_binned.push_back(objnum);
+		total_radius += radius;
+
+		for (int axis = 0; axis < 3; ++axis) {
+			Obj_grid_min.a1d[axis] = MIN(Obj_grid_min.a1d[axis], objp->pos.a1d[axis] - radius);
+			Obj_grid_max.a1d[axis] = MAX(Obj_grid_max.a1d[axis], objp->pos.a1d[axis] + radius);
+		}
+	}
+
+	if (Obj_grid_binned.empty()) {
+		Obj_grid_dims[0] = Obj_grid_dims[1] = Obj_grid_dims[2] = 0;
+		return;
+	}
+
+	size_t num_objects = Obj_grid_binned.size();
+
+	// about one cell per object, but no smaller than the average object so that most objects only touch a few cells
+	vec3d extent;
+	vm_vec_sub(&extent, &Obj_grid_max, &Obj_grid_min);
+
+	float volume = MAX(extent.xyz.x, 1.0f) * MAX(extent.xyz.y, 1.0f) * MAX(extent.xyz.z, 1.0f);
+	float cell_size = MAX(powf(volume / num_objects, 1.0f / 3.0f), total_radius / num_objects);
+
+	size_t num_cells = 1;
+	for (int axis = 0; axis < 3; ++axis) {
+		int dim = static_cast<int>(ceilf(extent.a1d[axis] / cell_size));
+		CLAMP(dim, 1, OBJ_GRID_MAX_DIM);
+
+		Obj_grid_dims[axis] = dim;
+		Obj_grid_scale.a1d[axis] = (extent.a1d[axis] > 0.0f) ? dim / extent.a1d[axis] : 0.0f;
+		num_cells *= dim;
+	}
+
+	// count the objects per cell first so that all cells can share one array
+	Obj_grid_cell_start.assign(num_cells + 1, 0);
+
+	for (int pass = 0; pass < 2; ++pass) {
+		for (int objnum : Obj_grid_binned) {
+			int lo[3], hi[3];
+			obj_grid_cells_touched(&Objects[objnum].pos, Obj_grid_radius[objnum], lo, hi);
+
+			if ((hi[0] - lo[0] + 1) * (hi[1] - lo[1] + 1) * (hi[2] - lo[2] + 1) > OBJ_GRID_MAX_OBJECT_CELLS) {
+				if (pass == 0) {
+					Obj_grid_large_objects.push_back(objnum);
+				}
+				continue;
+			}
+
+			for (int z = lo[2]; z <= hi[2]; ++z) {
+				for (int y = lo[1]; y <= hi[1]; ++y) {
+					for (int x = lo[0]; x <= hi[0]; ++x) {
+						size_t cell = (static_cast<size_t>(z) * Obj_grid_dims[1] + y) * Obj_grid_dims[0] + x;
+
+						if (pass == 0) {
+							++Obj_grid_cell_start[cell + 1];
+						} else {
+							Obj_grid_cell_objects[Obj_grid_cell_start[cell]++] = objnum;
+						}
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			for (size_t cell = 0; cell < num_cells; ++cell) {
+				Obj_grid_cell_start[cell + 1] += Obj_grid_cell_start[cell];
+			}
+			Obj_grid_cell_objects.resize(Obj_grid_cell_start[num_cells]);
+		} else {
+			// filling the cells moved each start to the start of the next cell
+			for (size_t cell = num_cells; cell > 0; --cell) {
+				Obj_grid_cell_start[cell] = Obj_grid_cell_start[cell - 1];
+			}
+			Obj_grid_cell_start[0] = 0;
+		}
+	}
+}
+
+void obj_grid_end()
+{
+	Obj_grid_active = false;
+	Obj_grid_types = 0;
+}
+
+bool obj_grid_covers(uint type_mask)
+{
+	return Obj_grid_active && !(type_mask & ~Obj_grid_types);
+}
+
+// puts the objects found through the cells back in the order of obj_used_list, which is the order they were binned in
+static void obj_grid_sort_list(SCP_frame_vector<int> &list)
+{
+	std::sort(list.begin(), list.end(), [](int a, int b) { return Obj_grid_order[a] < Obj_grid_order[b]; });
+}
+
+// starts a query, after which each object is only looked at once
+static void obj_grid_next_stamp()
+{
+	if (++Obj_grid_stamp == 0) {
+		std::fill(Obj_grid_stamps.begin(), Obj_grid_stamps.end(), 0);
+		Obj_grid_stamp = 1;
+	}
+}
+
+static bool obj_in_sphere(const object *objp, const vec3d *pos, float radius, float obj_radius)
+{
+	float reach = radius + obj_radius;
+	return vm_vec_dist_squared(&objp->pos, pos) <= reach * reach;
+}
+
+static void obj_grid_test(SCP_frame_vector<int> &list, int objnum, const vec3d *pos, float radius, uint type_mask)
+{
+	if (Obj_grid_stamps[objnum] == Obj_grid_stamp) {
+		return;
+	}
+	Obj_grid_stamps[objnum] = Obj_grid_stamp;
+
+	auto objp = &Objects[objnum];
+	MONITOR_INC(NumAreaEffectObjectsTested, 1);
+
+	if ((type_mask & OBJ_GRID_TYPE(objp->type)) && obj_in_sphere(objp, pos, radius, Obj_grid_radius[objnum])) {
+		list.push_back(objnum);
+	}
+}
+
+void obj_find_in_sphere(SCP_frame_vector<int> &list, const vec3d *pos, float radius, uint type_mask)
+{
+	list.clear();
+
+	if (!obj_grid_covers(type_mask)) {
+		for (object *objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp)) {
+			if (!(type_mask & OBJ_GRID_TYPE(objp->type)))
+				continue;
+
+			MONITOR_INC(NumAreaEffectObjectsTested, 1);
+
+			if (obj_in_sphere(objp, pos, radius, obj_area_effect_radius(objp))) {
+				list.push_back(OBJ_INDEX(objp));
+			}
+		}
+		return;
+	}
+
+	obj_grid_next_stamp();
+
+	int lo[3], hi[3];
+	bool touches_cells = !Obj_grid_cell_start.empty() && obj_grid_cells_touched(pos, radius, lo, hi);
+
+	if (touches_cells && static_cast<size_t>(hi[0] - lo[0] + 1) * (hi[1] - lo[1] + 1) * (hi[2] - lo[2] + 1) > Obj_grid_binned.size()) {
+		// a sphere that covers most of the grid is better off testing every object, which are already in order
+		for (int objnum : Obj_grid_binned) {
+			obj_grid_test(list, objnum, pos, radius, type_mask);
+		}
+		return;
+	}
+
+	for (int objnum : Obj_grid_large_objects) {
+		obj_grid_test(list, objnum, pos, radius, type_mask);
+	}
+
+	// otherwise only the large objects could be in the sphere
+	if (touches_cells) {
+		for (int z = lo[2]; z <= hi[2]; ++z) {
+			for (int y = lo[1]; y <= hi[1]; ++y) {
+				for (int x = lo[0]; x <= hi[0]; ++x) {
+					size_t cell = (static_cast<size_t>(z) * Obj_grid_dims[1] + y) * Obj_grid_dims[0] + x;
+
+					for (uint j = Obj_grid_cell_start[cell]; j < Obj_grid_cell_start[cell + 1]; ++j) {
+						obj_grid_test(list, Obj_grid_cell_objects[j], pos, radius, type_mask);
+					}
+				}
+			}
+		}
+	}
+
+	// the same order whether or not there is a grid
+	obj_grid_sort_list(list);
+}
+
+// culls the block of cells from lo to hi, and splits it in two along its longest side if it isn't culled
+static void obj_grid_cull_block(SCP_frame_vector<int> &list, const int lo[3], const int hi[3],
+	const std::function<bool(const vec3d *bmin, const vec3d *bmax)> &box_outside)
+{
+	vec3d bmin, bmax;
+
+	for (int axis = 0; axis < 3; ++axis) {
+		float cell_size = (Obj_grid_max.a1d[axis] - Obj_grid_min.a1d[axis]) / Obj_grid_dims[axis];
+
+		bmin.a1d[axis] = Obj_grid_min.a1d[axis] + lo[axis] * cell_size;
+		bmax.a1d[axis] = Obj_grid_min.a1d[axis] + (hi[axis] + 1) * cell_size;
+	}
+
+	if (box_outside(&bmin, &bmax)) {
+		return;
+	}
+
+	int split_axis = 0;
+	for (int axis = 1; axis < 3; ++axis) {
+		if (hi[axis] - lo[axis] > hi[split_axis] - lo[split_axis]) {
+			split_axis = axis;
+		}
+	}
+
+	if (hi[split_axis] > lo[split_axis]) {
+		int mid = (lo[split_axis] + hi[split_axis]) / 2;
+		int split_lo[3] = { lo[0], lo[1], lo[2] };
+		int split_hi[3] = { hi[0], hi[1], hi[2] };
+
+		split_hi[split_axis] = mid;
+		obj_grid_cull_block(list, lo, split_hi, box_outside);
+
+		split_lo[split_axis] = mid + 1;
+		obj_grid_cull_block(list, split_lo, hi, box_outside);
+		return;
+	}
+
+	// a single cell which isn't culled
+	size_t cell = (static_cast<size_t>(lo[2]) * Obj_grid_dims[1] + lo[1]) * Obj_grid_dims[0] + lo[0];
+
+	for (uint j = Obj_grid_cell_start[cell]; j < Obj_grid_cell_start[cell + 1]; ++j) {
+		int objnum = Obj_grid_cell_objects[j];
+
+		if (Obj_grid_stamps[objnum] != Obj_grid_stamp) {
+			Obj_grid_stamps[objnum] = Obj_grid_stamp;
+			list.push_back(objnum);
+		}
+	}
+}
+
+void obj_grid_find_unculled(SCP_frame_vector<int> &list, const std::function<bool(const vec3d *bmin, const vec3d *bmax)> &box_outside)
+{
+	Assertion(Obj_grid_active, "There is no object grid to cull!");
+
+	list.clear();
+	obj_grid_next_stamp();
+
+	// the large objects aren't in the cells, so they can't be culled along with them
+	for (int objnum : Obj_grid_large_objects) {
+		Obj_grid_stamps[objnum] = Obj_grid_stamp;
+		list.push_back(objnum);
+	}
+
+	if (!Obj_grid_cell_start.empty()) {
+		int lo[3] = { 0, 0, 0 };
+		int hi[3] = { Obj_grid_dims[0] - 1, Obj_grid_dims[1] - 1, Obj_grid_dims[2] - 1 };
+
+		obj_grid_cull_block(list, lo, hi, box_outside);
+	}
+
+	obj_grid_sort_list(list);
+}
@@ -0,0 +1,38 @@
+#ifndef _OBJECT_GRID_H
+#define _OBJECT_GRID_H
+
+#include "globalincs/pstypes.h"
+
+#include <functional>
+
+class object;
+
+// the bit of an object type in the type masks below
+#define OBJ_GRID_TYPE(type)		(1u << (type))
+#define OBJ_GRID_ALL_TYPES		(~0u)
+
+// How far from its position an object can be hit by an area effect
+float obj_area_effect_radius(const object *objp);
+
+// Bins all objects of the types in type_mask into a uniform grid, so that obj_find_in_sphere() only has to look at the
+// objects near each sphere.  Meant for a batch of area effects, such as all the shockwaves of a frame: the objects must
+// not move until obj_grid_end(), and objects created in between aren't found.  Each object takes up the sphere of
+// radius_func(objp) around its position.
+void obj_grid_begin(uint type_mask, float (*radius_func)(const object *objp) = obj_area_effect_radius);
+void obj_grid_end();
+
+// Whether there is an active grid which obj_find_in_sphere() can use for the types in type_mask
+bool obj_grid_covers(uint type_mask);
+
+// Fills list with the numbers of the objects of the types in type_mask which could be within radius of pos, in the
+// order of obj_used_list.  For ships this includes their bounding boxes, for other objects their radius.  Uses the grid
+// if one covering these types is active, and looks at every object otherwise.
+void obj_find_in_sphere(SCP_frame_vector<int> &list, const vec3d *pos, float radius, uint type_mask);
+
+// Fills list with the numbers of the objects in the active grid which aren't in a box that box_outside() is true for,
+// in the order of obj_used_list.  The grid is split into smaller and smaller blocks of cells, and a block is only split
+// further if box_outside() is false for all of it, so for something like the view frustum whole clusters of objects
+// are dropped with a single test.
+void obj_grid_find_unculled(SCP_frame_vector<int> &list, const std::function<bool(const vec3d *bmin, const vec3d *bmax)> &box_outside);
+
+#endif
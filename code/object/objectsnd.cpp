@@ -715,7 +715,7 @@ int obj_snd_assign(int objnum, gamesnd_id sndnum, const vec3d *pos, int flags, c
 {
 	Assertion(pos != nullptr, "Sound position must not be null!");
 
-	if(objnum < 0 || objnum >= MAX_OBJECTS)
+	if(objnum < 0 || objnum >= (int)Objects.size())
 		return -1;
 
 	if(!sndnum.isValid())
@@ -816,7 +816,7 @@ void	obj_snd_delete_type(int objnum, gamesnd_id sndnum, ship_subsys *ss)
 	object	*objp;
 	obj_snd	*osp;
 
-	if(objnum < 0 || objnum >= MAX_OBJECTS)
+	if(objnum < 0 || objnum >= (int)Objects.size())
 		return;
 
 	objp = &Objects[objnum];
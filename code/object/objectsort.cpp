@@ -22,9 +22,11 @@
 #include "model/modelrender.h"
 #include "nebula/neb.h"
 #include "object/object.h"
+#include "object/objectgrid.h"
 #include "scripting/scripting.h"
 #include "render/3d.h"
 #include "render/batching.h"
+#include "render/occlusion.h"
 #include "ship/ship.h"
 #include "tracing/tracing.h"
 #include "weapon/weapon.h"
@@ -128,22 +130,9 @@ vec3d check_offsets[8] = {
   { { {  1.0f,  1.0f,  1.0f } } }
 };
 
-// See if an object is in the view cone.
-// Returns:
-// 0 if object isn't in the view cone
-// 1 if object is in cone 
-// This routine could possibly be optimized.  Right now, for an
-// offscreen object, it has to rotate 8 points to determine it's
-// offscreen.  Not the best considering we're looking at a sphere.
-int obj_in_view_cone( object * objp )
+// The size of the box around an object that has to be in view for it to be rendered
+static float obj_view_cone_size( const object *objp )
 {
-	int i;
-	vec3d tmp,pt;
-	ubyte codes;
-
-	// Center isn't in... are other points?
-	ubyte and_codes = 0xff;
-
 	float obj_size;
 
 	if (objp->type == OBJ_WEAPON && Weapon_info[Weapons[objp->instance].weapon_info_index].render_type == WRT_LASER) {
@@ -159,8 +148,33 @@ int obj_in_view_cone( object * objp )
 		obj_size = objp->radius;
 	}
 
+	return obj_size;
+}
+
+// See if an object is in the view cone.
+// Returns:
+// 0 if object isn't in the view cone
+// 1 if object is in cone 
+// This routine could possibly be optimized.  Right now, for an
+// offscreen object, it has to rotate 8 points to determine it's
+// offscreen.  Not the best considering we're looking at a sphere.
+int obj_in_view_cone( object * objp )
+{
+	return obj_sphere_in_view_cone(&objp->pos, obj_view_cone_size(objp));
+}
+
+// Same as obj_in_view_cone() for anything the size of obj_size around pos
+int obj_sphere_in_view_cone( const vec3d *pos, float obj_size )
+{
+	int i;
+	vec3d tmp,pt;
+	ubyte codes;
+
+	// Center isn't in... are other points?
+	ubyte and_codes = 0xff;
+
 	for (i=0; i<8; i++ ) {
-		vm_vec_scale_add( &pt, &objp->pos, &check_offsets[i], obj_size );
+		vm_vec_scale_add( &pt, pos, &check_offsets[i], obj_size );
 		codes=g3_rotate_vector(&tmp,&pt);
 		if ( !codes ) {
 			//mprintf(( "A point is inside, so render it.\n" ));
@@ -178,6 +192,26 @@ int obj_in_view_cone( object * objp )
 	return 1;
 }
 
+// True if the box from bmin to bmax is completely outside the view cone
+static bool obj_box_outside_view_cone( const vec3d *bmin, const vec3d *bmax )
+{
+	vec3d tmp, pt;
+	ubyte and_codes = 0xff;
+
+	for (int i = 0; i < 8; i++) {
+		pt.xyz.x = (i & 1) ? bmax->xyz.x : bmin->xyz.x;
+		pt.xyz.y = (i & 2) ? bmax->xyz.y : bmin->xyz.y;
+		pt.xyz.z = (i & 4) ? bmax->xyz.z : bmin->xyz.z;
+
+		and_codes &= g3_rotate_vector(&tmp, &pt);
+		if (!and_codes) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 inline bool obj_render_is_model(object *obj)
 {
 	return obj->type == OBJ_SHIP 
@@ -202,9 +236,8 @@ void obj_render_all(const std::function<void(object*)>& render_function, bool *d
 	int i;
 	float fog_near, fog_far, fog_density;
 
-	objp = Objects;
-
-	for (i=0;i<=Highest_object_index;i++,objp++) {
+	for (i=0;i<=Highest_object_index;i++) {
+		objp = &Objects[i];
 		if ( (objp->type != OBJ_NONE) && (objp->flags[Object::Object_Flags::Renders]) )	{
             objp->flags.remove(Object::Object_Flags::Was_rendered);
 
@@ -316,6 +349,9 @@ void obj_render_all(const std::function<void(object*)>& render_function, bool *d
 	batching_render_all(true);
 }
 
+// scenes with fewer objects than this are culled one object at a time
+#define OBJ_RENDER_MIN_GRID_OBJECTS		256
+
 void obj_render_queue_all()
 {
 	GR_DEBUG_SCOPE("Render all objects");
@@ -325,43 +361,94 @@ void obj_render_queue_all()
 	int i;
 	model_draw_list scene;
 
-	objp = Objects;
-
 	gr_deferred_lighting_begin(false);
 
 	scene.init();
 
 	bool full_neb = is_full_nebula();
 
-	for ( i = 0; i <= Highest_object_index; i++,objp++ ) {
-		if ( (objp->type != OBJ_NONE) && ( objp->flags [Object::Object_Flags::Renders] ) )	{
-            objp->flags.remove(Object::Object_Flags::Was_rendered);
+	// the objects which could be in view, in object number order
+	SCP_frame_vector<int> candidates;
 
-			if ( !obj_in_view_cone(objp) ) {
-				continue;
-			}
+	{
+		TRACE_SCOPE(tracing::CullObjects);
 
-			if ( full_neb ) {
-				vec3d to_obj;
-				vm_vec_sub( &to_obj, &objp->pos, &Eye_position );
-				float z = vm_vec_dot( &Eye_matrix.vec.fvec, &to_obj );
+		for ( i = 0; i <= Highest_object_index; i++ ) {
+			objp = &Objects[i];
+			if ( (objp->type != OBJ_NONE) && ( objp->flags [Object::Object_Flags::Renders] ) )	{
+				objp->flags.remove(Object::Object_Flags::Was_rendered);
 
-				if ( neb2_skip_render(objp, z) ){
-					continue;
+				if ( Num_objects < OBJ_RENDER_MIN_GRID_OBJECTS ) {
+					candidates.push_back(i);
 				}
 			}
+		}
+
+		// with lots of objects, whole clusters of them can be dropped at once
+		if ( Num_objects >= OBJ_RENDER_MIN_GRID_OBJECTS ) {
+			obj_grid_begin(OBJ_GRID_ALL_TYPES, obj_view_cone_size);
+			obj_grid_find_unculled(candidates, obj_box_outside_view_cone);
+			obj_grid_end();
+
+			// the grid keeps the order of obj_used_list, so render in the same order as with fewer objects
+			std::sort(candidates.begin(), candidates.end());
+		}
+	}
+
+	if ( Cmdline_occlusion_cull ) {
+		occlusion_begin();
 
+		for ( int objnum : candidates ) {
+			objp = &Objects[objnum];
 
-			if ( (objp->type == OBJ_SHIP) && Ships[objp->instance].shader_effect_timestamp.isValid() ) {
-				effect_ships.push_back(objp);
+			if ( objp->flags[Object::Object_Flags::Renders] && occlusion_can_occlude(objp) && obj_in_view_cone(objp) ) {
+				occlusion_add_occluder(objp);
+			}
+		}
+	}
+
+	for ( int objnum : candidates ) {
+		objp = &Objects[objnum];
+
+		if ( !objp->flags[Object::Object_Flags::Renders] ) {
+			continue;
+		}
+
+		if ( !obj_in_view_cone(objp) ) {
+			continue;
+		}
+
+		// the occluders themselves are never behind their own hulls
+		if ( Cmdline_occlusion_cull && occlusion_sphere_hidden(&objp->pos, obj_view_cone_size(objp)) ) {
+			continue;
+		}
+
+		if ( full_neb ) {
+			vec3d to_obj;
+			vm_vec_sub( &to_obj, &objp->pos, &Eye_position );
+			float z = vm_vec_dot( &Eye_matrix.vec.fvec, &to_obj );
+
+			if ( neb2_skip_render(objp, z) ){
 				continue;
 			}
+		}
+
 
-            objp->flags.set(Object::Object_Flags::Was_rendered);
-			obj_queue_render(objp, &scene);
+		if ( (objp->type == OBJ_SHIP) && Ships[objp->instance].shader_effect_timestamp.isValid() ) {
+			effect_ships.push_back(objp);
+			continue;
 		}
+
+		objp->flags.set(Object::Object_Flags::Was_rendered);
+		obj_queue_render(objp, &scene);
 	}
 
+	if ( Cmdline_occlusion_cull ) {
+		occlusion_end();
+	}
+
+	asteroid_render_dormant(&scene);
+
 	scene.init_render();
 
 	scene.render_all(ZBUFFER_TYPE_FULL);
@@ -291,7 +291,7 @@ waypoint *find_matching_waypoint(const char *name)
 
 waypoint *find_waypoint_with_objnum(int objnum)
 {
-	if (objnum < 0 || objnum >= MAX_OBJECTS || Objects[objnum].type != OBJ_WAYPOINT)
+	if (objnum < 0 || objnum >= (int)Objects.size() || Objects[objnum].type != OBJ_WAYPOINT)
 		return nullptr;
 
 	return find_waypoint_with_instance(Objects[objnum].instance);
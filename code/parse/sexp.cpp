@@ -77,6 +77,7 @@
 #include "network/multiutil.h"
 #include "object/objcollide.h"
 #include "object/objectdock.h"
+#include "object/objectgrid.h"
 #include "object/objectshield.h"
 #include "object/objectsnd.h"
 #include "object/waypoint.h"
@@ -8041,7 +8042,7 @@ int sexp_special_warp_dist( int n)
 	auto shipp = ship_entry->shipp();
 
 	// check that ship has warpout_objnum
-	if (shipp->special_warpout_objnum < 0 || shipp->special_warpout_objnum >= MAX_OBJECTS) {
+	if (shipp->special_warpout_objnum < 0 || shipp->special_warpout_objnum >= (int)Objects.size()) {
 		return SEXP_NAN;
 	}
 
@@ -14900,16 +14901,16 @@ void sexp_explosion_effect(int n)
 		{
 			float t_blast = 0.0f;
 			float t_damage = 0.0f;
-			for (auto objp: list_range(&obj_used_list))
+			SCP_frame_vector<int> candidates;
+			obj_find_in_sphere(candidates, &origin, (float)outer_radius, OBJ_GRID_TYPE(OBJ_SHIP) | OBJ_GRID_TYPE(OBJ_ASTEROID));
+
+			for (int objnum : candidates)
 			{
+				auto objp = &Objects[objnum];
+
 				if (objp->flags[Object::Object_Flags::Should_be_dead])
 					continue;
 
-				if ( (objp->type != OBJ_SHIP) && (objp->type != OBJ_ASTEROID) )
-				{
-					continue;
-				}
-		
 				// don't blast no-collide or navbuoys
 				if ( !objp->flags[Object::Object_Flags::Collides] || (objp->type == OBJ_SHIP && ship_get_SIF(objp->instance)[Ship::Info_Flags::Navbuoy]) )
 				{
@@ -16906,8 +16907,8 @@ void sexp_set_asteroid_field(int n, bool new_sexp)
 		}
 	}
 
-	if (num_asteroids > MAX_ASTEROIDS) {
-		num_asteroids = MAX_ASTEROIDS;
+	if (num_asteroids > asteroid_max_field_asteroids()) {
+		num_asteroids = asteroid_max_field_asteroids();
 	}
 
 	vec3d o_min = vm_vec_new((float)o_minx, (float)o_miny, (float)o_minz);
@@ -17011,8 +17012,8 @@ void sexp_set_debris_field(int n, bool new_sexp)
 		n = CDR(n);
 	}
 
-	if (num_asteroids > MAX_ASTEROIDS) {
-		num_asteroids = MAX_ASTEROIDS;
+	if (num_asteroids > asteroid_max_field_asteroids()) {
+		num_asteroids = asteroid_max_field_asteroids();
 	}
 
 	vec3d o_min = vm_vec_new((float)o_minx, (float)o_miny, (float)o_minz);
@@ -21445,6 +21446,9 @@ void ship_copy_damage(const ship_registry_entry *target, const ship_registry_ent
 		if (target_ss->submodel_instance_2 && source_ss->submodel_instance_2)
 			target_ss->submodel_instance_2->blown_off = source_ss->submodel_instance_2->blown_off;
 	}
+
+	// the copied hits don't add up to the old aggregates
+	ship_recalc_subsys_strength(target_shipp);
 }
 
 void sexp_replace_texture(int n, bool skybox)
@@ -0,0 +1,237 @@
+#include "render/occlusion.h"
+
+#include "model/model.h"
+#include "object/object.h"
+#include "render/3d.h"
+#include "render/3dinternal.h"
+#include "ship/ship.h"
+#include "tracing/Monitor.h"
+#include "tracing/tracing.h"
+
+#include <algorithm>
+#include <cfloat>
+
+// the size of the depth buffer, which only has to be fine enough to hide small objects behind big hulls
+#define OCCLUSION_WIDTH			256
+#define OCCLUSION_HEIGHT		128
+
+// points closer to the eye than this aren't drawn, since their projection can't be trusted
+#define OCCLUSION_NEAR_Z		1.0f
+
+struct occlusion_point {
+	float x, y, z;
+	bool valid;
+};
+
+static bool Occlusion_active = false;
+static SCP_vector<float> Occlusion_depth;		// the closest occluder in each pixel, FLT_MAX if there is none
+static float Occlusion_scale_x, Occlusion_scale_y;	// from screen to buffer pixels
+static bool Occlusion_empty = true;
+
+static SCP_vector<occlusion_point> Occlusion_points;
+static SCP_vector<vec3d> Occlusion_world_points;
+
+MONITOR(NumOcclusionCulled)
+
+void occlusion_begin()
+{
+	Occlusion_active = true;
+	Occlusion_empty = true;
+
+	Occlusion_depth.assign(OCCLUSION_WIDTH * OCCLUSION_HEIGHT, FLT_MAX);
+	Occlusion_scale_x = i2fl(OCCLUSION_WIDTH) / i2fl(Canvas_width);
+	Occlusion_scale_y = i2fl(OCCLUSION_HEIGHT) / i2fl(Canvas_height);
+}
+
+void occlusion_end()
+{
+	Occlusion_active = false;
+}
+
+bool occlusion_can_occlude(const object *objp)
+{
+	if (objp->type != OBJ_SHIP || objp == Viewer_obj) {
+		return false;
+	}
+
+	auto shipp = &Ships[objp->instance];
+	auto sip = &Ship_info[shipp->ship_info_index];
+
+	if (!sip->is_big_or_huge()) {
+		return false;
+	}
+
+	// ships which are see-through, cut off by a warp effect or breaking up don't hide all of what's behind them
+	if (shipp->flags[Ship::Ship_Flags::Cloaked, Ship::Ship_Flags::Render_with_alpha_mult] || shipp->shader_effect_timestamp.isValid()
+		|| shipp->is_arriving() || shipp->is_dying_or_departing()) {
+		return false;
+	}
+
+	// the hull can't be projected if the eye is inside it
+	if (vm_vec_dist_squared(&objp->pos, &Eye_position) <= objp->radius * objp->radius) {
+		return false;
+	}
+
+	auto pm = model_get(sip->model_num);
+	return pm->n_detail_levels > 0 && pm->detail[0] >= 0 && pm->submodel[pm->detail[0]].collision_tree_index >= 0;
+}
+
+// fills in all the pixels whose centers are inside the triangle, at the depth of its farthest corner
+static void occlusion_draw_triangle(const occlusion_point *a, const occlusion_point *b, const occlusion_point *c)
+{
+	float area = (b->x - a->x) * (c->y - a->y) - (b->y - a->y) * (c->x - a->x);
+	if (fabsf(area) < 1e-6f) {
+		return;
+	}
+
+	int x0 = MAX(0, static_cast<int>(floorf(std::min({ a->x, b->x, c->x }))));
+	int x1 = MIN(OCCLUSION_WIDTH - 1, static_cast<int>(ceilf(std::max({ a->x, b->x, c->x }))));
+	int y0 = MAX(0, static_cast<int>(floorf(std::min({ a->y, b->y, c->y }))));
+	int y1 = MIN(OCCLUSION_HEIGHT - 1, static_cast<int>(ceilf(std::max({ a->y, b->y, c->y }))));
+
+	if (x0 > x1 || y0 > y1) {
+		return;
+	}
+
+	float z = std::max({ a->z, b->z, c->z });
+	float sign = (area > 0.0f) ? 1.0f : -1.0f;
+
+	for (int y = y0; y <= y1; ++y) {
+		float py = y + 0.5f;
+
+		for (int x = x0; x <= x1; ++x) {
+			float px = x + 0.5f;
+
+			float e0 = ((b->x - a->x) * (py - a->y) - (b->y - a->y) * (px - a->x)) * sign;
+			float e1 = ((c->x - b->x) * (py - b->y) - (c->y - b->y) * (px - b->x)) * sign;
+			float e2 = ((a->x - c->x) * (py - c->y) - (a->y - c->y) * (px - c->x)) * sign;
+
+			if (e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f) {
+				float &depth = Occlusion_depth[y * OCCLUSION_WIDTH + x];
+				depth = MIN(depth, z);
+			}
+		}
+	}
+}
+
+void occlusion_add_occluder(const object *objp)
+{
+	Assertion(Occlusion_active, "Occluders can only be added between occlusion_begin() and occlusion_end()!");
+
+	TRACE_SCOPE(tracing::DrawOccluders);
+
+	auto pm = model_get(Ship_info[Ships[objp->instance].ship_info_index].model_num);
+	auto tree = model_get_bsp_collision_tree(pm->submodel[pm->detail[0]].collision_tree_index);
+
+	// project all the points of the hull first, since the polygons share them
+	Occlusion_points.resize(tree->n_verts);
+	Occlusion_world_points.resize(tree->n_verts);
+
+	vm_vec_unrotate_add_n(Occlusion_world_points.data(), tree->point_list, tree->n_verts, &objp->orient, &objp->pos);
+
+	for (int i = 0; i < tree->n_verts; ++i) {
+		vertex v;
+		g3_rotate_vertex(&v, &Occlusion_world_points[i]);
+
+		auto &pt = Occlusion_points[i];
+		pt.valid = v.world.xyz.z >= OCCLUSION_NEAR_Z;
+
+		if (pt.valid) {
+			g3_project_vertex(&v);
+
+			pt.x = v.screen.xyw.x * Occlusion_scale_x;
+			pt.y = v.screen.xyw.y * Occlusion_scale_y;
+			pt.z = v.world.xyz.z;
+		}
+	}
+
+	// polygons are tested for facing the eye in model space
+	vec3d eye_local, to_eye;
+	vm_vec_sub(&to_eye, &Eye_position, &objp->pos);
+	vm_vec_rotate(&eye_local, &to_eye, &objp->orient);
+
+	for (int l = 0; l < tree->n_leaves; ++l) {
+		auto leaf = &tree->leaf_list[l];
+
+		if (leaf->num_verts < 3 || leaf->tmap_num >= pm->n_textures || pm->maps[leaf->tmap_num].is_transparent) {
+			continue;
+		}
+
+		// the back faces of a hull aren't drawn, so they don't hide anything
+		auto first = &tree->vert_list[leaf->vert_start];
+		vm_vec_sub(&to_eye, &eye_local, &tree->point_list[first->vertnum]);
+		if (vm_vec_dot(&to_eye, &leaf->plane_norm) <= 0.0f) {
+			continue;
+		}
+
+		auto a = &Occlusion_points[first->vertnum];
+		if (!a->valid) {
+			continue;
+		}
+
+		for (int k = 1; k < leaf->num_verts - 1; ++k) {
+			auto b = &Occlusion_points[tree->vert_list[leaf->vert_start + k].vertnum];
+			auto c = &Occlusion_points[tree->vert_list[leaf->vert_start + k + 1].vertnum];
+
+			if (b->valid && c->valid) {
+				occlusion_draw_triangle(a, b, c);
+			}
+		}
+	}
+
+	Occlusion_empty = false;
+}
+
+bool occlusion_sphere_hidden(const vec3d *pos, float radius)
+{
+	if (!Occlusion_active || Occlusion_empty) {
+		return false;
+	}
+
+	// the screen rectangle of the box around the sphere, and how close it gets
+	float min_x = FLT_MAX, min_y = FLT_MAX, max_x = -FLT_MAX, max_y = -FLT_MAX;
+	float min_z = FLT_MAX;
+
+	for (int i = 0; i < 8; ++i) {
+		vec3d corner;
+		vm_vec_make(&corner, (i & 1) ? radius : -radius, (i & 2) ? radius : -radius, (i & 4) ? radius : -radius);
+		vm_vec_add2(&corner, pos);
+
+		vertex v;
+		g3_rotate_vertex(&v, &corner);
+
+		if (v.world.xyz.z < OCCLUSION_NEAR_Z) {
+			return false;
+		}
+
+		g3_project_vertex(&v);
+
+		min_x = MIN(min_x, v.screen.xyw.x * Occlusion_scale_x);
+		max_x = MAX(max_x, v.screen.xyw.x * Occlusion_scale_x);
+		min_y = MIN(min_y, v.screen.xyw.y * Occlusion_scale_y);
+		max_y = MAX(max_y, v.screen.xyw.y * Occlusion_scale_y);
+		min_z = MIN(min_z, v.world.xyz.z);
+	}
+
+	// one pixel more all around, since the edge pixels of an occluder are only partly covered, but nothing off
+	// the screen can be seen anyway
+	int x0 = MAX(0, static_cast<int>(floorf(min_x)) - 1);
+	int x1 = MIN(OCCLUSION_WIDTH - 1, static_cast<int>(floorf(max_x)) + 1);
+	int y0 = MAX(0, static_cast<int>(floorf(min_y)) - 1);
+	int y1 = MIN(OCCLUSION_HEIGHT - 1, static_cast<int>(floorf(max_y)) + 1);
+
+	if (x0 > x1 || y0 > y1) {
+		return false;
+	}
+
+	for (int y = y0; y <= y1; ++y) {
+		for (int x = x0; x <= x1; ++x) {
+			if (Occlusion_depth[y * OCCLUSION_WIDTH + x] >= min_z) {
+				return false;
+			}
+		}
+	}
+
+	MONITOR_INC(NumOcclusionCulled, 1);
+	return true;
+}
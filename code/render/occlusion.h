@@ -0,0 +1,22 @@
+#ifndef _OCCLUSION_H
+#define _OCCLUSION_H
+
+#include "globalincs/pstypes.h"
+
+class object;
+
+// A coarse depth buffer which is drawn on the CPU from the hulls of big ships, so that the objects hidden behind them
+// can be skipped before any of their rendering is set up.  Must be used within a 3d frame, with the view of the scene.
+void occlusion_begin();
+void occlusion_end();
+
+// Whether an object can hide other objects: a big ship whose hull is fully drawn and opaque, and not around the eye
+bool occlusion_can_occlude(const object *objp);
+
+// Draws the hull of the ship into the depth buffer
+void occlusion_add_occluder(const object *objp);
+
+// True if the sphere around pos is completely hidden behind the occluders drawn so far
+bool occlusion_sphere_hidden(const vec3d *pos, float radius);
+
+#endif
@@ -978,7 +978,7 @@ ade_odata_setter<object_h> ade_object_to_odata(int obj_idx)
 {
 	using namespace scripting::api;
 
-	if(obj_idx < 0 || obj_idx >= MAX_OBJECTS)
+	if(obj_idx < 0 || obj_idx >= (int)Objects.size())
 		return l_Object.Set(object_h());
 
 	object *objp = &Objects[obj_idx];
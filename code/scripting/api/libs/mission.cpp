@@ -100,7 +100,7 @@ int object_subclass_at_index(A& object_subclass_array, size_t array_size, int in
 	for (size_t i = 0; i < array_size; ++i)
 	{
 		int objnum = object_subclass_array[i].objnum;
-		if (objnum < 0 || objnum >= MAX_OBJECTS)
+		if (objnum < 0 || objnum >= (int)Objects.size())
 			continue;
 		if (Objects[objnum].flags[Object::Object_Flags::Should_be_dead])
 			continue;
@@ -636,13 +636,13 @@ ADE_INDEXER(l_Mission_Weapons, "number Index", "Gets handle to a weapon object i
 
 	int objnum = -1;
 	if (idx > 0)
-		objnum = object_subclass_at_index(Weapons, MAX_WEAPONS, idx);
+		objnum = object_subclass_at_index(Weapons, Weapons.size(), idx);
 
 	return ade_set_args(L, "o", l_Weapon.Set(object_h(objnum)));
 }
 ADE_FUNC(__len, l_Mission_Weapons, NULL, "Number of weapon objects in mission. Note that this is only accurate for one frame.", "number", "Number of weapon objects in mission")
 {
-	return ade_set_args(L, "i", object_subclass_count(Weapons, MAX_WEAPONS));
+	return ade_set_args(L, "i", object_subclass_count(Weapons, Weapons.size()));
 }
 
 //****SUBLIBRARY: Mission/Beams
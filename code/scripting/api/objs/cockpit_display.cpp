@@ -200,7 +200,7 @@ size_t cockpit_display_h::GetId() const {
 	return m_display_num;
 }
 bool cockpit_display_h::isValid() const {
-	if (m_obj_num < 0 || m_obj_num >= MAX_OBJECTS)
+	if (m_obj_num < 0 || m_obj_num >= (int)Objects.size())
 	{
 		return false;
 	}
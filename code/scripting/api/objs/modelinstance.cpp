@@ -329,6 +329,7 @@ ADE_VIRTVAR(Orientation, l_SubmodelInstance, "orientation", "Gets or sets the su
 	{
 		smi->canonical_prev_orient = smi->canonical_orient;
 		smi->canonical_orient = *mh->GetMatrix();
+		submodel_instance_moved(smi);
 
 		float angle = 0.0f;
 		vm_closest_angle_to_matrix(&smi->canonical_orient, &smih->GetSubmodel()->rotation_axis, &angle);
@@ -361,6 +362,7 @@ ADE_VIRTVAR(TranslationOffset,
 
 		smi->canonical_prev_offset = smi->canonical_offset;
 		smi->canonical_offset = *vec;
+		submodel_instance_moved(smi);
 
 		smi->cur_offset = vm_vec_mag(vec);
 	}
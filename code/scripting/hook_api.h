@@ -8,6 +8,7 @@
 
 #include "utils/tuples.h"
 
+#include <array>
 #include <utility>
 #include <optional>
 
@@ -36,10 +37,22 @@ struct HookParameterInstance {
 	}
 };
 
+// The names of the hook variables that were set for one run of a hook. This points at the names in the parameter list
+// of that run, so running a hook doesn't need to allocate anything to remember what it has to remove again.
+template <size_t N>
+struct HookParameterNames {
+	std::array<const SCP_string*, N> names;
+	size_t count = 0;
+
+	const SCP_string* const* begin() const { return names.data(); }
+	const SCP_string* const* end() const { return names.data() + count; }
+};
+
+template <size_t N>
 struct SetSingleHookVarHelper {
-	SCP_vector<SCP_string>& paramNames;
+	HookParameterNames<N>& paramNames;
 
-	SetSingleHookVarHelper(SCP_vector<SCP_string>& paramNames_) : paramNames(paramNames_) {}
+	SetSingleHookVarHelper(HookParameterNames<N>& paramNames_) : paramNames(paramNames_) {}
 
 	template <typename T>
 	void operator()(HookParameterInstance<T>&& instance)
@@ -49,9 +62,10 @@ struct SetSingleHookVarHelper {
 			return;
 		}
 
-		paramNames.push_back(instance.name);
+		// only the value is moved out of the instance, so the name stays valid for as long as the parameter list
+		paramNames.names[paramNames.count++] = &instance.name;
 
-		Script_system.SetHookVar(instance.name.c_str(),
+		Script_system.SetHookVar(instance.name,
 								 instance.type,
 								 detail::convert_arg_type(std::move(instance.value)));
 	}
@@ -66,11 +80,11 @@ struct HookParameterInstanceList {
 	{
 	}
 
-	void setHookVars(SCP_vector<SCP_string>& paramNames)
+	void setHookVars(HookParameterNames<sizeof...(Args)>& paramNames)
 	{
-		util::tuples::for_each<0, SetSingleHookVarHelper, HookParameterInstance<Args>...>(
+		util::tuples::for_each<0, SetSingleHookVarHelper<sizeof...(Args)>, HookParameterInstance<Args>...>(
 			std::move(params),
-			SetSingleHookVarHelper(paramNames));
+			SetSingleHookVarHelper<sizeof...(Args)>(paramNames));
 	}
 };
 
@@ -152,25 +166,26 @@ class HookImpl : public HookBase {
 	template <typename... Args>
 	int run(condition_t condition, detail::HookParameterInstanceList<Args...> argsList = hook_param_list<Args...>()) const
 	{
-		if (!Scripting_game_init_run)
+		// no script uses this hook, so there's no point in handing the parameters to Lua
+		if (!Scripting_game_init_run || !Script_system.IsActiveAction(this->_hookId))
 			return 0;
 
-		SCP_vector<SCP_string> paramNames;
+		detail::HookParameterNames<sizeof...(Args)> paramNames;
 		argsList.setHookVars(paramNames);
 
 #ifndef NDEBUG
-		std::for_each(paramNames.begin(), paramNames.end(), [this](const SCP_string& param) {
-			Assertion(this->hasParameter(param),
+		std::for_each(paramNames.begin(), paramNames.end(), [this](const SCP_string* param) {
+			Assertion(this->hasParameter(*param),
 				"Hook '%s' does not accept parameter '%s'.",
 				this->_hookName.c_str(),
-				param.c_str());
+				param->c_str());
 			});
 #endif
 
-		const auto num_run = Script_system.RunCondition(this->_hookId, std::any(std::move(condition)));
+		const auto num_run = Script_system.RunCondition(this->_hookId, std::any(static_cast<const condition_t*>(&condition)));
 
-		for (const auto& param : paramNames) {
-			Script_system.RemHookVar(param.c_str());
+		for (const auto param : paramNames) {
+			Script_system.RemHookVar(*param);
 		}
 
 		return num_run;
@@ -186,25 +201,26 @@ class HookImpl<void> : public HookBase {
 	template <typename... Args>
 	int run(detail::HookParameterInstanceList<Args...> argsList = hook_param_list<Args...>()) const
 	{
-		if (!Scripting_game_init_run)
+		// no script uses this hook, so there's no point in handing the parameters to Lua
+		if (!Scripting_game_init_run || !Script_system.IsActiveAction(this->_hookId))
 			return 0;
 
-		SCP_vector<SCP_string> paramNames;
+		detail::HookParameterNames<sizeof...(Args)> paramNames;
 		argsList.setHookVars(paramNames);
 
 #ifndef NDEBUG
-		std::for_each(paramNames.begin(), paramNames.end(), [this](const SCP_string& param) {
-			Assertion(this->hasParameter(param),
+		std::for_each(paramNames.begin(), paramNames.end(), [this](const SCP_string* param) {
+			Assertion(this->hasParameter(*param),
 				"Hook '%s' does not accept parameter '%s'.",
 				this->_hookName.c_str(),
-				param.c_str());
+				param->c_str());
 			});
 #endif
 
 		const auto num_run = Script_system.RunCondition(this->_hookId, std::any{});
 
-		for (const auto& param : paramNames) {
-			Script_system.RemHookVar(param.c_str());
+		for (const auto param : paramNames) {
+			Script_system.RemHookVar(*param);
 		}
 
 		return num_run;
@@ -245,25 +261,25 @@ class OverridableHookImpl : public Hook<condition_t> {
 	template <typename... Args>
 	bool isOverride(condition_t condition, detail::HookParameterInstanceList<Args...> argsList = hook_param_list<Args...>()) const
 	{
-		if (!Scripting_game_init_run)
+		if (!Scripting_game_init_run || !Script_system.IsActiveAction(this->_hookId))
 			return false;
 
-		SCP_vector<SCP_string> paramNames;
+		detail::HookParameterNames<sizeof...(Args)> paramNames;
 		argsList.setHookVars(paramNames);
 
 #ifndef NDEBUG
-		std::for_each(paramNames.begin(), paramNames.end(), [this](const SCP_string& param) {
-			Assertion(this->hasParameter(param),
+		std::for_each(paramNames.begin(), paramNames.end(), [this](const SCP_string* param) {
+			Assertion(this->hasParameter(*param),
 				"Hook '%s' does not accept parameter '%s'.",
 				this->_hookName.c_str(),
-				param.c_str());
+				param->c_str());
 			});
 #endif
 
-		const auto ret_val = Script_system.IsConditionOverride(this->_hookId, std::any(std::move(condition)));
+		const auto ret_val = Script_system.IsConditionOverride(this->_hookId, std::any(static_cast<const condition_t*>(&condition)));
 
-		for (const auto& param : paramNames) {
-			Script_system.RemHookVar(param.c_str());
+		for (const auto param : paramNames) {
+			Script_system.RemHookVar(*param);
 		}
 
 		return ret_val;
@@ -279,25 +295,25 @@ protected:
 	template <typename... Args>
 	bool isOverride(detail::HookParameterInstanceList<Args...> argsList = hook_param_list<Args...>()) const
 	{
-		if (!Scripting_game_init_run)
+		if (!Scripting_game_init_run || !Script_system.IsActiveAction(this->_hookId))
 			return false;
 
-		SCP_vector<SCP_string> paramNames;
+		detail::HookParameterNames<sizeof...(Args)> paramNames;
 		argsList.setHookVars(paramNames);
 
 #ifndef NDEBUG
-		std::for_each(paramNames.begin(), paramNames.end(), [this](const SCP_string& param) {
-			Assertion(this->hasParameter(param),
+		std::for_each(paramNames.begin(), paramNames.end(), [this](const SCP_string* param) {
+			Assertion(this->hasParameter(*param),
 				"Hook '%s' does not accept parameter '%s'.",
 				this->_hookName.c_str(),
-				param.c_str());
+				param->c_str());
 			});
 #endif
 
 		const auto ret_val = Script_system.IsConditionOverride(this->_hookId, std::any{});
 
-		for (const auto& param : paramNames) {
-			Script_system.RemHookVar(param.c_str());
+		for (const auto param : paramNames) {
+			Script_system.RemHookVar(*param);
 		}
 
 		return ret_val;
@@ -19,6 +19,11 @@
 	build.emplace(conditionParseName, ::make_unique<ParseableConditionImpl<conditionsClassName, \
 		decltype(std::declval<conditionsClassName>().argument), decltype(argumentParse(std::declval<SCP_string>()))>> \
 		(documentation, &conditionsClassName::argument, argumentParse, argumentValid))
+// for conditions that are only true if argumentIndex(argument) is the parsed value, which lets hooks be indexed by it
+#define HOOK_CONDITION_INDEXED(conditionsClassName, conditionParseName, documentation, argument, argumentParse, argumentValid, argumentIndex) \
+	build.emplace(conditionParseName, ::make_unique<ParseableConditionImpl<conditionsClassName, \
+		decltype(std::declval<conditionsClassName>().argument), decltype(argumentParse(std::declval<SCP_string>()))>> \
+		(documentation, &conditionsClassName::argument, argumentParse, argumentValid, argumentIndex))
 
 extern const char *Scan_code_text_english[];
 
@@ -32,6 +37,7 @@ class ParseableConditionImpl : public ParseableCondition {
 	const operating_t conditions_t::* object;
 	std::function<cache_t(const SCP_string&)> cache;
 	std::function<bool(operating_t, const cache_t&)> evaluate;
+	std::function<int(operating_t)> index;
 
 	template<typename _conditions_t, typename _operating_t, typename _cache_t> friend class EvaluatableConditionImpl;
 public:
@@ -39,8 +45,13 @@ public:
 		return ::make_unique<EvaluatableConditionImpl<conditions_t, operating_t, cache_t>>(*this, input);
 	}
 
-	ParseableConditionImpl(SCP_string documentation_, const operating_t conditions_t::* object_, std::function<cache_t(const SCP_string&)> cache_, std::function<bool(operating_t, const cache_t&)> evaluate_) :
-		ParseableCondition(std::move(documentation_)), object(object_), cache(std::move(cache_)), evaluate(std::move(evaluate_)) { }
+	int getIndexValue(const std::any& conditionContext) const override {
+		const conditions_t& conditions = *std::any_cast<const conditions_t*>(conditionContext);
+		return index(conditions.*object);
+	}
+
+	ParseableConditionImpl(SCP_string documentation_, const operating_t conditions_t::* object_, std::function<cache_t(const SCP_string&)> cache_, std::function<bool(operating_t, const cache_t&)> evaluate_, std::function<int(operating_t)> index_ = nullptr) :
+		ParseableCondition(std::move(documentation_)), object(object_), cache(std::move(cache_)), evaluate(std::move(evaluate_)), index(std::move(index_)) { }
 };
 
 template<typename conditions_t, typename operating_t, typename cache_t>
@@ -52,9 +63,19 @@ public:
 	EvaluatableConditionImpl(const ParseableConditionImpl<conditions_t, operating_t, cache_t>& _condition, const SCP_string& input) : condition(_condition), cached(condition.cache(input)) { }
 
 	bool evaluate(const std::any& conditionContext) const override {
-		const conditions_t& conditions = std::any_cast<conditions_t>(conditionContext);
+		const conditions_t& conditions = *std::any_cast<const conditions_t*>(conditionContext);
 		return condition.evaluate(conditions.*(condition.object), cached);
 	}
+
+	const ParseableCondition* getIndex(int& value) const override {
+		if constexpr (std::is_same_v<cache_t, int>) {
+			if (condition.index) {
+				value = cached;
+				return &condition;
+			}
+		}
+		return nullptr;
+	}
 };
 
 
@@ -82,6 +103,28 @@ static bool conditionIsObjecttype(const object* objp, const int& value) {
 	return objp != nullptr && objp->type == value;
 }
 
+// the values that the class and type conditions above are indexed by
+
+static int conditionIndexShipClass(const ship* shipp) {
+	return shipp != nullptr ? shipp->ship_info_index : -1;
+}
+
+static int conditionIndexWeaponClass(const weapon* wep) {
+	return wep != nullptr ? wep->weapon_info_index : -1;
+}
+
+static int conditionIndexObjecttype(const object* objp) {
+	return objp != nullptr ? objp->type : -1;
+}
+
+static int conditionIndexObjectShipClass(const object* objp) {
+	return (objp != nullptr && objp->type == OBJ_SHIP) ? Ships[objp->instance].ship_info_index : -1;
+}
+
+static int conditionIndexObjectWeaponClass(const object* objp) {
+	return (objp != nullptr && objp->type == OBJ_WEAPON) ? Weapons[objp->instance].weapon_info_index : -1;
+}
+
 template<typename fnc_t, typename value_t>
 static bool conditionObjectIsShipDo(fnc_t fnc, const object* objp, const value_t& value) {
 	if (objp != nullptr && objp->type == OBJ_SHIP) {
@@ -161,16 +204,16 @@ static int conditionParseRawControl(const SCP_string& name) {
 
 #define HOOK_CONDITION_SHIPP(classname, prefix, documentationAddendum, shipp) \
 	HOOK_CONDITION(classname, prefix "Ship", "Specifies the name of the ship " documentationAddendum, shipp, conditionParseString, conditionCompareShip); \
-	HOOK_CONDITION(classname, prefix "Ship class", "Specifies the class of the ship " documentationAddendum, shipp, conditionParseShipClass, conditionCompareShipClass); \
+	HOOK_CONDITION_INDEXED(classname, prefix "Ship class", "Specifies the class of the ship " documentationAddendum, shipp, conditionParseShipClass, conditionCompareShipClass, conditionIndexShipClass); \
 	HOOK_CONDITION(classname, prefix "Ship type", "Specifies the type of the ship " documentationAddendum, shipp, conditionParseShipType, conditionCompareShipType); 
 
 #define HOOK_CONDITION_SHIP_OBJP(classname, prefix, documentationAddendum, objp_) \
 	HOOK_CONDITION(classname, prefix "Ship", "Specifies the name of the ship " documentationAddendum, objp_, conditionParseString, [](const object* objp, const SCP_string& shipname) -> bool { \
 		return conditionObjectIsShipDo(&conditionCompareShip, objp, shipname); \
 	}); \
-	HOOK_CONDITION(classname, prefix "Ship class", "Specifies the class of the ship " documentationAddendum, objp_, conditionParseShipClass, [](const object* objp, const int& shipclass) -> bool { \
+	HOOK_CONDITION_INDEXED(classname, prefix "Ship class", "Specifies the class of the ship " documentationAddendum, objp_, conditionParseShipClass, [](const object* objp, const int& shipclass) -> bool { \
 		return conditionObjectIsShipDo(&conditionCompareShipClass, objp, shipclass); \
-	}); \
+	}, conditionIndexObjectShipClass); \
 	HOOK_CONDITION(classname, prefix "Ship type", "Specifies the type of the ship " documentationAddendum, objp_, conditionParseShipType, [](const object* objp, const int& shiptype) -> bool { \
 		return conditionObjectIsShipDo(&conditionCompareShipType, objp, shiptype); \
 	});
@@ -241,15 +284,15 @@ HOOK_CONDITIONS_START(ShipDepartConditions)
 HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(WeaponDeathConditions)
-	HOOK_CONDITION(WeaponDeathConditions, "Weapon class", "Specifies the class of the weapon that died.", dying_wep, conditionParseWeaponClass, conditionCompareWeaponClass);
+	HOOK_CONDITION_INDEXED(WeaponDeathConditions, "Weapon class", "Specifies the class of the weapon that died.", dying_wep, conditionParseWeaponClass, conditionCompareWeaponClass, conditionIndexWeaponClass);
 HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(ObjectDeathConditions)
 	HOOK_CONDITION_SHIP_OBJP(ObjectDeathConditions, "", "that died.", dying_objp);
-	HOOK_CONDITION(ObjectDeathConditions, "Weapon class", "Specifies the class of the weapon that died.", dying_objp, conditionParseWeaponClass, [](const object* objp, const int& weaponclass) -> bool {
+	HOOK_CONDITION_INDEXED(ObjectDeathConditions, "Weapon class", "Specifies the class of the weapon that died.", dying_objp, conditionParseWeaponClass, [](const object* objp, const int& weaponclass) -> bool {
 		return conditionObjectIsWeaponDo(&conditionCompareWeaponClass, objp, weaponclass);
-	});
-	HOOK_CONDITION(ObjectDeathConditions, "Object type", "Specifies the type of the object that died.", dying_objp, conditionParseObjectType, conditionIsObjecttype);
+	}, conditionIndexObjectWeaponClass);
+	HOOK_CONDITION_INDEXED(ObjectDeathConditions, "Object type", "Specifies the type of the object that died.", dying_objp, conditionParseObjectType, conditionIsObjecttype, conditionIndexObjecttype);
 HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(ShipArriveConditions)
@@ -258,8 +301,8 @@ HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(WeaponCreatedConditions)
 	HOOK_CONDITION_SHIP_OBJP(WeaponCreatedConditions, "", "that fired the weapon.", parent_objp);
-	HOOK_CONDITION(WeaponCreatedConditions, "Object type", "Specifies the type of the object that is the parent of this weapon.", parent_objp, conditionParseObjectType, conditionIsObjecttype);
-	HOOK_CONDITION(WeaponCreatedConditions, "Weapon class", "Specifies the class of the weapon that was fired.", spawned_wep, conditionParseWeaponClass, conditionCompareWeaponClass);
+	HOOK_CONDITION_INDEXED(WeaponCreatedConditions, "Object type", "Specifies the type of the object that is the parent of this weapon.", parent_objp, conditionParseObjectType, conditionIsObjecttype, conditionIndexObjecttype);
+	HOOK_CONDITION_INDEXED(WeaponCreatedConditions, "Weapon class", "Specifies the class of the weapon that was fired.", spawned_wep, conditionParseWeaponClass, conditionCompareWeaponClass, conditionIndexWeaponClass);
 HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(WeaponEquippedConditions)
@@ -296,10 +339,10 @@ HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(ObjectDrawConditions)
 	HOOK_CONDITION_SHIP_OBJP(ObjectDrawConditions, "", "that was drawn / drawn from.", drawn_from_objp);
-	HOOK_CONDITION(ObjectDrawConditions, "Weapon class", "Specifies the class of the weapon that was drawn / drawn from.", drawn_from_objp, conditionParseWeaponClass, [](const object* objp, const int& weaponclass) -> bool {
+	HOOK_CONDITION_INDEXED(ObjectDrawConditions, "Weapon class", "Specifies the class of the weapon that was drawn / drawn from.", drawn_from_objp, conditionParseWeaponClass, [](const object* objp, const int& weaponclass) -> bool {
 		return conditionObjectIsWeaponDo(&conditionCompareWeaponClass, objp, weaponclass);
-	});
-	HOOK_CONDITION(ObjectDrawConditions, "Object type", "Specifies the type of the object that was drawn / drawn from.", drawn_from_objp, conditionParseObjectType, conditionIsObjecttype);
+	}, conditionIndexObjectWeaponClass);
+	HOOK_CONDITION_INDEXED(ObjectDrawConditions, "Object type", "Specifies the type of the object that was drawn / drawn from.", drawn_from_objp, conditionParseObjectType, conditionIsObjecttype, conditionIndexObjecttype);
 HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(KeyPressConditions)
@@ -308,7 +351,7 @@ HOOK_CONDITIONS_END
 
 HOOK_CONDITIONS_START(CommOrderConditions)
 	HOOK_CONDITION_SHIPP(CommOrderConditions, "", "that sent the order.", source);
-	HOOK_CONDITION(CommOrderConditions, "Object type", "Specifies the type of object that is the target of the order.", target, conditionParseObjectType, conditionIsObjecttype);
+	HOOK_CONDITION_INDEXED(CommOrderConditions, "Object type", "Specifies the type of object that is the target of the order.", target, conditionParseObjectType, conditionIsObjecttype, conditionIndexObjecttype);
 	HOOK_CONDITION_SHIP_OBJP(CommOrderConditions, "Target ", "that is being targeted.", target);
 HOOK_CONDITIONS_END
 
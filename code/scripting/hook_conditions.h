@@ -13,12 +13,23 @@ enum class ArrivalLocation;
 
 namespace scripting {
 
+class ParseableCondition;
+
+// The condition context handed to evaluate() holds a pointer to the hook's conditions struct, so that running a hook
+// doesn't have to copy the struct into the std::any.
 class EvaluatableCondition {
 public:
 	virtual bool evaluate(const std::any& /*conditionContext*/) const {
 		return false;
 	};
 
+	// Conditions that can only be true when one cheap-to-find value of the event (a ship class, a weapon class, an
+	// object type) equals the value they were parsed with return the condition they were parsed from and set value.
+	// The script system uses this to index the actions of a hook and skip the ones that can't match.
+	virtual const ParseableCondition* getIndex(int& /*value*/) const {
+		return nullptr;
+	}
+
 	virtual ~EvaluatableCondition() = default;
 };
 
@@ -30,6 +41,11 @@ public:
 		return make_unique<EvaluatableCondition>();
 	};
 
+	// the value of the event that conditions returned from getIndex() are matched against
+	virtual int getIndexValue(const std::any& /*conditionContext*/) const {
+		return -1;
+	}
+
 	ParseableCondition() : documentation("Invalid Condition. Will never evaluate.") { }
 
 	virtual ~ParseableCondition() = default;
@@ -436,9 +436,14 @@ void script_state::SetHookObjects(int num, ...)
 	va_end(vl);
 }
 
-void script_state::RemHookVar(const char* name)
+void script_state::RemHookVar(const SCP_string& name)
 {
-	this->RemHookVars({name});
+	if (LuaState != nullptr) {
+		auto hookVar = HookVariableValues.find(name);
+		if (hookVar != HookVariableValues.end() && !hookVar->second.empty()) {
+			hookVar->second.pop_back();
+		}
+	}
 }
 
 void script_state::RemHookVars(std::initializer_list<SCP_string> names)
@@ -501,13 +506,26 @@ int script_state::RunCondition(int action_type, const std::any& local_condition_
 	if (action_it == ConditionalHooks.end())
 		return num;
 
-	for(const auto& action : action_it->second) 
-	{
-		if (action.ConditionsValid(local_condition_data))
-		{
-			RunBytecode(action.hook.hook_function);
-			num++;
+	// The actions are accessed by position since a nested hook may add actions to this list. Those only run from the
+	// next time on.
+	const auto& actions = action_it->second;
+	const auto candidates = GetActionCandidates(action_type, actions.size(), local_condition_data);
+
+	if (candidates == nullptr) {
+		for (size_t i = 0, num_actions = actions.size(); i < num_actions; ++i) {
+			if (actions[i].ConditionsValid(local_condition_data)) {
+				RunBytecode(actions[i].hook.hook_function);
+				num++;
+			}
+		}
+	} else {
+		for (const auto i : *candidates) {
+			if (actions[i].ConditionsValid(local_condition_data)) {
+				RunBytecode(actions[i].hook.hook_function);
+				num++;
+			}
 		}
+		ActionCandidatesDepth--;
 	}
 
 	ProcessAddedHooks();
@@ -520,15 +538,55 @@ bool script_state::IsConditionOverride(int action_type, const std::any& local_co
 	if (action_it == ConditionalHooks.end())
 		return false;
 
-	for (const auto& action : action_it->second)
-	{
-		if (action.ConditionsValid(local_condition_data))
-		{
-			if (IsOverride(action.hook))
-				return true;
+	const auto& actions = action_it->second;
+	const auto candidates = GetActionCandidates(action_type, actions.size(), local_condition_data);
+	bool is_override = false;
+
+	if (candidates == nullptr) {
+		for (size_t i = 0, num_actions = actions.size(); i < num_actions && !is_override; ++i) {
+			is_override = actions[i].ConditionsValid(local_condition_data) && IsOverride(actions[i].hook);
+		}
+	} else {
+		for (size_t i = 0; i < candidates->size() && !is_override; ++i) {
+			const auto& action = actions[(*candidates)[i]];
+			is_override = action.ConditionsValid(local_condition_data) && IsOverride(action.hook);
+		}
+		ActionCandidatesDepth--;
+	}
+
+	return is_override;
+}
+
+// Returns nullptr if the hook isn't indexed, in which case all of its actions have to be checked. Otherwise this returns
+// the actions that can match in order and the caller has to decrement ActionCandidatesDepth once it is done with them.
+const SCP_vector<size_t>* script_state::GetActionCandidates(int action_type, size_t num_actions, const std::any& local_condition_data)
+{
+	auto index_it = ActionIndices.find(action_type);
+	if (index_it == ActionIndices.end() || index_it->second.indexed.empty())
+		return nullptr;
+
+	const auto& index = index_it->second;
+
+	if (ActionCandidatesDepth >= ActionCandidates.size()) {
+		ActionCandidates.emplace_back(make_unique<SCP_vector<size_t>>());
+	}
+	auto& candidates = *ActionCandidates[ActionCandidatesDepth++];
+	candidates.assign(index.unindexed.begin(), index.unindexed.end());
+
+	for (const auto& condition_index : index.indexed) {
+		auto matching = condition_index.second.find(condition_index.first->getIndexValue(local_condition_data));
+		if (matching != condition_index.second.end()) {
+			candidates.insert(candidates.end(), matching->second.begin(), matching->second.end());
 		}
 	}
-	return false;
+
+	// the actions have to run in the order they were added, no matter which list they came from
+	if (index.indexed.size() > 1 || !index.unindexed.empty()) {
+		std::sort(candidates.begin(), candidates.end());
+	}
+
+	Assertion(candidates.empty() || candidates.back() < num_actions, "Action index of hook %d is out of date!", action_type);
+	return &candidates;
 }
 
 void script_state::Clear()
@@ -536,6 +594,8 @@ void script_state::Clear()
 	// Free all lua value references
 	ConditionalHooks.clear();
 	HookVariableValues.clear();
+	ActionCandidates.clear();
+	ActionCandidatesDepth = 0;
 
 	AssayActions();
 
@@ -1013,9 +1073,36 @@ void script_state::AddGameInitFunction(script_function func) { GameInitFunctions
 // AssayActions() after modifying ConditionalHooks before returning to normal operation of the scripting system!
 void script_state::AssayActions() {
 	ActiveActions.clear();
+	ActionIndices.clear();
 
 	for (const auto &hook : ConditionalHooks) {
 		ActiveActions[hook.first] = !hook.second.empty();
+
+		auto& index = ActionIndices[hook.first];
+		for (size_t i = 0; i < hook.second.size(); ++i) {
+			const ParseableCondition* indexCondition = nullptr;
+			int value = -1;
+
+			for (const auto& local_condition : hook.second[i].local_conditions) {
+				indexCondition = local_condition->getIndex(value);
+				if (indexCondition != nullptr)
+					break;
+			}
+
+			if (indexCondition == nullptr) {
+				index.unindexed.push_back(i);
+				continue;
+			}
+
+			auto condition_it = std::find_if(index.indexed.begin(), index.indexed.end(), [indexCondition](const std::pair<const ParseableCondition*, SCP_unordered_map<int, SCP_vector<size_t>>>& entry) {
+				return entry.first == indexCondition;
+			});
+			if (condition_it == index.indexed.end()) {
+				index.indexed.emplace_back(indexCondition, SCP_unordered_map<int, SCP_vector<size_t>>());
+				condition_it = index.indexed.end() - 1;
+			}
+			condition_it->second[value].push_back(i);
+		}
 	}
 }
 
@@ -116,6 +116,14 @@ public:
 	bool ConditionsValid(const std::any& local_condition_data) const;
 };
 
+// Lets RunCondition skip the actions of a hook that can't match without evaluating their conditions. Every action is
+// either in the unindexed list or, if one of its local conditions supports it, in the index of the first such condition
+// under the value that condition needs. All lists hold positions in the hook's action list, in order.
+struct script_action_index {
+	SCP_vector<size_t> unindexed;
+	SCP_vector<std::pair<const scripting::ParseableCondition*, SCP_unordered_map<int, SCP_vector<size_t>>>> indexed;
+};
+
 //**********Main script_state function
 class script_state
 {
@@ -145,6 +153,14 @@ class script_state
 	// AssayActions is responsible for keeping it up to date.
 	SCP_unordered_map<int, bool> ActiveActions;
 
+	// Built by AssayActions as well. The candidate lists are kept per nesting level since hooks can run from within
+	// other hooks, and are reused so that running a hook doesn't allocate.
+	SCP_unordered_map<int, script_action_index> ActionIndices;
+	SCP_vector<std::unique_ptr<SCP_vector<size_t>>> ActionCandidates;
+	size_t ActionCandidatesDepth = 0;
+
+	const SCP_vector<size_t>* GetActionCandidates(int action_type, size_t num_actions, const std::any& local_condition_data);
+
 	void ParseChunkSub(script_function& out_func, const char* debug_str=NULL);
 
 	void SetLuaSession(struct lua_State *L);
@@ -182,10 +198,10 @@ public:
 	//void MoveData(script_state &in);
 
 	template<typename T>
-	void SetHookVar(const char *name, char format, T&& value);
+	void SetHookVar(const SCP_string& name, char format, T&& value);
 	void SetHookObject(const char *name, object *objp);
 	void SetHookObjects(int num, ...);
-	void RemHookVar(const char *name);
+	void RemHookVar(const SCP_string& name);
 	void RemHookVars(std::initializer_list<SCP_string> names);
 
 	const SCP_unordered_map<SCP_string, SCP_vector<luacpp::LuaReference>>& GetHookVariableReferences();
@@ -222,7 +238,7 @@ public:
 };
 
 template<typename T>
-void script_state::SetHookVar(const char *name, char format, T&& value)
+void script_state::SetHookVar(const SCP_string& name, char format, T&& value)
 {
 	if(format == '\0')
 		return;
@@ -64,6 +64,7 @@
 #include "object/objcollide.h"
 #include "object/object.h"
 #include "object/objectdock.h"
+#include "object/objectgrid.h"
 #include "object/objectshield.h"
 #include "object/objectsnd.h"
 #include "object/waypoint.h"
@@ -7183,6 +7184,7 @@ void ship::clear()
 	orders_allowed_against.clear();
 
 	subsys_list_indexer.reset();
+	subsys_lookup.clear();
 	subsys_list.clear();
 	// since these aren't cleared by clear()
 	subsys_list.next = NULL;
@@ -7741,33 +7743,106 @@ static void ship_set(int ship_index, int objnum, int ship_type)
  * Needed because several places in FreeSpace change subsystem strength and all 
  * this data needs to be kept up to date.
  */
-void ship_recalc_subsys_strength( ship *shipp )
+/**
+ * What an engine contributes to the engine strength of its ship.  Damaged engines still contribute ENGINE_MIN_STR.
+ */
+static float ship_engine_str(const ship_subsys *ss)
 {
-	int i;
-	ship_subsys *ship_system;
+	// an engine which can't be damaged is always at full strength
+	if (ss->max_hits <= 0.0f)
+		return 1.0f;
 
+	float ratio = ss->current_hits / ss->max_hits;
+	if ( ratio < ENGINE_MIN_STR )
+		ratio = ENGINE_MIN_STR;
+
+	return ratio;
+}
+
+/**
+ * Adds up the subsystems of a ship into the aggregate strengths of each type.
+ */
+static void ship_sum_subsys_strength(const ship *shipp, ship_subsys_info info[SUBSYSTEM_MAX])
+{
 	// fill in the subsys_info fields for all particular types of subsystems
-	// make the current strength be 1.0.  If there are initial conditions on the ship, then
-	// the mission parse code should take care of setting that.
-	for (i = 0; i < SUBSYSTEM_MAX; i++) {
-		shipp->subsys_info[i].type_count = 0;
-		shipp->subsys_info[i].aggregate_max_hits = 0.0f;
-		shipp->subsys_info[i].aggregate_current_hits = 0.0f;
+	for (int i = 0; i < SUBSYSTEM_MAX; i++) {
+		info[i].type_count = 0;
+		info[i].aggregate_max_hits = 0.0f;
+		info[i].aggregate_current_hits = 0.0f;
+		info[i].aggregate_engine_str = 0.0f;
 	}
 
 	// count all of the subsystems of a particular type.  For each generic type of subsystem, we store the
 	// total count of hits.  (i.e. for 3 engines, we store the sum of the max_hits for each engine)
-	for ( ship_system = GET_FIRST(&shipp->subsys_list); ship_system != END_OF_LIST(&shipp->subsys_list); ship_system = GET_NEXT(ship_system) ) {
+	for (auto ship_system : list_range(&shipp->subsys_list)) {
+		int type = ship_system->system_info->type;
+		Assert ( (type >= 0) && (type < SUBSYSTEM_MAX) );
 
 		if (!(ship_system->flags[Ship::Subsystem_Flags::No_aggregate])) {
-			int type = ship_system->system_info->type;
-			Assert ( (type >= 0) && (type < SUBSYSTEM_MAX) );
+			info[type].type_count++;
+			info[type].aggregate_max_hits += ship_system->max_hits;
+			info[type].aggregate_current_hits += ship_system->current_hits;
+		}
+
+		// all engines count towards the engine strength, even the ones which aren't aggregated
+		if (type == SUBSYSTEM_ENGINE) {
+			info[type].aggregate_engine_str += ship_engine_str(ship_system);
+		}
+	}
+}
+
+void ship_subsys_set_hits(ship *shipp, ship_subsys *ss, float hits)
+{
+	auto ssip = &shipp->subsys_info[ss->system_info->type];
+
+	if (!(ss->flags[Ship::Subsystem_Flags::No_aggregate])) {
+		ssip->aggregate_current_hits += hits - ss->current_hits;
+		CLAMP(ssip->aggregate_current_hits, 0.0f, ssip->aggregate_max_hits);
+	}
+
+	if (ss->system_info->type == SUBSYSTEM_ENGINE) {
+		ssip->aggregate_engine_str -= ship_engine_str(ss);
+		ss->current_hits = hits;
+		ssip->aggregate_engine_str += ship_engine_str(ss);
+	} else {
+		ss->current_hits = hits;
+	}
+}
+
+#ifndef NDEBUG
+void ship_validate_subsys_strength(ship *shipp)
+{
+	ship_subsys_info expected[SUBSYSTEM_MAX];
+	ship_sum_subsys_strength(shipp, expected);
+
+	for (int i = 0; i < SUBSYSTEM_MAX; i++) {
+		auto ssip = &shipp->subsys_info[i];
+
+		// the incremental updates pick up a little rounding error along the way
+		float tolerance = 0.01f + 0.001f * expected[i].aggregate_max_hits;
 
-			shipp->subsys_info[type].type_count++;
-			shipp->subsys_info[type].aggregate_max_hits += ship_system->max_hits;
-			shipp->subsys_info[type].aggregate_current_hits += ship_system->current_hits;
+		if ( (ssip->type_count != expected[i].type_count)
+			|| (fabsf(ssip->aggregate_max_hits - expected[i].aggregate_max_hits) > tolerance)
+			|| (fabsf(ssip->aggregate_current_hits - expected[i].aggregate_current_hits) > tolerance)
+			|| (fabsf(ssip->aggregate_engine_str - expected[i].aggregate_engine_str) > 0.001f * (expected[i].type_count + 1)) ) {
+			mprintf(("Aggregate strength of the %s subsystems of %s is %d/%.2f/%.2f/%.3f, but they add up to %d/%.2f/%.2f/%.3f\n",
+				Subsystem_types[i], shipp->ship_name,
+				ssip->type_count, ssip->aggregate_max_hits, ssip->aggregate_current_hits, ssip->aggregate_engine_str,
+				expected[i].type_count, expected[i].aggregate_max_hits, expected[i].aggregate_current_hits, expected[i].aggregate_engine_str));
+
+			*ssip = expected[i];
 		}
+	}
+}
+#endif
+
+void ship_recalc_subsys_strength( ship *shipp )
+{
+	// If there are initial conditions on the ship, then the mission parse code should take care of setting
+	// them before this is called.
+	ship_sum_subsys_strength(shipp, shipp->subsys_info);
 
+	for (auto ship_system : list_range(&shipp->subsys_list)) {
 		//Get rid of any persistent sounds on the subsystem
 		//This is inefficient + sloppy but there's not really an easy way to handle things
 		//if a subsystem is brought back from the dead, other than this
@@ -9401,14 +9476,15 @@ static void ship_blow_up_area_apply_blast( object *exp_objp)
 		object *objp;
 		float blast = 0.0f;
 		float damage = 0.0f;
-		for ( objp = GET_FIRST(&obj_used_list); objp !=END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp) ) {
+		SCP_frame_vector<int> candidates;
+		obj_find_in_sphere(candidates, &exp_objp->pos, outer_rad, OBJ_GRID_TYPE(OBJ_SHIP) | OBJ_GRID_TYPE(OBJ_ASTEROID));
+
+		for (int objnum : candidates) {
+			objp = &Objects[objnum];
+
 			if (objp->flags[Object::Object_Flags::Should_be_dead])
 				continue;
 
-			if ( (objp->type != OBJ_SHIP) && (objp->type != OBJ_ASTEROID) ) {
-				continue;
-			}
-		
 			if ( objp == exp_objp ){
 				continue;
 			}
@@ -10144,7 +10220,6 @@ void ship_do_weapon_thruster_frame( weapon *weaponp, object *objp, float frameti
 static void ship_auto_repair_frame(int shipnum, float frametime)
 {
 	ship_subsys		*ssp;
-	ship_subsys_info	*ssip;
 	ship			*sp;
 	ship_info		*sip;
 	object			*objp;
@@ -10205,7 +10280,6 @@ static void ship_auto_repair_frame(int shipnum, float frametime)
 	// iterate through subsystems, repair as needed based on elapsed frametime
 	for ( ssp = GET_FIRST(&sp->subsys_list); ssp != END_OF_LIST(&sp->subsys_list); ssp = GET_NEXT(ssp) ) {
 		Assert(ssp->system_info->type >= 0 && ssp->system_info->type < SUBSYSTEM_MAX);
-		ssip = &sp->subsys_info[ssp->system_info->type];
 
 		if (ssp->current_hits < ssp->max_hits) {
 
@@ -10228,22 +10302,14 @@ static void ship_auto_repair_frame(int shipnum, float frametime)
 			float repaired_delta = ssp->max_hits * real_repair_rate * frametime;
 			float repair_threshold_hits = ssp->max_hits * sip->subsys_repair_max;
 
-			if ((ssp->current_hits + repaired_delta) < repair_threshold_hits) {
-				ssp->current_hits += repaired_delta;
-			} else {
+			if ((ssp->current_hits + repaired_delta) >= repair_threshold_hits) {
 				repaired_delta = repair_threshold_hits - ssp->current_hits;
 				CLAMP(repaired_delta, 0.0f, repair_threshold_hits); // this will be negative if it is already way above the threshold
-				if (repaired_delta != 0.0f)
-					ssp->current_hits += repaired_delta;
 			}
 
-			// aggregate repair
-			if (!(ssp->flags[Ship::Subsystem_Flags::No_aggregate])) {
-				ssip->aggregate_current_hits += ssip->aggregate_max_hits * real_repair_rate * frametime;
-				if ( ssip->aggregate_current_hits > ssip->aggregate_max_hits ) {
-					ssip->aggregate_current_hits = ssip->aggregate_max_hits;
-				}
-			}
+			// the aggregate strength gets repaired along with it
+			if (repaired_delta != 0.0f)
+				ship_subsys_set_hits(sp, ssp, ssp->current_hits + repaired_delta);
 
 			// check to see if this subsystem was totally non functional before -- if so, then
 			// reset the flags
@@ -10976,6 +11042,10 @@ void ship_process_post(object * obj, float frametime)
 
 	ship_auto_repair_frame(num, frametime);
 
+#ifndef NDEBUG
+	ship_validate_subsys_strength(shipp);
+#endif
+
 	shipfx_do_lightning_frame(shipp);
 
 	// if the ship has an EMP effect active, process it
@@ -11893,7 +11963,7 @@ void change_ship_type(int n, int ship_type, int by_sexp)
 			}
 		}
 
-		for (i = 0; i < MAX_WEAPONS; i++) {
+		for (i = 0; i < (int)Weapons.size(); i++) {
 			if (Weapons[i].objnum == -1) {
 				continue;
 			}
@@ -14040,7 +14110,7 @@ static bool ship_fire_secondary_detonate(object *obj, ship_weapon *swp)
 			// check for currently locked missiles (highest precedence)
 			for ( mo = GET_FIRST(&Missile_obj_list); mo != END_OF_LIST(&Missile_obj_list); mo = GET_NEXT(mo) ) {
 				object	*mobjp;
-				Assert(mo->objnum >= 0 && mo->objnum < MAX_OBJECTS);
+				Assert(mo->objnum >= 0 && mo->objnum < (int)Objects.size());
 				mobjp = &Objects[mo->objnum];
 				if (mobjp->flags[Object::Object_Flags::Should_be_dead])
 					continue;
@@ -15618,6 +15688,130 @@ void object_get_eye(vec3d *eye_pos, matrix *eye_orient, const object *obj, bool
 	}
 }
 
+void ship_subsys_lookup::clear()
+{
+	name_first.clear();
+	name_next.clear();
+	by_type.clear();
+	std::fill(std::begin(type_start), std::end(type_start), 0);
+}
+
+/**
+ * Hash of a subsystem name which is the same for any two names that subsystem_stricmp() considers equal
+ */
+static uint32_t ship_subsys_name_hash(const char *name)
+{
+	size_t len = strlen(name);
+
+	// subsystem_stricmp() ignores a trailing s
+	if ((len > 0) && (SCP_tolower(name[len - 1]) == 's'))
+		len--;
+
+	// FNV-1a
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < len; ++i) {
+		hash ^= static_cast<uint32_t>(SCP_tolower(name[i]));
+		hash *= 16777619u;
+	}
+
+	// the map reserves this one
+	if (hash == util::FlatHashMap<int>::EMPTY_KEY)
+		hash = 0;
+
+	return hash;
+}
+
+/**
+ * Create or recreate the subsystem index cache.
+ */
+void ship_index_subsystems(ship *shipp)
+{
+	auto sinfo = &Ship_info[shipp->ship_info_index];
+	auto &lookup = shipp->subsys_lookup;
+
+	// if the indexer already exists, its size won't change, so don't reallocate it
+	if (shipp->subsys_list_indexer.get() == nullptr)
+		shipp->subsys_list_indexer.reset(new ship_subsys* [sinfo->n_subsystems]);
+
+	lookup.clear();
+	lookup.name_next.assign(sinfo->n_subsystems, -1);
+
+	auto ss = GET_FIRST(&shipp->subsys_list);
+	for (int index = 0; index < sinfo->n_subsystems; ++index)
+	{
+		// normal indexing to valid subsystems
+		if (ss != END_OF_LIST(&shipp->subsys_list))
+		{
+			shipp->subsys_list_indexer[index] = ss;
+			ss->parent_subsys_index = index;
+
+			// chain subsystems with the same name hash in list order, so that the first match is still found first
+			uint32_t hash = ship_subsys_name_hash(ss->system_info->subobj_name);
+			auto first = lookup.name_first.find(hash);
+			if (first == nullptr) {
+				lookup.name_first[hash] = index;
+			} else {
+				int last = *first;
+				while (lookup.name_next[last] >= 0)
+					last = lookup.name_next[last];
+				lookup.name_next[last] = index;
+			}
+
+			++lookup.type_start[ss->system_info->type + 1];
+
+			ss = GET_NEXT(ss);
+		}
+		// in the event we run out of subsystems (i.e. if not all subsystems were linked)
+		else
+		{
+			shipp->subsys_list_indexer[index] = nullptr;
+		}
+	}
+
+	// sort the subsystems by type
+	for (int type = 0; type < SUBSYSTEM_MAX; ++type)
+		lookup.type_start[type + 1] += lookup.type_start[type];
+
+	lookup.by_type.resize(lookup.type_start[SUBSYSTEM_MAX]);
+
+	int type_fill[SUBSYSTEM_MAX];
+	std::copy(lookup.type_start, lookup.type_start + SUBSYSTEM_MAX, type_fill);
+
+	for (int index = 0; index < sinfo->n_subsystems; ++index)
+	{
+		if (shipp->subsys_list_indexer[index] != nullptr)
+			lookup.by_type[type_fill[shipp->subsys_list_indexer[index]->system_info->type]++] = index;
+	}
+
+	shipp->flags.set(Ship::Ship_Flags::Subsystem_cache_valid);
+}
+
+/**
+ * Returns the subsystem lookups of a ship, rebuilding them first if they're out of date.
+ */
+static const ship_subsys_lookup &ship_get_subsys_lookup(const ship *shipp)
+{
+	// the caches aren't part of the ship's state as far as callers are concerned
+	if (!shipp->flags[Ship::Ship_Flags::Subsystem_cache_valid])
+		ship_index_subsystems(const_cast<ship *>(shipp));
+
+	return shipp->subsys_lookup;
+}
+
+/**
+ * Calls func on each subsystem of the given type, in the order of the ship's subsystem list, until it returns false.
+ */
+template <typename Func>
+static void ship_for_each_subsys_of_type(const ship *shipp, int type, Func func)
+{
+	const auto &lookup = ship_get_subsys_lookup(shipp);
+
+	for (int i = lookup.type_start[type]; i < lookup.type_start[type + 1]; ++i) {
+		if (!func(shipp->subsys_list_indexer[lookup.by_type[i]]))
+			return;
+	}
+}
+
 // of attackers to make this decision.
 //
 // NOTE: This function takes into account how many ships are attacking a subsystem, and will 
@@ -15632,7 +15826,6 @@ void object_get_eye(vec3d *eye_pos, matrix *eye_orient, const object *obj, bool
 #define MAX_SUBSYS_ATTACKERS 3
 ship_subsys *ship_get_best_subsys_to_attack(ship *sp, int subsys_type, const vec3d *attacker_pos)
 {
-	ship_subsys	*ss;
 	ship_subsys *best_in_sight_subsys, *lowest_attacker_subsys, *ss_return;
 	int			lowest_num_attackers, lowest_in_sight_attackers, num_attackers;
 	vec3d		gsubpos;
@@ -15640,8 +15833,8 @@ ship_subsys *ship_get_best_subsys_to_attack(ship *sp, int subsys_type, const vec
 	lowest_in_sight_attackers = lowest_num_attackers = 1000;
 	ss_return = best_in_sight_subsys = lowest_attacker_subsys = NULL;
 
-	for (ss = GET_FIRST(&sp->subsys_list); ss != END_OF_LIST(&sp->subsys_list); ss = GET_NEXT(ss) ) {
-		if ( (ss->system_info->type == subsys_type) && (ss->current_hits > 0) ) {
+	ship_for_each_subsys_of_type(sp, subsys_type, [&](ship_subsys *ss) {
+		if ( ss->current_hits > 0 ) {
 
 			// get world pos of subsystem
 			vm_vec_unrotate(&gsubpos, &ss->system_info->pnt, &Objects[sp->objnum].orient);
@@ -15670,7 +15863,8 @@ ship_subsys *ship_get_best_subsys_to_attack(ship *sp, int subsys_type, const vec
 				}
 			}
 		}
-	}
+		return true;
+	});
 
 	if ( best_in_sight_subsys == NULL ) {
 		// no subsystems are in sight, so return the subsystem with the lowest # of attackers
@@ -15705,12 +15899,17 @@ ship_subsys *ship_find_first_subsys(ship *sp, int subsys_type, const vec3d *atta
 	if ( attacker_pos != nullptr ) {
 		return ship_get_best_subsys_to_attack(sp, subsys_type, attacker_pos);
 	} else {
-		// next, scan the list of subsystems and search for the first subsystem of the particular
-		// type which has > 0 hits remaining.
-		for (auto ss : list_range(&sp->subsys_list)) {
-			if ( (ss->system_info->type == subsys_type) && (ss->current_hits > 0) )
-				return ss;
-		}
+		// next, scan the subsystems of the particular type and search for the first one
+		// which has > 0 hits remaining.
+		ship_subsys *first = nullptr;
+		ship_for_each_subsys_of_type(sp, subsys_type, [&](ship_subsys *ss) {
+			if ( ss->current_hits > 0 )
+				first = ss;
+			return first == nullptr;
+		});
+
+		if ( first != nullptr )
+			return first;
 	}
 		
 	// maybe we shouldn't get here, but with possible floating point rounding, I suppose we could
@@ -15718,36 +15917,6 @@ ship_subsys *ship_find_first_subsys(ship *sp, int subsys_type, const vec3d *atta
 	return nullptr;
 }
 
-/**
- * Create or recreate the subsystem index cache.
- */
-void ship_index_subsystems(ship *shipp)
-{
-	auto sinfo = &Ship_info[shipp->ship_info_index];
-
-	// if the indexer already exists, its size won't change, so don't reallocate it
-	if (shipp->subsys_list_indexer.get() == nullptr)
-		shipp->subsys_list_indexer.reset(new ship_subsys* [sinfo->n_subsystems]);
-
-	auto ss = GET_FIRST(&shipp->subsys_list);
-	for (int index = 0; index < sinfo->n_subsystems; ++index)
-	{
-		// normal indexing to valid subsystems
-		if (ss != END_OF_LIST(&shipp->subsys_list))
-		{
-			shipp->subsys_list_indexer[index] = ss;
-			ss->parent_subsys_index = index;
-			ss = GET_NEXT(ss);
-		}
-		// in the event we run out of subsystems (i.e. if not all subsystems were linked)
-		else
-		{
-			shipp->subsys_list_indexer[index] = nullptr;
-		}
-	}
-
-	shipp->flags.set(Ship::Ship_Flags::Subsystem_cache_valid);
-}
 
 /**
  * Returns the 'nth' ship_subsys structure in a ship's linked list of subsystems.
@@ -15790,16 +15959,16 @@ int ship_get_subsys_index(const ship_subsys *subsys)
  */
 int ship_find_subsys(const ship *sp, const char *ss_name)
 {
-	int count;
-	ship_subsys *ss;
+	auto &lookup = ship_get_subsys_lookup(sp);
 
-	count = 0;
-	ss = GET_FIRST(&sp->subsys_list);
-	while ( ss != END_OF_LIST( &sp->subsys_list ) ) {
-		if ( !subsystem_stricmp(ss->system_info->subobj_name, ss_name) )
-			return count;
-		count++;
-		ss = GET_NEXT( ss );
+	auto first = lookup.name_first.find(ship_subsys_name_hash(ss_name));
+	if (first == nullptr)
+		return -1;
+
+	// different names can have the same hash
+	for (int index = *first; index >= 0; index = lookup.name_next[index]) {
+		if ( !subsystem_stricmp(sp->subsys_list_indexer[index]->system_info->subobj_name, ss_name) )
+			return index;
 	}
 
 	return -1;
@@ -15833,7 +16002,6 @@ bool ship_subsystems_blown(const ship* shipp, int type, bool skip_dying_check)
 float ship_get_subsystem_strength(const ship *shipp, int type, bool skip_dying_check, bool no_minimum_engine_str)
 {
 	float strength;
-	ship_subsys *ssp;
 
 	Assertion( (type >= 0) && (type < SUBSYSTEM_MAX), "ship_get_subsystem_strength() subsystem type %d is out of range!", type );
 
@@ -15854,24 +16022,7 @@ float ship_get_subsystem_strength(const ship *shipp, int type, bool skip_dying_c
 
 	// if we don't need to enforce a minimum engine contribution ratio, we can just use the regular strength calculation
 	if ( (type == SUBSYSTEM_ENGINE) && !no_minimum_engine_str && (strength < 1.0f) ) {
-		float percent;
-
-		percent = 0.0f;
-		ssp = GET_FIRST(&shipp->subsys_list);
-		while ( ssp != END_OF_LIST( &shipp->subsys_list ) ) {
-
-			if ( ssp->system_info->type == SUBSYSTEM_ENGINE ) {
-				float ratio;
-
-				ratio = ssp->current_hits / ssp->max_hits;
-				if ( ratio < ENGINE_MIN_STR )
-					ratio = ENGINE_MIN_STR;
-
-				percent += ratio;
-			}
-			ssp = GET_NEXT( ssp );
-		}
-		strength = percent / (float)shipp->subsys_info[type].type_count;
+		strength = shipp->subsys_info[type].aggregate_engine_str / (float)shipp->subsys_info[type].type_count;
 	}
 
 	return strength;
@@ -15887,15 +16038,11 @@ float ship_get_subsystem_strength(const ship *shipp, int type, bool skip_dying_c
  */
 void ship_set_subsystem_strength( ship *shipp, int type, float strength )
 {
-	ship_subsys *ssp;
-
 	Assert ( (type >= 0) && (type < SUBSYSTEM_MAX) );
 	CLAMP(strength, 0.0f, 1.0f);
 
-	ssp = GET_FIRST(&shipp->subsys_list);
-	while ( ssp != END_OF_LIST( &shipp->subsys_list ) ) {
-
-		if ( (ssp->system_info->type == type) && !(ssp->flags[Ship::Subsystem_Flags::No_aggregate]) ) {
+	ship_for_each_subsys_of_type(shipp, type, [&](ship_subsys *ssp) {
+		if ( !(ssp->flags[Ship::Subsystem_Flags::No_aggregate]) ) {
 			ssp->current_hits = strength * ssp->max_hits;
 
 			// maybe blow up subsys
@@ -15903,8 +16050,8 @@ void ship_set_subsystem_strength( ship *shipp, int type, float strength )
 				do_subobj_destroyed_stuff(shipp, ssp, nullptr);
 			}
 		}
-		ssp = GET_NEXT( ssp );
-	}
+		return true;
+	});
 
 	// fix up the overall ship subsys status
 	ship_recalc_subsys_strength(shipp);
@@ -16046,7 +16193,7 @@ float ship_calculate_rearm_duration( object *objp )
 //
 int ship_do_rearm_frame( object *objp, float frametime )
 {
-	int			i, banks_full, primary_banks_full, subsys_type, last_ballistic_idx = -1;
+	int			i, banks_full, primary_banks_full, last_ballistic_idx = -1;
 	float			shield_str, max_shield_str = 0.0f, repair_delta, repair_allocated, max_hull_repair = 0, max_subsys_repair;
 	ship			*shipp;
 	ship_weapon	*swp;
@@ -16134,7 +16281,6 @@ int ship_do_rearm_frame( object *objp, float frametime )
 
 		if ( ssp->current_hits < max_subsys_repair && repair_allocated > 0 ) {
 			subsys_all_ok = false;
-			subsys_type = ssp->system_info->type;
 
 			if ( objp == Player_obj ) {
 				player_maybe_start_repair_sound();
@@ -16147,18 +16293,8 @@ int ship_do_rearm_frame( object *objp, float frametime )
 			repair_allocated -= repair_delta;
 			Assert(repair_allocated >= 0.0f);
 
-			// add repair to current strength of single subsystem
-			ssp->current_hits += repair_delta;
-			if ( ssp->current_hits > max_subsys_repair ) {
-				ssp->current_hits = max_subsys_repair;
-			}
-
-			// add repair to aggregate strength of subsystems of that type
-			if (!(ssp->flags[Ship::Subsystem_Flags::No_aggregate])) {
-				shipp->subsys_info[subsys_type].aggregate_current_hits += repair_delta;
-				if ( shipp->subsys_info[subsys_type].aggregate_current_hits > shipp->subsys_info[subsys_type].aggregate_max_hits )
-					shipp->subsys_info[subsys_type].aggregate_current_hits = shipp->subsys_info[subsys_type].aggregate_max_hits;
-			}
+			// add repair to current strength of single subsystem, and to the aggregate strength of subsystems of that type
+			ship_subsys_set_hits(shipp, ssp, MIN(ssp->current_hits + repair_delta, max_subsys_repair));
 
 			// check to see if this subsystem was totally non functional before -- if so, then
 			// reset the flags
@@ -17555,12 +17691,12 @@ static int ship_has_homing_missile_locked(ship *shipp)
 	weapon_info	*wip;
 	missile_obj	*mo;
 
-	Assert(shipp->objnum >= 0 && shipp->objnum < MAX_OBJECTS);
+	Assert(shipp->objnum >= 0 && shipp->objnum < (int)Objects.size());
 	locked_objp = &Objects[shipp->objnum];
 
 	// check for currently locked missiles (highest precedence)
 	for ( mo = GET_NEXT(&Missile_obj_list); mo != END_OF_LIST(&Missile_obj_list); mo = GET_NEXT(mo) ) {
-		Assert(mo->objnum >= 0 && mo->objnum < MAX_OBJECTS);
+		Assert(mo->objnum >= 0 && mo->objnum < (int)Objects.size());
 		A = &Objects[mo->objnum];
 		if (A->flags[Object::Object_Flags::Should_be_dead])
 			continue;
@@ -17568,7 +17704,7 @@ static int ship_has_homing_missile_locked(ship *shipp)
 		if (A->type != OBJ_WEAPON)
 			continue;
 
-		Assert((A->instance >= 0) && (A->instance < MAX_WEAPONS));
+		Assert((A->instance >= 0) && (A->instance < (int)Weapons.size()));
 		wp = &Weapons[A->instance];
 		wip = &Weapon_info[wp->weapon_info_index];
 
@@ -19649,19 +19785,14 @@ ship_subsys *ship_get_subsys(const ship *shipp, const char *subsys_name)
 		return NULL;
 	}
 
-	ship_subsys *ss = GET_FIRST(&shipp->subsys_list);
-	while (ss != END_OF_LIST(&shipp->subsys_list)) {
-		// check subsystem name
-		if (!subsystem_stricmp(ss->system_info->subobj_name, subsys_name)) {
-			return ss;
-		}
+	int index = ship_find_subsys(shipp, subsys_name);
 
-		// next
-		ss = GET_NEXT(ss);
+	// didn't find it
+	if (index < 0) {
+		return NULL;
 	}
 
-	// didn't find it
-	return NULL;
+	return shipp->subsys_list_indexer[index];
 }
 
 int ship_get_num_subsys(const ship *shipp)
@@ -21535,6 +21666,7 @@ void ship_render_weapon_models(model_render_params *ship_render_info, model_draw
 					angles angs = vmd_zero_angles;
 					angs.b = shipp->primary_rotate_ang[i];
 					vm_angles_2_matrix(&pmi->submodel[mn].canonical_orient, &angs);
+					submodel_instance_moved(&pmi->submodel[mn]);
 				}
 			}
 		}
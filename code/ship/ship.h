@@ -27,6 +27,7 @@
 #include "radar/radarsetup.h"
 #include "render/3d.h"
 #include "species_defs/species_defs.h"
+#include "utils/FlatHashMap.h"
 #include "weapon/shockwave.h"
 #include "weapon/trails.h"
 #include "ship/ship_flags.h"
@@ -457,8 +458,20 @@ typedef struct ship_subsys_info {
 	int	type_count;					// number of subsystems of type on this ship;
 	float aggregate_max_hits;		// maximum number of hits for all subsystems of this type.
 	float aggregate_current_hits;	// current count of hits for all subsystems of this type.	
+	float aggregate_engine_str;		// sum of what each engine contributes to the engine strength, see ship_get_subsystem_strength()
 } ship_subsys_info;
 
+// Lookups into a ship's list of subsystems by name and by type, so that finding one doesn't need to walk the list.
+// Rebuilt by ship_index_subsystems() along with ship::subsys_list_indexer.
+struct ship_subsys_lookup {
+	util::FlatHashMap<int> name_first;	// hash of a subsystem name -> index of the first subsystem whose name has that hash
+	SCP_vector<int> name_next;			// index of the next subsystem whose name has the same hash, or -1
+	SCP_vector<int> by_type;			// indexes of the subsystems sorted by type, in list order within each type
+	int type_start[SUBSYSTEM_MAX + 1];	// where the subsystems of each type start in by_type
+
+	void clear();
+};
+
 // Karajorma - Used by the alter-ship-flag SEXP as an alternative to having lots of ship flag SEXPs
 typedef struct ship_flag_name {
 	Ship::Ship_Flags flag;							// the actual ship flag constant as given by the define below
@@ -656,6 +669,7 @@ public:
 	// describing the state of all engines combined) -- MWA 4/1/97
 	ship_subsys	subsys_list;									//	linked list of subsystems for this ship.
 	std::unique_ptr<ship_subsys*[]> subsys_list_indexer;		//	provides random-access lookup to the linked list
+	ship_subsys_lookup subsys_lookup;						//	provides lookup by name and type, kept alongside subsys_list_indexer
 	ship_subsys	*last_targeted_subobject[MAX_PLAYERS];	// Last subobject that has been targeted.  NULL if none;(player specific)
 	ship_subsys_info	subsys_info[SUBSYSTEM_MAX];		// info on particular generic types of subsystems	
 
@@ -1736,6 +1750,12 @@ extern int get_available_primary_weapons(object *objp, int *outlist, int *outban
 
 extern int get_available_secondary_weapons(object *objp, int *outlist, int *outbanklist);
 extern void ship_recalc_subsys_strength( ship *shipp );
+// sets the hits of a subsystem and updates the aggregate strengths of its type to match
+extern void ship_subsys_set_hits(ship *shipp, ship_subsys *ss, float hits);
+#ifndef NDEBUG
+// checks the aggregate strengths of a ship against adding up its subsystems, and fixes them if they've drifted
+extern void ship_validate_subsys_strength(ship *shipp);
+#endif
 extern void physics_ship_init(object *objp);
 
 //	Note: This is not a general purpose routine.
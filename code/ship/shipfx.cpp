@@ -510,7 +510,7 @@ static int shipfx_special_warp_objnum_valid(int objnum)
 	object *special_objp;
 
 	// must be a valid object
-	if ((objnum < 0) || (objnum >= MAX_OBJECTS))
+	if ((objnum < 0) || (objnum >= (int)Objects.size()))
 		return 0;
 
 	special_objp = &Objects[objnum];
@@ -147,7 +147,7 @@ void do_subobj_destroyed_stuff( ship *ship_p, ship_subsys *subsys, const vec3d*
 					// is it not yet destroyed?  (this is a valid check because we already know there is a submodel)
 					if (!ssp->submodel_instance_1->blown_off) {
 						// then destroy it first
-						ssp->current_hits = 0;
+						ship_subsys_set_hits(ship_p, ssp, 0.0f);
 						do_subobj_destroyed_stuff(ship_p, ssp, nullptr, no_explosion);
 					}
 				}
@@ -632,25 +632,13 @@ std::pair<std::optional<ConditionData>, float> do_subobj_heal_stuff(const object
 				};
 			}
 
-			subsystem->current_hits += heal_to_apply;
-
-			float* agg_hits = &ship_p->subsys_info[subsystem->system_info->type].aggregate_current_hits;
-			float agg_max_hits = ship_p->subsys_info[subsystem->system_info->type].aggregate_max_hits;
-			if (!(subsystem->flags[Ship::Subsystem_Flags::No_aggregate])) {
-				*agg_hits += heal_to_apply;
-			}
-
-			if (subsystem->current_hits > subsystem->max_hits) {
-				healing_left += subsystem->current_hits - subsystem->max_hits;
-				if (!(subsystem->flags[Ship::Subsystem_Flags::No_aggregate])) {
-					*agg_hits += subsystem->current_hits - subsystem->max_hits;
-				}
-				subsystem->current_hits = subsystem->max_hits;					
+			float new_hits = subsystem->current_hits + heal_to_apply;
+			if (new_hits > subsystem->max_hits) {
+				healing_left += new_hits - subsystem->max_hits;
+				new_hits = subsystem->max_hits;
 			}
-			
-			if (*agg_hits > agg_max_hits)
-				*agg_hits = agg_max_hits;
 
+			ship_subsys_set_hits(ship_p, subsystem, new_hits);
 
 			if (healing_left <= 0)  // no more healing to distribute, so stop checking
 				break;
@@ -810,13 +798,7 @@ std::pair<std::optional<ConditionData>, float> do_subobj_hit_stuff(object *ship_
 			Assert(Player_ai->targeted_subsys != NULL);
 			if ( (subsys == Player_ai->targeted_subsys) && (subsys->current_hits > 0.0f) ) {
 				Assert(mss->type == (int) -damage);
-				if (!(subsys->flags[Ship::Subsystem_Flags::No_aggregate])) {
-					ship_p->subsys_info[mss->type].aggregate_current_hits -= subsys->current_hits;
-					if (ship_p->subsys_info[mss->type].aggregate_current_hits < 0.0f) {
-						ship_p->subsys_info[mss->type].aggregate_current_hits = 0.0f;
-					}
-				}
-				subsys->current_hits = 0.0f;
+				ship_subsys_set_hits(ship_p, subsys, 0.0f);
 				do_subobj_destroyed_stuff( ship_p, subsys, global_damage ? nullptr : hitpos );
 				continue;
 			} else {
@@ -1037,22 +1019,13 @@ std::pair<std::optional<ConditionData>, float> do_subobj_hit_stuff(object *ship_
 				};
 			}
 
-			subsystem->current_hits -= damage_to_apply;
-			if (!(subsystem->flags[Ship::Subsystem_Flags::No_aggregate])) {
-				ship_p->subsys_info[subsystem->system_info->type].aggregate_current_hits -= damage_to_apply;
+			float new_hits = subsystem->current_hits - damage_to_apply;
+			if (new_hits < 0.0f) {
+				damage_left -= new_hits;
+				new_hits = 0.0f;					// set to 0 so repair on subsystem takes immediate effect
 			}
 
-			if (subsystem->current_hits < 0.0f) {
-				damage_left -= subsystem->current_hits;
-				if (!(subsystem->flags[Ship::Subsystem_Flags::No_aggregate])) {
-					ship_p->subsys_info[subsystem->system_info->type].aggregate_current_hits -= subsystem->current_hits;
-				}
-				subsystem->current_hits = 0.0f;					// set to 0 so repair on subsystem takes immediate effect
-			}
-
-			if ( ship_p->subsys_info[subsystem->system_info->type].aggregate_current_hits < 0.0f ){
-				ship_p->subsys_info[subsystem->system_info->type].aggregate_current_hits = 0.0f;
-			}
+			ship_subsys_set_hits(ship_p, subsystem, new_hits);
 
 			// multiplayer clients never blow up subobj stuff on their own
 			if ( (subsystem->current_hits <= 0.0f) && !MULTIPLAYER_CLIENT) {
@@ -1085,7 +1058,7 @@ static void shiphit_record_player_killer(const object *killer_objp, player *p)
 	case OBJ_WEAPON:
 		p->killer_objtype=OBJ_WEAPON;
 		p->killer_weapon_index=Weapons[killer_objp->instance].weapon_info_index;
-		if (killer_objp->parent >= 0 && killer_objp->parent < MAX_OBJECTS) {
+		if (killer_objp->parent >= 0 && killer_objp->parent < (int)Objects.size()) {
 			p->killer_species = Ship_info[Ships[Objects[killer_objp->parent].instance].ship_info_index].species;
 
 			if ( &Objects[killer_objp->parent] == Player_obj ) {
@@ -1842,8 +1815,8 @@ static void ship_vaporize(ship *shipp)
 	if (shipp == nullptr) {
 		return;
 	}
-	Assert((shipp->objnum >= 0) && (shipp->objnum < MAX_OBJECTS));
-	if ( (shipp->objnum < 0) || (shipp->objnum >= MAX_OBJECTS) ) {
+	Assert((shipp->objnum >= 0) && (shipp->objnum < (int)Objects.size()));
+	if ( (shipp->objnum < 0) || (shipp->objnum >= (int)Objects.size()) ) {
 		return;
 	}
 	ship_objp = &Objects[shipp->objnum];
@@ -2353,7 +2326,7 @@ static void ship_do_damage(object *ship_objp, object *other_obj, const vec3d *hi
 	// Goober5000 - check to see what other_obj is
 	if (other_obj)
 	{
-		other_obj_is_weapon = ((other_obj->type == OBJ_WEAPON) && (other_obj->instance >= 0) && (other_obj->instance < MAX_WEAPONS));
+		other_obj_is_weapon = ((other_obj->type == OBJ_WEAPON) && (other_obj->instance >= 0) && (other_obj->instance < (int)Weapons.size()));
 		other_obj_is_beam = ((other_obj->type == OBJ_BEAM) && (other_obj->instance >= 0) && (other_obj->instance < MAX_BEAMS));
 		other_obj_is_shockwave = ((other_obj->type == OBJ_SHOCKWAVE) && (other_obj->instance >= 0) && (other_obj->instance < MAX_SHOCKWAVES));
 	}
@@ -2645,7 +2618,7 @@ static void ship_do_damage(object *ship_objp, object *other_obj, const vec3d *hi
 						// don't call scoring for asteroids
 						break;
 					case OBJ_WEAPON:
-						if((other_obj->parent < 0) || (other_obj->parent >= MAX_OBJECTS)){
+						if((other_obj->parent < 0) || (other_obj->parent >= (int)Objects.size())){
 							scoring_add_damage(ship_objp, NULL, damage);
 						} else {
 							scoring_add_damage(ship_objp, &Objects[other_obj->parent], damage);
@@ -2767,7 +2740,7 @@ static void ship_do_healing(object* ship_objp, const object* other_obj, const ve
 	// maybe adjust "damage" done by shockwave for BIG|HUGE
 	maybe_shockwave_damage_adjust(ship_objp, other_obj, &healing);
 
-	other_obj_is_weapon = ((other_obj->type == OBJ_WEAPON) && (other_obj->instance >= 0) && (other_obj->instance < MAX_WEAPONS));
+	other_obj_is_weapon = ((other_obj->type == OBJ_WEAPON) && (other_obj->instance >= 0) && (other_obj->instance < (int)Weapons.size()));
 	other_obj_is_beam = ((other_obj->type == OBJ_BEAM) && (other_obj->instance >= 0) && (other_obj->instance < MAX_BEAMS));
 	other_obj_is_shockwave = ((other_obj->type == OBJ_SHOCKWAVE) && (other_obj->instance >= 0) && (other_obj->instance < MAX_SHOCKWAVES));
 	
@@ -188,6 +188,7 @@ endif()
 
 # ddsutils files
 add_file_folder("ddsutils"
+	ddsutils/ddscompress.cpp
 	ddsutils/ddsutils.cpp
 	ddsutils/ddsutils.h
 )
@@ -424,6 +425,8 @@ IF (WIN32)
 ENDIF(WIN32)
 
 add_file_folder("GlobalIncs\\\\Memory"
+	globalincs/memory/frame_arena.cpp
+	globalincs/memory/frame_arena.h
 	globalincs/memory/memory.h
 	globalincs/memory/memory.cpp
 	globalincs/memory/utils.h
@@ -920,6 +923,8 @@ add_file_folder("Network"
 	network/multi.h
 	network/multi_campaign.cpp
 	network/multi_campaign.h
+	network/multi_capture.cpp
+	network/multi_capture.h
 	network/multi_data.cpp
 	network/multi_data.h
 	network/multi_dogfight.cpp
@@ -934,6 +939,8 @@ add_file_folder("Network"
 	network/multi_ingame.h
 	network/multi_kick.cpp
 	network/multi_kick.h
+	network/multi_loadtest.cpp
+	network/multi_loadtest.h
 	network/multi_log.cpp
 	network/multi_log.h
 	network/multi_lua.cpp
@@ -1024,6 +1031,8 @@ add_file_folder("Object"
 	object/object.h
 	object/objectdock.cpp
 	object/objectdock.h
+	object/objectgrid.cpp
+	object/objectgrid.h
 	object/objectshield.cpp
 	object/objectshield.h
 	object/objectsnd.cpp
@@ -1235,6 +1244,8 @@ add_file_folder("Render"
 	render/3dsetup.cpp
 	render/batching.cpp
 	render/batching.h
+	render/occlusion.cpp
+	render/occlusion.h
 )
 
 add_file_folder("ScpUi"
@@ -1698,10 +1709,12 @@ add_file_folder("Ui"
 add_file_folder("Utils"
 	utils/base64.cpp
 	utils/base64.h
+	utils/ChunkedPool.h
 	utils/encoding.cpp
 	utils/encoding.h
 	utils/event.h
 	utils/finally.h
+	utils/FlatHashMap.h
 	utils/HeapAllocator.cpp
 	utils/HeapAllocator.h
 	utils/id.h
@@ -41,6 +41,8 @@ Category LoadBatchingBuffers("Load batching buffers", true);
 Category SortColliders("Sort Colliders", false);
 Category FindOverlapColliders("Find overlap colliders", false);
 Category CollidePair("Collide Pair", false);
+Category BeamCollisions("Beam collisions", false);
+Category BuildObjectGrid("Build object grid", false);
 Category RetimeCollisionCache("Retime Collision Cache", false);
 
 Category WeaponPostMove("Weapon post move", false);
@@ -48,6 +50,7 @@ Category ShipPostMove("Ship post move", false);
 Category FireballPostMove("Fireball post move", false);
 Category DebrisPostMove("Debris post move", false);
 Category AsteroidPostMove("Asteroid post move", false);
+Category DormantAsteroids("Dormant asteroids", false);
 Category PreMove("Pre Move", false);
 Category Physics("Physics", false);
 Category PostMove("Post Move", false);
@@ -55,6 +58,8 @@ Category CollisionDetection("Collision Detection", false);
 
 Category RenderBuffer("Render Buffer", true);
 
+Category CullObjects("Cull objects", false);
+Category DrawOccluders("Draw occluders", false);
 Category QueueRender("Queue Render", false);
 Category BuildModelUniforms("Build Model Uniforms", false);
 Category UploadModelUniforms("Upload Model Uniforms", true);
@@ -81,9 +86,11 @@ Category ParticlesMoveAll("Move particles", false);
 
 Category EnvironmentMapping("Environment Mapping", true);
 Category BuildShadowMap("Build Shadow Map", true);
+Category CullShadowCasters("Cull shadow casters", false);
 Category RenderScene("Render scene", true);
 Category RenderTrails("Render trails", true);
 Category MoveObjects("Move Objects", false);
+Category WeaponHoming("Weapon homing", false);
 Category ProcessParticleEffects("Process particle effects", false);
 Category TrailsMoveAll("Trails move all", false);
 Category Simulation("Simulation", false);
@@ -138,6 +145,8 @@ Category LoadSound("Load Sound", false);
 Category LevelPageIn("Level page in", false);
 Category PageInStop("Finish page in", false);
 Category PageInSingleBitmap("Page in single bitmap", false);
+Category DDSDecompress("DDS decompress", false);
+Category DDSCompress("DDS compress", false);
 Category ShipPageIn("Ship page in", false);
 Category WeaponPageIn("Weapon page in", false);
 
@@ -54,6 +54,8 @@ extern Category LoadBatchingBuffers;
 extern Category SortColliders;
 extern Category FindOverlapColliders;
 extern Category CollidePair;
+extern Category BeamCollisions;
+extern Category BuildObjectGrid;
 extern Category RetimeCollisionCache;
 
 extern Category WeaponPostMove;
@@ -61,6 +63,7 @@ extern Category ShipPostMove;
 extern Category FireballPostMove;
 extern Category DebrisPostMove;
 extern Category AsteroidPostMove;
+extern Category DormantAsteroids;
 extern Category PreMove;
 extern Category Physics;
 extern Category PostMove;
@@ -68,6 +71,8 @@ extern Category CollisionDetection;
 
 extern Category RenderBuffer;
 
+extern Category CullObjects;
+extern Category DrawOccluders;
 extern Category QueueRender;
 extern Category BuildModelUniforms;
 extern Category UploadModelUniforms;
@@ -94,9 +99,11 @@ extern Category ParticlesMoveAll;
 
 extern Category EnvironmentMapping;
 extern Category BuildShadowMap;
+extern Category CullShadowCasters;
 extern Category RenderScene;
 extern Category RenderTrails;
 extern Category MoveObjects;
+extern Category WeaponHoming;
 extern Category ProcessParticleEffects;
 extern Category TrailsMoveAll;
 extern Category Simulation;
@@ -152,6 +159,8 @@ extern Category LoadSound;
 extern Category LevelPageIn;
 extern Category PageInStop;
 extern Category PageInSingleBitmap;
+extern Category DDSDecompress;
+extern Category DDSCompress;
 extern Category ShipPageIn;
 extern Category WeaponPageIn;
 
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include <iterator>
+#include <memory>
+
+namespace util {
+
+/**
+ * @brief An array of up to MAX_SIZE elements which is allocated one chunk at a time as it grows
+ *
+ * This replaces fixed global arrays whose elements are referred to by index all over the code. Growing never moves
+ * existing elements, so their indices and addresses stay valid, and the elements of each chunk are contiguous for
+ * iterating over them. Like the elements of a global array, new elements are value initialized. Chunks are only freed
+ * when the pool itself is destroyed, so an index that was valid once can always be looked at.
+ *
+ * Since the elements aren't in one block of memory, the index of an element can't be worked out from its address.
+ */
+template <typename T, size_t MAX_SIZE, size_t CHUNK_SIZE = 1024>
+class ChunkedPool {
+	static_assert((CHUNK_SIZE & (CHUNK_SIZE - 1)) == 0, "The chunk size must be a power of two!");
+	static_assert(MAX_SIZE % CHUNK_SIZE == 0, "The maximum size must be a whole number of chunks!");
+
+	static const size_t NUM_CHUNKS = MAX_SIZE / CHUNK_SIZE;
+
+	std::unique_ptr<T[]> _chunks[NUM_CHUNKS];
+	size_t _size = 0;
+
+	template <typename Pool, typename Value>
+	class iterator_base {
+		Pool* _pool;
+		size_t _index;
+
+	 public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Value*;
+		using reference = Value&;
+
+		iterator_base(Pool* pool, size_t index) : _pool(pool), _index(index) {}
+
+		reference operator*() const { return (*_pool)[_index]; }
+		pointer operator->() const { return &(*_pool)[_index]; }
+
+		iterator_base& operator++()
+		{
+			++_index;
+			return *this;
+		}
+
+		bool operator==(const iterator_base& other) const { return _index == other._index; }
+		bool operator!=(const iterator_base& other) const { return _index != other._index; }
+	};
+
+ public:
+	typedef iterator_base<ChunkedPool, T> iterator;
+	typedef iterator_base<const ChunkedPool, const T> const_iterator;
+
+	ChunkedPool() = default;
+
+	ChunkedPool(const ChunkedPool&) = delete;
+	ChunkedPool& operator=(const ChunkedPool&) = delete;
+
+	T& operator[](size_t index)
+	{
+		return _chunks[index / CHUNK_SIZE][index % CHUNK_SIZE];
+	}
+	const T& operator[](size_t index) const
+	{
+		return _chunks[index / CHUNK_SIZE][index % CHUNK_SIZE];
+	}
+
+	/**
+	 * @brief The number of elements that have been allocated so far
+	 */
+	size_t size() const { return _size; }
+
+	static constexpr size_t max_size() { return MAX_SIZE; }
+	static constexpr size_t chunk_size() { return CHUNK_SIZE; }
+
+	/**
+	 * @brief Allocates another chunk of elements at the end of the pool
+	 * @return The number of new elements, or 0 if the pool is already as large as it can get
+	 */
+	size_t grow()
+	{
+		if (_size == MAX_SIZE) {
+			return 0;
+		}
+
+		_chunks[_size / CHUNK_SIZE].reset(new T[CHUNK_SIZE]());
+		_size += CHUNK_SIZE;
+
+		return CHUNK_SIZE;
+	}
+
+	iterator begin() { return iterator(this, 0); }
+	iterator end() { return iterator(this, _size); }
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, _size); }
+};
+
+}
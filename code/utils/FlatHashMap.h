@@ -0,0 +1,241 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace util {
+
+/**
+ * @brief A hash map from integer keys to values, stored in one flat array
+ *
+ * Entries live directly in the array and collisions are resolved by linear probing, so a lookup usually touches a
+ * single cache line and inserting never allocates unless the table has to grow. Erasing an entry moves the entries
+ * after it in the probe sequence back instead of leaving a tombstone, so the table doesn't slow down over time when
+ * entries keep coming and going.
+ *
+ * Inserting (which may grow the table) and erasing both invalidate pointers to values. The key EMPTY_KEY is reserved
+ * for marking unused slots.
+ */
+template <typename T, typename Key = uint32_t>
+class FlatHashMap {
+	static_assert(std::is_integral<Key>::value && std::is_unsigned<Key>::value, "The keys must be unsigned integers!");
+
+ public:
+	static constexpr Key EMPTY_KEY = std::numeric_limits<Key>::max();
+
+ private:
+	static const size_t MIN_CAPACITY = 16;
+
+	struct Slot {
+		Key key = EMPTY_KEY;
+		T value = T();
+	};
+
+	SCP_vector<Slot> _slots;
+	size_t _size = 0;
+	size_t _mask = 0;
+
+	// the 64 bit finalizer of MurmurHash3, since the keys are often sequential or packed indices
+	static size_t hash(Key key)
+	{
+		uint64_t h = key;
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+		h *= 0xc4ceb9fe1a85ec53ULL;
+		h ^= h >> 33;
+		return static_cast<size_t>(h);
+	}
+
+	// the slot holding the key, or the empty slot where it would go
+	size_t findSlot(Key key) const
+	{
+		size_t i = hash(key) & _mask;
+
+		while (_slots[i].key != key && _slots[i].key != EMPTY_KEY) {
+			i = (i + 1) & _mask;
+		}
+
+		return i;
+	}
+
+	void rehash(size_t capacity)
+	{
+		SCP_vector<Slot> old;
+		old.swap(_slots);
+
+		_slots.resize(capacity);
+		_mask = capacity - 1;
+
+		for (auto& slot : old) {
+			if (slot.key != EMPTY_KEY) {
+				_slots[findSlot(slot.key)] = std::move(slot);
+			}
+		}
+	}
+
+	// empties slot i, and moves back any of the following entries that could use it
+	void eraseSlot(size_t i)
+	{
+		size_t j = i;
+
+		while (true) {
+			j = (j + 1) & _mask;
+
+			if (_slots[j].key == EMPTY_KEY) {
+				break;
+			}
+
+			// an entry can only move back if the hole is between its home slot and where it is now
+			size_t home = hash(_slots[j].key) & _mask;
+			if (((j - home) & _mask) >= ((j - i) & _mask)) {
+				_slots[i] = std::move(_slots[j]);
+				i = j;
+			}
+		}
+
+		_slots[i] = Slot();
+		--_size;
+	}
+
+ public:
+	size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+	size_t capacity() const { return _slots.size(); }
+
+	/**
+	 * @brief Finds the value of a key
+	 * @return The value, or nullptr if the key isn't in the map
+	 */
+	T* find(Key key)
+	{
+		Assertion(key != EMPTY_KEY, "The empty key can't be looked up!");
+
+		if (_size == 0) {
+			return nullptr;
+		}
+
+		auto& slot = _slots[findSlot(key)];
+		return slot.key == key ? &slot.value : nullptr;
+	}
+
+	const T* find(Key key) const
+	{
+		return const_cast<FlatHashMap*>(this)->find(key);
+	}
+
+	/**
+	 * @brief Finds the value of a key, inserting a default constructed one if it isn't in the map yet
+	 */
+	T& operator[](Key key)
+	{
+		Assertion(key != EMPTY_KEY, "The empty key can't be inserted!");
+
+		// keep the table at most half full, beyond which the runs of used slots get long enough to slow down lookups
+		if ((_size + 1) * 2 > _slots.size()) {
+			rehash(std::max(_slots.size() * 2, MIN_CAPACITY));
+		}
+
+		auto& slot = _slots[findSlot(key)];
+		if (slot.key == EMPTY_KEY) {
+			slot.key = key;
+			++_size;
+		}
+
+		return slot.value;
+	}
+
+	/**
+	 * @brief Removes a key from the map
+	 * @return true if the key was in the map
+	 */
+	bool erase(Key key)
+	{
+		if (_size == 0) {
+			return false;
+		}
+
+		size_t i = findSlot(key);
+		if (_slots[i].key != key) {
+			return false;
+		}
+
+		eraseSlot(i);
+		return true;
+	}
+
+	/**
+	 * @brief Calls func(key, value) for every entry, and removes the entries it returns true for
+	 *
+	 * Every entry is visited exactly once, even though removing entries moves others around.
+	 *
+	 * @return The number of entries removed
+	 */
+	template <typename Func>
+	size_t eraseIf(Func func)
+	{
+		if (_size == 0) {
+			return 0;
+		}
+
+		// Entries only ever move back into the hole that was just made, from later in the same run of used slots. By
+		// starting after an empty slot no run wraps around past the start, so moved entries haven't been visited yet.
+		size_t start = 0;
+		while (_slots[start].key != EMPTY_KEY) {
+			++start;
+		}
+
+		size_t removed = 0;
+		size_t i = (start + 1) & _mask;
+
+		for (size_t n = 1; n < _slots.size(); ) {
+			auto& slot = _slots[i];
+
+			if (slot.key != EMPTY_KEY && func(slot.key, slot.value)) {
+				eraseSlot(i);
+				++removed;
+
+				// look at whatever moved into this slot
+				if (_slots[i].key != EMPTY_KEY) {
+					continue;
+				}
+			}
+
+			i = (i + 1) & _mask;
+			++n;
+		}
+
+		return removed;
+	}
+
+	/**
+	 * @brief Calls func(key, value) for every entry
+	 */
+	template <typename Func>
+	void forEach(Func func)
+	{
+		for (auto& slot : _slots) {
+			if (slot.key != EMPTY_KEY) {
+				func(slot.key, slot.value);
+			}
+		}
+	}
+
+	/**
+	 * @brief Removes all entries, but keeps the memory for reuse
+	 */
+	void clear()
+	{
+		for (auto& slot : _slots) {
+			slot = Slot();
+		}
+
+		_size = 0;
+	}
+};
+
+}
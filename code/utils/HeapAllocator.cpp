@@ -5,197 +5,342 @@ namespace {
 const size_t HEAP_SIZE_INCREASE = 1 * 1024 * 1024; // Always increment in 1MB steps
 const size_t HEAP_MAX_INCREASE = 20 * 1024 * 1024; // never increase heap size by more than 20MB
 
-template<typename TIter, typename T>
-TIter get_element_before(TIter first, TIter last, const T& value) {
-	if (first == last) {
-		// There are no elements in the range
-		return last;
-	}
-
-	auto iter = std::upper_bound(first, last, value);
-
-	if (iter == first) {
-		// The element before this does not exist
-		return last;
+const int EXACT_FIT_SEARCH = 4; // how many blocks of the list of the requested size are checked before rounding up
+
+// Index of the highest set bit, value must not be zero
+int highest_bit(uint64_t value) {
+	int bit = 0;
+	for (int shift = 32; shift > 0; shift >>= 1) {
+		if ((value >> shift) != 0) {
+			value >>= shift;
+			bit += shift;
+		}
 	}
+	return bit;
+}
 
-	// We found the position (which may be last) so now we can decrement it once to get the element before this found position
-	return std::next(iter, -1);
+// Index of the lowest set bit, value must not be zero
+int lowest_bit(uint64_t value) {
+	return highest_bit(value & (~value + 1));
 }
 
 }
 
 namespace util {
 HeapAllocator::HeapAllocator(const HeapAllocator::HeapResizer& creator) : _heapResizer(creator) {
+	for (auto i = 0; i < FIRST_LEVEL_COUNT; ++i) {
+		_secondLevelMaps[i] = 0;
+		for (auto j = 0; j < SECOND_LEVEL_COUNT; ++j) {
+			_freeLists[i][j] = INVALID_BLOCK;
+		}
+	}
+
 	_heapSize = HEAP_SIZE_INCREASE;
 	_lastSizeIncraese = HEAP_SIZE_INCREASE;
 	_heapResizer(_heapSize);
 
-	MemoryRange range;
-	range.offset = 0;
-	range.size = _heapSize;
+	auto block = newBlock();
+	_blocks[block].offset = 0;
+	_blocks[block].size = _heapSize;
+	_lastBlock = block;
 
-	addFreeRange(range);
+	insertFreeBlock(block);
 }
-size_t HeapAllocator::allocate(size_t size) {
-	// Do a simple first-fit algorithm. Not very efficient but it should do the job well for our purposes
-	for (auto iter = _freeRanges.begin(); iter != _freeRanges.end(); ++iter) {
-		if (iter->size >= size) {
-			// Found a match!
-			auto offset = iter->offset;
-
-			iter->offset += size;
-			iter->size -= size;
-
-			if (iter->size == 0) {
-				// This range is now empty and must be removed. Since we won't be using this iterator anymore it can be
-				// safely erased
-				_freeRanges.erase(iter);
-			}
+void HeapAllocator::mapping(size_t size, int& firstLevel, int& secondLevel) {
+	if (size < SECOND_LEVEL_COUNT) {
+		// Small sizes get a list of their own each
+		firstLevel = 0;
+		secondLevel = static_cast<int>(size);
+		return;
+	}
+
+	auto bit = highest_bit(size);
+	firstLevel = bit - SECOND_LEVEL_BITS + 1;
+	secondLevel = static_cast<int>(size >> (bit - SECOND_LEVEL_BITS)) - SECOND_LEVEL_COUNT;
+}
+uint32_t HeapAllocator::newBlock() {
+	if (!_unusedBlocks.empty()) {
+		auto block = _unusedBlocks.back();
+		_unusedBlocks.pop_back();
+
+		_blocks[block] = Block();
+		return block;
+	}
 
-			MemoryRange allocated;
-			allocated.size = size;
-			allocated.offset = offset;
+	_blocks.emplace_back();
+	return static_cast<uint32_t>(_blocks.size() - 1);
+}
+void HeapAllocator::releaseBlock(uint32_t block) {
+	_unusedBlocks.push_back(block);
+}
+void HeapAllocator::insertFreeBlock(uint32_t block) {
+	auto& b = _blocks[block];
+
+	int fl, sl;
+	mapping(b.size, fl, sl);
 
-			addAllocatedRange(allocated);
+	b.free = true;
+	b.prevFree = INVALID_BLOCK;
+	b.nextFree = _freeLists[fl][sl];
+
+	if (b.nextFree != INVALID_BLOCK) {
+		_blocks[b.nextFree].prevFree = block;
+	}
 
-			return offset;
+	_freeLists[fl][sl] = block;
+	_firstLevelMap |= uint64_t(1) << fl;
+	_secondLevelMaps[fl] |= 1u << sl;
+
+	++_numFreeBlocks;
+}
+void HeapAllocator::removeFreeBlock(uint32_t block) {
+	auto& b = _blocks[block];
+
+	int fl, sl;
+	mapping(b.size, fl, sl);
+
+	if (b.prevFree != INVALID_BLOCK) {
+		_blocks[b.prevFree].nextFree = b.nextFree;
+	} else {
+		_freeLists[fl][sl] = b.nextFree;
+	}
+
+	if (b.nextFree != INVALID_BLOCK) {
+		_blocks[b.nextFree].prevFree = b.prevFree;
+	}
+
+	if (_freeLists[fl][sl] == INVALID_BLOCK) {
+		_secondLevelMaps[fl] &= ~(1u << sl);
+		if (_secondLevelMaps[fl] == 0) {
+			_firstLevelMap &= ~(uint64_t(1) << fl);
+		}
+	}
+
+	b.free = false;
+	b.prevFree = INVALID_BLOCK;
+	b.nextFree = INVALID_BLOCK;
+
+	--_numFreeBlocks;
+}
+uint32_t HeapAllocator::findFreeBlock(size_t size) const {
+	int fl, sl;
+
+	// Prefer a block from the list of this exact size if one of the first few fits, since that leaves the larger blocks
+	// alone and gives back freed ranges of the same size right away
+	mapping(size, fl, sl);
+	auto candidate = _freeLists[fl][sl];
+	for (auto i = 0; i < EXACT_FIT_SEARCH && candidate != INVALID_BLOCK; ++i) {
+		if (_blocks[candidate].size >= size) {
+			return candidate;
 		}
+		candidate = _blocks[candidate].nextFree;
+	}
+
+	// Round the size up to the next list boundary so that every block in the list we find is large enough
+	auto rounded = size;
+	if (rounded >= SECOND_LEVEL_COUNT) {
+		rounded += (size_t(1) << (highest_bit(rounded) - SECOND_LEVEL_BITS)) - 1;
 	}
+	mapping(rounded, fl, sl);
 
-	// No free range found => increase size of heap
+	if (fl < FIRST_LEVEL_COUNT) {
+		uint32_t secondLevelMap = (sl < SECOND_LEVEL_COUNT) ? (_secondLevelMaps[fl] & (~0u << sl)) : 0;
 
+		if (secondLevelMap == 0) {
+			// Nothing in this first level list so look at the larger ones
+			uint64_t firstLevelMap = (fl + 1 < FIRST_LEVEL_COUNT) ? (_firstLevelMap & (~uint64_t(0) << (fl + 1))) : 0;
+
+			if (firstLevelMap != 0) {
+				fl = lowest_bit(firstLevelMap);
+				secondLevelMap = _secondLevelMaps[fl];
+			}
+		}
+
+		if (secondLevelMap != 0) {
+			return _freeLists[fl][lowest_bit(secondLevelMap)];
+		}
+	}
+
+	// The rest of the list of this exact size may still have a block that is large enough. This only happens right
+	// before the heap needs to grow so going through that list doesn't hurt.
+	for (auto block = candidate; block != INVALID_BLOCK; block = _blocks[block].nextFree) {
+		if (_blocks[block].size >= size) {
+			return block;
+		}
+	}
+
+	return INVALID_BLOCK;
+}
+void HeapAllocator::growHeap() {
 	// We increase the heap size every time we run out of memory in order to reduce reallocation times
 	_lastSizeIncraese = std::min(HEAP_MAX_INCREASE, 2 * _lastSizeIncraese);
 
-	// Make sure that our allocation can actually fit into the new block if its too large for a single increase
 	auto increase = std::max(HEAP_SIZE_INCREASE, _lastSizeIncraese);
 	auto lastOffset = _heapSize;
 
 	_heapSize += increase;
 	_heapResizer(_heapSize);
 
-	MemoryRange newFree;
-	newFree.offset = lastOffset;
-	newFree.size = increase;
+	// The new memory either extends the free range at the end of the heap or becomes a new one
+	if (_blocks[_lastBlock].free) {
+		removeFreeBlock(_lastBlock);
+		_blocks[_lastBlock].size += increase;
+		insertFreeBlock(_lastBlock);
+		return;
+	}
 
-	addFreeRange(newFree);
+	auto block = newBlock();
+	auto& b = _blocks[block];
+	b.offset = lastOffset;
+	b.size = increase;
+	b.prevPhysical = _lastBlock;
 
-	// Call us again but this time it should succeed
-	return allocate(size);
+	_blocks[_lastBlock].nextPhysical = block;
+	_lastBlock = block;
+
+	insertFreeBlock(block);
 }
-void HeapAllocator::addFreeRange(const HeapAllocator::MemoryRange& range) {
-	if (range.size == 0) {
-		// Ignore empty ranges
-		return;
+size_t HeapAllocator::allocate(size_t size) {
+	Assertion(size > 0, "Empty allocations are not supported!");
+
+	auto block = findFreeBlock(size);
+	while (block == INVALID_BLOCK) {
+		// No free range found => increase size of heap, possibly several times if the allocation is very large
+		growHeap();
+		block = findFreeBlock(size);
 	}
 
-	Assertion(std::is_sorted(_freeRanges.begin(), _freeRanges.end()),
-			  "Free ranges were not sorted before adding a free range.");
+	removeFreeBlock(block);
 
-	auto left = get_element_before(_freeRanges.begin(), _freeRanges.end(), range);
-	auto right = std::upper_bound(_freeRanges.begin(), _freeRanges.end(), range);
+	if (_blocks[block].size > size) {
+		// Give the rest of the block back to the free lists. newBlock may move the blocks so no references before this.
+		auto rest = newBlock();
+		auto& b = _blocks[block];
+		auto& r = _blocks[rest];
 
-	if (left != _freeRanges.end()) {
-		// This new range may be just after another
-		if (left->offset + left->size == range.offset) {
-			left->size += range.size;
+		r.offset = b.offset + size;
+		r.size = b.size - size;
+		r.prevPhysical = block;
+		r.nextPhysical = b.nextPhysical;
 
-			// After this operation the two ranges may be connected. If that happens then they need to be merged as well
-			if (right != _freeRanges.end() && check_connected_range(*left, *right)) {
-				left->size += right->size;
-				_freeRanges.erase(right);
-			}
+		if (r.nextPhysical != INVALID_BLOCK) {
+			_blocks[r.nextPhysical].prevPhysical = rest;
+		} else {
+			_lastBlock = rest;
+		}
 
-			checkRangesMerged();
+		b.nextPhysical = rest;
+		b.size = size;
 
-			// The range has been added by merging it with another
-			return;
-		}
+		insertFreeBlock(rest);
 	}
 
-	if (right != _freeRanges.end()) {
-		// This new range may be just before another
-		if (range.offset + range.size == right->offset) {
-			right->offset = range.offset;
-			right->size += range.size;
+	auto offset = _blocks[block].offset;
 
-			// After this operation the two ranges may be connected. If that happens then they need to be merged as well
-			if (left != _freeRanges.end() && check_connected_range(*left, *right)) {
-				left->size += right->size;
-				_freeRanges.erase(right);
-			}
+	Assertion(_allocatedBlocks.find(offset) == _allocatedBlocks.end(),
+			  "Allocated ranges already contain the specified range!");
+	_allocatedBlocks.emplace(offset, block);
+	_allocatedSize += size;
 
-			checkRangesMerged();
+	return offset;
+}
+void HeapAllocator::free(size_t offset) {
+	auto it = _allocatedBlocks.find(offset);
 
-			// The range has been added by merging it with another
-			return;
-		}
-	}
+	// Make sure that the range is valid
+	Assertion(it != _allocatedBlocks.end(), "Specified offset was not found in the allocated ranges!");
 
-	// If we are here then we found no range to merge the new range into
-	_freeRanges.insert(right, range);
+	auto block = it->second;
+	_allocatedBlocks.erase(it);
+	_allocatedSize -= _blocks[block].size;
 
-	checkRangesMerged();
-}
-void HeapAllocator::addAllocatedRange(const HeapAllocator::MemoryRange& range) {
-	Assertion(std::is_sorted(_allocatedRanges.begin(), _allocatedRanges.end()), "Allocated ranges are not sorted!");
-	Assertion(!std::binary_search(_allocatedRanges.begin(), _allocatedRanges.end(), range),
-			  "Allocated ranges already contain the specified range!");
+	// Merge the range with the free ranges around it
+	auto next = _blocks[block].nextPhysical;
+	if (next != INVALID_BLOCK && _blocks[next].free) {
+		removeFreeBlock(next);
+
+		_blocks[block].size += _blocks[next].size;
+		_blocks[block].nextPhysical = _blocks[next].nextPhysical;
 
-	// We need to keep the vector sorted for better search performance so we insert this new range at the sorted position
-	// into the vector
-	auto it = std::upper_bound(_allocatedRanges.begin(), _allocatedRanges.end(), range);
+		if (_blocks[next].nextPhysical != INVALID_BLOCK) {
+			_blocks[_blocks[next].nextPhysical].prevPhysical = block;
+		} else {
+			_lastBlock = block;
+		}
 
-	// This works even if it is .end() since .insert will just add it to the vector in that case
-	_allocatedRanges.insert(it, range);
+		releaseBlock(next);
+	}
 
-	Assertion(std::is_sorted(_allocatedRanges.begin(), _allocatedRanges.end()), "Allocated ranges are not sorted!");
-}
-void HeapAllocator::free(size_t offset) {
-	// We use a dummy range for finding the entry in our allocated ranges
-	MemoryRange range;
-	range.offset = offset;
+	auto prev = _blocks[block].prevPhysical;
+	if (prev != INVALID_BLOCK && _blocks[prev].free) {
+		removeFreeBlock(prev);
 
-	auto it = std::lower_bound(_allocatedRanges.begin(), _allocatedRanges.end(), range);
+		_blocks[prev].size += _blocks[block].size;
+		_blocks[prev].nextPhysical = _blocks[block].nextPhysical;
 
-	// Make sure that the range is valid
-	Assertion(it != _allocatedRanges.end(), "Specified offset was not found in the allocated ranges!");
-	Assertion(it->offset == offset, "Specified offset does not point to the start of an allocated range!");
+		if (_blocks[block].nextPhysical != INVALID_BLOCK) {
+			_blocks[_blocks[block].nextPhysical].prevPhysical = prev;
+		} else {
+			_lastBlock = prev;
+		}
 
-	// Copy the range out of the vector before erasing it so we can add it to the free ranges
-	auto freedRange = *it;
+		releaseBlock(block);
+		block = prev;
+	}
 
-	_allocatedRanges.erase(it);
+	insertFreeBlock(block);
 
-	addFreeRange(freedRange);
+	checkRangesMerged(block);
 }
 size_t HeapAllocator::numAllocations() const {
-	return _allocatedRanges.size();
+	return _allocatedBlocks.size();
 }
-bool HeapAllocator::check_connected_range(const MemoryRange& left, const MemoryRange& right) {
-	return left.offset + left.size == right.offset;
+HeapAllocator::Statistics HeapAllocator::statistics() const {
+	Statistics stats;
+
+	stats.heapSize = _heapSize;
+	stats.allocatedSize = _allocatedSize;
+	stats.freeSize = _heapSize - _allocatedSize;
+	stats.numAllocations = _allocatedBlocks.size();
+	stats.numFreeRanges = _numFreeBlocks;
+
+	// The largest free range is in the highest non-empty list but that list still covers a range of sizes
+	if (_firstLevelMap != 0) {
+		auto fl = highest_bit(_firstLevelMap);
+		auto sl = highest_bit(_secondLevelMaps[fl]);
+
+		for (auto block = _freeLists[fl][sl]; block != INVALID_BLOCK; block = _blocks[block].nextFree) {
+			stats.largestFreeRange = std::max(stats.largestFreeRange, _blocks[block].size);
+		}
+	}
+
+	return stats;
 }
-void HeapAllocator::checkRangesMerged() {
+void HeapAllocator::checkRangesMerged(uint32_t block) {
 // This is a debug only function because its values are only used in debug and linters will get tripped up otherwise.
 #ifndef NDEBUG
-	bool first = true;
-	size_t lastEnd = 0;
-	for (auto& range : _freeRanges) {
-		if (!first) {
-			Assertion(lastEnd != range.offset, "Found unmerged ranges at offset " SIZE_T_ARG "!", lastEnd);
-		}
+	const auto& b = _blocks[block];
 
-		lastEnd = range.offset + range.size;
-		first = false;
+	if (b.prevPhysical != INVALID_BLOCK) {
+		const auto& prev = _blocks[b.prevPhysical];
+		Assertion(!prev.free, "Found unmerged ranges at offset " SIZE_T_ARG "!", b.offset);
+		Assertion(prev.offset + prev.size == b.offset, "Found a gap between ranges at offset " SIZE_T_ARG "!", b.offset);
+	}
+	if (b.nextPhysical != INVALID_BLOCK) {
+		const auto& next = _blocks[b.nextPhysical];
+		Assertion(!next.free, "Found unmerged ranges at offset " SIZE_T_ARG "!", next.offset);
+		Assertion(b.offset + b.size == next.offset, "Found a gap between ranges at offset " SIZE_T_ARG "!", next.offset);
 	}
+#else
+	SCP_UNUSED(block);
 #endif
 }
 
-bool HeapAllocator::MemoryRange::operator<(const HeapAllocator::MemoryRange& other) const {
-	return offset < other.offset;
-}
-bool HeapAllocator::MemoryRange::operator==(const HeapAllocator::MemoryRange& other) const {
-	return offset == other.offset;
+float HeapAllocator::Statistics::fragmentation() const {
+	if (freeSize == 0) {
+		return 0.0f;
+	}
+
+	return 1.0f - static_cast<float>(largestFreeRange) / static_cast<float>(freeSize);
 }
 }
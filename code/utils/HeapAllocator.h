@@ -2,6 +2,7 @@
 
 #include "globalincs/pstypes.h"
 
+#include <cstdint>
 #include <functional>
 
 namespace util {
@@ -11,6 +12,10 @@ namespace util {
  *
  * This class does not allocate memory! It only keeps track of where memory is stored and which memory ranges may be
  * reused later. This needs some kind of underlying memory manager before it can do anything.
+ *
+ * Free ranges are kept in two-level segregated fit (TLSF) free lists so allocating and freeing memory takes constant
+ * time no matter how many ranges there are. Allocations are never padded, so if all sizes are multiples of some stride
+ * then all offsets will be as well.
  */
 class HeapAllocator {
  public:
@@ -21,13 +26,43 @@ class HeapAllocator {
 	 */
 	typedef std::function<void(size_t)> HeapResizer;
 
+	/**
+	 * @brief How the memory of the heap is used at the moment
+	 */
+	struct Statistics {
+		size_t heapSize = 0;
+		size_t allocatedSize = 0;
+		size_t freeSize = 0;
+		size_t numAllocations = 0;
+		size_t numFreeRanges = 0;
+		size_t largestFreeRange = 0;
+
+		/**
+		 * @brief How much the free memory is split up
+		 * @return 0 if all free memory is in one range, approaching 1 the more ranges it is spread over
+		 */
+		float fragmentation() const;
+	};
+
  private:
-	struct MemoryRange {
+	// Free ranges are sorted into lists by the position of the highest set bit of their size (first level) and the
+	// next SECOND_LEVEL_BITS bits below that (second level). Bitmaps of the non-empty lists make finding one that holds
+	// a large enough range a matter of a few bit operations.
+	static const int SECOND_LEVEL_BITS = 4;
+	static const int SECOND_LEVEL_COUNT = 1 << SECOND_LEVEL_BITS;
+	static const int FIRST_LEVEL_COUNT = 64;
+	static const uint32_t INVALID_BLOCK = UINT32_MAX;
+
+	// A range of the heap, free or allocated. Blocks link to their neighbours in memory so that freed ranges can be
+	// merged, and free blocks link to the other blocks in their free list.
+	struct Block {
 		size_t offset = 0;
 		size_t size = 0;
-
-		bool operator<(const MemoryRange& other) const;
-		bool operator==(const MemoryRange& other) const;
+		uint32_t prevPhysical = INVALID_BLOCK;
+		uint32_t nextPhysical = INVALID_BLOCK;
+		uint32_t prevFree = INVALID_BLOCK;
+		uint32_t nextFree = INVALID_BLOCK;
+		bool free = false;
 	};
 
 	size_t _heapSize = 0;
@@ -35,18 +70,33 @@ class HeapAllocator {
 
 	HeapResizer _heapResizer;
 
-	SCP_vector<MemoryRange> _freeRanges;
-	SCP_vector<MemoryRange> _allocatedRanges;
+	SCP_vector<Block> _blocks;
+	SCP_vector<uint32_t> _unusedBlocks;
+	uint32_t _lastBlock = INVALID_BLOCK;
+
+	SCP_unordered_map<size_t, uint32_t> _allocatedBlocks;
+	size_t _allocatedSize = 0;
+	size_t _numFreeBlocks = 0;
 
-	void addFreeRange(const MemoryRange& range);
-	void addAllocatedRange(const MemoryRange& range);
+	uint64_t _firstLevelMap = 0;
+	uint32_t _secondLevelMaps[FIRST_LEVEL_COUNT];
+	uint32_t _freeLists[FIRST_LEVEL_COUNT][SECOND_LEVEL_COUNT];
+
+	uint32_t newBlock();
+	void releaseBlock(uint32_t block);
+
+	void insertFreeBlock(uint32_t block);
+	void removeFreeBlock(uint32_t block);
+	uint32_t findFreeBlock(size_t size) const;
+
+	void growHeap();
 
 	/**
-	 * @brief Checks if all free ranges are merged properly.
+	 * @brief Checks if a free block was merged with its neighbours properly.
 	 */
-	void checkRangesMerged();
+	void checkRangesMerged(uint32_t block);
 
-	static bool check_connected_range(const MemoryRange& left, const MemoryRange& right);
+	static void mapping(size_t size, int& firstLevel, int& secondLevel);
  public:
 	explicit HeapAllocator(const HeapResizer& creatorFunction);
 	~HeapAllocator() = default;
@@ -69,6 +119,12 @@ class HeapAllocator {
 	 * @return The active allocations in this heap.
 	 */
 	size_t numAllocations() const;
+
+	/**
+	 * @brief Retrieves how much of the heap is used and how the free memory is spread out
+	 * @return The statistics of this heap.
+	 */
+	Statistics statistics() const;
 };
 
 }
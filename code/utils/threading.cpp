@@ -23,9 +23,40 @@ namespace threading {
 	static std::atomic<WorkerThreadTask> worker_task;
 
 	static SCP_vector<std::thread> worker_threads;
+	static thread_local bool worker_thread = false;
+
+	//One parallel_for() call. Lives on the stack of the main thread for as long as parallel_for() runs.
+	struct parallel_for_batch {
+		const std::function<void(size_t)>* func;
+		size_t count;
+		std::atomic_size_t next;
+	};
+
+	static std::atomic<parallel_for_batch*> parallel_for_current(nullptr);
+	static std::atomic_size_t parallel_for_active_workers(0);
 
 	//Internal Functions
+	static void parallel_for_do_batch(parallel_for_batch* batch) {
+		for (size_t i = batch->next.fetch_add(1, std::memory_order_relaxed); i < batch->count; i = batch->next.fetch_add(1, std::memory_order_relaxed)) {
+			(*batch->func)(i);
+		}
+	}
+
+	static void parallel_for_mp_worker_thread() {
+		//Count ourselves in before looking for the batch, so that parallel_for() either waits for us, or we see that the batch is gone.
+		parallel_for_active_workers.fetch_add(1);
+
+		parallel_for_batch* batch = parallel_for_current.load();
+		if (batch != nullptr) {
+			parallel_for_do_batch(batch);
+		}
+
+		parallel_for_active_workers.fetch_sub(1);
+	}
+
 	static void mp_worker_thread_main(size_t threadIdx) {
+		worker_thread = true;
+
 		while(true) {
 			{
 				std::unique_lock<std::mutex> lk(wait_for_task_mutex);
@@ -38,6 +69,9 @@ namespace threading {
 				case WorkerThreadTask::COLLISION:
 					collide_mp_worker_thread(threadIdx);
 					break;
+				case WorkerThreadTask::PARALLEL_FOR:
+					parallel_for_mp_worker_thread();
+					break;
 				default:
 					UNREACHABLE("Invalid threaded worker task!");
 			}
@@ -184,6 +218,10 @@ namespace threading {
 		for(auto& thread : worker_threads) {
 			thread.join();
 		}
+
+		worker_threads.clear();
+		spin_down_threaded_task();
+		num_threads = 0;
 	}
 
 	bool is_threading() {
@@ -193,4 +231,37 @@ namespace threading {
 	size_t get_num_workers() {
 		return worker_threads.size();
 	}
+
+	bool is_worker_thread() {
+		return worker_thread;
+	}
+
+	void parallel_for(size_t count, size_t min_threaded_count, const std::function<void(size_t)>& func) {
+		Assertion(!worker_thread, "parallel_for() must not be called from the task pool!");
+
+		if (!is_threading() || count < min_threaded_count) {
+			for (size_t i = 0; i < count; i++) {
+				func(i);
+			}
+			return;
+		}
+
+		parallel_for_batch batch;
+		batch.func = &func;
+		batch.count = count;
+		batch.next.store(0);
+
+		parallel_for_current.store(&batch);
+		spin_up_threaded_task(WorkerThreadTask::PARALLEL_FOR);
+
+		parallel_for_do_batch(&batch);
+
+		spin_down_threaded_task();
+		parallel_for_current.store(nullptr);
+
+		//Workers may still be finishing the last items they claimed, or be about to look for the batch. Either way, the batch must outlive them.
+		while (parallel_for_active_workers.load() > 0) {
+			std::this_thread::yield();
+		}
+	}
 }
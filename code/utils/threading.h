@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 
 namespace threading {
-	enum class WorkerThreadTask : uint8_t { EXIT, COLLISION };
+	enum class WorkerThreadTask : uint8_t { EXIT, COLLISION, PARALLEL_FOR };
 
 	//Call this to start a task on the task pool. Note that task-specific data must be set up before calling this.
 	void spin_up_threaded_task(WorkerThreadTask task);
@@ -16,4 +18,11 @@ namespace threading {
 
 	bool is_threading();
 	size_t get_num_workers();
+
+	//True on the threads of the task pool, which must not touch state that the main thread fills in lazily.
+	bool is_worker_thread();
+
+	//Calls func(i) for every i in [0, count), split between the calling thread and the task pool, and returns once every call has finished and no worker is left inside the loop.
+	//Below min_threaded_count, or without a task pool, everything runs on the calling thread. Must be called from the main thread.
+	void parallel_for(size_t count, size_t min_threaded_count, const std::function<void(size_t)>& func);
 }
\ No newline at end of file
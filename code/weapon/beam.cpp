@@ -53,6 +53,7 @@
 #include "globalincs/globals.h"
 #include "globalincs/vmallocator.h"
 #include "tracing/tracing.h"
+#include "utils/threading.h"
 
 // ------------------------------------------------------------------------------------------------
 // BEAM WEAPON DEFINES/VARS
@@ -768,7 +769,7 @@ int beam_get_weapon_info_index(const object *bm)
 int beam_get_num_collisions(int objnum)
 {	
 	// sanity checks
-	if((objnum < 0) || (objnum >= MAX_OBJECTS)){
+	if((objnum < 0) || (objnum >= (int)Objects.size())){
 		Int3();
 		return -1;
 	}
@@ -794,7 +795,7 @@ int beam_get_num_collisions(int objnum)
 int beam_get_collision(int objnum, int num, int *collision_objnum, mc_info **cinfo)
 {
 	// sanity checks
-	if((objnum < 0) || (objnum >= MAX_OBJECTS)){
+	if((objnum < 0) || (objnum >= (int)Objects.size())){
 		Int3();
 		return 0;
 	}
@@ -2078,7 +2079,7 @@ void beam_apply_lighting()
 		l = &Beam_lights[idx];		
 
 		// bad object
-		if((l->objnum < 0) || (l->objnum >= MAX_OBJECTS) || (l->bm == NULL)){
+		if((l->objnum < 0) || (l->objnum >= (int)Objects.size()) || (l->bm == NULL)){
 			continue;
 		}
 
@@ -3048,16 +3049,20 @@ void beam_jitter_aim(beam *b, float aim)
 // BEAM COLLISION FUNCTIONS
 // -----------------------------===========================------------------------------
 
+// the ray casts of each beam are done together, and only split between threads if there are enough beams
+#define BEAM_COLLIDE_MIN_THREADED_BEAMS		4
+
+static SCP_vector<beam_collide_query> Beam_collide_queries;
+// where the queries of each beam start in the queries being cast, followed by the end of the last one
+static SCP_vector<size_t> Beam_collide_batches;
+
 // collide a beam with a ship, returns 1 if we can ignore all future collisions between the 2 objects
+// the ray casts are queued up for beam_collide_all_queued()
 int beam_collide_ship(obj_pair *pair)
 {
 	beam * a_beam;
-	object *weapon_objp;
 	object *ship_objp;
 	ship *shipp;
-	ship_info *sip;
-	weapon_info *bwi;
-	mc_info mc_hull_enter, mc_hull_exit, mc_shield, *mc;
 	int model_num;
 	float width;
 
@@ -3073,7 +3078,6 @@ int beam_collide_ship(obj_pair *pair)
 	Assert(pair->a->instance >= 0);
 	Assert(pair->a->type == OBJ_BEAM);
 	Assert(Beams[pair->a->instance].objnum == OBJ_INDEX(pair->a));
-	weapon_objp = pair->a;
 	a_beam = &Beams[pair->a->instance];
 
 	// Don't check collisions for warping out player if past stage 1.
@@ -3091,18 +3095,18 @@ int beam_collide_ship(obj_pair *pair)
 	if (a_beam->flags & BF_SAFETY) {
 		return 0;
 	}
-	
+
 	// if the colliding object is the shooting object, return 1 so this is culled
 	if (!pair->a->flags[Object::Object_Flags::Collides_with_parent] && pair->b == a_beam->objp) {
 		return 1;
-	}	
+	}
 
 	// try and get a model
 	model_num = beam_get_model(pair->b);
 	if (model_num < 0) {
 		return 1;
 	}
-	
+
 #ifndef NDEBUG
 	Beam_test_ints++;
 	Beam_test_ship++;
@@ -3120,11 +3124,6 @@ int beam_collide_ship(obj_pair *pair)
 	if (shipp->flags[Ship::Ship_Flags::Arriving_stage_1])
 		return 0;
 
-	int quadrant_num = -1;
-	bool valid_hit_occurred = false;
-	sip = &Ship_info[shipp->ship_info_index];
-	bwi = &Weapon_info[a_beam->weapon_info_index];
-
 	polymodel *pm = model_get(model_num);
 
 	// get the width of the beam
@@ -3133,7 +3132,12 @@ int beam_collide_ship(obj_pair *pair)
 
 	// Goober5000 - I tried to make collision code much saner... here begin the (major) changes
 
+	beam_collide_query query;
+	query.pair = *pair;
+	query.type = beam_collide_type::SHIP;
+
 	// set up collision struct
+	mc_info &mc_hull_enter = query.mc_hull_enter;
 	mc_hull_enter.model_instance_num = shipp->model_instance_num;
 	mc_hull_enter.model_num = model_num;
 	mc_hull_enter.submodel_num = -1;
@@ -3151,32 +3155,54 @@ int beam_collide_ship(obj_pair *pair)
 	}
 
 	// check all three kinds of collisions ---
-	int shield_collision, hull_enter_collision, hull_exit_collision;
-
 	if (pm->shield.ntris > 0) {
-		mc_shield = mc_hull_enter;
-		mc_shield.flags |= MC_CHECK_SHIELD;
-
-		shield_collision = model_collide(&mc_shield);
-	} else {
-		shield_collision = 0;
+		query.check_shield = true;
+		query.mc_shield = mc_hull_enter;
+		query.mc_shield.flags |= MC_CHECK_SHIELD;
 	}
 
 	if (beam_will_tool_target(a_beam, ship_objp)) {
-		mc_hull_exit = mc_hull_enter;
-		mc_hull_exit.flags |= MC_CHECK_MODEL;
+		query.check_hull_exit = true;
+		query.mc_hull_exit = mc_hull_enter;
+		query.mc_hull_exit.flags |= MC_CHECK_MODEL;
 
 		// reverse this vector so that we check for exit holes as opposed to entrance holes
-		std::swap(mc_hull_exit.p0, mc_hull_exit.p1);
-		hull_exit_collision = model_collide(&mc_hull_exit);
-	} else {
-		hull_exit_collision = 0;
+		std::swap(query.mc_hull_exit.p0, query.mc_hull_exit.p1);
 	}
 
 	mc_hull_enter.flags |= MC_CHECK_MODEL;
-	hull_enter_collision = model_collide(&mc_hull_enter);
 	// ---
 
+	Beam_collide_queries.push_back(std::move(query));
+
+	// reset timestamp to timeout immediately
+	pair->next_check_time = timestamp(0);
+
+	return 0;
+}
+
+// handle the hits of a beam:ship query once its ray casts are done
+static void beam_collide_ship_process(beam_collide_query *query)
+{
+	obj_pair *pair = &query->pair;
+	beam *a_beam = &Beams[pair->a->instance];
+	object *weapon_objp = pair->a;
+	object *ship_objp = pair->b;
+	ship *shipp = &Ships[ship_objp->instance];
+	ship_info *sip = &Ship_info[shipp->ship_info_index];
+	weapon_info *bwi = &Weapon_info[a_beam->weapon_info_index];
+	mc_info &mc_hull_enter = query->mc_hull_enter;
+	mc_info &mc_hull_exit = query->mc_hull_exit;
+	mc_info &mc_shield = query->mc_shield;
+	mc_info *mc;
+
+	int shield_collision = query->shield_collision;
+	int hull_enter_collision = query->hull_enter_collision;
+	int hull_exit_collision = query->hull_exit_collision;
+
+	int quadrant_num = -1;
+	bool valid_hit_occurred = false;
+
     // If we have a range less than the "far" range, check if the ray actually hit within the range
     if (a_beam->range < BEAM_FAR_LENGTH
         && (shield_collision || hull_enter_collision || hull_exit_collision))
@@ -3201,7 +3227,7 @@ int beam_collide_ship(obj_pair *pair)
         }
     }
 
-	
+
 	if (hull_enter_collision || hull_exit_collision || shield_collision) {
 		WarpEffect* warp_effect = nullptr;
 
@@ -3341,15 +3367,32 @@ int beam_collide_ship(obj_pair *pair)
 			}
 		}
 	}
-
-	// reset timestamp to timeout immediately
-	pair->next_check_time = timestamp(0);
-		
-	return 0;
 }
 
+// queues a single ray cast of a beam against an asteroid, missile or piece of debris
+static void beam_collide_queue_ray(obj_pair *pair, beam_collide_type type, int model_num)
+{
+	beam *a_beam = &Beams[pair->a->instance];
+
+	beam_collide_query query;
+	query.pair = *pair;
+	query.type = type;
+
+	mc_info &test_collide = query.mc_hull_enter;
+	test_collide.model_instance_num = -1;
+	test_collide.model_num = model_num;
+	test_collide.submodel_num = -1;
+	test_collide.orient = &pair->b->orient;
+	test_collide.pos = &pair->b->pos;
+	test_collide.p0 = &a_beam->last_start;
+	test_collide.p1 = &a_beam->last_shot;
+	test_collide.flags = MC_CHECK_MODEL | MC_CHECK_RAY;
+
+	Beam_collide_queries.push_back(std::move(query));
+}
 
 // collide a beam with an asteroid, returns 1 if we can ignore all future collisions between the 2 objects
+// the ray cast is queued up for beam_collide_all_queued()
 int beam_collide_asteroid(obj_pair *pair)
 {
 	beam * a_beam;
@@ -3375,18 +3418,18 @@ int beam_collide_asteroid(obj_pair *pair)
 	if(a_beam->flags & BF_SAFETY){
 		return 0;
 	}
-	
+
 	// if the colliding object is the shooting object, return 1 so this is culled
 	if(pair->b == a_beam->objp){
 		return 1;
-	}	
+	}
 
 	// try and get a model
 	model_num = beam_get_model(pair->b);
 	if(model_num < 0){
 		Int3();
 		return 1;
-	}	
+	}
 
 #ifndef NDEBUG
 	Beam_test_ints++;
@@ -3394,16 +3437,20 @@ int beam_collide_asteroid(obj_pair *pair)
 #endif
 
 	// do the collision
-	mc_info test_collide;
-	test_collide.model_instance_num = -1;
-	test_collide.model_num = model_num;
-	test_collide.submodel_num = -1;
-	test_collide.orient = &pair->b->orient;
-	test_collide.pos = &pair->b->pos;
-	test_collide.p0 = &a_beam->last_start;
-	test_collide.p1 = &a_beam->last_shot;
-	test_collide.flags = MC_CHECK_MODEL | MC_CHECK_RAY;
-	model_collide(&test_collide);
+	beam_collide_queue_ray(pair, beam_collide_type::ASTEROID, model_num);
+
+	// reset timestamp to timeout immediately
+	pair->next_check_time = timestamp(0);
+
+	return 0;
+}
+
+// handle the hit of a beam:asteroid query once its ray cast is done
+static void beam_collide_asteroid_process(beam_collide_query *query)
+{
+	obj_pair *pair = &query->pair;
+	beam *a_beam = &Beams[pair->a->instance];
+	mc_info &test_collide = query->mc_hull_enter;
 
 	// if we got a hit
 	if (test_collide.num_hits)
@@ -3449,20 +3496,14 @@ int beam_collide_asteroid(obj_pair *pair)
 					scripting::hook_param("Beam", 'o', pair->a),
 					scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
 		}
-
-		return 0;
 	}
-
-	// reset timestamp to timeout immediately
-	pair->next_check_time = timestamp(0);
-		
-	return 0;	
 }
 
 // collide a beam with a missile, returns 1 if we can ignore all future collisions between the 2 objects
+// the ray cast is queued up for beam_collide_all_queued()
 int beam_collide_missile(obj_pair *pair)
 {
-	beam *a_beam;	
+	beam *a_beam;
 	int model_num;
 
 	// bogus
@@ -3485,7 +3526,7 @@ int beam_collide_missile(obj_pair *pair)
 	if(a_beam->flags & BF_SAFETY){
 		return 0;
 	}
-	
+
 	// don't collide if the beam and missile share their parent
 	if (pair->b->parent_sig >= 0 && a_beam->objp && pair->b->parent_sig == a_beam->objp->signature) {
 		return 1;
@@ -3502,16 +3543,20 @@ int beam_collide_missile(obj_pair *pair)
 #endif
 
 	// do the collision
-	mc_info test_collide;
-	test_collide.model_instance_num = -1;
-	test_collide.model_num = model_num;
-	test_collide.submodel_num = -1;
-	test_collide.orient = &pair->b->orient;
-	test_collide.pos = &pair->b->pos;
-	test_collide.p0 = &a_beam->last_start;
-	test_collide.p1 = &a_beam->last_shot;
-	test_collide.flags = MC_CHECK_MODEL | MC_CHECK_RAY;
-	model_collide(&test_collide);
+	beam_collide_queue_ray(pair, beam_collide_type::MISSILE, model_num);
+
+	// reset timestamp to timeout immediately
+	pair->next_check_time = timestamp(0);
+
+	return 0;
+}
+
+// handle the hit of a beam:missile query once its ray cast is done
+static void beam_collide_missile_process(beam_collide_query *query)
+{
+	obj_pair *pair = &query->pair;
+	beam *a_beam = &Beams[pair->a->instance];
+	mc_info &test_collide = query->mc_hull_enter;
 
 	// if we got a hit
 	if(test_collide.num_hits)
@@ -3558,16 +3603,12 @@ int beam_collide_missile(obj_pair *pair)
 					scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
 		}
 	}
-
-	// reset timestamp to timeout immediately
-	pair->next_check_time = timestamp(0);
-
-	return 0;
 }
 
 // collide a beam with debris, returns 1 if we can ignore all future collisions between the 2 objects
+// the ray cast is queued up for beam_collide_all_queued()
 int beam_collide_debris(obj_pair *pair)
-{	
+{
 	beam * a_beam;
 	int model_num;
 
@@ -3594,33 +3635,37 @@ int beam_collide_debris(obj_pair *pair)
 	if(a_beam->flags & BF_SAFETY){
 		return 0;
 	}
-	
+
 	// if the colliding object is the shooting object, return 1 so this is culled
 	if(pair->b == a_beam->objp){
 		return 1;
-	}	
+	}
 
 	// try and get a model
 	model_num = beam_get_model(pair->b);
 	if(model_num < 0){
 		return 1;
-	}	
+	}
 
 #ifndef NDEBUG
 	Beam_test_ints++;
 #endif
 
 	// do the collision
-	mc_info test_collide;
-	test_collide.model_instance_num = -1;
-	test_collide.model_num = model_num;
-	test_collide.submodel_num = -1;
-	test_collide.orient = &pair->b->orient;
-	test_collide.pos = &pair->b->pos;
-	test_collide.p0 = &a_beam->last_start;
-	test_collide.p1 = &a_beam->last_shot;
-	test_collide.flags = MC_CHECK_MODEL | MC_CHECK_RAY;
-	model_collide(&test_collide);
+	beam_collide_queue_ray(pair, beam_collide_type::DEBRIS, model_num);
+
+	// reset timestamp to timeout immediately
+	pair->next_check_time = timestamp(0);
+
+	return 0;
+}
+
+// handle the hit of a beam:debris query once its ray cast is done
+static void beam_collide_debris_process(beam_collide_query *query)
+{
+	obj_pair *pair = &query->pair;
+	beam *a_beam = &Beams[pair->a->instance];
+	mc_info &test_collide = query->mc_hull_enter;
 
 	// if we got a hit
 	if(test_collide.num_hits)
@@ -3667,11 +3712,75 @@ int beam_collide_debris(obj_pair *pair)
 					scripting::hook_param("Hitpos", 'o', test_collide.hit_point_world)));
 		}
 	}
+}
 
-	// reset timestamp to timeout immediately
-	pair->next_check_time = timestamp(0);
+// runs the ray casts of a query, which only read the models and objects and so are safe on any thread
+static void beam_collide_cast(beam_collide_query *query)
+{
+	if (query->check_shield)
+		query->shield_collision = model_collide(&query->mc_shield);
 
-	return 0;
+	if (query->check_hull_exit)
+		query->hull_exit_collision = model_collide(&query->mc_hull_exit);
+
+	query->hull_enter_collision = model_collide(&query->mc_hull_enter);
+}
+
+void beam_collide_cast_all(SCP_vector<beam_collide_query> &queries)
+{
+	std::sort(queries.begin(), queries.end(), [](const beam_collide_query &a, const beam_collide_query &b) {
+		if (a.pair.a != b.pair.a)
+			return OBJ_INDEX(a.pair.a) < OBJ_INDEX(b.pair.a);
+		return OBJ_INDEX(a.pair.b) < OBJ_INDEX(b.pair.b);
+	});
+
+	Beam_collide_batches.clear();
+	for (size_t q = 0; q < queries.size(); ++q) {
+		if (q == 0 || queries[q].pair.a != queries[q - 1].pair.a)
+			Beam_collide_batches.push_back(q);
+	}
+
+	size_t num_batches = Beam_collide_batches.size();
+	Beam_collide_batches.push_back(queries.size());
+
+	threading::parallel_for(num_batches, BEAM_COLLIDE_MIN_THREADED_BEAMS, [&queries](size_t i) {
+		for (size_t q = Beam_collide_batches[i]; q < Beam_collide_batches[i + 1]; ++q) {
+			beam_collide_cast(&queries[q]);
+		}
+	});
+}
+
+/**
+ * Run the ray casts of all beam collisions queued up while finding the collision pairs, and then handle the hits here
+ * on the main thread.
+ */
+void beam_collide_all_queued()
+{
+	if (Beam_collide_queries.empty())
+		return;
+
+	TRACE_SCOPE(tracing::BeamCollisions);
+
+	beam_collide_cast_all(Beam_collide_queries);
+
+	for (auto &query : Beam_collide_queries) {
+		switch (query.type) {
+		case beam_collide_type::SHIP:
+			beam_collide_ship_process(&query);
+			break;
+		case beam_collide_type::ASTEROID:
+			beam_collide_asteroid_process(&query);
+			break;
+		case beam_collide_type::MISSILE:
+			beam_collide_missile_process(&query);
+			break;
+		case beam_collide_type::DEBRIS:
+			beam_collide_debris_process(&query);
+			break;
+		}
+	}
+
+	Beam_collide_queries.clear();
 }
 
 // early-out function for when adding object collision pairs, return 1 if the pair should be ignored
@@ -3871,7 +3980,7 @@ void beam_handle_collisions(beam *b)
 		int target = b->f_collisions[idx].c_objnum;
 
 		// if we have an invalid object
-		if((target < 0) || (target >= MAX_OBJECTS)){
+		if((target < 0) || (target >= (int)Objects.size())){
 			continue;
 		}
 
@@ -17,12 +17,12 @@
 //
 #include "globalincs/globals.h"
 #include "model/model.h"
+#include "object/objcollide.h"
 #include "utils/modular_curves.h"
 
 // prototypes
 class object;
 class ship_subsys;
-struct obj_pair;
 struct beam_weapon_info;
 struct vec3d;
 
@@ -279,6 +279,28 @@ int beam_collide_missile(obj_pair *pair);
 // collide a beam with debris, returns 1 if we can ignore all future collisions between the 2 objects
 int beam_collide_debris(obj_pair *pair);
 
+// do the ray casts the beam_collide_* functions queued up, and add the hits to the beams (after collision checking)
+void beam_collide_all_queued();
+
+// the kinds of objects a beam can collide with
+enum class beam_collide_type { SHIP, ASTEROID, MISSILE, DEBRIS };
+
+// A beam:object pair which got past the early checks.  The ray casts of all of these are run in one batch after the
+// collision pairs of the frame have been found, and the hits are then handled on the main thread.
+struct beam_collide_query {
+	obj_pair pair;
+	beam_collide_type type;
+	bool check_shield = false;
+	bool check_hull_exit = false;
+	mc_info mc_hull_enter, mc_hull_exit, mc_shield;
+	int hull_enter_collision = 0, hull_exit_collision = 0, shield_collision = 0;
+};
+
+// Run the ray casts of the queries, after sorting them by beam and then by the object hit so that they come out the
+// same no matter in which order the pairs were found.  The casts of each beam are done together, split between this
+// thread and the task pool if there are enough beams.
+void beam_collide_cast_all(SCP_vector<beam_collide_query> &queries);
+
 // pre-move (before collision checking - but AFTER ALL OTHER OBJECTS HAVE BEEN MOVED)
 void beam_move_all_pre();
 
@@ -16,6 +16,7 @@
 #include "model/modelrender.h"
 #include "nebula/neb.h"
 #include "object/object.h"
+#include "object/objectgrid.h"
 #include "options/Option.h"
 #include "render/3d.h"
 #include "render/batching.h"
@@ -35,6 +36,11 @@ static int Default_shockwave_loaded = 0;
 
 SCP_vector<shockwave_info> Shockwave_info;
 
+// the kinds of objects a shockwave can hit
+#define SHOCKWAVE_HIT_TYPES				(OBJ_GRID_TYPE(OBJ_SHIP) | OBJ_GRID_TYPE(OBJ_ASTEROID) | OBJ_GRID_TYPE(OBJ_WEAPON))
+// with fewer shockwaves, building a grid of the objects takes longer than looking at all of them
+#define SHOCKWAVE_GRID_MIN_SHOCKWAVES	2
+
 shockwave Shockwaves[MAX_SHOCKWAVES];
 shockwave Shockwave_list;
 int Shockwave_inited = 0;
@@ -313,12 +319,14 @@ void shockwave_move(object *shockwave_objp, float frametime)
 
 	// blast ships and asteroids
 	// And (some) weapons
-	for ( objp = GET_FIRST(&obj_used_list); objp !=END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp) ) {
+	SCP_frame_vector<int> candidates;
+	obj_find_in_sphere(candidates, &sw->pos, MIN(sw->outer_radius, sw->radius), SHOCKWAVE_HIT_TYPES);
+
+	for (int objnum : candidates) {
+		objp = &Objects[objnum];
+
 		if (objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
-		if ( (objp->type != OBJ_SHIP) && (objp->type != OBJ_ASTEROID) && (objp->type != OBJ_WEAPON)) {
-			continue;
-		}
 
 		if(objp->type == OBJ_WEAPON) {
 			// only apply to missiles with hitpoints
@@ -694,7 +702,17 @@ void shockwave_level_close()
 void shockwave_move_all(float frametime)
 {
 	shockwave	*sw, *next;
-	
+	int num_shockwaves = 0;
+
+	for ( sw = GET_FIRST(&Shockwave_list); sw != &Shockwave_list; sw = GET_NEXT(sw) ) {
+		++num_shockwaves;
+	}
+
+	// nothing moves while the shockwaves do, so they can all share one grid of the objects they could hit
+	bool use_grid = num_shockwaves >= SHOCKWAVE_GRID_MIN_SHOCKWAVES;
+	if (use_grid)
+		obj_grid_begin(SHOCKWAVE_HIT_TYPES);
+
 	sw = GET_FIRST(&Shockwave_list);
 	while ( sw != &Shockwave_list ) {
 		next = sw->next;
@@ -702,6 +720,9 @@ void shockwave_move_all(float frametime)
 		shockwave_move(&Objects[sw->objnum], frametime);
 		sw = next;
 	}
+
+	if (use_grid)
+		obj_grid_end();
 }
 
 /**
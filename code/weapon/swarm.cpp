@@ -152,7 +152,7 @@ void swarm_update_direction(object *objp, swarm_info* swarmp)
 	float			vel, target_dist, radius;
 	physics_info	*pi;
 
-	Assert(objp->instance >= 0 && objp->instance < MAX_WEAPONS);
+	Assert(objp->instance >= 0 && objp->instance < (int)Weapons.size());
 
 	wp = &Weapons[objp->instance];
 
@@ -326,17 +326,17 @@ void turret_swarm_set_up_info(int parent_objnum, ship_subsys *turret, const weap
 	*/
 
 	// get ship pointer	
-	Assert((parent_objnum >= 0) && (parent_objnum < MAX_OBJECTS));
-	if((parent_objnum < 0) || (parent_objnum >= MAX_OBJECTS)){
+	Assert((parent_objnum >= 0) && (parent_objnum < (int)Objects.size()));
+	if((parent_objnum < 0) || (parent_objnum >= (int)Objects.size())){
 		return;
 	}
 	parent_obj = &Objects[parent_objnum];
 	Assert(parent_obj->type == OBJ_SHIP);
 	shipp = &Ships[parent_obj->instance];
-	Assert(turret->turret_enemy_objnum < MAX_OBJECTS);
+	Assert(turret->turret_enemy_objnum < (int)Objects.size());
 	if (turret->turret_enemy_objnum < 0 && !no_tracking_object)
 		return;
-	if (turret->turret_enemy_objnum >= MAX_OBJECTS)
+	if (turret->turret_enemy_objnum >= (int)Objects.size())
 		return;
 
 	// valid swarm weapon
@@ -18,12 +18,35 @@
 #include "render/3d.h" 
 #include "ship/ship.h"
 #include "tracing/tracing.h"
+#include "utils/threading.h"
 #include "weapon/trails.h"
 #include "render/batching.h"
 
+
 static int Num_trails = 0;
 static trail Trails;
 
+// the trails are split between threads in chunks of this many, and only if there are enough of them
+#define TRAIL_CHUNK_SIZE			16
+#define TRAIL_MIN_THREADED_TRAILS	64
+
+// the geometry of a trail for this frame, which is a number of quads followed by a triangle at the tip
+struct trail_geometry {
+	trail *trailp;
+	primitive_batch *batchp;
+	size_t first_vert;			// where its vertices start in Trail_verts
+	int num_quads;				// 4 vertices each
+	bool end_tri;				// 3 vertices
+	float quad_ratio;			// trapezoidal correction of the quads
+};
+
+// all trails in list order, and how many of its segments are still alive after moving each one
+static SCP_vector<trail *> Trail_list;
+static SCP_vector<int> Trail_alive_segments;
+
+static SCP_vector<trail_geometry> Trail_geometry;
+static SCP_vector<vertex> Trail_verts;
+
 void trail_info_init(trail_info* t_info) {
 	t_info->pt = vmd_zero_vector;
 	t_info->w_start = 0.0f;
@@ -135,24 +158,69 @@ int trail_is_on_ship(trail *trailp, ship *shipp)
 	return 0;
 }
 
-void trail_render( trail * trailp )
+// finds the sections of a trail which are still alive, from the newest to the oldest
+static int trail_get_sections(const trail *trailp, int sections[NUM_TRAIL_SECTIONS])
 {
-	int sections[NUM_TRAIL_SECTIONS];
 	int num_sections = 0;
+	int n = trailp->tail;
+
+	do	{
+		n--;
+
+		if (n < 0)
+			n = NUM_TRAIL_SECTIONS-1;
+
+		if (trailp->val[n] > 1.0f)
+			break;
+
+		sections[num_sections++] = n;
+	} while ( n != trailp->head );
+
+	return num_sections;
+}
 
+// works out how much geometry a trail needs this frame, returns false if it has nothing to draw
+static bool trail_setup_geometry(trail *trailp, trail_geometry *geom)
+{
 	if (trailp->tail == trailp->head)
-		return;
+		return false;
 
 	trail_info *ti	= &trailp->info;
 
 	if (ti->texture.bitmap_id <= 0) {
-		return;
+		return false;
 	}
 
-	auto batchp = batching_find_batch(ti->texture.bitmap_id, batch_info::FLAT_EMISSIVE);
+	geom->trailp = trailp;
+	geom->quad_ratio = 1.0f;
 
 	if (trailp->single_segment) {
 		Assertion(trailp->tail == 2, "Single segment trail with more than two values!");
+		geom->num_quads = 1;
+		geom->end_tri = false;
+	} else {
+		int sections[NUM_TRAIL_SECTIONS];
+		int num_sections = trail_get_sections(trailp, sections);
+
+		if (num_sections <= 1)
+			return false;
+
+		geom->num_quads = num_sections - 2;
+		geom->end_tri = true;
+	}
+
+	geom->batchp = batching_find_batch(ti->texture.bitmap_id, batch_info::FLAT_EMISSIVE);
+	return true;
+}
+
+// fills in the vertices of a trail, which only reads the trail and the view so it's safe on any thread
+static void trail_build_geometry(trail_geometry *geom)
+{
+	trail *trailp = geom->trailp;
+	trail_info *ti	= &trailp->info;
+	vertex *verts = &Trail_verts[geom->first_vert];
+
+	if (trailp->single_segment) {
 		// confusing, i know
 		int front = trailp->tail - 1;
 		int back = trailp->head;
@@ -175,7 +243,6 @@ void trail_render( trail * trailp )
 		trail_calc_facing_pts(&ftop, &fbot, &trail_direction, &trailp->pos[front], f_width);
 		trail_calc_facing_pts(&btop, &bbot, &trail_direction, &trailp->pos[back], b_width);
 
-		vertex verts[4];
 		verts[0].r = verts[0].g = verts[0].b = verts[0].a = (ubyte)fl2i(f_alpha * 255.0f);
 		verts[1].r = verts[1].g = verts[1].b = verts[1].a = (ubyte)fl2i(f_alpha * 255.0f);
 		verts[2].r = verts[2].g = verts[2].b = verts[2].a = (ubyte)fl2i(b_alpha * 255.0f);
@@ -200,26 +267,15 @@ void trail_render( trail * trailp )
 		if (f_width <= 0.0f)
 			ratio = 999.0f;
 
-		batching_add_quad(ti->texture.bitmap_id, verts, batchp, ratio);
+		geom->quad_ratio = ratio;
 		return;
 	}
 
-	int n = trailp->tail;
-
-	do	{
-		n--;
-
-		if (n < 0)
-			n = NUM_TRAIL_SECTIONS-1;
-
-		if (trailp->val[n] > 1.0f)
-			break;
-
-		sections[num_sections++] = n;
-	} while ( n != trailp->head );
+	int sections[NUM_TRAIL_SECTIONS];
+	int num_sections = trail_get_sections(trailp, sections);
+	int n;
 
-	if (num_sections <= 1)
-		return;
+	Assertion(num_sections == geom->num_quads + 2, "Trail sections changed between setting up and building its geometry!");
 
 	float w_size = (ti->w_end - ti->w_start);
 	float a_size = (ti->a_end - ti->a_start);
@@ -287,7 +343,6 @@ void trail_render( trail * trailp )
 		if (i > 0) {
 			if (i == num_sections-1) {
 				// Last one...
-				vertex verts[3];
 				verts[0].r = verts[0].g = verts[0].b = verts[0].a = prev_alpha;
 				verts[1].r = verts[1].g = verts[1].b = verts[1].a = prev_alpha;
 				verts[2].r = verts[2].g = verts[2].b = verts[2].a = current_alpha;
@@ -306,10 +361,7 @@ void trail_render( trail * trailp )
 				verts[0].texture_position.v = 0.0f;
 				verts[1].texture_position.v = 1.0f;
 				verts[2].texture_position.v = 0.5f;
-
-				batching_add_tri(ti->texture.bitmap_id, verts, batchp);
 			} else {
-				vertex verts[4];
 				verts[0].r = verts[0].g = verts[0].b = verts[0].a = prev_alpha;
 				verts[1].r = verts[1].g = verts[1].b = verts[1].a = prev_alpha;
 				verts[2].r = verts[2].g = verts[2].b = verts[2].a = current_alpha;
@@ -328,7 +380,7 @@ void trail_render( trail * trailp )
 				verts[0].texture_position.v = verts[3].texture_position.v = 0.0f;
 				verts[1].texture_position.v = verts[2].texture_position.v = 1.0f;
 
-				batching_add_quad(ti->texture.bitmap_id, verts, batchp);
+				verts += 4;
 			}
 		}
 
@@ -386,59 +438,89 @@ void trail_set_segment( trail *trailp, vec3d *pos )
 	trailp->pos[next] = *pos;
 }
 
-void trail_move_all(float frametime)
+// ages the points of a trail and moves them along, returns how many of its segments are still alive
+static int trail_move(trail *trailp, float frametime)
 {
-	TRACE_SCOPE(tracing::TrailsMoveAll);
+	int num_alive_segments = 0, n;
+	float time_delta = frametime / trailp->info.max_life;
 
-	int num_alive_segments,n;
-	float time_delta;
-	trail *next_trail;
-	trail *prev_trail = &Trails;
+	if (trailp->single_segment) {
+		trailp->val[0] += time_delta;
+
+		if (trailp->val[0] > 0.0f) {
+			// finished 'unfurling'
+			// back end moves too now
+			trailp->pos[0] += trailp->vel[0] * frametime;
+		}
 
-	for (trail *trailp = Trails.next; trailp != &Trails; trailp = next_trail) {
-		next_trail = trailp->next;
+		if (trailp->object_died) {
+			if (trailp->val[0] >= trailp->val[1])
+				num_alive_segments = 0; // back has caught up to front and were dead
+			else
+				num_alive_segments = 2;
+		} else {
+			trailp->pos[1] += trailp->vel[1] * frametime;
+			trailp->val[1] += time_delta;
 
-		num_alive_segments = 0;
-		time_delta = frametime / trailp->info.max_life;
+			num_alive_segments = 2;
+		}
+	} else if ( trailp->tail != trailp->head )	{
+		n = trailp->tail;			
+		do	{
+			n--;
+			if ( n < 0 ) n = NUM_TRAIL_SECTIONS-1;
 
-		if (trailp->single_segment) {
-			trailp->val[0] += time_delta;
+			trailp->val[n] += time_delta;
 
-			if (trailp->val[0] > 0.0f) {
-				// finished 'unfurling'
-				// back end moves too now
-				trailp->pos[0] += trailp->vel[0] * frametime;
+			if ( trailp->val[n] <= 1.0f ) {
+				num_alive_segments++;	// Record how many still alive.
 			}
 
-			if (trailp->object_died) {
-				if (trailp->val[0] >= trailp->val[1])
-					num_alive_segments = 0; // back has caught up to front and were dead
-				else
-					num_alive_segments = 2;
-			} else {
-				trailp->pos[1] += trailp->vel[1] * frametime;
-				trailp->val[1] += time_delta;
+			trailp->pos[n] += trailp->vel[n] * frametime; 
 
-				num_alive_segments = 2;
-			}
-		} else if ( trailp->tail != trailp->head )	{
-			n = trailp->tail;			
-			do	{
-				n--;
-				if ( n < 0 ) n = NUM_TRAIL_SECTIONS-1;
+		} while ( n != trailp->head );
+	}
 
-				trailp->val[n] += time_delta;
+	return num_alive_segments;
+}
 
-				if ( trailp->val[n] <= 1.0f ) {
-					num_alive_segments++;	// Record how many still alive.
-				}
+// runs func on each of the trails numbered 0 to num_trails - 1, in chunks which are split between this thread and the
+// task pool if there are enough trails
+template <typename F>
+static void trail_parallel_for(size_t num_trails, F func)
+{
+	size_t num_chunks = (num_trails + TRAIL_CHUNK_SIZE - 1) / TRAIL_CHUNK_SIZE;
 
-				trailp->pos[n] += trailp->vel[n] * frametime; 
+	threading::parallel_for(num_chunks, TRAIL_MIN_THREADED_TRAILS / TRAIL_CHUNK_SIZE, [num_trails, &func](size_t i) {
+		size_t end = std::min((i + 1) * TRAIL_CHUNK_SIZE, num_trails);
 
-			} while ( n != trailp->head );
-		}		
-	
-		if ( (num_alive_segments < 1) && trailp->object_died)
+		for (size_t t = i * TRAIL_CHUNK_SIZE; t < end; ++t) {
+			func(t);
+		}
+	});
+}
+
+void trail_move_all(float frametime)
+{
+	TRACE_SCOPE(tracing::TrailsMoveAll);
+
+	Trail_list.clear();
+	for (trail *trailp = Trails.next; trailp != &Trails; trailp = trailp->next) {
+		Trail_list.push_back(trailp);
+	}
+
+	Trail_alive_segments.resize(Trail_list.size());
+
+	trail_parallel_for(Trail_list.size(), [frametime](size_t i) {
+		Trail_alive_segments[i] = trail_move(Trail_list[i], frametime);
+	});
+
+	trail *prev_trail = &Trails;
+
+	for (size_t i = 0; i < Trail_list.size(); ++i) {
+		trail *trailp = Trail_list[i];
+
+		if ( (Trail_alive_segments[i] < 1) && trailp->object_died)
 		{
 			prev_trail->next = trailp->next;
 			delete trailp;
@@ -467,9 +549,43 @@ void trail_render_all()
 	if ( !Detail.weapon_extras )
 		return;
 
+	// every trail gets its own part of the vertex buffer, so they can be built in any order and still be batched in
+	// list order
+	Trail_geometry.clear();
+	size_t num_verts = 0;
+
 	for(trail *trailp = Trails.next; trailp!=&Trails; trailp = trailp->next )
 	{
-		trail_render(trailp);
+		trail_geometry geom;
+		if (!trail_setup_geometry(trailp, &geom))
+			continue;
+
+		geom.first_vert = num_verts;
+		num_verts += geom.num_quads * 4 + (geom.end_tri ? 3 : 0);
+
+		Trail_geometry.push_back(geom);
+	}
+
+	if (Trail_geometry.empty())
+		return;
+
+	Trail_verts.resize(num_verts);
+
+	trail_parallel_for(Trail_geometry.size(), [](size_t i) {
+		trail_build_geometry(&Trail_geometry[i]);
+	});
+
+	for (auto &geom : Trail_geometry) {
+		int bitmap_id = geom.trailp->info.texture.bitmap_id;
+		vertex *verts = &Trail_verts[geom.first_vert];
+
+		for (int i = 0; i < geom.num_quads; ++i, verts += 4) {
+			batching_add_quad(bitmap_id, verts, geom.batchp, geom.quad_ratio);
+		}
+
+		if (geom.end_tri) {
+			batching_add_tri(bitmap_id, verts, geom.batchp);
+		}
 	}
 }
 
@@ -32,6 +32,7 @@
 #include "weapon/weapon_flags.h"
 #include "model/modelrender.h"
 #include "render/3d.h"
+#include "utils/ChunkedPool.h"
 
 #include "utils/modular_curves.h"
 
@@ -267,7 +268,9 @@ typedef struct spawn_weapon_info
 #define BEAM_FAR_LENGTH				30000.0f
 
 
-extern weapon Weapons[MAX_WEAPONS];
+#define WEAPON_CHUNK_SIZE			256		// how many weapon slots are added when Weapons[] runs out
+
+extern util::ChunkedPool<weapon, MAX_WEAPONS, WEAPON_CHUNK_SIZE> Weapons;
 
 #define WEAPON_TITLE_LEN			48
 
@@ -940,8 +943,6 @@ extern int Default_cmeasure_index;
 
 extern SCP_vector<int> Player_weapon_precedence;	// Vector of weapon types, precedence list for player weapon selection
 
-#define WEAPON_INDEX(wp)			(int)(wp-Weapons)
-
 typedef struct tracking_info {
 	ship_subsys *subsys;
 	int objnum;
@@ -966,6 +967,9 @@ void weapon_delete( object * obj );
 void weapon_process_pre( object *obj, float frame_time);
 void weapon_process_post( object *obj, float frame_time);
 
+// steers all homing weapons before any object moves, with the turn math spread over the worker threads
+void weapon_home_all(float frame_time);
+
 //Call before weapons_page_in to mark a weapon as used
 void weapon_mark_as_used(int weapon_id);
 
@@ -1022,7 +1026,7 @@ void	weapon_area_apply_blast(const vec3d *force_apply_pos, object *ship_objp, co
 int	weapon_area_calc_damage(const object *objp, const vec3d *pos, float inner_rad, float outer_rad, float max_blast, float max_damage,
 										float *blast, float *damage, float limit);
 
-void find_homing_object_cmeasures(const SCP_vector<object*> &cmeasure_list);
+void find_homing_object_cmeasures(const SCP_frame_vector<object*> &cmeasure_list);
 
 // THE FOLLOWING FUNCTION IS IN SHIP.CPP!!!!
 // JAS - figure out which thruster bitmap will get rendered next
@@ -38,6 +38,7 @@
 #include "network/multiutil.h"
 #include "object/objcollide.h"
 #include "object/objectdock.h"
+#include "object/objectgrid.h"
 #include "object/objectshield.h"
 #include "object/objectsnd.h"
 #include "parse/parsehi.h"
@@ -64,6 +65,7 @@
 #include "particle/volumes/PointVolume.h"
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
+#include "utils/threading.h"
 #include "weapon.h"
 #include "model/modelrender.h"
 
@@ -92,12 +94,12 @@ DCF_BOOL( weapon_flyby, Weapon_flyby_sound_enabled )
 
 static TIMESTAMP Weapon_flyby_sound_timer;
 
-weapon Weapons[MAX_WEAPONS];
+util::ChunkedPool<weapon, MAX_WEAPONS, WEAPON_CHUNK_SIZE> Weapons;
 SCP_vector<weapon_info> Weapon_info;
 
 #define		MISSILE_OBJ_USED	(1<<0)			// flag used in missile_obj struct
 #define		MAX_MISSILE_OBJS	MAX_WEAPONS		// max number of missiles tracked in missile list
-missile_obj Missile_objs[MAX_MISSILE_OBJS];	// array used to store missile object indexes
+util::ChunkedPool<missile_obj, MAX_MISSILE_OBJS, WEAPON_CHUNK_SIZE> Missile_objs;	// array used to store missile object indexes
 missile_obj Missile_obj_list;						// head of linked list of missile_obj structs
 
 #define DEFAULT_WEAPON_SPAWN_COUNT	10
@@ -326,7 +328,7 @@ void missile_obj_list_init()
 	int i;
 
 	list_init(&Missile_obj_list);
-	for ( i = 0; i < MAX_MISSILE_OBJS; i++ ) {
+	for ( i = 0; i < (int)Missile_objs.size(); i++ ) {
 		Missile_objs[i].flags = 0;
 	}
 }
@@ -339,11 +341,11 @@ int missile_obj_list_add(int objnum)
 {
 	int i;
 
-	for ( i = 0; i < MAX_MISSILE_OBJS; i++ ) {
+	for ( i = 0; i < (int)Missile_objs.size(); i++ ) {
 		if ( !(Missile_objs[i].flags & MISSILE_OBJ_USED) )
 			break;
 	}
-	if ( i == MAX_MISSILE_OBJS ) {
+	if ( i == (int)Missile_objs.size() && Missile_objs.grow() == 0 ) {
 		Error(LOCATION, "Fatal Error: Ran out of missile object nodes\n");
 		return -1;
 	}
@@ -362,7 +364,7 @@ int missile_obj_list_add(int objnum)
  */
 void missle_obj_list_remove(int index)
 {
-	Assert(index >= 0 && index < MAX_MISSILE_OBJS);
+	Assert(index >= 0 && index < (int)Missile_objs.size());
 	list_remove(&Missile_obj_list, &Missile_objs[index]);	
 	Missile_objs[index].flags = 0;
 }
@@ -4971,7 +4973,7 @@ void weapon_level_init()
 
 	// Reset everything between levels
 	Num_weapons = 0;
-	for (i=0; i<MAX_WEAPONS; i++)	{
+	for (i=0; i<(int)Weapons.size(); i++)	{
 		Weapons[i].objnum = -1;
 		Weapons[i].weapon_info_index = -1;
 	}
@@ -5304,8 +5306,23 @@ void find_homing_object(object *weapon_objp, int num)
 /**
  * For all homing weapons, see if they should be decoyed by a countermeasure.
  */
-void find_homing_object_cmeasures(const SCP_vector<object*> &cmeasure_list)
+void find_homing_object_cmeasures(const SCP_frame_vector<object*> &cmeasure_list)
 {
+	// Sort the countermeasures along x, so that each weapon only has to look at the ones that are within the largest
+	// effective radius of it on that axis.  The candidates are then visited in their original order, so which
+	// countermeasure wins (and the random rolls made along the way) are the same as checking the whole list.
+	SCP_frame_vector<int> cmeasures_by_x(cmeasure_list.size());
+	float max_effective_rad = 0.0f;
+	for (size_t i = 0; i < cmeasure_list.size(); i++) {
+		cmeasures_by_x[i] = (int)i;
+		max_effective_rad = MAX(max_effective_rad, Weapon_info[Weapons[cmeasure_list[i]->instance].weapon_info_index].cm_effective_rad);
+	}
+	std::sort(cmeasures_by_x.begin(), cmeasures_by_x.end(), [&cmeasure_list](int a, int b) {
+		return cmeasure_list[a]->pos.xyz.x < cmeasure_list[b]->pos.xyz.x;
+	});
+
+	SCP_frame_vector<int> nearby_cmeasures;
+
 	for (object *weapon_objp = GET_FIRST(&obj_used_list); weapon_objp != END_OF_LIST(&obj_used_list); weapon_objp = GET_NEXT(weapon_objp) ) {
 		if (weapon_objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
@@ -5319,8 +5336,25 @@ void find_homing_object_cmeasures(const SCP_vector<object*> &cmeasure_list)
 				continue;
 
 			if (wip->is_homing()) {
+				const vec3d &weapon_pos = weapon_objp->pos;
+
+				auto first = std::lower_bound(cmeasures_by_x.cbegin(), cmeasures_by_x.cend(), weapon_pos.xyz.x - max_effective_rad, [&cmeasure_list](int cm, float x) {
+					return cmeasure_list[cm]->pos.xyz.x < x;
+				});
+
+				nearby_cmeasures.clear();
+				for (auto cm = first; cm != cmeasures_by_x.cend() && cmeasure_list[*cm]->pos.xyz.x <= weapon_pos.xyz.x + max_effective_rad; ++cm) {
+					const vec3d &cm_pos = cmeasure_list[*cm]->pos;
+					if (fl_abs(cm_pos.xyz.y - weapon_pos.xyz.y) <= max_effective_rad && fl_abs(cm_pos.xyz.z - weapon_pos.xyz.z) <= max_effective_rad) {
+						nearby_cmeasures.push_back(*cm);
+					}
+				}
+				std::sort(nearby_cmeasures.begin(), nearby_cmeasures.end());
+
 				float best_dot = wip->fov;
-				for (auto cit = cmeasure_list.cbegin(); cit != cmeasure_list.cend(); ++cit) {
+				for (int cm : nearby_cmeasures) {
+					auto cit = &cmeasure_list[cm];
+
 					//don't have a weapon try to home in on itself
 					if (*cit == weapon_objp)
 						continue;
@@ -5450,6 +5484,20 @@ bool aspect_should_lose_target(weapon* wp)
 	return false;
 }
 
+// A missile turn queued by weapon_home() while weapon_home_all() is running.  The turn only reads the frame's object
+// state and only writes the missile's own physics, so the queued turns can be worked through on any thread.
+struct weapon_homing_turn {
+	int objnum;
+	vec3d target_pos;
+	vec3d turnrate_mod;
+};
+
+static bool Weapon_homing_batch = false;
+static SCP_vector<weapon_homing_turn> Weapon_homing_turns;
+
+// below this many turns it is not worth waking up the worker threads
+static const size_t WEAPON_HOMING_MIN_THREADED_TURNS = 32;
+
 /**
  * Make weapon num home.  It's also object *obj.
  */
@@ -5903,10 +5951,16 @@ void weapon_home(object *obj, int num, float frame_time)
 		// turn the missile towards the target only if non-swarm.  Homing swarm missiles choose
 		// a different vector to turn towards, this is done in swarm_update_direction().
 		if ( wp->swarm_info_ptr == nullptr ) {
-			ai_turn_towards_vector(&target_pos, obj, nullptr, nullptr, 0.0f, 0, nullptr, &turnrate_mod);
-			vel = vm_vec_mag(&obj->phys_info.desired_vel);
+			if (Weapon_homing_batch) {
+				// weapon_home_all() does the turn once every weapon has picked its goal.  This only happens with
+				// framerate independent turning, where the turn leaves obj->orient (and so desired_vel) alone.
+				Weapon_homing_turns.push_back({ OBJ_INDEX(obj), target_pos, turnrate_mod });
+			} else {
+				ai_turn_towards_vector(&target_pos, obj, nullptr, nullptr, 0.0f, 0, nullptr, &turnrate_mod);
+				vel = vm_vec_mag(&obj->phys_info.desired_vel);
 
-			vm_vec_copy_scale(&obj->phys_info.desired_vel, &obj->orient.vec.fvec, vel);
+				vm_vec_copy_scale(&obj->phys_info.desired_vel, &obj->orient.vec.fvec, vel);
+			}
 		}
 
 		// (likely) fs1 code to early detonate if still nearby the target but not pointing at it
@@ -5982,22 +6036,18 @@ void weapon_do_homing_behavior(object* obj, float  frame_time) {
 	}
 }
 
-// as Mike K did with ships -- break weapon into process_pre and process_post for code to execute
-// before and after physics movement
-
-void weapon_process_pre( object *obj, float  frame_time)
+// corkscrew missiles move in cscrew_process_pre() before they home, so they keep homing from weapon_process_pre()
+static bool weapon_homes_in_batch(const weapon *wp)
 {
-	if(obj->type != OBJ_WEAPON)
-		return;
+	return wp->cscrew_index < 0;
+}
 
+// detonate weapons that are past their detonation range, or close enough to their target, before they home
+static void weapon_maybe_detonate_pre(object *obj)
+{
 	weapon *wp = &Weapons[obj->instance];
 	weapon_info *wip = &Weapon_info[wp->weapon_info_index];
 
-	// if the object is a corkscrew style weapon, process it now
-	if((obj->type == OBJ_WEAPON) && (Weapons[obj->instance].cscrew_index >= 0)){
-		cscrew_process_pre(obj);
-	}
-
 	//WMC - Originally flak_maybe_detonate, moved here.
 	if(wp->det_range > 0.0f)
 	{
@@ -6031,9 +6081,61 @@ void weapon_process_pre( object *obj, float  frame_time)
 			}
 		}
 	}
+}
+
+/**
+ * Run the homing behavior of every weapon before any object moves this frame.  Target selection and everything else
+ * with side effects runs here on the main thread, while the turns themselves are queued up and then split between
+ * the main thread and the task pool.
+ */
+void weapon_home_all(float frame_time)
+{
+	TRACE_SCOPE(tracing::WeaponHoming);
+
+	Weapon_homing_turns.clear();
+	Weapon_homing_batch = true;
+
+	for (object *objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp)) {
+		if (objp->type != OBJ_WEAPON || objp->flags[Object::Object_Flags::Should_be_dead])
+			continue;
+
+		if (weapon_homes_in_batch(&Weapons[objp->instance])) {
+			weapon_maybe_detonate_pre(objp);
+			weapon_do_homing_behavior(objp, frame_time);
+		}
+	}
+
+	Weapon_homing_batch = false;
+
+	threading::parallel_for(Weapon_homing_turns.size(), WEAPON_HOMING_MIN_THREADED_TURNS, [](size_t i) {
+		const auto &turn = Weapon_homing_turns[i];
+		ai_turn_towards_vector(&turn.target_pos, &Objects[turn.objnum], nullptr, nullptr, 0.0f, 0, nullptr, &turn.turnrate_mod);
+	});
+}
+
+// as Mike K did with ships -- break weapon into process_pre and process_post for code to execute
+// before and after physics movement
+
+void weapon_process_pre( object *obj, float  frame_time)
+{
+	if(obj->type != OBJ_WEAPON)
+		return;
+
+	weapon *wp = &Weapons[obj->instance];
+
+	// if the object is a corkscrew style weapon, process it now
+	if((obj->type == OBJ_WEAPON) && (Weapons[obj->instance].cscrew_index >= 0)){
+		cscrew_process_pre(obj);
+	}
+
+	// weapons that home in a batch have already been through this in weapon_home_all()
+	if (!Framerate_independent_turning || !weapon_homes_in_batch(wp)) {
+		weapon_maybe_detonate_pre(obj);
+	}
 
 	// If this flag is false missile turning is evaluated in weapon_process_post()
-	if (Framerate_independent_turning) {
+	// and if it's true, most weapons have already been steered by weapon_home_all()
+	if (Framerate_independent_turning && !weapon_homes_in_batch(wp)) {
 		weapon_do_homing_behavior(obj, frame_time);
 	}
 }
@@ -6565,7 +6667,7 @@ void weapon_set_tracking_info(int weapon_objnum, int parent_objnum, int target_o
 			(!targeting_same || (MULTI_DOGFIGHT && (target_team == Iff_traitor)));
 
 		// Cyborg17 - exclude all invalid object numbers here since in multi, the lock slots can get out of sync.
-		if ((target_objnum > -1) && (target_objnum < (MAX_OBJECTS)) && can_lock) {
+		if ((target_objnum > -1) && (target_objnum < (int)Objects.size()) && can_lock) {
 			wp->target_num = target_objnum;
 			wp->target_sig = Objects[target_objnum].signature;
 			if ( (wip->wi_flags[Weapon::Info_Flags::Homing_aspect]) && target_is_locked) {
@@ -6648,6 +6750,27 @@ size_t* get_pointer_to_weapon_fire_pattern_index(int weapon_type, int ship_idx,
 	return NULL;
 }
 
+/**
+ * Adds another chunk of free slots to Weapons[]
+ *
+ * @return false if Weapons[] is already as large as it can get
+ */
+static bool weapon_grow_slots()
+{
+	size_t first_new = Weapons.size();
+
+	if (Weapons.grow() == 0)
+		return false;
+
+	for (size_t i = first_new; i < Weapons.size(); i++) {
+		Weapons[i].objnum = -1;
+		Weapons[i].weapon_info_index = -1;
+	}
+
+	nprintf(("Weapon", "Grew weapon slots to %d\n", (int)Weapons.size()));
+	return true;
+}
+
 /**
  * Create a weapon object
  *
@@ -6723,18 +6846,18 @@ int weapon_create( const vec3d *pos, const matrix *porient, int weapon_type, int
 		}
 	}
 
-	if (Num_weapons == MAX_WEAPONS) {
+	if (Num_weapons == (int)Weapons.size() && !weapon_grow_slots()) {
 		mprintf(("Can't fire due to lack of weapon slots"));
 		return -1;
 	}
 
-	for (n=0; n<MAX_WEAPONS; n++ ){
+	for (n=0; n<(int)Weapons.size(); n++ ){
 		if (Weapons[n].weapon_info_index < 0){
 			break;
 		}
 	}
 
-	Assertion(n != MAX_WEAPONS, "Somehow tried to create weapons despite being at max weapons");
+	Assertion(n != (int)Weapons.size(), "Somehow tried to create weapons despite being at max weapons");
 
 	// make sure we are loaded and useable
 	if ( (wip->render_type == WRT_POF) && (wip->model_num < 0) ) {
@@ -7183,7 +7306,7 @@ void spawn_child_weapons(object *objp, int spawn_index_override)
 
 	Assertion(objp->type == OBJ_WEAPON || objp->type == OBJ_BEAM, "spawn_child_weapons() doesn't make sense for non-weapon non-beam objects; get a coder!\n");
 	Assertion(objp->instance >= 0, "spawn_child_weapons() called with an object with an instance of %d; get a coder!\n", objp->instance);
-	Assertion(!(objp->type == OBJ_WEAPON) || (objp->instance < MAX_WEAPONS), "spawn_child_weapons() called with a weapon with an instance of %d while MAX_WEAPONS is %d; get a coder!\n", objp->instance, MAX_WEAPONS);
+	Assertion(!(objp->type == OBJ_WEAPON) || (objp->instance < (int)Weapons.size()), "spawn_child_weapons() called with a weapon with an instance of %d while there are only %d weapon slots; get a coder!\n", objp->instance, (int)Weapons.size());
 	Assertion(!(objp->type == OBJ_BEAM) || (objp->instance < MAX_BEAMS), "spawn_child_weapons() called with a beam with an instance of %d while MAX_BEAMS is %d; get a coder!\n", objp->instance, MAX_BEAMS);
 
 	if (objp->type == OBJ_WEAPON) {
@@ -7679,13 +7802,15 @@ void weapon_do_area_effect(object *wobjp, const shockwave_create_info *sci, cons
 
 	// only blast ships and asteroids
 	// And (some) weapons
-	for ( objp = GET_FIRST(&obj_used_list); objp !=END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp) ) {
+	SCP_frame_vector<int> candidates;
+	obj_find_in_sphere(candidates, pos, sci->outer_rad, OBJ_GRID_TYPE(OBJ_SHIP) | OBJ_GRID_TYPE(OBJ_ASTEROID) | OBJ_GRID_TYPE(OBJ_WEAPON));
+
+	for (int objnum : candidates) {
+		objp = &Objects[objnum];
+
 		if (objp->flags[Object::Object_Flags::Should_be_dead])
 			continue;
-		if ( (objp->type != OBJ_SHIP) && (objp->type != OBJ_ASTEROID) && (objp->type != OBJ_WEAPON) ) {
-			continue;
-		}
-	
+
 		if (objp->type == OBJ_WEAPON) {
 			// only apply to missiles with hitpoints
 			weapon_info* wip2 = &Weapon_info[Weapons[objp->instance].weapon_info_index];
@@ -8093,8 +8218,8 @@ bool weapon_hit( object* weapon_obj, object* impacted_obj, const vec3d* hitpos,
 	if(weapon_obj == nullptr){
 		return false;
 	}
-	Assert((weapon_obj->type == OBJ_WEAPON) && (weapon_obj->instance >= 0) && (weapon_obj->instance < MAX_WEAPONS));
-	if((weapon_obj->type != OBJ_WEAPON) || (weapon_obj->instance < 0) || (weapon_obj->instance >= MAX_WEAPONS)){
+	Assert((weapon_obj->type == OBJ_WEAPON) && (weapon_obj->instance >= 0) && (weapon_obj->instance < (int)Weapons.size()));
+	if((weapon_obj->type != OBJ_WEAPON) || (weapon_obj->instance < 0) || (weapon_obj->instance >= (int)Weapons.size())){
 		return false;
 	}
 
@@ -8229,7 +8354,7 @@ bool weapon_hit( object* weapon_obj, object* impacted_obj, const vec3d* hitpos,
     weapon_obj->flags.set(Object::Object_Flags::Should_be_dead);
 
 	// decrement parent's number of active remote detonators if applicable
-	if (wip->wi_flags[Weapon::Info_Flags::Remote] && weapon_obj->parent >= 0 && (weapon_obj->parent < MAX_OBJECTS)) {
+	if (wip->wi_flags[Weapon::Info_Flags::Remote] && weapon_obj->parent >= 0 && (weapon_obj->parent < (int)Objects.size())) {
 		object* parent = &Objects[weapon_obj->parent];
 		if ( parent->type == OBJ_SHIP && parent->signature == weapon_obj->parent_sig)
 			Ships[Objects[weapon_obj->parent].instance].weapons.remote_detonaters_active--;
@@ -8676,14 +8801,14 @@ float weapon_get_damage_scale(const weapon_info *wip, const object *wep, const o
 	}
 
 	// don't scale any damage if its not a weapon	
-	if((wep->type != OBJ_WEAPON) || (wep->instance < 0) || (wep->instance >= MAX_WEAPONS)){
+	if((wep->type != OBJ_WEAPON) || (wep->instance < 0) || (wep->instance >= (int)Weapons.size())){
 		return 1.0f;
 	}
 	wp = &Weapons[wep->instance];
 
 	// was the weapon fired by the player
 	from_player = 0;
-	if((wep->parent >= 0) && (wep->parent < MAX_OBJECTS) && (Objects[wep->parent].flags[Object::Object_Flags::Player_ship])){
+	if((wep->parent >= 0) && (wep->parent < (int)Objects.size()) && (Objects[wep->parent].flags[Object::Object_Flags::Player_ship])){
 		from_player = 1;
 	}
 		
@@ -8754,7 +8879,7 @@ float weapon_get_damage_scale(const weapon_info *wip, const object *wep, const o
 
 void pause_in_flight_sounds()
 {
-	for (int i = 0; i < MAX_WEAPONS; i++)
+	for (int i = 0; i < (int)Weapons.size(); i++)
 	{
 		if (Weapons[i].objnum != -1)
 		{
@@ -2071,15 +2071,13 @@ void CFREDView::OnSelectList()
 // position camera to view all objects on the screen at once.  Doesn't change orientation.
 void view_universe(int just_marked)
 {
-	int i, max = 0, obj_flags[MAX_OBJECTS];
+	int i, max = 0;
+	SCP_vector<int> obj_flags(Objects.size(), 0);
 	float dist, largest = 20.0f;
 	vec3d center, p1, p2;		// center of all the objects collectively
 	vertex v;
 	object *ptr;
 
-	for (i=0; i<MAX_OBJECTS; i++)
-		obj_flags[i] = 0;
-
 	if (just_marked)
 		ptr = &Objects[cur_object_index];
 	else
@@ -4401,7 +4399,8 @@ void CFREDView::OnNextObj()
 
 void CFREDView::OnPrevObj() 
 {
-	int arr[MAX_OBJECTS], i = 0, n = 0;
+	SCP_vector<int> arr(Objects.size());
+	int i = 0, n = 0;
 	object *ptr;
 
 	if (Bg_bitmap_dialog) {
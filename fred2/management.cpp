@@ -906,7 +906,7 @@ int query_valid_object(int index)
 	int obj_found = FALSE;
 	object *ptr;
 
-	if (index < 0 || index >= MAX_OBJECTS || Objects[index].type == OBJ_NONE)
+	if (index < 0 || index >= (int)Objects.size() || Objects[index].type == OBJ_NONE)
 		return FALSE;
 
 	ptr = GET_FIRST(&obj_used_list);
@@ -927,7 +927,7 @@ int query_valid_ship(int index)
 	int obj_found = FALSE;
 	object *ptr;
 
-	if (index < 0 || index >= MAX_OBJECTS || Objects[index].type != OBJ_SHIP)
+	if (index < 0 || index >= (int)Objects.size() || Objects[index].type != OBJ_SHIP)
 		return FALSE;
 
 	ptr = GET_FIRST(&obj_used_list);
@@ -948,7 +948,7 @@ int query_valid_waypoint(int index)
 	int obj_found = FALSE;
 	object *ptr;
 
-	if (index < 0 || index >= MAX_OBJECTS || Objects[index].type != OBJ_WAYPOINT)
+	if (index < 0 || index >= (int)Objects.size() || Objects[index].type != OBJ_WAYPOINT)
 		return FALSE;
 
 	ptr = GET_FIRST(&obj_used_list);
@@ -1454,7 +1454,7 @@ void unmark_all()
 	int i;
 
 	if (Marked) {
-		for (i=0; i<MAX_OBJECTS; i++){
+		for (i=0; i<(int)Objects.size(); i++){
             Objects[i].flags.remove(Object::Object_Flags::Marked);
 		}
 
@@ -2275,7 +2275,7 @@ void object_moved(object *objp)
 	if ((objp->type == OBJ_SHIP) || (objp->type == OBJ_START)) // do we have a ship?
 	{
 		// reset the already-handled flag (inefficient, but it's FRED, so who cares)
-        for (int i = 0; i < MAX_OBJECTS; i++)
+        for (int i = 0; i < (int)Objects.size(); i++)
             Objects[i].flags.remove(Object::Object_Flags::Docked_already_handled);
 
 		// move all docked objects docked to me
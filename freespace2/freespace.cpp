@@ -29,6 +29,7 @@
 
 #include "globalincs/alphacolors.h"
 #include "globalincs/crashdump.h"
+#include "globalincs/memory/frame_arena.h"
 #include "globalincs/mspdb_callstack.h"
 #include "globalincs/version.h"
 
@@ -131,6 +132,7 @@
 #include "network/multi_fstracker.h"
 #include "network/multi_ingame.h"
 #include "network/multi_interpolate.h"
+#include "network/multi_loadtest.h"
 #include "network/multi_log.h"
 #include "network/multi_pause.h"
 #include "network/multi_pxo.h"
@@ -2789,7 +2791,7 @@ void player_repair_frame(float frametime)
 					&& (Net_player->player_id != np.player_id)
 					&& (np.m_player != nullptr)
 					&& (np.m_player->objnum >= 0)
-					&& (np.m_player->objnum < MAX_OBJECTS)){
+					&& (np.m_player->objnum < (int)Objects.size())){
 
 				// don't rearm/repair if the player is dead or dying/departing
 				if ( !NETPLAYER_IS_DEAD((&np)) && !(Ships[Objects[np.m_player->objnum].instance].is_dying_or_departing()) ) {
@@ -3638,7 +3640,7 @@ void game_simulation_frame()
 				continue;
 
 			// bogus
-			if((moveup->objnum < 0) || (moveup->objnum >= MAX_OBJECTS) || (Objects[moveup->objnum].type != OBJ_SHIP) || (Objects[moveup->objnum].instance < 0) || (Objects[moveup->objnum].instance >= MAX_SHIPS) || (Ships[Objects[moveup->objnum].instance].ship_info_index < 0) || (Ships[Objects[moveup->objnum].instance].ship_info_index >= ship_info_size())){
+			if((moveup->objnum < 0) || (moveup->objnum >= (int)Objects.size()) || (Objects[moveup->objnum].type != OBJ_SHIP) || (Objects[moveup->objnum].instance < 0) || (Objects[moveup->objnum].instance >= MAX_SHIPS) || (Ships[Objects[moveup->objnum].instance].ship_info_index < 0) || (Ships[Objects[moveup->objnum].instance].ship_info_index >= ship_info_size())){
 				continue;
 			}
 
@@ -4410,6 +4412,9 @@ void game_set_frametime(int state)
 	float frame_cap_diff;
 	bool do_pre_player_skip = false;
 
+	// the load test only counts the time spent working, not the frame cap sleeps below
+	multi_loadtest_frame_end();
+
 	// sync all timestamps across the entire frame
 	timer_start_frame();
 
@@ -4457,6 +4462,8 @@ void game_set_frametime(int state)
 		Frametime = thistime - Last_time;
    }
 
+	multi_loadtest_frame_start();
+
 	// If framerate is too low, cap it.
 	if (Frametime > MAX_FRAMETIME)	{
 #ifndef NDEBUG
@@ -6907,6 +6914,9 @@ int game_main(int argc, char *argv[])
 			break;
 		}
 
+		// Nothing may hold on to frame memory past this point
+		memory::frame_arena_reset();
+
 		// Since tracing is always active this needs to happen in the main loop
 		tracing::process_events();
 	} 
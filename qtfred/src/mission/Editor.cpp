@@ -411,7 +411,7 @@ bool Editor::loadMission(const std::string& mission_name, int flags) {
 }
 void Editor::unmark_all() {
 	if (numMarked > 0) {
-		for (auto i = 0; i < MAX_OBJECTS; i++) {
+		for (auto i = 0; i < (int)Objects.size(); i++) {
 			Objects[i].flags.remove(Object::Object_Flags::Marked);
 			if (Objects[i].type != OBJ_NONE) {
 				// Only emit signals for valid objects
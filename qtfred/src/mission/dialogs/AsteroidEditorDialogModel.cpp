@@ -60,7 +60,7 @@ void AsteroidEditorDialogModel::initializeData()
 		_num_asteroids = 1; // fallback
 	}
 
-	CLAMP(_num_asteroids, 1, MAX_ASTEROIDS);
+	CLAMP(_num_asteroids, 1, asteroid_max_field_asteroids());
 
 	_avg_speed = QString::number(static_cast<int>(vm_vec_mag(&_a_field.vel)));
 
@@ -108,7 +108,7 @@ void AsteroidEditorDialogModel::update_internal_field()
 	
 	// Do some quick data conversion
 	int num_asteroids = _enable_asteroids ? _num_asteroids : 0;
-	CLAMP(num_asteroids, 0, MAX_ASTEROIDS);
+	CLAMP(num_asteroids, 0, asteroid_max_field_asteroids());
 	vec3d vel_vec = vmd_x_vector;
 	vm_vec_scale(&vel_vec, static_cast<float>(_avg_speed.toInt()));
 	
@@ -111,7 +111,7 @@ void AsteroidEditorDialog::initializeUi()
 	ui->lineEdit_ibox_maxZ->setText(_model->getBoxText(AsteroidEditorDialogModel::_box_line_edits::_I_MAX_Z));
 
 	// Housekeeping
-	ui->spinBoxNumber->setRange(1, MAX_ASTEROIDS);
+	ui->spinBoxNumber->setRange(1, asteroid_max_field_asteroids());
 }
 
 void AsteroidEditorDialog::updateUi()
@@ -0,0 +1,284 @@
+#include <gtest/gtest.h>
+
+#include "asteroid/asteroid.h"
+#include "globalincs/linklist.h"
+#include "globalincs/systemvars.h"
+#include "mission/missionparse.h"
+#include "mod_table/mod_table.h"
+#include "model/model.h"
+#include "object/object.h"
+#include "render/3d.h"
+#include "ship/ship.h"
+
+#include "util/FSTestFixture.h"
+
+#include <algorithm>
+
+extern polymodel *Polygon_models[MAX_POLYGON_MODELS];
+extern float flFrametime;
+
+class AsteroidDormantTest : public test::FSTestFixture {
+ public:
+	AsteroidDormantTest() : test::FSTestFixture(INIT_NONE) {
+	}
+
+ protected:
+	static constexpr int MODEL_NUM = MAX_POLYGON_MODELS - 1;
+	static constexpr float FIELD_SIZE = 1000.0f;
+
+	polymodel *_pm = nullptr;
+	bool _saved_bulk = false;
+	int _saved_game_mode = 0;
+	vec3d _saved_gravity;
+
+	void SetUp() override {
+		test::FSTestFixture::SetUp();
+
+		obj_init();
+		list_init(&Ship_obj_list);
+
+		// the asteroids only need the radius of their model
+		_pm = new polymodel();
+		_pm->id = MODEL_NUM;
+		_pm->rad = 10.0f;
+		Polygon_models[MODEL_NUM] = _pm;
+
+		asteroid_info debris;
+		strcpy_s(debris.name, "Test debris");
+		debris.max_speed = 100.0f;
+		debris.initial_asteroid_strength = 100.0f;
+		debris.subtypes.push_back({ "", MODEL_NUM, "" });
+		Asteroid_info.push_back(debris);
+
+		_saved_bulk = Bulk_asteroid_fields;
+		_saved_game_mode = Game_mode;
+		_saved_gravity = The_mission.gravity;
+
+		Bulk_asteroid_fields = true;
+		Game_mode = GM_NORMAL;
+		flFrametime = 0.1f;
+
+		// debris fields only wrap with gravity, which doesn't pull on debris with a gravity_const of 0
+		vm_vec_make(&The_mission.gravity, 0.0f, -10.0f, 0.0f);
+
+		// far enough away that the viewer never sees an asteroid wrap
+		vm_vec_make(&Eye_position, 0.0f, 0.0f, 100.0f * FIELD_SIZE);
+		Eye_matrix = vmd_identity_matrix;
+
+		asteroid_level_init();
+	}
+	void TearDown() override {
+		asteroid_level_close();
+		obj_delete_all();
+
+		Asteroid_info.clear();
+		Polygon_models[MODEL_NUM] = nullptr;
+		delete _pm;
+
+		Bulk_asteroid_fields = _saved_bulk;
+		Game_mode = _saved_game_mode;
+		The_mission.gravity = _saved_gravity;
+
+		test::FSTestFixture::TearDown();
+	}
+
+	static void create_field(int num_asteroids) {
+		vec3d o_min, o_max;
+		vm_vec_make(&o_min, -FIELD_SIZE, -FIELD_SIZE, -FIELD_SIZE);
+		vm_vec_make(&o_max, FIELD_SIZE, FIELD_SIZE, FIELD_SIZE);
+
+		// the field needs a valid inner box even if it doesn't use it
+		vm_vec_make(&Asteroid_field.inner_min_bound, -1.0f, -1.0f, -1.0f);
+		vm_vec_make(&Asteroid_field.inner_max_bound, 1.0f, 1.0f, 1.0f);
+
+		asteroid_create_debris_field(num_asteroids, 50, { 0 }, o_min, o_max, false);
+	}
+
+	static int make_waker(const vec3d *pos, float radius) {
+		int objnum = obj_create(OBJ_WEAPON, -1, -1, nullptr, pos, radius, flagset<Object::Object_Flags>());
+		EXPECT_GE(objnum, 0);
+		obj_merge_created_list();
+		return objnum;
+	}
+
+	static SCP_vector<object *> asteroid_objects() {
+		SCP_vector<object *> asteroids;
+
+		for (object *objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp)) {
+			if (objp->type == OBJ_ASTEROID && !objp->flags[Object::Object_Flags::Should_be_dead]) {
+				asteroids.push_back(objp);
+			}
+		}
+
+		return asteroids;
+	}
+};
+
+TEST_F(AsteroidDormantTest, fieldSizeIsCapped) {
+	ASSERT_EQ(MAX_DORMANT_ASTEROIDS, asteroid_max_field_asteroids());
+
+	Bulk_asteroid_fields = false;
+	ASSERT_EQ(MAX_ASTEROIDS, asteroid_max_field_asteroids());
+}
+
+TEST_F(AsteroidDormantTest, distantAsteroidsMoveAndWrapInBulk) {
+	const int NUM_ASTEROIDS = 500;
+
+	// nothing is close to the field, so none of the asteroids become objects
+	create_field(NUM_ASTEROIDS);
+	ASSERT_EQ(NUM_ASTEROIDS, asteroid_dormant_count());
+	ASSERT_EQ(0, asteroid_count());
+
+	SCP_vector<vec3d> pos(NUM_ASTEROIDS), vel(NUM_ASTEROIDS);
+	for (int i = 0; i < NUM_ASTEROIDS; ++i) {
+		asteroid_dormant_get(i, &pos[i], &vel[i]);
+	}
+
+	int num_wrapped = 0;
+
+	for (int frame = 0; frame < 200; ++frame) {
+		asteroid_frame();
+		ASSERT_EQ(NUM_ASTEROIDS, asteroid_dormant_count());
+
+		for (int i = 0; i < NUM_ASTEROIDS; ++i) {
+			vec3d expected;
+			vm_vec_scale_add(&expected, &pos[i], &vel[i], flFrametime);
+
+			// out one side of the field and back in the other
+			bool wrapped = false;
+			for (int axis = 0; axis < 3; ++axis) {
+				if (expected.a1d[axis] < -FIELD_SIZE) {
+					expected.a1d[axis] += 2.0f * FIELD_SIZE;
+					wrapped = true;
+				} else if (expected.a1d[axis] > FIELD_SIZE) {
+					expected.a1d[axis] -= 2.0f * FIELD_SIZE;
+					wrapped = true;
+				}
+			}
+			num_wrapped += wrapped;
+
+			vec3d new_vel;
+			asteroid_dormant_get(i, &pos[i], &new_vel);
+
+			ASSERT_NEAR(expected.xyz.x, pos[i].xyz.x, 0.01f) << "asteroid " << i << ", frame " << frame;
+			ASSERT_NEAR(expected.xyz.y, pos[i].xyz.y, 0.01f) << "asteroid " << i << ", frame " << frame;
+			ASSERT_NEAR(expected.xyz.z, pos[i].xyz.z, 0.01f) << "asteroid " << i << ", frame " << frame;
+			ASSERT_EQ(vel[i], new_vel);
+		}
+	}
+
+	ASSERT_GT(num_wrapped, 0);
+}
+
+TEST_F(AsteroidDormantTest, asteroidsWakeUpAndGoBackToSleep) {
+	const int NUM_ASTEROIDS = 200;
+
+	create_field(NUM_ASTEROIDS);
+	ASSERT_EQ(NUM_ASTEROIDS, asteroid_dormant_count());
+
+	vec3d pos, vel;
+	asteroid_dormant_get(0, &pos, &vel);
+
+	// something flies right up to the first asteroid
+	flFrametime = 0.0f;
+	int waker = make_waker(&pos, 10.0f);
+	asteroid_frame();
+
+	auto awake = asteroid_objects();
+	ASSERT_FALSE(awake.empty());
+	ASSERT_EQ(static_cast<int>(awake.size()), asteroid_count());
+	ASSERT_EQ(NUM_ASTEROIDS, asteroid_count() + asteroid_dormant_count());
+
+	auto first = std::find_if(awake.begin(), awake.end(), [&pos](const object *objp) { return vm_vec_same(&objp->pos, &pos); });
+	ASSERT_NE(awake.end(), first);
+	ASSERT_EQ(vel, (*first)->phys_info.vel);
+
+	// once it is gone again, they all go back to sleep where they were
+	Objects[waker].flags.set(Object::Object_Flags::Should_be_dead);
+	asteroid_frame();
+
+	SCP_vector<vec3d> awake_pos;
+	for (auto objp : awake) {
+		awake_pos.push_back(objp->pos);
+
+		Asteroids[objp->instance].check_for_wrap = TIMESTAMP::immediate();
+		asteroid_process_post(objp);
+		ASSERT_TRUE(objp->flags[Object::Object_Flags::Should_be_dead]);
+	}
+	obj_delete_all_that_should_be_dead();
+
+	ASSERT_EQ(0, asteroid_count());
+	ASSERT_EQ(NUM_ASTEROIDS, asteroid_dormant_count());
+
+	// the ones which went to sleep are at the end of the dormant asteroids
+	for (size_t i = 0; i < awake_pos.size(); ++i) {
+		asteroid_dormant_get(NUM_ASTEROIDS - static_cast<int>(awake_pos.size()) + static_cast<int>(i), &pos, &vel);
+		ASSERT_TRUE(vm_vec_same(&awake_pos[i], &pos));
+	}
+}
+
+TEST_F(AsteroidDormantTest, asteroidsStayAwakeForNewArrivals) {
+	const int NUM_ASTEROIDS = 200;
+
+	create_field(NUM_ASTEROIDS);
+
+	vec3d pos, vel;
+	asteroid_dormant_get(0, &pos, &vel);
+
+	flFrametime = 0.0f;
+	int waker = make_waker(&pos, 10.0f);
+	asteroid_frame();
+
+	auto awake = asteroid_objects();
+	ASSERT_FALSE(awake.empty());
+
+	// the first one leaves, and the next frame something else arrives in the same place before the asteroids move
+	Objects[waker].flags.set(Object::Object_Flags::Should_be_dead);
+	asteroid_frame();
+
+	make_waker(&pos, 10.0f);
+	asteroid_find_wakers();
+
+	for (auto objp : awake) {
+		Asteroids[objp->instance].check_for_wrap = TIMESTAMP::immediate();
+		asteroid_process_post(objp);
+		ASSERT_FALSE(objp->flags[Object::Object_Flags::Should_be_dead]);
+	}
+
+	ASSERT_EQ(static_cast<int>(awake.size()), asteroid_count());
+}
+
+TEST_F(AsteroidDormantTest, asteroidsWakeUpWhenOutOfSlots) {
+	const int NUM_ASTEROIDS = MAX_ASTEROIDS + 100;
+
+	create_field(NUM_ASTEROIDS);
+	ASSERT_EQ(NUM_ASTEROIDS, asteroid_dormant_count());
+
+	// something big enough to wake up the whole field uses up every asteroid slot
+	flFrametime = 0.0f;
+	int waker = make_waker(&vmd_zero_vector, 10.0f * FIELD_SIZE);
+	asteroid_frame();
+
+	ASSERT_EQ(MAX_ASTEROIDS, asteroid_count());
+	ASSERT_EQ(100, asteroid_dormant_count());
+
+	// then it shrinks to wake up a single dormant asteroid, and an asteroid object far from it has to make room
+	vec3d pos, vel;
+	asteroid_dormant_get(0, &pos, &vel);
+
+	Objects[waker].pos = pos;
+	Objects[waker].radius = 1.0f;
+	asteroid_frame();
+
+	ASSERT_EQ(MAX_ASTEROIDS - 1, static_cast<int>(asteroid_objects().size()));
+	ASSERT_EQ(101, asteroid_dormant_count());
+
+	// the slot is free once the object is gone, and the asteroid wakes up the next frame
+	obj_delete_all_that_should_be_dead();
+	asteroid_frame();
+
+	auto awake = asteroid_objects();
+	ASSERT_EQ(MAX_ASTEROIDS, static_cast<int>(awake.size()));
+	ASSERT_EQ(100, asteroid_dormant_count());
+	ASSERT_NE(awake.end(), std::find_if(awake.begin(), awake.end(), [&pos](const object *objp) { return vm_vec_same(&objp->pos, &pos); }));
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "bmpman/bm_internal.h"
+#include "bmpman/bmpman.h"
+#include "globalincs/systemvars.h"
+
+#include "util/FSTestFixture.h"
+
+class TextureBudgetTest : public test::FSTestFixture {
+ public:
+	TextureBudgetTest() : test::FSTestFixture(INIT_CFILE | INIT_GRAPHICS) {
+		addCommandlineArg("-texture_budget");
+		addCommandlineArg("1");
+	}
+
+ protected:
+	static constexpr size_t TEXTURE_SIZE = 400 * 1024;
+
+	int _standalone = 0;
+	SCP_vector<int> _handles;
+
+	void SetUp() override {
+		test::FSTestFixture::SetUp();
+
+		// standalone servers only ever load one placeholder bitmap
+		_standalone = Is_standalone;
+		Is_standalone = 0;
+
+		for (int i = 0; i < 3; ++i) {
+			_handles.push_back(bm_load_duplicate("attacker"));
+			ASSERT_GE(_handles.back(), 0);
+		}
+	}
+	void TearDown() override {
+		for (auto handle : _handles) {
+			bm_release(handle);
+		}
+
+		Is_standalone = _standalone;
+
+		test::FSTestFixture::TearDown();
+	}
+
+	// what the graphics API does when it uploads a texture, and then a few frames where it isn't used
+	void upload(int handle) {
+		bm_set_resident_size(handle, TEXTURE_SIZE);
+
+		for (int i = 0; i < 3; ++i) {
+			bm_end_frame();
+		}
+	}
+
+	static size_t resident_size(int handle) {
+		return bm_get_entry(handle)->resident_size;
+	}
+};
+
+TEST_F(TextureBudgetTest, evictsLeastRecentlyUsed) {
+	upload(_handles[0]);
+	upload(_handles[1]);
+	upload(_handles[2]);
+
+	// the third texture put the total over 1 MB, and the oldest one is enough to get back under it
+	ASSERT_EQ(0u, resident_size(_handles[0]));
+	ASSERT_EQ(TEXTURE_SIZE, resident_size(_handles[1]));
+	ASSERT_EQ(TEXTURE_SIZE, resident_size(_handles[2]));
+
+	// the bitmap itself stays loaded so that the texture can be made again
+	ASSERT_EQ(1, bm_is_valid(_handles[0]));
+}
+
+TEST_F(TextureBudgetTest, usageKeepsTexturesResident) {
+	upload(_handles[0]);
+	upload(_handles[1]);
+
+	bm_mark_used(_handles[0]);
+	upload(_handles[2]);
+
+	ASSERT_EQ(TEXTURE_SIZE, resident_size(_handles[0]));
+	ASSERT_EQ(0u, resident_size(_handles[1]));
+	ASSERT_EQ(TEXTURE_SIZE, resident_size(_handles[2]));
+}
+
+TEST_F(TextureBudgetTest, lockedTexturesStay) {
+	upload(_handles[0]);
+	upload(_handles[1]);
+
+	ASSERT_NE(nullptr, bm_lock(_handles[0], 32, BMP_TEX_OTHER));
+	upload(_handles[2]);
+	bm_unlock(_handles[0]);
+
+	ASSERT_EQ(TEXTURE_SIZE, resident_size(_handles[0]));
+	ASSERT_EQ(0u, resident_size(_handles[1]));
+	ASSERT_EQ(TEXTURE_SIZE, resident_size(_handles[2]));
+}
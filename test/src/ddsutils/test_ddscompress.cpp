@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include "ddsutils/ddsutils.h"
+
+#include "util/test_util.h"
+
+#include <cmath>
+#include <random>
+
+namespace {
+
+struct dds_format {
+	uint fourcc;
+	size_t block_size;
+	bool alpha;
+	double max_error;	// root mean square, per channel
+	const char* name;
+};
+
+const dds_format Formats[] = {
+	{FOURCC_DXT1, 8, false, 4.0, "BC1"},
+	{FOURCC_DXT5, 16, true, 4.0, "BC3"},
+	{FOURCC_DX10, 16, true, 3.0, "BC7"},
+};
+
+// pixels past the end of the surface that the blocks of small surfaces may write to
+const size_t PADDING = 4 * 4 * 4 * 4;
+
+// smooth gradients with a bit of noise on top, about what the textures of a model look like
+SCP_vector<ubyte> test_image(uint width, uint height, bool alpha, uint seed)
+{
+	std::mt19937 rng(seed);
+	SCP_vector<ubyte> pixels(width * height * 4);
+
+	for (uint y = 0; y < height; ++y) {
+		for (uint x = 0; x < width; ++x) {
+			auto pixel = &pixels[(y * width + x) * 4];
+			const int noise = static_cast<int>(rng() % 9) - 4;
+
+			pixel[0] = static_cast<ubyte>(128 + 100 * std::sin(x * 0.03) + noise);
+			pixel[1] = static_cast<ubyte>(128 + 100 * std::cos(y * 0.05) + noise);
+			pixel[2] = static_cast<ubyte>(128 + 100 * std::sin((x + y) * 0.02));
+			pixel[3] = alpha ? static_cast<ubyte>((x * 7 + y * 3) & 0xFF) : 255;
+		}
+	}
+
+	return pixels;
+}
+
+double rms_error(const SCP_vector<ubyte>& a, const SCP_vector<ubyte>& b, size_t count)
+{
+	double sum = 0.0;
+
+	for (size_t i = 0; i < count; ++i) {
+		const double d = static_cast<double>(a[i]) - static_cast<double>(b[i]);
+		sum += d * d;
+	}
+
+	return std::sqrt(sum / count);
+}
+
+} // namespace
+
+TEST(DDSCompressTest, roundTrip)
+{
+	const uint sizes[][2] = {{4, 4}, {64, 64}, {256, 32}, {8, 2}, {1, 1}};
+
+	for (const auto& format : Formats) {
+		for (const auto& size : sizes) {
+			const uint width = size[0];
+			const uint height = size[1];
+
+			auto image = test_image(width, height, format.alpha, width * 31 + height);
+
+			SCP_vector<ubyte> blocks(dds_compressed_size(format.fourcc, width, height, 1));
+			dds_compress(format.fourcc, image.data(), blocks.data(), width, height);
+
+			SCP_vector<ubyte> pixels(width * height * 4 + PADDING);
+			dds_decompress(format.fourcc, blocks.data(), pixels.data(), width, height);
+
+			ASSERT_LE(rms_error(image, pixels, image.size()), format.max_error) << format.name << " " << width << "x" << height;
+		}
+	}
+}
+
+TEST(DDSCompressTest, solidColors)
+{
+	const ubyte colors[][4] = {{0, 0, 0, 255}, {255, 255, 255, 255}, {10, 200, 30, 255}, {255, 0, 128, 0}};
+
+	for (const auto& format : Formats) {
+		for (const auto& color : colors) {
+			SCP_vector<ubyte> image(4 * 4 * 4);
+
+			for (size_t i = 0; i < image.size(); ++i) {
+				image[i] = color[i % 4];
+			}
+
+			if ( !format.alpha ) {
+				for (size_t i = 3; i < image.size(); i += 4) {
+					image[i] = 255;
+				}
+			}
+
+			SCP_vector<ubyte> blocks(format.block_size);
+			dds_compress(format.fourcc, image.data(), blocks.data(), 4, 4);
+
+			SCP_vector<ubyte> pixels(image.size());
+			dds_decompress(format.fourcc, blocks.data(), pixels.data(), 4, 4);
+
+			for (size_t i = 0; i < image.size(); ++i) {
+				ASSERT_NEAR(image[i], pixels[i], 4) << format.name << " channel " << (i % 4);
+			}
+		}
+	}
+}
+
+TEST(DDSCompressTest, opaqueBC1Blocks)
+{
+	const uint size = 64;
+	auto image = test_image(size, size, false, 3);
+
+	SCP_vector<ubyte> blocks(dds_compressed_size(FOURCC_DXT1, size, size, 1));
+	dds_compress(FOURCC_DXT1, image.data(), blocks.data(), size, size);
+
+	// the 3 color mode would make some pixels transparent, so blocks with different colors need c0 > c1
+	for (size_t i = 0; i < blocks.size(); i += 8) {
+		const ushort c0 = static_cast<ushort>(blocks[i] | (blocks[i + 1] << 8));
+		const ushort c1 = static_cast<ushort>(blocks[i + 2] | (blocks[i + 3] << 8));
+
+		ASSERT_TRUE(c0 > c1 || (c0 == c1 && blocks[i + 4] == 0 && blocks[i + 5] == 0 && blocks[i + 6] == 0 && blocks[i + 7] == 0));
+	}
+}
+
+TEST(DDSCompressTest, compressedSize)
+{
+	ASSERT_EQ(static_cast<size_t>(8), dds_compressed_size(FOURCC_DXT1, 4, 4, 1));
+	ASSERT_EQ(static_cast<size_t>(8), dds_compressed_size(FOURCC_DXT1, 1, 1, 1));
+	ASSERT_EQ(static_cast<size_t>(16 * 16 + 16 * 4 + 16 * 3), dds_compressed_size(FOURCC_DXT5, 16, 16, 5));
+	ASSERT_EQ(static_cast<size_t>((128 + 32 + 8 + 4 + 2 + 1 + 1 + 1) * 16), dds_compressed_size(FOURCC_DX10, 128, 16, 8));
+}
+
+TEST(DDSCompressTest, threadedCompressMatchesSerial)
+{
+	// big enough to be split into bands for the worker threads
+	const uint size = 1024;
+
+	for (const auto& format : Formats) {
+		auto image = test_image(size, size, format.alpha, 1);
+
+		SCP_vector<ubyte> serial(dds_compressed_size(format.fourcc, size, size, 1));
+		dds_compress(format.fourcc, image.data(), serial.data(), size, size);
+
+		SCP_vector<ubyte> threaded(serial.size());
+		{
+			test::ScopedTaskPool pool(4);
+			dds_compress(format.fourcc, image.data(), threaded.data(), size, size);
+		}
+
+		ASSERT_EQ(serial, threaded) << format.name;
+
+		SCP_vector<ubyte> pixels(size * size * 4);
+		dds_decompress(format.fourcc, threaded.data(), pixels.data(), size, size);
+
+		ASSERT_LE(rms_error(image, pixels, image.size()), format.max_error) << format.name;
+	}
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include "ddsutils/ddsutils.h"
+
+#include "util/test_util.h"
+
+#include <random>
+
+// the reference decoders, from the bcdec implementation in ddsutils.cpp
+extern "C" {
+void bcdec_bc1(const void* compressedBlock, void* decompressedBlock, int destinationPitch);
+void bcdec_bc2(const void* compressedBlock, void* decompressedBlock, int destinationPitch);
+void bcdec_bc3(const void* compressedBlock, void* decompressedBlock, int destinationPitch);
+void bcdec_bc7(const void* compressedBlock, void* decompressedBlock, int destinationPitch);
+}
+
+namespace {
+
+struct dds_format {
+	uint fourcc;
+	size_t block_size;
+	void (*reference)(const void*, void*, int);
+	const char* name;
+};
+
+const dds_format Formats[] = {
+	{FOURCC_DXT1, 8, bcdec_bc1, "BC1"},
+	{FOURCC_DXT3, 16, bcdec_bc2, "BC2"},
+	{FOURCC_DXT5, 16, bcdec_bc3, "BC3"},
+	{FOURCC_DX10, 16, bcdec_bc7, "BC7"},
+};
+
+// pixels past the end of the surface that the blocks of small surfaces may write to
+const size_t PADDING = 4 * 4 * 4 * 4;
+
+SCP_vector<ubyte> random_blocks(const dds_format& format, uint width, uint height, uint seed)
+{
+	std::mt19937 rng(seed);
+	SCP_vector<ubyte> blocks(((width + 3) / 4) * ((height + 3) / 4) * format.block_size);
+
+	for (auto& b : blocks) {
+		b = static_cast<ubyte>(rng());
+	}
+
+	return blocks;
+}
+
+// decompresses the way dds_read_bitmap used to, block by block through bcdec and then swizzled to BGRA
+SCP_vector<ubyte> reference_decompress(const dds_format& format, const SCP_vector<ubyte>& blocks, uint width, uint height)
+{
+	SCP_vector<ubyte> pixels(width * height * 4 + PADDING);
+	const ubyte* src = blocks.data();
+
+	for (uint i = 0; i < height; i += 4) {
+		for (uint j = 0; j < width; j += 4) {
+			format.reference(src, pixels.data() + (i * width + j) * 4, static_cast<int>(width * 4));
+			src += format.block_size;
+		}
+	}
+
+	for (size_t x = 0; x < width * height * 4; x += 4) {
+		std::swap(pixels[x], pixels[x + 2]);
+	}
+
+	pixels.resize(width * height * 4);
+	return pixels;
+}
+
+} // namespace
+
+TEST(DDSUtilsTest, decompressMatchesReference)
+{
+	const uint sizes[][2] = {{4, 4}, {64, 64}, {256, 32}, {8, 2}, {2, 2}, {1, 1}};
+
+	for (const auto& format : Formats) {
+		for (const auto& size : sizes) {
+			const uint width = size[0];
+			const uint height = size[1];
+
+			auto blocks = random_blocks(format, width, height, width * 31 + height);
+			auto expected = reference_decompress(format, blocks, width, height);
+
+			SCP_vector<ubyte> pixels(width * height * 4 + PADDING);
+			dds_decompress(format.fourcc, blocks.data(), pixels.data(), width, height);
+			pixels.resize(width * height * 4);
+
+			ASSERT_EQ(expected, pixels) << format.name << " " << width << "x" << height;
+		}
+	}
+}
+
+TEST(DDSUtilsTest, decompressVolume)
+{
+	const auto& format = Formats[0];
+	const uint width = 16, height = 8, depth = 3;
+
+	auto blocks = random_blocks(format, width, height * depth, 7);
+
+	SCP_vector<ubyte> pixels(width * height * depth * 4);
+	dds_decompress(format.fourcc, blocks.data(), pixels.data(), width, height, depth);
+
+	// the slices of a volume are laid out just like one surface that is depth times as high
+	ASSERT_EQ(reference_decompress(format, blocks, width, height * depth), pixels);
+}
+
+TEST(DDSUtilsTest, threadedDecompressMatchesReference)
+{
+	// large enough to be split up between the task pool
+	const uint size = 1024;
+
+	test::ScopedTaskPool pool(4);
+
+	for (const auto& format : Formats) {
+		auto blocks = random_blocks(format, size, size, 1);
+		SCP_vector<ubyte> pixels(size * size * 4);
+
+		dds_decompress(format.fourcc, blocks.data(), pixels.data(), size, size);
+
+		ASSERT_EQ(reference_decompress(format, blocks, size, size), pixels) << format.name;
+	}
+}
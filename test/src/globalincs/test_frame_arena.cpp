@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include "globalincs/memory/frame_arena.h"
+#include "globalincs/pstypes.h"
+
+TEST(FrameArenaTest, containers)
+{
+	memory::frame_arena_reset();
+
+	SCP_frame_vector<int> numbers;
+	for (int i = 0; i < 10000; ++i) {
+		numbers.push_back(i);
+	}
+
+	SCP_frame_map<int, double> values;
+	for (int i = 0; i < 1000; ++i) {
+		values.emplace(i, i * 0.5);
+	}
+
+	for (int i = 0; i < 10000; ++i) {
+		ASSERT_EQ(i, numbers[i]);
+	}
+	for (int i = 0; i < 1000; ++i) {
+		ASSERT_DOUBLE_EQ(i * 0.5, values[i]);
+	}
+
+	ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(&values[0]) % alignof(double));
+}
+
+TEST(FrameArenaTest, memoryIsReused)
+{
+	memory::frame_arena_reset();
+
+	// The first frame may need several chunks from the heap, the frames after that must fit into what the arena has
+	for (int frame = 0; frame < 3; ++frame) {
+		{
+			SCP_frame_vector<SCP_frame_vector<int>> lists(100);
+			for (auto& list : lists) {
+				list.resize(5000);
+			}
+		}
+
+		memory::frame_arena_reset();
+
+		const auto& stats = memory::frame_arena_last_frame_stats();
+		ASSERT_GE(stats.allocations, 101u);
+		ASSERT_GE(stats.bytes, 100u * 5000u * sizeof(int));
+
+		if (frame > 0) {
+			ASSERT_EQ(0u, stats.chunks);
+		}
+	}
+}
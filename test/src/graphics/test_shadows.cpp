@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include "graphics/shadows.h"
+#include "object/object.h"
+#include "render/3d.h"
+
+#include "util/FSTestFixture.h"
+#include "util/test_util.h"
+
+#include <random>
+
+class ShadowCullTest : public test::FSTestFixture {
+ public:
+	ShadowCullTest() : test::FSTestFixture(INIT_NONE) {
+	}
+
+ protected:
+	void SetUp() override {
+		test::FSTestFixture::SetUp();
+
+		obj_init();
+
+		vm_vec_zero(&Eye_position);
+
+		// nested boxes in front of the eye, like the cascades shadows_start_render() sets up
+		for (int i = 0; i < MAX_SHADOW_CASCADES; ++i) {
+			const float size = 500.0f * (1 << i);
+
+			vm_vec_make(&Shadow_frustums[i].min, -size, -size, -size);
+			vm_vec_make(&Shadow_frustums[i].max, size, size, size);
+		}
+	}
+	void TearDown() override {
+		// the casters were made out of points, which is what they have to be deleted as
+		for (int i = 0; i <= Highest_object_index; ++i) {
+			if (Objects[i].type != OBJ_NONE) {
+				Objects[i].type = OBJ_POINT;
+			}
+		}
+
+		obj_delete_all();
+
+		test::FSTestFixture::TearDown();
+	}
+
+	// a field of objects of different sizes reaching past the outer cascade, every other one of which casts a shadow
+	static void make_field(std::mt19937& rng, size_t num_objects) {
+		std::uniform_real_distribution<float> coord(-6000.0f, 6000.0f);
+		std::uniform_real_distribution<float> radius(1.0f, 200.0f);
+
+		for (size_t i = 0; i < num_objects; ++i) {
+			vec3d pos;
+			vm_vec_make(&pos, coord(rng), coord(rng), coord(rng));
+
+			int objnum = obj_create(OBJ_POINT, -1, static_cast<int>(i), nullptr, &pos, radius(rng), flagset<Object::Object_Flags>());
+			ASSERT_GE(objnum, 0);
+
+			if (i % 2 == 0) {
+				Objects[objnum].type = OBJ_RAW_POF;
+			}
+		}
+		obj_merge_created_list();
+	}
+};
+
+TEST_F(ShadowCullTest, matchesCheckingEachCascade) {
+	std::mt19937 rng(1234);
+	make_field(rng, 4000);
+
+	matrix light_matrix;
+	vec3d light_dir;
+	vm_vec_make(&light_dir, 0.3f, -0.8f, 0.5f);
+	vm_vector_2_matrix(&light_matrix, &light_dir, nullptr, nullptr);
+
+	SCP_vector<ubyte> serial;
+	shadows_cull_casters(&light_matrix, serial);
+
+	ASSERT_EQ(static_cast<size_t>(Highest_object_index + 1), serial.size());
+
+	for (int i = 0; i <= Highest_object_index; ++i) {
+		ubyte expected = 0;
+
+		if (Objects[i].type == OBJ_RAW_POF) {
+			for (int j = 0; j < MAX_SHADOW_CASCADES; ++j) {
+				if (shadows_obj_in_frustum(&Objects[i], &light_matrix, &Shadow_frustums[j].min, &Shadow_frustums[j].max)) {
+					expected |= (1 << j);
+				}
+			}
+		}
+
+		ASSERT_EQ(expected, serial[i]) << "object " << i;
+	}
+
+	SCP_vector<ubyte> threaded;
+	{
+		test::ScopedTaskPool pool(4);
+		shadows_cull_casters(&light_matrix, threaded);
+	}
+
+	ASSERT_EQ(serial, threaded);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include "lighting/lighting.h"
+#include "math/vecmat.h"
+
+#include <random>
+
+namespace {
+
+struct sphere {
+	vec3d pos;
+	float rad;
+};
+
+// lights and objects spread over a battle sized area, like a fight full of beams and explosions
+void make_scene(scene_lights& lights, SCP_vector<light>& all_lights, SCP_vector<sphere>& objects, size_t num_lights, size_t num_objects)
+{
+	std::mt19937 rng(1234);
+	std::uniform_real_distribution<float> coord(-5000.0f, 5000.0f);
+	std::uniform_real_distribution<float> light_radius(50.0f, 400.0f);
+	std::uniform_real_distribution<float> object_radius(5.0f, 300.0f);
+	std::uniform_real_distribution<float> tube_length(-1000.0f, 1000.0f);
+
+	light sun;
+	memset(&sun, 0, sizeof(sun));
+	sun.type = Light_Type::Directional;
+	vm_vec_make(&sun.vec, 0.0f, 0.0f, 1.0f);
+	lights.addLight(&sun);
+	all_lights.push_back(sun);
+
+	for (size_t i = 0; i < num_lights; ++i) {
+		light l;
+		memset(&l, 0, sizeof(l));
+
+		l.type = (i % 3 == 0) ? Light_Type::Tube : Light_Type::Point;
+		vm_vec_make(&l.vec, coord(rng), coord(rng), coord(rng));
+		vm_vec_make(&l.vec2, l.vec.xyz.x + tube_length(rng), l.vec.xyz.y + tube_length(rng), l.vec.xyz.z + tube_length(rng));
+		l.rada = l.radb = light_radius(rng);
+
+		// a few lights that reach across most of the scene
+		if (i % 50 == 0) {
+			l.radb *= 20.0f;
+		}
+
+		lights.addLight(&l);
+		all_lights.push_back(l);
+	}
+
+	for (size_t i = 0; i < num_objects; ++i) {
+		sphere s;
+		vm_vec_make(&s.pos, coord(rng), coord(rng), coord(rng));
+		s.rad = object_radius(rng);
+		objects.push_back(s);
+	}
+}
+
+size_t count_lights(const SCP_vector<light>& all_lights, const sphere& s)
+{
+	size_t count = 0;
+
+	for (const auto& l : all_lights) {
+		float dist_squared;
+
+		if (l.type == Light_Type::Point) {
+			dist_squared = vm_vec_dist_squared(&l.vec, &s.pos);
+		} else if (l.type == Light_Type::Tube) {
+			vec3d nearest;
+			vm_vec_dist_squared_to_line(&s.pos, &l.vec, &l.vec2, &nearest, &dist_squared);
+		} else {
+			continue;
+		}
+
+		if (dist_squared < (l.radb + s.rad) * (l.radb + s.rad)) {
+			++count;
+		}
+	}
+
+	return count;
+}
+
+} // namespace
+
+TEST(SceneLights, filter_matches_all_lights)
+{
+	for (size_t num_lights : {5, 100, 1000}) {
+		scene_lights lights;
+		SCP_vector<light> all_lights;
+		SCP_vector<sphere> objects;
+
+		make_scene(lights, all_lights, objects, num_lights, 200);
+
+		for (const auto& s : objects) {
+			lights.setLightFilter(&s.pos, s.rad);
+			auto info = lights.bufferLights();
+
+			ASSERT_EQ(count_lights(all_lights, s), info.num_lights) << num_lights << " lights";
+		}
+	}
+}
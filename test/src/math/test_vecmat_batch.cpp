@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include "math/vecmat.h"
+
+#include <random>
+
+namespace {
+
+// the counts are chosen to hit both the groups of four and the leftovers after them
+const size_t Counts[] = {1, 3, 4, 7, 8, 13, 64, 101};
+
+SCP_vector<vec3d> random_points(size_t count, uint seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+
+	SCP_vector<vec3d> points(count);
+	for (auto& point : points) {
+		point.xyz.x = dist(rng);
+		point.xyz.y = dist(rng);
+		point.xyz.z = dist(rng);
+	}
+
+	return points;
+}
+
+matrix random_orient(uint seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> dist(-PI, PI);
+
+	angles a;
+	a.p = dist(rng);
+	a.b = dist(rng);
+	a.h = dist(rng);
+
+	matrix m;
+	vm_angles_2_matrix(&m, &a);
+	return m;
+}
+
+void expect_vec_near(const vec3d& expected, const vec3d& actual)
+{
+	EXPECT_NEAR(expected.xyz.x, actual.xyz.x, 0.01f);
+	EXPECT_NEAR(expected.xyz.y, actual.xyz.y, 0.01f);
+	EXPECT_NEAR(expected.xyz.z, actual.xyz.z, 0.01f);
+}
+
+} // namespace
+
+TEST(VecmatBatchTest, unrotateAdd)
+{
+	const matrix m = random_orient(1);
+	const vec3d pos = random_points(1, 1).front();
+
+	for (auto count : Counts) {
+		auto points = random_points(count, static_cast<uint>(count));
+		SCP_vector<vec3d> transformed(count);
+
+		vm_vec_unrotate_add_n(transformed.data(), points.data(), count, &m, &pos);
+
+		for (size_t i = 0; i < count; ++i) {
+			vec3d expected;
+			vm_vec_unrotate(&expected, &points[i], &m);
+			expected += pos;
+
+			expect_vec_near(expected, transformed[i]);
+		}
+	}
+}
+
+TEST(VecmatBatchTest, unrotateAddInPlace)
+{
+	const matrix m = random_orient(2);
+	const vec3d pos = random_points(1, 2).front();
+
+	for (auto count : Counts) {
+		auto points = random_points(count, static_cast<uint>(count));
+		auto transformed = points;
+
+		vm_vec_unrotate_add_n(transformed.data(), transformed.data(), count, &m, &pos);
+
+		for (size_t i = 0; i < count; ++i) {
+			vec3d expected;
+			vm_vec_unrotate(&expected, &points[i], &m);
+			expected += pos;
+
+			expect_vec_near(expected, transformed[i]);
+		}
+	}
+}
@@ -98,4 +98,39 @@ TEST_F(SubmodelLocalizeTest, submodel_instance_localize_roundtrip_world) {
 	EXPECT_VECMAT_NEAR(global, (vec3d{ {{-1.0f, 4.0f, 1.0f}} }));
 	EXPECT_VECMAT_NEAR(roundtrip, local);
 	EXPECT_VECMAT_NEAR(roundtripMat, localMat);
-}
\ No newline at end of file
+}
+
+TEST_F(SubmodelLocalizeTest, submodel_instance_transform_cache) {
+
+	vec3d global;
+	vec3d local{ {{0.0f, 1.0f, 0.0f}} };
+
+	// the second call is answered from the cache
+	model_instance_local_to_global_point(&global, &local, pm, pmi, 2);
+	EXPECT_VECMAT_NEAR(global, (vec3d{ {{-1.0f, 1.0f, 1.0f}} }));
+	model_instance_local_to_global_point(&global, &local, pm, pmi, 2);
+	EXPECT_VECMAT_NEAR(global, (vec3d{ {{-1.0f, 1.0f, 1.0f}} }));
+
+	// moving a parent has to be picked up by its children
+	pmi->submodel[1].canonical_orient = vmd_identity_matrix;
+	submodel_instance_moved(&pmi->submodel[1]);
+
+	vec3d expected;
+	vm_vec_unrotate(&expected, &local, &pmi->submodel[2].canonical_orient);
+	expected += vec3d{ {{0.0f, 2.0f, 0.0f}} };
+
+	model_instance_local_to_global_point(&global, &local, pm, pmi, 2);
+	EXPECT_VECMAT_NEAR(global, expected);
+
+	vec3d roundtrip;
+	model_instance_global_to_local_point(&roundtrip, &global, pm, pmi, 2);
+	EXPECT_VECMAT_NEAR(roundtrip, local);
+
+	// as does a translation
+	pmi->submodel[2].canonical_offset = vec3d{ {{3.0f, 0.0f, 0.0f}} };
+	submodel_instance_moved(&pmi->submodel[2]);
+
+	expected += vec3d{ {{3.0f, 0.0f, 0.0f}} };
+	model_instance_local_to_global_point(&global, &local, pm, pmi, 2);
+	EXPECT_VECMAT_NEAR(global, expected);
+}
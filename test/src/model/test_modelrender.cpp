@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include "graphics/tmapper.h"
+#include "graphics/util/uniform_structs.h"
+#include "model/modelrender.h"
+
+#include "util/FSTestFixture.h"
+
+class ModelDrawListTest : public test::FSTestFixture {
+ public:
+	ModelDrawListTest() : test::FSTestFixture(INIT_CFILE | INIT_GRAPHICS) {
+	}
+
+ protected:
+	static constexpr int NUM_SUBMODELS = 3;
+
+	vertex_buffer _buffer;
+	indexed_vertex_source _vert_src;
+
+	void SetUp() override {
+		test::FSTestFixture::SetUp();
+
+		_buffer.flags = VB_FLAG_MODEL_ID;
+	}
+
+	// queues the draw of one object, like model_render_queue() does for a batched model
+	void queue_object(model_draw_list& scene, const model_material& mat, float x, uint tmap_flags = TMAP_FLAG_BATCH_TRANSFORMS) {
+		vec3d pos;
+		vm_vec_make(&pos, x, 0.0f, 100.0f);
+
+		scene.push_transform(&pos, &vmd_identity_matrix);
+
+		if (tmap_flags & TMAP_FLAG_BATCH_TRANSFORMS) {
+			scene.start_model_batch(NUM_SUBMODELS);
+
+			for (int i = 0; i < NUM_SUBMODELS; ++i) {
+				scene.add_submodel_to_batch(i);
+			}
+		}
+
+		scene.add_buffer_draw(&mat, &_vert_src, &_buffer, 0, tmap_flags);
+
+		scene.pop_transform();
+	}
+};
+
+TEST_F(ModelDrawListTest, identicalModelsAreInstanced) {
+	model_material mat;
+	model_draw_list scene;
+	scene.init();
+
+	for (int i = 0; i < 50; ++i) {
+		queue_object(scene, mat, i * 10.0f);
+	}
+
+	scene.init_render();
+	scene.render_all();
+
+	auto& stats = scene.get_stats();
+	ASSERT_EQ(50u, stats.queued_draws);
+	ASSERT_EQ(1u, stats.draw_calls);
+	ASSERT_EQ(1u, stats.instanced_draw_calls);
+	ASSERT_EQ(49 * sizeof(graphics::model_uniform_data), stats.uniform_bytes_saved);
+}
+
+TEST_F(ModelDrawListTest, differentMaterialsAreNotInstanced) {
+	model_material red, blue;
+	red.set_color(255, 0, 0, 255);
+	blue.set_color(0, 0, 255, 255);
+
+	model_draw_list scene;
+	scene.init();
+
+	for (int i = 0; i < 20; ++i) {
+		queue_object(scene, (i < 10) ? red : blue, i * 10.0f);
+	}
+
+	// the sort order doesn't tell the colors apart, so keep the order they were queued in
+	scene.init_render(false);
+	scene.render_all();
+
+	auto& stats = scene.get_stats();
+	ASSERT_EQ(20u, stats.queued_draws);
+	ASSERT_EQ(2u, stats.draw_calls);
+	ASSERT_EQ(2u, stats.instanced_draw_calls);
+	ASSERT_EQ(18 * sizeof(graphics::model_uniform_data), stats.uniform_bytes_saved);
+}
+
+TEST_F(ModelDrawListTest, unbatchedModelsAreNotInstanced) {
+	model_material mat;
+	model_draw_list scene;
+	scene.init();
+
+	for (int i = 0; i < 10; ++i) {
+		queue_object(scene, mat, i * 10.0f, 0);
+	}
+
+	scene.init_render();
+	scene.render_all();
+
+	auto& stats = scene.get_stats();
+	ASSERT_EQ(10u, stats.queued_draws);
+	ASSERT_EQ(10u, stats.draw_calls);
+	ASSERT_EQ(0u, stats.instanced_draw_calls);
+	ASSERT_EQ(0u, stats.uniform_bytes_saved);
+}
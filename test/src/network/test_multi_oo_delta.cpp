@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+#include <random>
+
+#include "math/vecmat.h"
+#include "network/multi_obj.h"
+#include "network/multiutil.h"
+
+namespace {
+
+// Size of the position and orientation section of an object update when sent in full.
+const int FULL_POS_ORIENT_SIZE = 16;
+
+struct simulated_ship {
+	vec3d pos;
+	angles angs;
+	vec3d vel;
+	angles rotvel;
+
+	oo_delta_history sent;		// the server's history for this ship
+	oo_delta_history received;	// the client's history for this ship
+};
+
+}
+
+TEST(MultiObjDeltaTests, roundTrip)
+{
+	std::mt19937 gen(1);
+	std::uniform_real_distribution<float> posDist(-60000.0f, 60000.0f);
+	std::uniform_real_distribution<float> moveDist(-300.0f, 300.0f);
+	std::uniform_real_distribution<float> angDist(-PI, PI);
+
+	for (int i = 0; i < 1000; ++i) {
+		vec3d base_pos;
+		vm_vec_make(&base_pos, posDist(gen), posDist(gen) / 2.0f, posDist(gen));
+		angles base_angs = { angDist(gen), angDist(gen), angDist(gen) };
+
+		vec3d pos;
+		vm_vec_make(&pos, base_pos.xyz.x + moveDist(gen), base_pos.xyz.y + moveDist(gen), base_pos.xyz.z + moveDist(gen));
+		angles angs = { angDist(gen), angDist(gen), angDist(gen) };
+
+		int base[OO_DELTA_COMPONENTS];
+		multi_quantize_position(&base_pos, base);
+		multi_quantize_orient(&base_angs, base + 3);
+
+		int quantized[OO_DELTA_COMPONENTS];
+		multi_quantize_position(&pos, quantized);
+		multi_quantize_orient(&angs, quantized + 3);
+
+		ubyte data[64];
+		int written = multi_pack_unpack_pos_orient_delta(1, data, base, quantized);
+		ASSERT_GT(written, 0);
+
+		int unpacked[OO_DELTA_COMPONENTS];
+		int read = multi_pack_unpack_pos_orient_delta(0, data, base, unpacked);
+		ASSERT_EQ(written, read);
+
+		for (int j = 0; j < OO_DELTA_COMPONENTS; ++j) {
+			ASSERT_EQ(quantized[j], unpacked[j]);
+		}
+
+		// a client without the baseline must still read exactly as much as was written
+		ASSERT_EQ(written, multi_pack_unpack_pos_orient_delta(0, data, nullptr, unpacked));
+	}
+}
+
+TEST(MultiObjDeltaTests, matchesFullPacker)
+{
+	vec3d pos;
+	vm_vec_make(&pos, 1234.5678f, -432.1f, 98765.4321f);
+	angles angs = { 0.25f, -1.5f, 3.0f };
+
+	ubyte data[64];
+	int quantized[OO_DELTA_COMPONENTS];
+	multi_pack_unpack_position(1, data, &pos, quantized);
+
+	vec3d unpacked_pos;
+	int unpacked[OO_DELTA_COMPONENTS];
+	multi_pack_unpack_position(0, data, &unpacked_pos, unpacked);
+
+	multi_pack_unpack_orient(1, data, &angs, quantized + 3);
+
+	angles unpacked_angs;
+	multi_pack_unpack_orient(0, data, &unpacked_angs, unpacked + 3);
+
+	int expected[OO_DELTA_COMPONENTS];
+	multi_quantize_position(&pos, expected);
+	multi_quantize_orient(&angs, expected + 3);
+
+	for (int j = 0; j < OO_DELTA_COMPONENTS; ++j) {
+		ASSERT_EQ(expected[j], quantized[j]);
+		ASSERT_EQ(expected[j], unpacked[j]);
+	}
+
+	vec3d dequantized_pos;
+	multi_dequantize_position(unpacked, &dequantized_pos);
+	ASSERT_EQ(unpacked_pos.xyz.x, dequantized_pos.xyz.x);
+	ASSERT_EQ(unpacked_pos.xyz.y, dequantized_pos.xyz.y);
+	ASSERT_EQ(unpacked_pos.xyz.z, dequantized_pos.xyz.z);
+}
+
+TEST(MultiObjDeltaTests, tooFarFallsBack)
+{
+	int base[OO_DELTA_COMPONENTS] = { 0, 0, 0, 0, 0, 0 };
+	int quantized[OO_DELTA_COMPONENTS] = { 20000 * 512, 0, 0, 0, 0, 0 };
+
+	ubyte data[64];
+	ASSERT_EQ(0, multi_pack_unpack_pos_orient_delta(1, data, base, quantized));
+}
+
+// Simulates one client watching a mix of dogfighting fighters and slow capital ships for a minute through the
+// real packers and baseline tracking, with the server sending updates at the rates multi_obj.cpp uses, the client
+// acknowledging 100ms later and 5% of the packets getting lost.
+TEST(MultiObjDeltaTests, bandwidthSimulation)
+{
+	const int NUM_FIGHTERS = 24;
+	const int NUM_CAPSHIPS = 8;
+	const int NUM_SHIPS = NUM_FIGHTERS + NUM_CAPSHIPS;
+	const int FRAME_MS = 16;
+	const int DURATION_MS = 60 * 1000;
+	const int ACK_DELAY_MS = 100;
+
+	std::mt19937 gen(26);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+
+	SCP_vector<simulated_ship> ships(NUM_SHIPS);
+	SCP_vector<int> send_interval(NUM_SHIPS);
+	SCP_vector<int> deltas_in_a_row(NUM_SHIPS, 0);
+	for (int i = 0; i < NUM_SHIPS; ++i) {
+		bool fighter = i < NUM_FIGHTERS;
+		float speed = fighter ? 75.0f : 8.0f;
+		float turn = fighter ? 1.2f : 0.05f;
+
+		vm_vec_make(&ships[i].pos, unit(gen) * 3000.0f, unit(gen) * 1000.0f, unit(gen) * 3000.0f);
+		ships[i].angs = { unit(gen) * PI, unit(gen) * PI, unit(gen) * PI };
+		vm_vec_make(&ships[i].vel, unit(gen) * speed, unit(gen) * speed, unit(gen) * speed);
+		ships[i].rotvel = { unit(gen) * turn, unit(gen) * turn, unit(gen) * turn };
+		multi_oo_delta_history_clear(&ships[i].sent);
+		multi_oo_delta_history_clear(&ships[i].received);
+
+		// near fighters at "high" object update level, capital ships at midrange
+		send_interval[i] = fighter ? 66 : 120;
+	}
+
+	// what the client has received, and what the server has heard about so far
+	ushort client_seq = 0;
+	uint client_mask = 0;
+	bool client_valid = false;
+
+	ushort acked_seq = 0;
+	uint acked_mask = 0;
+	bool ack_valid = false;
+
+	struct ack {
+		int arrival_time;
+		ushort seq;
+		uint mask;
+	};
+	SCP_vector<ack> acks_in_flight;
+
+	size_t full_bytes = 0;
+	size_t sent_bytes = 0;
+	int num_deltas = 0;
+	ushort packet_seq = 0;
+
+	for (int time = 0; time < DURATION_MS; time += FRAME_MS) {
+		// move everybody
+		float frametime = FRAME_MS / 1000.0f;
+		for (auto& ship : ships) {
+			vm_vec_scale_add2(&ship.pos, &ship.vel, frametime);
+			ship.angs.p = fmodf(ship.angs.p + ship.rotvel.p * frametime + PI, PI2) - PI;
+			ship.angs.b = fmodf(ship.angs.b + ship.rotvel.b * frametime + PI, PI2) - PI;
+			ship.angs.h = fmodf(ship.angs.h + ship.rotvel.h * frametime + PI, PI2) - PI;
+		}
+
+		// the server hears about acknowledgements after the round trip, and only keeps the newest
+		for (auto it = acks_in_flight.begin(); it != acks_in_flight.end();) {
+			if (it->arrival_time <= time) {
+				acked_seq = it->seq;
+				acked_mask = it->mask;
+				ack_valid = true;
+				it = acks_in_flight.erase(it);
+			} else {
+				++it;
+			}
+		}
+
+		// one packet per frame for this client
+		bool lost = chance(gen) < 0.05f;
+		if (!lost) {
+			multi_oo_record_seq(packet_seq, &client_seq, &client_mask, &client_valid);
+		}
+
+		for (int i = 0; i < NUM_SHIPS; ++i) {
+			auto& ship = ships[i];
+
+			if (time % send_interval[i] >= FRAME_MS) {
+				continue;
+			}
+
+			ubyte data[64];
+			bool delta;
+			int size = multi_oo_pack_pos_orient(data, &ship.sent, acked_seq, acked_mask, ack_valid, &ship.pos, &ship.angs, &delta);
+			multi_oo_delta_history_commit(&ship.sent, packet_seq);
+
+			full_bytes += FULL_POS_ORIENT_SIZE;
+			sent_bytes += size;
+
+			// a full update has to be forced regularly
+			if (delta) {
+				++num_deltas;
+				ASSERT_LT(deltas_in_a_row[i]++, OO_DELTA_MAX_IN_A_ROW);
+			} else {
+				ASSERT_EQ(FULL_POS_ORIENT_SIZE, size);
+				deltas_in_a_row[i] = 0;
+			}
+
+			if (lost) {
+				continue;
+			}
+
+			// since the server only uses acknowledged baselines, the client must always be able to decode the delta,
+			// and get exactly what a full update would have given it
+			vec3d pos;
+			angles angs;
+			bool valid;
+			ASSERT_EQ(size, multi_oo_unpack_pos_orient(data, delta, &ship.received, packet_seq, &pos, &angs, &valid));
+			ASSERT_TRUE(valid);
+
+			vec3d expected_pos;
+			angles expected_angs;
+			ubyte full_data[64];
+			int full_size = multi_pack_unpack_position(1, full_data, &ship.pos);
+			multi_pack_unpack_orient(1, full_data + full_size, &ship.angs);
+			full_size = multi_pack_unpack_position(0, full_data, &expected_pos);
+			multi_pack_unpack_orient(0, full_data + full_size, &expected_angs);
+
+			ASSERT_EQ(expected_pos.xyz.x, pos.xyz.x);
+			ASSERT_EQ(expected_pos.xyz.y, pos.xyz.y);
+			ASSERT_EQ(expected_pos.xyz.z, pos.xyz.z);
+			ASSERT_EQ(expected_angs.p, angs.p);
+			ASSERT_EQ(expected_angs.b, angs.b);
+			ASSERT_EQ(expected_angs.h, angs.h);
+		}
+
+		// the client acknowledges in its next control info, which can get lost too
+		if (client_valid && chance(gen) >= 0.05f) {
+			acks_in_flight.push_back({ time + ACK_DELAY_MS, client_seq, client_mask });
+		}
+		++packet_seq;
+	}
+
+	// most updates should be deltas, and they should save a good part of the position bandwidth
+	ASSERT_GT(num_deltas, 0);
+	ASSERT_LT(sent_bytes, full_bytes * 9 / 10);
+}
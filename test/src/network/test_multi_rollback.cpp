@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "io/timer.h"
+#include "network/multi_obj.h"
+
+namespace {
+
+// starts frames 0 .. count - 1 at the given times
+void add_frames(rollback_time_index* index, const int* starts, int count)
+{
+	multi_rollback_time_index_reset(index, 0, TIMESTAMP(starts[0]));
+
+	for (int i = 1; i < count; ++i) {
+		multi_rollback_time_index_add(index, i, TIMESTAMP(starts[i]));
+	}
+}
+
+int find(const rollback_time_index* index, int time)
+{
+	return multi_rollback_time_index_find(index, TIMESTAMP(time));
+}
+
+}
+
+TEST(MultiRollbackTests, frameBoundaries)
+{
+	// crosses a wrap of the index, and has a frame that took no time at all
+	const int starts[] = { ROLLBACK_TIME_INDEX_SIZE - 20, ROLLBACK_TIME_INDEX_SIZE - 4, ROLLBACK_TIME_INDEX_SIZE + 13, ROLLBACK_TIME_INDEX_SIZE + 13, ROLLBACK_TIME_INDEX_SIZE + 30 };
+	auto index = std::unique_ptr<rollback_time_index>(new rollback_time_index);
+	add_frames(index.get(), starts, 5);
+
+	// before the first frame
+	ASSERT_EQ(-1, find(index.get(), starts[0] - 1));
+
+	// the first and last millisecond of each finished frame
+	ASSERT_EQ(0, find(index.get(), starts[0]));
+	ASSERT_EQ(0, find(index.get(), starts[1] - 1));
+	ASSERT_EQ(1, find(index.get(), starts[1]));
+	ASSERT_EQ(1, find(index.get(), ROLLBACK_TIME_INDEX_SIZE - 1));
+	ASSERT_EQ(1, find(index.get(), ROLLBACK_TIME_INDEX_SIZE));
+	ASSERT_EQ(1, find(index.get(), starts[2] - 1));
+
+	// frame 2 took no time, so its start belongs to frame 3
+	ASSERT_EQ(3, find(index.get(), starts[2]));
+	ASSERT_EQ(3, find(index.get(), starts[4] - 1));
+
+	// the frame that is still running, and the future
+	ASSERT_EQ(-1, find(index.get(), starts[4]));
+	ASSERT_EQ(-1, find(index.get(), starts[4] + 100));
+}
+
+TEST(MultiRollbackTests, forgetsOldFrames)
+{
+	const int starts[] = { 1000, 1016, 1016 + ROLLBACK_TIME_INDEX_SIZE, 1032 + ROLLBACK_TIME_INDEX_SIZE };
+	auto index = std::unique_ptr<rollback_time_index>(new rollback_time_index);
+	add_frames(index.get(), starts, 4);
+
+	// frame 1 ran so long that frame 0 is out of reach, along with the start of frame 1
+	ASSERT_EQ(-1, find(index.get(), starts[0]));
+	ASSERT_EQ(-1, find(index.get(), starts[3] - ROLLBACK_TIME_INDEX_SIZE - 1));
+	ASSERT_EQ(1, find(index.get(), starts[3] - ROLLBACK_TIME_INDEX_SIZE));
+	ASSERT_EQ(1, find(index.get(), starts[2] - 1));
+	ASSERT_EQ(2, find(index.get(), starts[2]));
+	ASSERT_EQ(2, find(index.get(), starts[3] - 1));
+}
+
+TEST(MultiRollbackTests, resetForgetsEverything)
+{
+	const int starts[] = { 500, 516, 532 };
+	auto index = std::unique_ptr<rollback_time_index>(new rollback_time_index);
+	add_frames(index.get(), starts, 3);
+
+	multi_rollback_time_index_reset(index.get(), 0, TIMESTAMP(600));
+	multi_rollback_time_index_add(index.get(), 1, TIMESTAMP(616));
+
+	ASSERT_EQ(-1, find(index.get(), 510));
+	ASSERT_EQ(0, find(index.get(), 600));
+	ASSERT_EQ(0, find(index.get(), 615));
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include "globalincs/linklist.h"
+#include "object/object.h"
+#include "object/objectgrid.h"
+
+#include "util/FSTestFixture.h"
+
+#include <algorithm>
+#include <random>
+
+class ObjectGridTest : public test::FSTestFixture {
+ public:
+	ObjectGridTest() : test::FSTestFixture(INIT_NONE) {
+	}
+
+ protected:
+	void SetUp() override {
+		test::FSTestFixture::SetUp();
+
+		obj_init();
+	}
+	void TearDown() override {
+		obj_grid_end();
+		obj_delete_all();
+
+		test::FSTestFixture::TearDown();
+	}
+
+	// a dense field of points of different sizes, like the fighters and bombs of a big battle
+	static void make_field(std::mt19937& rng, size_t num_objects, float field_size) {
+		std::uniform_real_distribution<float> coord(-field_size, field_size);
+		std::uniform_real_distribution<float> radius(1.0f, 50.0f);
+
+		for (size_t i = 0; i < num_objects; ++i) {
+			vec3d pos;
+			vm_vec_make(&pos, coord(rng), coord(rng), coord(rng));
+
+			ASSERT_GE(obj_create(OBJ_POINT, -1, static_cast<int>(i), nullptr, &pos, radius(rng), flagset<Object::Object_Flags>()), 0);
+		}
+		obj_merge_created_list();
+	}
+
+	static SCP_vector<vec3d> make_centers(std::mt19937& rng, size_t num_centers, float field_size) {
+		std::uniform_real_distribution<float> coord(-field_size, field_size);
+		SCP_vector<vec3d> centers(num_centers);
+
+		for (auto& center : centers) {
+			vm_vec_make(&center, coord(rng), coord(rng), coord(rng));
+		}
+
+		return centers;
+	}
+};
+
+TEST_F(ObjectGridTest, matchesLookingAtEveryObject) {
+	std::mt19937 rng(1234);
+	make_field(rng, 2000, 5000.0f);
+
+	auto centers = make_centers(rng, 100, 6000.0f);
+	const float radii[] = { 0.0f, 10.0f, 250.0f, 1000.0f, 20000.0f };
+
+	SCP_frame_vector<int> expected, found;
+
+	for (float radius : radii) {
+		for (const auto& center : centers) {
+			obj_find_in_sphere(expected, &center, radius, OBJ_GRID_TYPE(OBJ_POINT));
+
+			obj_grid_begin(OBJ_GRID_TYPE(OBJ_POINT));
+			obj_find_in_sphere(found, &center, radius, OBJ_GRID_TYPE(OBJ_POINT));
+			obj_grid_end();
+
+			ASSERT_EQ(expected, found);
+		}
+	}
+}
+
+TEST_F(ObjectGridTest, onlyFindsRequestedTypes) {
+	std::mt19937 rng(42);
+	make_field(rng, 100, 100.0f);
+
+	vec3d center = vmd_zero_vector;
+	SCP_frame_vector<int> found;
+
+	obj_grid_begin(OBJ_GRID_TYPE(OBJ_POINT));
+
+	obj_find_in_sphere(found, &center, 1000.0f, OBJ_GRID_TYPE(OBJ_POINT));
+	ASSERT_EQ(100u, found.size());
+
+	obj_find_in_sphere(found, &center, 1000.0f, OBJ_GRID_TYPE(OBJ_SHIP));
+	ASSERT_TRUE(found.empty());
+
+	obj_grid_end();
+}
+
+TEST_F(ObjectGridTest, cullingKeepsEveryObjectInFront) {
+	std::mt19937 rng(4321);
+	make_field(rng, 2000, 5000.0f);
+
+	std::uniform_real_distribution<float> coord(-1.0f, 1.0f);
+	SCP_frame_vector<int> found;
+
+	for (int i = 0; i < 50; ++i) {
+		// everything behind a plane through the middle of the field is culled
+		vec3d normal;
+		vm_vec_make(&normal, coord(rng), coord(rng), coord(rng));
+		vm_vec_normalize_safe(&normal);
+
+		auto box_outside = [&](const vec3d *bmin, const vec3d *bmax) {
+			vec3d nearest;
+			for (int axis = 0; axis < 3; ++axis) {
+				nearest.a1d[axis] = (normal.a1d[axis] > 0.0f) ? bmax->a1d[axis] : bmin->a1d[axis];
+			}
+			return vm_vec_dot(&nearest, &normal) < 0.0f;
+		};
+
+		obj_grid_begin(OBJ_GRID_TYPE(OBJ_POINT));
+		obj_grid_find_unculled(found, box_outside);
+		obj_grid_end();
+
+		ASSERT_LT(found.size(), 2000u);
+
+		SCP_vector<bool> unculled(Objects.size(), false);
+		for (int objnum : found) {
+			unculled[objnum] = true;
+		}
+
+		for (object *objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp)) {
+			if (vm_vec_dot(&objp->pos, &normal) + objp->radius >= 0.0f) {
+				ASSERT_TRUE(unculled[OBJ_INDEX(objp)]);
+			}
+		}
+	}
+}
+
+TEST_F(ObjectGridTest, keepsTheOrderOfTheUsedList) {
+	std::mt19937 rng(5678);
+	make_field(rng, 1000, 2000.0f);
+
+	// move every third object to the end of the list, so that the list isn't in object number order anymore
+	SCP_vector<object *> moved;
+	int i = 0;
+	for (object *objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp)) {
+		if (i++ % 3 == 0) {
+			moved.push_back(objp);
+		}
+	}
+	for (auto objp : moved) {
+		list_remove(&obj_used_list, objp);
+		list_append(&obj_used_list, objp);
+	}
+
+	SCP_vector<uint> order(Objects.size(), 0);
+	uint rank = 0;
+	for (object *objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp)) {
+		order[OBJ_INDEX(objp)] = rank++;
+	}
+	auto by_list_order = [&order](int a, int b) { return order[a] < order[b]; };
+
+	auto centers = make_centers(rng, 50, 2000.0f);
+	SCP_frame_vector<int> expected, found;
+
+	obj_grid_begin(OBJ_GRID_TYPE(OBJ_POINT));
+
+	for (const auto& center : centers) {
+		obj_find_in_sphere(found, &center, 500.0f, OBJ_GRID_TYPE(OBJ_POINT));
+		ASSERT_TRUE(std::is_sorted(found.begin(), found.end(), by_list_order));
+	}
+
+	// keep everything on one side of a plane, which is split over many blocks of cells
+	obj_grid_find_unculled(found, [](const vec3d *bmin, const vec3d *) { return bmin->xyz.x > 0.0f; });
+	ASSERT_FALSE(found.empty());
+	ASSERT_TRUE(std::is_sorted(found.begin(), found.end(), by_list_order));
+	ASSERT_FALSE(std::is_sorted(found.begin(), found.end()));
+
+	obj_grid_end();
+
+	// and the same as looking at every object without a grid
+	for (const auto& center : centers) {
+		obj_find_in_sphere(expected, &center, 500.0f, OBJ_GRID_TYPE(OBJ_POINT));
+
+		obj_grid_begin(OBJ_GRID_TYPE(OBJ_POINT));
+		obj_find_in_sphere(found, &center, 500.0f, OBJ_GRID_TYPE(OBJ_POINT));
+		obj_grid_end();
+
+		ASSERT_EQ(expected, found);
+	}
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "object/object.h"
+
+#include "util/FSTestFixture.h"
+
+class ObjectPoolTest : public test::FSTestFixture {
+ public:
+	ObjectPoolTest() : test::FSTestFixture(INIT_NONE) {
+	}
+
+ protected:
+	void SetUp() override {
+		test::FSTestFixture::SetUp();
+
+		obj_init();
+	}
+	void TearDown() override {
+		obj_delete_all();
+
+		test::FSTestFixture::TearDown();
+	}
+
+	static int create_point(int instance) {
+		vec3d pos;
+		vm_vec_make(&pos, static_cast<float>(instance), 0.0f, 0.0f);
+
+		return obj_create(OBJ_POINT, -1, instance, nullptr, &pos, 1.0f, flagset<Object::Object_Flags>());
+	}
+};
+
+TEST_F(ObjectPoolTest, growsPastTheOldLimit) {
+	const int NUM_OBJECTS = 20000;
+	SCP_vector<int> objnums;
+
+	for (int i = 0; i < NUM_OBJECTS; ++i) {
+		objnums.push_back(create_point(i));
+		ASSERT_GE(objnums.back(), 0);
+	}
+	obj_merge_created_list();
+
+	ASSERT_EQ(NUM_OBJECTS, Num_objects);
+	ASSERT_GE(Objects.size(), static_cast<size_t>(NUM_OBJECTS));
+
+	// nothing had to be culled to make room
+	for (int i = 0; i < NUM_OBJECTS; ++i) {
+		auto objp = &Objects[objnums[i]];
+
+		ASSERT_EQ(OBJ_POINT, objp->type);
+		ASSERT_EQ(i, objp->instance);
+		ASSERT_EQ(objnums[i], OBJ_INDEX(objp));
+	}
+}
+
+TEST_F(ObjectPoolTest, growingKeepsObjectsInPlace) {
+	int objnum = create_point(0);
+	ASSERT_GE(objnum, 0);
+
+	object* objp = &Objects[objnum];
+	object_h handle(objp);
+
+	// enough to need a few more chunks
+	for (size_t i = 0; i < 3 * OBJECT_CHUNK_SIZE; ++i) {
+		ASSERT_GE(create_point(1), 0);
+	}
+
+	ASSERT_TRUE(handle.isValid());
+	ASSERT_EQ(objp, handle.objp());
+	ASSERT_EQ(objnum, OBJ_INDEX(objp));
+
+	// once the slot is reused the old handle must not find the new object
+	obj_delete(objnum);
+	ASSERT_FALSE(handle.isValid());
+
+	int reused = create_point(2);
+	ASSERT_EQ(objnum, reused);
+	ASSERT_FALSE(handle.isValid());
+}
+
+TEST_F(ObjectPoolTest, nullObjectHasNoIndex) {
+	ASSERT_EQ(-1, OBJ_INDEX(static_cast<object*>(nullptr)));
+}
@@ -0,0 +1,77 @@
+#include "object/object.h"
+#include "scripting/global_hooks.h"
+
+#include "scripting/ScriptingTestFixture.h"
+
+namespace {
+
+class HookDispatchTest : public test::scripting::ScriptingTestFixture {
+  public:
+	HookDispatchTest() : test::scripting::ScriptingTestFixture(INIT_CFILE) {}
+
+  protected:
+	static constexpr int NUM_TYPES = 8;
+
+	// adds one action per object type condition, plus one action without any conditions every tenth action
+	void addActions(int num_actions)
+	{
+		const auto& conditions = ::scripting::hooks::OnObjectRender->_conditions;
+		const auto& objectType = conditions.at("Object type");
+
+		for (int i = 0; i < num_actions; ++i) {
+			script_action action;
+			if (i % 10 != 0) {
+				action.local_conditions.emplace_back(objectType->parse(Object_type_names[i % NUM_TYPES]));
+			}
+			_state->AddConditionedHook(::scripting::hooks::OnObjectRender->getHookId(), std::move(action));
+		}
+		_state->ProcessAddedHooks();
+	}
+
+	int runFor(int objtype)
+	{
+		object obj;
+		obj.type = objtype;
+
+		::scripting::hooks::ObjectDrawConditions conditions{&obj};
+		return _state->RunCondition(::scripting::hooks::OnObjectRender->getHookId(), std::any(static_cast<const ::scripting::hooks::ObjectDrawConditions*>(&conditions)));
+	}
+};
+
+} // namespace
+
+TEST_F(HookDispatchTest, indexedConditions)
+{
+	addActions(100);
+
+	for (int type = 0; type < NUM_TYPES; ++type) {
+		int expected = 0;
+		for (int i = 0; i < 100; ++i) {
+			if (i % 10 == 0 || i % NUM_TYPES == type) {
+				++expected;
+			}
+		}
+
+		ASSERT_EQ(expected, runFor(type)) << "Object type " << Object_type_names[type];
+	}
+}
+
+TEST_F(HookDispatchTest, actionsAddedLaterAreIndexed)
+{
+	// the index is rebuilt whenever hooks are added, so the second batch has to show up alongside the first
+	addActions(40);
+	addActions(60);
+
+	for (int type = 0; type < NUM_TYPES; ++type) {
+		int expected = 0;
+		for (int num_actions : {40, 60}) {
+			for (int i = 0; i < num_actions; ++i) {
+				if (i % 10 == 0 || i % NUM_TYPES == type) {
+					++expected;
+				}
+			}
+		}
+
+		ASSERT_EQ(expected, runFor(type)) << "Object type " << Object_type_names[type];
+	}
+}
@@ -13,22 +13,42 @@ add_file_folder("Actions\\\\Expression"
 	actions/expression/test_ExpressionParser.cpp
 )
 
+add_file_folder("Asteroid"
+    asteroid/test_asteroid_dormant.cpp
+)
+
+add_file_folder("Bmpman"
+    bmpman/test_texture_budget.cpp
+)
+
 add_file_folder("CFile"
     cfile/cfile.cpp
 )
 
+add_file_folder("DDSUtils"
+    ddsutils/test_ddscompress.cpp
+    ddsutils/test_ddsutils.cpp
+)
+
 add_file_folder("Globalincs"
     globalincs/test_flagset.cpp
+    globalincs/test_frame_arena.cpp
     globalincs/test_safe_strings.cpp
     globalincs/test_version.cpp
 )
 
 add_file_folder("Graphics"
 	   graphics/test_font.cpp
+	   graphics/test_shadows.cpp
+)
+
+add_file_folder("Lighting"
+    lighting/test_scene_lights.cpp
 )
 
 add_file_folder("Math"
     math/test_vecmat.cpp
+    math/test_vecmat_batch.cpp
 )
 
 add_file_folder("menuui"
@@ -41,6 +61,17 @@ add_file_folder("mod"
 
 add_file_folder("model"
     model/test_modelread.cpp
+    model/test_modelrender.cpp
+)
+
+add_file_folder("Network"
+    network/test_multi_oo_delta.cpp
+    network/test_multi_rollback.cpp
+)
+
+add_file_folder("Object"
+    object/test_object_grid.cpp
+    object/test_object_pool.cpp
 )
 
 add_file_folder("Parse"
@@ -55,6 +86,7 @@ add_file_folder("Pilotfile"
 add_file_folder("Scripting"
     scripting/ade_args.cpp
     scripting/doc_parser.cpp
+    scripting/hook_dispatch.cpp
     scripting/require.cpp
     scripting/script_state.cpp
     scripting/ScriptingTestFixture.h
@@ -88,9 +120,13 @@ add_file_folder("Test Util"
 )
 
 add_file_folder("Utils"
+    utils/ChunkedPoolTest.cpp
+    utils/FlatHashMapTest.cpp
     utils/HeapAllocatorTest.cpp
+    utils/ThreadingTest.cpp
 )
 
 add_file_folder("Weapon"
+    weapon/test_beam_collide.cpp
     weapon/weapons.cpp
 )
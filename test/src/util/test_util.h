@@ -6,6 +6,10 @@
 
 #include <gtest/gtest.h>
 
+#include "globalincs/pstypes.h"
+#include "cmdline/cmdline.h"
+#include "utils/threading.h"
+
 // This macro skips the following test if we are not in debug mode
 // useful for things like parsing tests where there are no warnings in release mode
 #ifdef NDEBUG
@@ -15,4 +19,28 @@
 #define DEBUG_TEST() do {  } while (false)
 #endif
 
+namespace test {
+
+// Runs the task pool with the given number of threads, the calling thread included, for as long as it lives.
+// Lets a test check that threaded code gets the same results as it does on one thread.
+class ScopedTaskPool {
+	int _old_multithreading;
+
+ public:
+	explicit ScopedTaskPool(int threads) : _old_multithreading(Cmdline_multithreading) {
+		Cmdline_multithreading = threads;
+		threading::init_task_pool();
+	}
+
+	~ScopedTaskPool() {
+		threading::shut_down_task_pool();
+		Cmdline_multithreading = _old_multithreading;
+	}
+
+	ScopedTaskPool(const ScopedTaskPool&) = delete;
+	ScopedTaskPool& operator=(const ScopedTaskPool&) = delete;
+};
+
+}
+
 #endif //FS2_OPEN_TEST_UTIL_H
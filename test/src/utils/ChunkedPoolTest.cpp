@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include "utils/ChunkedPool.h"
+
+using namespace util;
+
+namespace {
+struct element {
+	int value;
+	float* pointer;
+};
+}
+
+TEST(ChunkedPoolTests, growByChunks) {
+	ChunkedPool<int, 64, 16> pool;
+
+	ASSERT_EQ((size_t)0, pool.size());
+	ASSERT_EQ(pool.begin(), pool.end());
+
+	for (size_t i = 1; i <= 4; ++i) {
+		ASSERT_EQ((size_t)16, pool.grow());
+		ASSERT_EQ(i * 16, pool.size());
+	}
+
+	// it can't get any larger than the maximum
+	ASSERT_EQ((size_t)0, pool.grow());
+	ASSERT_EQ((size_t)64, pool.size());
+}
+
+TEST(ChunkedPoolTests, newElementsAreZeroed) {
+	ChunkedPool<element, 64, 16> pool;
+	pool.grow();
+
+	for (auto& e : pool) {
+		ASSERT_EQ(0, e.value);
+		ASSERT_EQ(nullptr, e.pointer);
+	}
+}
+
+TEST(ChunkedPoolTests, elementsDontMove) {
+	ChunkedPool<int, 1024, 16> pool;
+	pool.grow();
+
+	SCP_vector<int*> addresses;
+	for (size_t i = 0; i < pool.size(); ++i) {
+		pool[i] = static_cast<int>(i);
+		addresses.push_back(&pool[i]);
+	}
+
+	while (pool.grow() > 0) {
+	}
+
+	for (size_t i = 0; i < addresses.size(); ++i) {
+		ASSERT_EQ(addresses[i], &pool[i]);
+		ASSERT_EQ(static_cast<int>(i), pool[i]);
+	}
+}
+
+TEST(ChunkedPoolTests, iteratesInIndexOrder) {
+	ChunkedPool<int, 64, 16> pool;
+	pool.grow();
+	pool.grow();
+
+	for (size_t i = 0; i < pool.size(); ++i) {
+		pool[i] = static_cast<int>(i) * 3;
+	}
+
+	int expected = 0;
+	for (auto value : pool) {
+		ASSERT_EQ(expected, value);
+		expected += 3;
+	}
+	ASSERT_EQ(static_cast<int>(pool.size()) * 3, expected);
+
+	const auto& const_pool = pool;
+	ASSERT_EQ(0, *const_pool.begin());
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+
+#include "utils/FlatHashMap.h"
+
+using namespace util;
+
+namespace {
+// the same packing of two object numbers as the collision pair cache
+uint32_t pair_key(uint32_t a, uint32_t b)
+{
+	return (a << 16) + b;
+}
+
+// every object paired with a few of its neighbours, as sorting the colliders along an axis would
+SCP_vector<uint32_t> neighbour_pairs(uint32_t num_objects, uint32_t neighbours)
+{
+	SCP_vector<uint32_t> keys;
+
+	for (uint32_t a = 0; a < num_objects; ++a) {
+		for (uint32_t n = 1; n <= neighbours; ++n) {
+			keys.push_back(pair_key(a, (a + n) % num_objects));
+		}
+	}
+
+	return keys;
+}
+}
+
+TEST(FlatHashMapTests, insertAndFind) {
+	FlatHashMap<int> map;
+
+	ASSERT_TRUE(map.empty());
+	ASSERT_EQ(nullptr, map.find(5));
+
+	map[5] = 50;
+	map[pair_key(3, 7)] = 37;
+
+	ASSERT_EQ((size_t)2, map.size());
+	ASSERT_EQ(50, *map.find(5));
+	ASSERT_EQ(37, *map.find(pair_key(3, 7)));
+	ASSERT_EQ(nullptr, map.find(pair_key(7, 3)));
+
+	// looking up with [] doesn't add another entry
+	map[5] += 1;
+	ASSERT_EQ((size_t)2, map.size());
+	ASSERT_EQ(51, *map.find(5));
+
+	ASSERT_TRUE(map.erase(5));
+	ASSERT_FALSE(map.erase(5));
+	ASSERT_EQ(nullptr, map.find(5));
+	ASSERT_EQ((size_t)1, map.size());
+
+	map.clear();
+	ASSERT_TRUE(map.empty());
+	ASSERT_EQ(nullptr, map.find(pair_key(3, 7)));
+}
+
+TEST(FlatHashMapTests, matchesUnorderedMap) {
+	FlatHashMap<uint32_t> map;
+	SCP_unordered_map<uint32_t, uint32_t> reference;
+
+	std::mt19937 gen(1234);
+	// a small key range, so that the probe sequences overlap a lot and erasing has to move entries around
+	std::uniform_int_distribution<uint32_t> keyDist(0, 2000);
+
+	for (int i = 0; i < 100000; ++i) {
+		auto key = keyDist(gen);
+
+		if (gen() % 3 == 0) {
+			ASSERT_EQ(reference.erase(key) > 0, map.erase(key));
+		} else {
+			map[key] = key * 3;
+			reference[key] = key * 3;
+		}
+	}
+
+	ASSERT_EQ(reference.size(), map.size());
+
+	for (uint32_t key = 0; key <= 2000; ++key) {
+		auto value = map.find(key);
+
+		if (reference.count(key)) {
+			ASSERT_NE(nullptr, value);
+			ASSERT_EQ(reference[key], *value);
+		} else {
+			ASSERT_EQ(nullptr, value);
+		}
+	}
+}
+
+TEST(FlatHashMapTests, eraseIfVisitsEachOnce) {
+	FlatHashMap<int> map;
+
+	for (uint32_t i = 0; i < 1000; ++i) {
+		map[i * 7] = 0;
+	}
+
+	// remove every other entry while marking the ones that stay
+	auto removed = map.eraseIf([](uint32_t key, int& visits) {
+		++visits;
+		return key % 2 == 0;
+	});
+
+	ASSERT_EQ((size_t)500, removed);
+	ASSERT_EQ((size_t)500, map.size());
+
+	size_t seen = 0;
+	map.forEach([&seen](uint32_t key, int& visits) {
+		ASSERT_EQ(1u, key % 2);
+		ASSERT_EQ(1, visits);
+		++seen;
+	});
+	ASSERT_EQ((size_t)500, seen);
+
+	for (uint32_t i = 0; i < 1000; ++i) {
+		ASSERT_EQ(i % 2 == 1, map.find(i * 7) != nullptr);
+	}
+}
+
+TEST(FlatHashMapTests, pairCacheCountsEachLookup) {
+	const uint32_t NEIGHBOURS = 8;
+	const int PASSES = 20;
+
+	for (uint32_t num_objects : {1000u, 5000u}) {
+		auto keys = neighbour_pairs(num_objects, NEIGHBOURS);
+		std::shuffle(keys.begin(), keys.end(), std::mt19937(1234));
+
+		FlatHashMap<int> map;
+		SCP_unordered_map<uint32_t, int> reference;
+
+		// every pair is looked up (and inserted on the first pass) once per frame
+		for (int pass = 0; pass < PASSES; ++pass) {
+			for (auto key : keys) {
+				++map[key];
+				++reference[key];
+			}
+		}
+
+		ASSERT_EQ(reference.size(), map.size());
+		for (auto key : keys) {
+			ASSERT_NE(nullptr, map.find(key));
+			ASSERT_EQ(PASSES, *map.find(key));
+		}
+	}
+}
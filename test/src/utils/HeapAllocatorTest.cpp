@@ -19,9 +19,48 @@ TEST(HeapAllocatorTests, simpleAllocate) {
 
 	ASSERT_EQ((size_t)1, allocator.numAllocations());
 
+	auto stats = allocator.statistics();
+	ASSERT_EQ((size_t)200, stats.allocatedSize);
+	ASSERT_EQ(stats.heapSize - 200, stats.freeSize);
+	ASSERT_EQ((size_t)1, stats.numFreeRanges);
+	ASSERT_EQ(stats.freeSize, stats.largestFreeRange);
+
 	allocator.free(offset);
 
 	ASSERT_EQ((size_t)0, allocator.numAllocations());
+
+	// Freeing the only allocation must leave one free range covering the whole heap
+	stats = allocator.statistics();
+	ASSERT_EQ((size_t)1, stats.numFreeRanges);
+	ASSERT_EQ(stats.heapSize, stats.largestFreeRange);
+	ASSERT_FLOAT_EQ(0.0f, stats.fragmentation());
+}
+
+TEST(HeapAllocatorTests, fragmentation) {
+	HeapAllocator allocator(dummyResizer);
+
+	SCP_vector<size_t> offsets;
+	for (auto i = 0; i < 100; ++i) {
+		offsets.push_back(allocator.allocate(1000));
+	}
+
+	// Free every other allocation so that the free memory is split into many ranges
+	for (size_t i = 0; i < offsets.size(); i += 2) {
+		allocator.free(offsets[i]);
+	}
+
+	auto stats = allocator.statistics();
+	ASSERT_EQ((size_t)50, stats.numAllocations);
+	ASSERT_EQ((size_t)50 * 1000, stats.allocatedSize);
+	ASSERT_EQ((size_t)51, stats.numFreeRanges);
+	ASSERT_GT(stats.fragmentation(), 0.0f);
+
+	// Ranges of exactly the freed size have to be reused before the rest of the heap
+	for (auto i = 0; i < 50; ++i) {
+		ASSERT_LT(allocator.allocate(1000), (size_t)100 * 1000);
+	}
+
+	ASSERT_EQ((size_t)1, allocator.statistics().numFreeRanges);
 }
 
 TEST(HeapAllocatorTests, manySmallAllocations) {
@@ -139,3 +178,48 @@ TEST(HeapAllocatorTests, largeAllocations) {
 	ASSERT_EQ(offsets.size(), allocator.numAllocations());
 	ASSERT_EQ((size_t)0, offsets.size());
 }
+
+TEST(HeapAllocatorTests, churnKeepsRangesMerged) {
+	HeapAllocator allocator(dummyResizer);
+
+	std::mt19937 gen(1234);
+	std::uniform_int_distribution<size_t> sizeDist(1, 5000);
+
+	const size_t NUM_LIVE = 2000;
+	const size_t NUM_OPERATIONS = 50000;
+
+	SCP_vector<size_t> offsets;
+	for (size_t i = 0; i < NUM_LIVE; ++i) {
+		offsets.push_back(allocator.allocate(52 * sizeDist(gen)));
+	}
+
+	auto heapSize = allocator.statistics().heapSize;
+
+	// Replace random allocations like models and decals being loaded and unloaded
+	for (size_t i = 0; i < NUM_OPERATIONS; ++i) {
+		std::uniform_int_distribution<size_t> dis(0, offsets.size() - 1);
+		auto& offset = offsets[dis(gen)];
+
+		allocator.free(offset);
+		offset = allocator.allocate(52 * sizeDist(gen));
+
+		ASSERT_EQ((size_t)0, offset % 52);
+	}
+
+	auto stats = allocator.statistics();
+	ASSERT_EQ(NUM_LIVE, stats.numAllocations);
+
+	// Neighboring free ranges are always merged, so there is at most one between each pair of allocations
+	ASSERT_LE(stats.numFreeRanges, NUM_LIVE + 1);
+
+	// The freed ranges have to be reused instead of the heap growing with every replacement
+	ASSERT_LE(stats.heapSize, 2 * heapSize);
+
+	for (auto offset : offsets) {
+		allocator.free(offset);
+	}
+
+	stats = allocator.statistics();
+	ASSERT_EQ((size_t)1, stats.numFreeRanges);
+	ASSERT_EQ(stats.heapSize, stats.largestFreeRange);
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include "globalincs/pstypes.h"
+#include "cmdline/cmdline.h"
+#include "utils/threading.h"
+
+#include <atomic>
+#include <thread>
+
+namespace {
+class ThreadingTest : public ::testing::Test {
+ protected:
+	int _old_multithreading = 0;
+
+	void SetUp() override {
+		_old_multithreading = Cmdline_multithreading;
+
+		// the main thread and three workers
+		Cmdline_multithreading = 4;
+		threading::init_task_pool();
+	}
+
+	void TearDown() override {
+		threading::shut_down_task_pool();
+		Cmdline_multithreading = _old_multithreading;
+	}
+};
+}
+
+TEST_F(ThreadingTest, parallelForCallsEachIndexOnce) {
+	ASSERT_TRUE(threading::is_threading());
+
+	SCP_vector<std::atomic_int> calls(10000);
+	threading::parallel_for(calls.size(), 1, [&calls](size_t i) { calls[i].fetch_add(1); });
+
+	for (auto& count : calls) {
+		ASSERT_EQ(1, count.load());
+	}
+}
+
+TEST_F(ThreadingTest, parallelForWaitsForEveryWorker) {
+	std::atomic_int inside(0);
+
+	// back to back batches, so a worker that was still inside the previous one would show up here
+	for (int batch = 0; batch < 200; ++batch) {
+		threading::parallel_for(64, 1, [&inside](size_t) {
+			inside.fetch_add(1);
+			std::this_thread::yield();
+			inside.fetch_sub(1);
+		});
+
+		ASSERT_EQ(0, inside.load());
+	}
+}
+
+TEST_F(ThreadingTest, smallCountsRunOnTheCallingThread) {
+	auto caller = std::this_thread::get_id();
+	std::atomic_bool elsewhere(false);
+
+	threading::parallel_for(8, 32, [caller, &elsewhere](size_t) {
+		if (std::this_thread::get_id() != caller) {
+			elsewhere = true;
+		}
+	});
+
+	ASSERT_FALSE(elsewhere.load());
+}
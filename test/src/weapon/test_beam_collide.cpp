@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+
+#include "model/model.h"
+#include "object/object.h"
+#include "weapon/beam.h"
+
+#include "util/FSTestFixture.h"
+#include "util/test_util.h"
+
+#include <algorithm>
+#include <random>
+
+extern polymodel *Polygon_models[MAX_POLYGON_MODELS];
+
+class BeamCollideTest : public test::FSTestFixture {
+ public:
+	BeamCollideTest() : test::FSTestFixture(INIT_NONE) {
+	}
+
+ protected:
+	static constexpr int MODEL_NUM = MAX_POLYGON_MODELS - 1;
+	static constexpr float SIZE = 50.0f;
+
+	polymodel *_pm = nullptr;
+
+	void SetUp() override {
+		test::FSTestFixture::SetUp();
+
+		obj_init();
+
+		// a model that is nothing but a cube shaped shield, which is all model_collide() needs for shield checks
+		_pm = new polymodel();
+		_pm->id = MODEL_NUM;
+		_pm->n_models = 1;
+		_pm->detail[0] = 0;
+		_pm->submodel = new bsp_info[1];
+		_pm->rad = SIZE * 1.8f;
+		vm_vec_make(&_pm->mins, -SIZE, -SIZE, -SIZE);
+		vm_vec_make(&_pm->maxs, SIZE, SIZE, SIZE);
+
+		_pm->shield.nverts = 8;
+		_pm->shield.verts = new shield_vertex[8];
+		for (int i = 0; i < 8; ++i) {
+			vm_vec_make(&_pm->shield.verts[i].pos, (i & 1) ? SIZE : -SIZE, (i & 2) ? SIZE : -SIZE, (i & 4) ? SIZE : -SIZE);
+			_pm->shield.verts[i].u = _pm->shield.verts[i].v = 0.0f;
+		}
+
+		// two triangles for each side, facing out
+		const int sides[6][4] = { {0, 2, 6, 4}, {1, 3, 7, 5}, {0, 1, 5, 4}, {2, 3, 7, 6}, {0, 1, 3, 2}, {4, 5, 7, 6} };
+
+		_pm->shield.ntris = 12;
+		_pm->shield.tris = new shield_tri[12];
+		for (int i = 0; i < 12; ++i) {
+			const int *side = sides[i / 2];
+			auto tri = &_pm->shield.tris[i];
+
+			tri->used = 0;
+			tri->verts[0] = side[0];
+			tri->verts[1] = side[(i % 2) ? 2 : 1];
+			tri->verts[2] = side[(i % 2) ? 3 : 2];
+			tri->neighbors[0] = tri->neighbors[1] = tri->neighbors[2] = -1;
+
+			vec3d center;
+			vm_vec_avg3(&center, &_pm->shield.verts[tri->verts[0]].pos, &_pm->shield.verts[tri->verts[1]].pos, &_pm->shield.verts[tri->verts[2]].pos);
+			vm_vec_normal(&tri->norm, &_pm->shield.verts[tri->verts[0]].pos, &_pm->shield.verts[tri->verts[1]].pos, &_pm->shield.verts[tri->verts[2]].pos);
+
+			if (vm_vec_dot(&tri->norm, &center) < 0.0f) {
+				vm_vec_negate(&tri->norm);
+			}
+		}
+
+		Polygon_models[MODEL_NUM] = _pm;
+	}
+	void TearDown() override {
+		Polygon_models[MODEL_NUM] = nullptr;
+
+		delete[] _pm->shield.tris;
+		delete[] _pm->shield.verts;
+		delete[] _pm->submodel;
+		delete _pm;
+
+		obj_delete_all();
+
+		test::FSTestFixture::TearDown();
+	}
+
+	static int make_object(const vec3d *pos) {
+		int objnum = obj_create(OBJ_POINT, -1, -1, nullptr, pos, SIZE, flagset<Object::Object_Flags>());
+		EXPECT_GE(objnum, 0);
+		return objnum;
+	}
+
+	static void setup_ray(mc_info *mc, const object *target, const vec3d *p0, const vec3d *p1) {
+		mc->model_num = MODEL_NUM;
+		mc->orient = &target->orient;
+		mc->pos = &target->pos;
+		mc->p0 = p0;
+		mc->p1 = p1;
+		mc->flags = MC_CHECK_SHIELD;
+	}
+};
+
+TEST_F(BeamCollideTest, batchedCastsMatchCastingEachQuery) {
+	const int NUM_BEAMS = 12;
+	const int NUM_TARGETS = 20;
+
+	std::mt19937 rng(1234);
+	std::uniform_real_distribution<float> coord(-5000.0f, 5000.0f);
+	std::uniform_real_distribution<float> miss(-2.0f * SIZE, 2.0f * SIZE);
+
+	SCP_vector<int> beams, targets;
+	for (int i = 0; i < NUM_BEAMS + NUM_TARGETS; ++i) {
+		vec3d pos;
+		vm_vec_make(&pos, coord(rng), coord(rng), coord(rng));
+
+		(i < NUM_BEAMS ? beams : targets).push_back(make_object(&pos));
+	}
+	obj_merge_created_list();
+
+	// every beam against every target, through the target but not always through its shield
+	SCP_vector<vec3d> ends(NUM_BEAMS * NUM_TARGETS * 2);
+	SCP_vector<beam_collide_query> queries;
+
+	for (int b = 0; b < NUM_BEAMS; ++b) {
+		for (int t = 0; t < NUM_TARGETS; ++t) {
+			object *beam_objp = &Objects[beams[b]];
+			object *target_objp = &Objects[targets[t]];
+
+			vec3d aim, offset;
+			vm_vec_make(&offset, miss(rng), miss(rng), miss(rng));
+			vm_vec_add(&aim, &target_objp->pos, &offset);
+
+			vec3d *p0 = &ends[(b * NUM_TARGETS + t) * 2];
+			vec3d *p1 = p0 + 1;
+
+			*p0 = beam_objp->pos;
+			vm_vec_sub(p1, &aim, p0);
+			vm_vec_scale_add(p1, p0, p1, 2.0f);
+
+			beam_collide_query query;
+			query.pair.a = beam_objp;
+			query.pair.b = target_objp;
+			query.type = beam_collide_type::SHIP;
+			query.check_shield = ((b + t) % 2 == 0);
+			query.check_hull_exit = ((b + t) % 3 == 0);
+
+			setup_ray(&query.mc_hull_enter, target_objp, p0, p1);
+			setup_ray(&query.mc_hull_exit, target_objp, p1, p0);
+			setup_ray(&query.mc_shield, target_objp, p0, p1);
+
+			queries.push_back(std::move(query));
+		}
+	}
+
+	// what casting each query on its own, the way beam collisions used to be checked, finds
+	auto expected = queries;
+	int num_hits = 0;
+
+	for (auto &query : expected) {
+		if (query.check_shield)
+			query.shield_collision = model_collide(&query.mc_shield);
+		if (query.check_hull_exit)
+			query.hull_exit_collision = model_collide(&query.mc_hull_exit);
+		query.hull_enter_collision = model_collide(&query.mc_hull_enter);
+
+		num_hits += query.hull_enter_collision;
+	}
+
+	// make sure the test actually tells hits and misses apart
+	ASSERT_GT(num_hits, 0);
+	ASSERT_LT(num_hits, static_cast<int>(expected.size()));
+
+	std::sort(expected.begin(), expected.end(), [](const beam_collide_query &a, const beam_collide_query &b) {
+		if (a.pair.a != b.pair.a)
+			return OBJ_INDEX(a.pair.a) < OBJ_INDEX(b.pair.a);
+		return OBJ_INDEX(a.pair.b) < OBJ_INDEX(b.pair.b);
+	});
+
+	for (int threads : { 1, 4 }) {
+		auto batched = queries;
+		std::shuffle(batched.begin(), batched.end(), rng);
+
+		{
+			test::ScopedTaskPool pool(threads);
+			beam_collide_cast_all(batched);
+		}
+
+		ASSERT_EQ(expected.size(), batched.size());
+
+		for (size_t i = 0; i < expected.size(); ++i) {
+			ASSERT_EQ(expected[i].pair.a, batched[i].pair.a) << threads << " threads, query " << i;
+			ASSERT_EQ(expected[i].pair.b, batched[i].pair.b) << threads << " threads, query " << i;
+
+			ASSERT_EQ(expected[i].hull_enter_collision, batched[i].hull_enter_collision) << threads << " threads, query " << i;
+			ASSERT_EQ(expected[i].hull_exit_collision, batched[i].hull_exit_collision) << threads << " threads, query " << i;
+			ASSERT_EQ(expected[i].shield_collision, batched[i].shield_collision) << threads << " threads, query " << i;
+
+			ASSERT_EQ(expected[i].mc_hull_enter.shield_hit_tri, batched[i].mc_hull_enter.shield_hit_tri);
+			ASSERT_FLOAT_EQ(expected[i].mc_hull_enter.hit_dist, batched[i].mc_hull_enter.hit_dist);
+		}
+	}
+}